@@ -14,4 +14,10 @@ namespace config {
 
 inline constexpr size_t inputBufferStartingSize = 256;
 
+// Environment variable naming the directory syntax trees of run modules are cached in, nothing is cached if it isn't set
+inline constexpr const char* cacheDirectoryVariable = "ELYRIUM_CACHE_DIR";
+
+// File argument which reads the source from the standard input instead, which is lexed while it is still being read
+inline constexpr const char* standardInputPath = "-";
+
 }
@@ -1,100 +1,34 @@
 #include <cstdio>
+#include <cstdlib>
 #include <chrono>
 #include <filesystem>
 
 #include <Elyrium/Core/Config.hpp>
 #include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/File.hpp>
+#include <Elyrium/Context.hpp>
 
 #include "Config.hpp"
+#include "Example.hpp"
 
 #include <Elyrium/Compiler/Lexer.hpp>
 #include <Elyrium/Compiler/Parser.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
+#include <Elyrium/Compiler/ModuleLoader.hpp>
+#include <Elyrium/Compiler/AstCache.hpp>
+#include <Elyrium/Compiler/Compiler.hpp>
 
-namespace {
-
-inline constexpr lsd::StringView code = " \
-/** \n\
- * Brainfuck interpreter in ELyrium \n\
- * \n\
- * Serves as a early syntax and VM test \n\
- * \n\
- * /* Nested comments */ \n\
- * // Nested comments \n\
- */ \n\
-// ALso demonstrates some trailing comma placement \n\
-\n\
-import \"io\"; \n\
-\n\
-@const let SUCCESS = 0; \n\
-@const let FAILURE = -1; \n\
-\n\
-@const let MOD_256_BITMAP = 0xFF; \n\
-\n\
-@const let TAPE_LEN = 16384; \n\
-@const let STACK_LEN = 1024; \n\
-\n\
-let stack : arr[uint, STACK_LEN,]; \n\
-let ptr : uint = 0; \n\
-\n\
-func interpret(tape : str*,) : int { \n\
-	for (let iptr : uint, i : int,; iptr <= tape.size(); iptr++, i = tape[iptr]) { \n\
-		if (i == '<') { \n\
-			if (--ptr >= stack.size()) \n\
-				break; \n\
-		} else if (i == '>') { \n\
-			if (++ptr >= stack.size()) \n\
-				break; \n\
-		} else if (i == '+') \n\
-			++stack[ptr] &= MOD_256_BITMAP; \n\
-		else if (i == '-') \n\
-			--stack[ptr] &= MOD_256_BITMAP; \n\
-		else if (i == '.') \n\
-			std.io.putchar(stack[ptr]); \n\
-		else if (i == ',') \n\
-			stack[ptr] = std.io.getchar() & MOD_256_BITMAP; \n\
-		else if (i == '[') { \n\
-			if (stack[ptr] == 0) { \n\
-				for (let nesting : uint = 1; nesting > 0) { \n\
-					if (++iptr; iptr >= tape.size()) \n\
-						return FAILURE; \n\
-\n\
-					if (i = tape[iptr]; i == ']') \n\
-						--nesting; \n\
-					else if (i == '[') \n\
-						++nesting; \n\
-				} \n\
-			} \n\
-		} else if (i == ']') { \n\
-			if (stack[ptr] == 0) { \n\
-				for (let nesting : uint = 1; nesting > 0) { \n\
-					if (++iptr; iptr >= tape.size()) \n\
-						return FAILURE; \n\
-\n\
-					if (i = tape[iptr]; i == '[') \n\
-						--nesting; \n\
-					else if (i == ']') \n\
-						++nesting; \n\
-				} \n\
-			} \n\
-		} else return FAILURE; \n\
-	} \n\
-\n\
-	return SUCCESS; \n\
-} \n\
-\n\
-func main() : int { \n\
-	let tape : str = io.getstr(); \n\
-\n\
-	return interpret(tape); \n\
-}";
+#include <Elyrium/Interpreter/Disassembler.hpp>
 
+namespace {
 
 int runCmdEnv() {
 	lsd::String inputBuffer;
 	inputBuffer.reserve(config::inputBufferStartingSize);
 
 
-	elyrium::compiler::Parser parser(code, "idk");
+	elyrium::Context context;
+	elyrium::compiler::Parser parser(context, example::brainfuck, "idk");
 	elyrium::compiler::ast::Module module;
 
 	try {
@@ -121,7 +55,7 @@ int runCmdEnv() {
 
 		if (inputBuffer == "__EXIT_CLI__") break;
 
-		elyrium::compiler::Parser parser(inputBuffer.data(), "stdin");
+		elyrium::compiler::Parser parser(context, inputBuffer.data(), "stdin");
 		elyrium::compiler::ast::stmt_ptr stmt;
 
 		try {
@@ -144,32 +78,169 @@ int runCmdEnv() {
 	return 0;
 }
 
-int checkOptions(char* arg) {
-	std::printf("Option given!\n");
+bool isStandardInput(const char* path) {
+	return lsd::StringView(path) == config::standardInputPath;
+}
+
+/**
+ * @brief Parses the standard input, which is lexed while it is still being read
+ *
+ * @param source Receives the input, which has to outlive the module
+ */
+elyrium::compiler::ast::Module parseStandardInput(elyrium::Context& context, lsd::String& source) {
+	elyrium::filesys::InputStream input(0);
+	return elyrium::compiler::Parser(context, input, source, "stdin").parse();
+}
+
+int checkFiles(int count, char* paths[]) {
+	elyrium::Context context;
+	elyrium::filesys::FileSystem fileSystem;
 
-	return 0;
+	int result = 0;
+
+	for (int i = 0; i < count; i++) {
+		if (isStandardInput(paths[i])) {
+			// Errors can't be collected while streaming, so only the first one is reported
+			try {
+				lsd::String source;
+				parseStandardInput(context, source);
+			} catch (const elyrium::Exception& exception) {
+				std::printf("%s", exception.what());
+				result = 1;
+			}
+
+			continue;
+		}
+
+		elyrium::filesys::SourceBuffer source;
+
+		try {
+			source = fileSystem.map(paths[i]);
+		} catch (const elyrium::filesys::FilesystemError& error) {
+			std::printf("%s\n", error.what());
+			result = 1;
+
+			continue;
+		}
+
+		// Every error of a file is reported in one pass, instead of stopping at the first one
+		elyrium::compiler::Diagnostics diagnostics(source.view(), paths[i]);
+		elyrium::compiler::Parser(context, source.view(), paths[i], diagnostics).parse();
+
+		if (!diagnostics.empty()) {
+			std::printf("%s", diagnostics.format().data());
+			result = 1;
+		}
+	}
+
+	return result;
+}
+
+int disassembleFiles(int count, char* paths[]) {
+	// An optimization level may precede the files, like with most compilers
+	auto level = elyrium::compiler::OptimizationLevel::none;
+
+	if (count > 0 && paths[0][0] == '-' && paths[0][1] == 'O') {
+		lsd::StringView option(paths[0]);
+
+		if (option == "-O1") level = elyrium::compiler::OptimizationLevel::basic;
+		else if (option == "-O2") level = elyrium::compiler::OptimizationLevel::full;
+		else if (option != "-O0") {
+			std::printf("Unknown optimization level \"%s\"!\nUsage: --disassemble [-O0 | -O1 | -O2] <files...>\n", paths[0]);
+
+			return 1;
+		}
+
+		count--;
+		paths++;
+	}
+
+	elyrium::Context context;
+	elyrium::filesys::FileSystem fileSystem;
+
+	int result = 0;
+
+	for (int i = 0; i < count; i++) {
+		try {
+			elyrium::filesys::SourceBuffer file;
+			lsd::String input;
+
+			elyrium::compiler::ast::Module module;
+			lsd::StringView source;
+			lsd::StringView path = paths[i];
+
+			if (isStandardInput(paths[i])) {
+				module = parseStandardInput(context, input);
+				source = lsd::StringView(input.data(), input.size());
+				path = "stdin";
+			} else {
+				file = fileSystem.map(paths[i]);
+				source = file.view();
+
+				module = elyrium::compiler::Parser(context, source, path).parse();
+			}
+
+			auto program = elyrium::compiler::Compiler(module, source, path, level).compile();
+
+			std::printf("%s", elyrium::bytecode::disassemble(program, context.symbols()).data());
+		} catch (const elyrium::filesys::FilesystemError& error) {
+			std::printf("%s\n", error.what());
+			result = 1;
+		} catch (const elyrium::Exception& exception) {
+			std::printf("%s", exception.what());
+			result = 1;
+		}
+	}
+
+	return result;
+}
+
+int checkOptions(int argc, char* argv[]) {
+	lsd::StringView option(argv[0]);
+
+	if (option == "-c" || option == "--check") return checkFiles(argc - 1, argv + 1);
+	else if (option == "-d" || option == "--disassemble") return disassembleFiles(argc - 1, argv + 1);
+
+	std::printf("Unknown option \"%s\"!\n", argv[0]);
+
+	return 1;
 }
 
 int runFile(char* path) {
-	auto globalPath = std::filesystem::current_path().append(path);
-	auto file = std::fopen(globalPath.c_str(), "r");
+	elyrium::Context context;
+	elyrium::compiler::ModuleLoader loader(context);
+	loader.addSearchPath(std::filesystem::current_path().string().c_str());
+
+	auto cacheDirectory = std::getenv(config::cacheDirectoryVariable);
+	elyrium::compiler::AstCache cache(context, cacheDirectory ? cacheDirectory : "");
+
+	if (cacheDirectory && *cacheDirectory != '\0') loader.bindCache(cache);
 
-	if (!file) {
-		std::printf("Could not open file at path \"%s\" with error: [Errno: %i] | %s\n", globalPath.c_str(), errno, std::strerror(errno));
+	elyrium::size_type root;
+
+	try {
+		root = loader.load(path);
+	} catch (const elyrium::filesys::FilesystemError& error) {
+		auto code = errno;
+		std::printf("%s\n", error.what());
 		
-		return errno;
-	} else {
-		std::printf("File loaded!\n");
+		return code;
+	} catch (const elyrium::Exception& exception) {
+		std::printf("%s", exception.what());
 
-		return 0;
+		return 1;
 	}
+
+	loader.unit(root).module().print();
+
+	return 0;
 }
 
 } // namespace
 
 int main(int argc, char* argv[]) {
 	if (argc > 1) {
-		if (*argv[1] == '-') return checkOptions(argv[1]);
+		if (*argv[1] == '-') return checkOptions(argc - 1, argv + 1);
 		else return runFile(argv[1]);
 	}
 	else {
@@ -11,9 +11,13 @@
 #pragma once
 
 #include <LSD/Vector.h>
-#include <LSD/UniquePointer.h>
+
+#include <Elyrium/Core/File.hpp>
 
 #include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/TokenBuffer.hpp>
+#include <Elyrium/Compiler/LiteralArena.hpp>
+#include <Elyrium/Compiler/AstArena.hpp>
 
 #include <cassert>
 #include <variant>
@@ -37,10 +41,11 @@ enum class ExprType {
 
 // General types and forward declarations
 
+// Nodes are owned by the AstArena of their module and are never deleted through a base pointer, so they have no virtual destructors
+
 class Statement {
 public:
 	Statement() = default;
-	virtual ~Statement() { };
 
 	virtual void print(int = 0) const = 0;
 };
@@ -57,14 +62,14 @@ class IfStmt;
 class ForStmt;
 class TryCatchStmt;
 
-using stmt_ptr = lsd::UniquePointer<Statement>;
-using null_stmt_ptr = lsd::UniquePointer<NullStmt>;
-using expr_stmt_ptr = lsd::UniquePointer<ExprStmt>;
-using jump_stmt_ptr = lsd::UniquePointer<JumpStmt>;
-using block_stmt_ptr = lsd::UniquePointer<BlockStmt>;
-using if_stmt_ptr = lsd::UniquePointer<IfStmt>;
-using for_stmt_ptr = lsd::UniquePointer<ForStmt>;
-using try_catch_stmt_ptr = lsd::UniquePointer<TryCatchStmt>;
+using stmt_ptr = NodePointer<Statement>;
+using null_stmt_ptr = NodePointer<NullStmt>;
+using expr_stmt_ptr = NodePointer<ExprStmt>;
+using jump_stmt_ptr = NodePointer<JumpStmt>;
+using block_stmt_ptr = NodePointer<BlockStmt>;
+using if_stmt_ptr = NodePointer<IfStmt>;
+using for_stmt_ptr = NodePointer<ForStmt>;
+using try_catch_stmt_ptr = NodePointer<TryCatchStmt>;
 
 
 class Declaration : public Statement { };
@@ -84,25 +89,24 @@ class CoroutineDecl;
 class ClassDecl;
 class EnumDecl;
 
-using decl_ptr = lsd::UniquePointer<Declaration>;
-using obj_decl_ptr = lsd::UniquePointer<ObjectDecl>;
-using null_decl_ptr = lsd::UniquePointer<NullDecl>;
-using namespace_decl_ptr = lsd::UniquePointer<NamespaceDecl>;
-using import_decl_ptr = lsd::UniquePointer<ImportDecl>;
-using variable_decl_ptr = lsd::UniquePointer<VariableDecl>;
-using function_decl_ptr = lsd::UniquePointer<FunctionDecl>;
-using special_function_decl_ptr = lsd::UniquePointer<SpecialFunctionDecl>;
-using coroutine_decl_ptr = lsd::UniquePointer<CoroutineDecl>;
-using class_decl_ptr = lsd::UniquePointer<ClassDecl>;
-using enum_decl_ptr = lsd::UniquePointer<EnumDecl>;
+using decl_ptr = NodePointer<Declaration>;
+using obj_decl_ptr = NodePointer<ObjectDecl>;
+using null_decl_ptr = NodePointer<NullDecl>;
+using namespace_decl_ptr = NodePointer<NamespaceDecl>;
+using import_decl_ptr = NodePointer<ImportDecl>;
+using variable_decl_ptr = NodePointer<VariableDecl>;
+using function_decl_ptr = NodePointer<FunctionDecl>;
+using special_function_decl_ptr = NodePointer<SpecialFunctionDecl>;
+using coroutine_decl_ptr = NodePointer<CoroutineDecl>;
+using class_decl_ptr = NodePointer<ClassDecl>;
+using enum_decl_ptr = NodePointer<EnumDecl>;
 
 
 class Expression {
 public:
 	Expression() = default;
-	virtual ~Expression() { }
 
-	virtual void bindRight(lsd::UniquePointer<Expression>&&);
+	virtual void bindRight(NodePointer<Expression>&&);
 	virtual void print(int = 0) const = 0;
 };
 
@@ -117,17 +121,17 @@ class IfExpr;
 class ForExpr;
 class TryCatchExpr;
 
-using expr_ptr = lsd::UniquePointer<Expression>;
-using atomic_expr_ptr = lsd::UniquePointer<AtomicExpr>;
-using member_expr_ptr = lsd::UniquePointer<MemberExpr>;
-using unary_expr_ptr = lsd::UniquePointer<UnaryExpr>;
-using infix_expr_ptr = lsd::UniquePointer<InfixExpr>;
-using closure_expr_ptr = lsd::UniquePointer<ClosureExpr>;
-using coclosure_expr_ptr = lsd::UniquePointer<CoclosureExpr>;
-using block_expr_ptr = lsd::UniquePointer<BlockExpr>;
-using if_expr_ptr = lsd::UniquePointer<IfExpr>;
-using for_expr_ptr = lsd::UniquePointer<ForExpr>;
-using try_catch_expr = lsd::UniquePointer<TryCatchExpr>;
+using expr_ptr = NodePointer<Expression>;
+using atomic_expr_ptr = NodePointer<AtomicExpr>;
+using member_expr_ptr = NodePointer<MemberExpr>;
+using unary_expr_ptr = NodePointer<UnaryExpr>;
+using infix_expr_ptr = NodePointer<InfixExpr>;
+using closure_expr_ptr = NodePointer<ClosureExpr>;
+using coclosure_expr_ptr = NodePointer<CoclosureExpr>;
+using block_expr_ptr = NodePointer<BlockExpr>;
+using if_expr_ptr = NodePointer<IfExpr>;
+using for_expr_ptr = NodePointer<ForExpr>;
+using try_catch_expr = NodePointer<TryCatchExpr>;
 
 
 namespace detail {
@@ -144,7 +148,7 @@ public:
 	void print(int level = 0) const;
 };
 
-using type_ident_ptr = lsd::UniquePointer<TypeIdentifier>;
+using type_ident_ptr = NodePointer<TypeIdentifier>;
 
 
 struct IdentifierDecl {
@@ -181,16 +185,28 @@ public:
 	expr_ptr& condition() noexcept {
 		return m_conditionOrRange;
 	}
+	const expr_ptr& condition() const noexcept {
+		return m_conditionOrRange;
+	}
 	expr_ptr& range() noexcept {
 		return m_conditionOrRange;
 	}
+	const expr_ptr& range() const noexcept {
+		return m_conditionOrRange;
+	}
 
 	lsd::Vector<expr_ptr>& loop() noexcept {
 		return m_loopOrItems;
 	}
+	const lsd::Vector<expr_ptr>& loop() const noexcept {
+		return m_loopOrItems;
+	}
 	lsd::Vector<expr_ptr>& items() noexcept {
 		return m_loopOrItems;
 	}
+	const lsd::Vector<expr_ptr>& items() const noexcept {
+		return m_loopOrItems;
+	}
 
 private:
 	expr_ptr m_conditionOrRange;
@@ -212,7 +228,7 @@ using param_t = lsd::Vector<IdentifierDecl>;
 using arg_t = lsd::Vector<expr_ptr>;
 using subscript_t = expr_ptr;
 
-using catch_construct_ptr = lsd::UniquePointer<CatchConstruct>;
+using catch_construct_ptr = NodePointer<CatchConstruct>;
 
 
 // Advanced utility classes
@@ -225,6 +241,17 @@ public:
 	void print(int level = 0) const;
 };
 
+/**
+ * @brief Tokens of a function body which was only pre-parsed, from its opening to its closing brace
+ */
+struct LazyBody {
+public:
+	TokenBuffer::index_type first = 0;
+	TokenBuffer::index_type last = 0;
+
+	void print(int level = 0) const;
+};
+
 } // namespace detail
 
 
@@ -235,10 +262,66 @@ public:
 	Module() = default;
 
 	void bindDeclaration(decl_ptr&& decl);
+	/**
+	 * @brief Replaces a range of top level declarations with others, which may be allocated outside of the arena of the module
+	 */
+	void replaceDeclarations(size_type first, size_type count, lsd::Vector<decl_ptr>&& declarations);
+	void bindArena(AstArena&& arena) {
+		m_arena = std::move(arena);
+	}
+	/**
+	 * @brief Keeps the tokens of the module around, which lazily parsed function bodies are parsed from
+	 */
+	void bindTokens(TokenBuffer&& tokens, lsd::StringView path) {
+		m_tokens = std::move(tokens);
+		m_path = path;
+	}
+	[[nodiscard]] AstArena releaseArena() noexcept {
+		return std::move(m_arena);
+	}
+	[[nodiscard]] TokenBuffer releaseTokens() noexcept {
+		return std::move(m_tokens);
+	}
+	void bindLiterals(LiteralArena&& literals) {
+		m_literals = std::move(literals);
+	}
+	/**
+	 * @brief Keeps a buffer alive which the tokens and literals of the module point into, like a mapped cache file
+	 */
+	void bindStorage(filesys::SourceBuffer&& storage) {
+		m_storage = std::move(storage);
+	}
 	void print() const;
 
+	[[nodiscard]] const LiteralArena& literals() const noexcept {
+		return m_literals;
+	}
+	[[nodiscard]] LiteralArena& literals() noexcept {
+		return m_literals;
+	}
+	[[nodiscard]] const AstArena& arena() const noexcept {
+		return m_arena;
+	}
+	[[nodiscard]] const TokenBuffer& tokens() const noexcept {
+		return m_tokens;
+	}
+	[[nodiscard]] lsd::StringView path() const noexcept {
+		return m_path;
+	}
+	[[nodiscard]] const lsd::Vector<decl_ptr>& declarations() const noexcept {
+		return m_declarations;
+	}
+
 private:
+	filesys::SourceBuffer m_storage; // Declared first so it outlives the nodes and literals pointing into it
+	AstArena m_arena; // Declared before everything else so the nodes outlive everything referring to them
+
 	lsd::Vector<decl_ptr> m_declarations;
+
+	LiteralArena m_literals;
+
+	TokenBuffer m_tokens;
+	lsd::StringView m_path;
 };
 
 
@@ -251,6 +334,10 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const Token& value() const noexcept {
+		return m_value;
+	}
+
 private:
 	Token m_value;
 };
@@ -269,6 +356,13 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const expr_ptr& value() const noexcept {
+		return m_value;
+	}
+	[[nodiscard]] const auto& chain() const noexcept {
+		return m_chain;
+	}
+
 private:
 	expr_ptr m_value;
 
@@ -291,6 +385,16 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const lsd::Vector<Token>& prefix() const noexcept {
+		return m_prefix;
+	}
+	[[nodiscard]] const expr_ptr& expr() const noexcept {
+		return m_expr;
+	}
+	[[nodiscard]] const Token& postfix() const noexcept {
+		return m_postfix;
+	}
+
 private:
 	lsd::Vector<Token> m_prefix;
 	expr_ptr m_expr;
@@ -304,6 +408,16 @@ public:
 	void bindRight(expr_ptr&& expr);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const expr_ptr& left() const noexcept {
+		return m_left;
+	}
+	[[nodiscard]] const Token& op() const noexcept {
+		return m_operator;
+	}
+	[[nodiscard]] const expr_ptr& right() const noexcept {
+		return m_right;
+	}
+
 private:
 	expr_ptr m_left;
 	Token m_operator;
@@ -317,6 +431,13 @@ public:
 	void bindExpr(expr_ptr&& expr);
 	void print(int level) const;
 
+	[[nodiscard]] const stmt_ptr& stmt() const noexcept {
+		return m_stmt;
+	}
+	[[nodiscard]] const expr_ptr& expr() const noexcept {
+		return m_expr;
+	}
+
 private:
 	stmt_ptr m_stmt;
 	expr_ptr m_expr;
@@ -332,6 +453,10 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const expr_ptr& expr() const noexcept {
+		return m_expr;
+	}
+
 private:
 	expr_ptr m_expr;
 };
@@ -343,6 +468,13 @@ public:
 	void bindExpr(expr_ptr&& ptr);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const Token& keyword() const noexcept {
+		return m_keyword;
+	}
+	[[nodiscard]] const expr_ptr& expr() const noexcept {
+		return m_expr;
+	}
+
 private:
 	Token m_keyword;
 	expr_ptr m_expr;
@@ -355,6 +487,10 @@ public:
 	void pushStatement(stmt_ptr&& stmt);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const lsd::Vector<stmt_ptr>& statements() const noexcept {
+		return m_statements;
+	}
+
 private:
 	lsd::Vector<stmt_ptr> m_statements;
 };
@@ -366,6 +502,16 @@ public:
 	void bindElseStatement(stmt_ptr&& stmt);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const detail::IfConstruct& construct() const noexcept {
+		return m_construct;
+	}
+	[[nodiscard]] const stmt_ptr& statement() const noexcept {
+		return m_statement;
+	}
+	[[nodiscard]] const stmt_ptr& elseStatement() const noexcept {
+		return m_chain;
+	}
+
 private:
 	detail::IfConstruct m_construct;
 	stmt_ptr m_statement;
@@ -382,6 +528,13 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const detail::ForConstruct& construct() const noexcept {
+		return m_construct;
+	}
+	[[nodiscard]] const stmt_ptr& statement() const noexcept {
+		return m_statement;
+	}
+
 private:
 	detail::ForConstruct m_construct;
 	stmt_ptr m_statement;
@@ -397,6 +550,13 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const stmt_ptr& tryBlock() const noexcept {
+		return m_tryBlock;
+	}
+	[[nodiscard]] const auto& catchBlocks() const noexcept {
+		return m_catchBlocks;
+	}
+
 private:
 	stmt_ptr m_tryBlock;
 	lsd::Vector<std::pair<stmt_ptr, detail::catch_construct_ptr>> m_catchBlocks;
@@ -412,6 +572,13 @@ public:
 	void bindDecl(decl_ptr&& decl);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const Token& identifier() const noexcept {
+		return m_identifier;
+	}
+	[[nodiscard]] const lsd::Vector<decl_ptr>& declarations() const noexcept {
+		return m_declarations;
+	}
+
 private:
 	Token m_identifier;
 	lsd::Vector<decl_ptr> m_declarations;
@@ -424,6 +591,10 @@ public:
 	void bindModule(const Token& module);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const lsd::Vector<Token>& modules() const noexcept {
+		return m_modules;
+	}
+
 private:
 	lsd::Vector<Token> m_modules;
 };
@@ -435,6 +606,13 @@ public:
 	void bindDeclaration(detail::IdentifierDecl&& decl);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const detail::Attributes& attributes() const noexcept {
+		return m_attributes;
+	}
+	[[nodiscard]] const lsd::Vector<detail::IdentifierDecl>& identifiers() const noexcept {
+		return m_identifiers;
+	}
+
 private:
 	detail::Attributes m_attributes;
 	lsd::Vector<detail::IdentifierDecl> m_identifiers;
@@ -446,15 +624,37 @@ public:
 
 	void bindConstruct(detail::FunctionConstruct&& construct);
 	void bindBody(BlockStmt&& stmt);
+	void bindLazyBody(const detail::LazyBody& body);
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const detail::Attributes& attributes() const noexcept {
+		return m_attributes;
+	}
+	[[nodiscard]] const Token& identifier() const noexcept {
+		return m_identifier;
+	}
+	[[nodiscard]] const detail::FunctionConstruct& construct() const noexcept {
+		return m_construct;
+	}
+	[[nodiscard]] const BlockStmt& body() const noexcept {
+		return m_body;
+	}
+	[[nodiscard]] bool lazy() const noexcept {
+		return m_lazy;
+	}
+	[[nodiscard]] const detail::LazyBody& lazyBody() const noexcept {
+		return m_lazyBody;
+	}
+
 private:
 	detail::Attributes m_attributes;
 	Token m_identifier;
 	detail::FunctionConstruct m_construct;
 
 	BlockStmt m_body;
+	detail::LazyBody m_lazyBody;
+	bool m_lazy = false;
 };
 
 /*
@@ -492,6 +692,16 @@ public:
 	void bindDecl(decl_ptr&& decl);
 	void print(int level = 0) const;
 
+	[[nodiscard]] const detail::Attributes& attributes() const noexcept {
+		return m_attributes;
+	}
+	[[nodiscard]] const Token& identifier() const noexcept {
+		return m_identifier;
+	}
+	[[nodiscard]] const lsd::Vector<decl_ptr>& declarations() const noexcept {
+		return m_body;
+	}
+
 private:
 	detail::Attributes m_attributes;
 	Token m_identifier;
@@ -507,6 +717,19 @@ public:
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const detail::Attributes& attributes() const noexcept {
+		return m_attributes;
+	}
+	[[nodiscard]] const Token& identifier() const noexcept {
+		return m_identifier;
+	}
+	[[nodiscard]] const detail::type_ident_ptr& type() const noexcept {
+		return m_type;
+	}
+	[[nodiscard]] const lsd::Vector<expr_ptr>& values() const noexcept {
+		return m_values;
+	}
+
 private:
 	detail::Attributes m_attributes;
 	Token m_identifier;
@@ -524,14 +747,33 @@ public:
 	void bindCaptureExpression(expr_ptr&& expr);
 	void bindConstruct(detail::FunctionConstruct&& construct);
 	void bindBody(BlockStmt&& stmt);
+	void bindLazyBody(const detail::LazyBody& body);
 
 	void print(int level = 0) const;
 
+	[[nodiscard]] const lsd::Vector<expr_ptr>& captures() const noexcept {
+		return m_captures;
+	}
+	[[nodiscard]] const detail::FunctionConstruct& construct() const noexcept {
+		return m_construct;
+	}
+	[[nodiscard]] const BlockStmt& body() const noexcept {
+		return m_body;
+	}
+	[[nodiscard]] bool lazy() const noexcept {
+		return m_lazy;
+	}
+	[[nodiscard]] const detail::LazyBody& lazyBody() const noexcept {
+		return m_lazyBody;
+	}
+
 private:
 	lsd::Vector<expr_ptr> m_captures;
 	detail::FunctionConstruct m_construct;
 
 	BlockStmt m_body;
+	detail::LazyBody m_lazyBody;
+	bool m_lazy = false;
 };
 
 } // namespace ast
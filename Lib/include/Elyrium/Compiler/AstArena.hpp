@@ -0,0 +1,140 @@
+/*************************
+ * @file AstArena.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Bump pointer storage for the nodes of a syntax tree
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Arena.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Non owning, move only handle to a node inside of an AstArena
+ *
+ * @note Moving out of a node pointer leaves it null, destroying it does nothing since the node is owned by its arena
+ */
+template <class Ty> class NodePointer {
+public:
+	using value_type = Ty;
+	using pointer = Ty*;
+
+	constexpr NodePointer() noexcept = default;
+	constexpr NodePointer(std::nullptr_t) noexcept { }
+	NodePointer(const NodePointer&) = delete;
+	constexpr NodePointer(NodePointer&& other) noexcept : m_pointer(std::exchange(other.m_pointer, nullptr)) { }
+	template <class Other> requires std::is_convertible_v<Other*, Ty*>
+	constexpr NodePointer(NodePointer<Other>&& other) noexcept : m_pointer(other.release()) { }
+
+	NodePointer& operator=(const NodePointer&) = delete;
+	constexpr NodePointer& operator=(NodePointer&& other) noexcept {
+		m_pointer = std::exchange(other.m_pointer, nullptr);
+		return *this;
+	}
+	template <class Other> requires std::is_convertible_v<Other*, Ty*>
+	constexpr NodePointer& operator=(NodePointer<Other>&& other) noexcept {
+		m_pointer = other.release();
+		return *this;
+	}
+	constexpr NodePointer& operator=(std::nullptr_t) noexcept {
+		m_pointer = nullptr;
+		return *this;
+	}
+
+	constexpr pointer release() noexcept {
+		return std::exchange(m_pointer, nullptr);
+	}
+
+	[[nodiscard]] constexpr pointer get() const noexcept {
+		return m_pointer;
+	}
+	[[nodiscard]] constexpr pointer operator->() const noexcept {
+		return m_pointer;
+	}
+	[[nodiscard]] constexpr Ty& operator*() const noexcept {
+		return *m_pointer;
+	}
+	[[nodiscard]] constexpr explicit operator bool() const noexcept {
+		return m_pointer != nullptr;
+	}
+
+private:
+	pointer m_pointer = nullptr;
+
+	constexpr explicit NodePointer(pointer pointer) noexcept : m_pointer(pointer) { }
+
+	friend class AstArena;
+};
+
+
+/**
+ * @brief Storage every node of a module is allocated from, releasing the whole tree at once when it dies
+ *
+ * @note Nodes which are trivially destructible are never visited again, only nodes which own memory outside of the arena are finalized
+ */
+class AstArena {
+public:
+	static constexpr size_type blockSize = 65536;
+
+	AstArena() noexcept : m_storage(blockSize) { }
+	AstArena(const AstArena&) = delete;
+	AstArena(AstArena&& other) noexcept;
+	~AstArena();
+
+	AstArena& operator=(const AstArena&) = delete;
+	AstArena& operator=(AstArena&& other) noexcept;
+
+	template <class Ty, class... Args> [[nodiscard]] NodePointer<Ty> create(Args&&... args) {
+		auto node = m_storage.construct<Ty>(std::forward<Args>(args)...);
+
+		if constexpr (!std::is_trivially_destructible_v<Ty>) {
+			m_finalizers = m_storage.construct<Finalizer>(Finalizer {
+				m_finalizers,
+				node,
+				[](void* object) { static_cast<Ty*>(object)->~Ty(); }
+			});
+		}
+
+		++m_nodeCount;
+
+		return NodePointer<Ty>(node);
+	}
+
+	void release() noexcept;
+
+	[[nodiscard]] size_type nodeCount() const noexcept {
+		return m_nodeCount;
+	}
+	[[nodiscard]] size_type allocatedBytes() const noexcept {
+		return m_storage.allocatedBytes();
+	}
+
+private:
+	struct Finalizer {
+	public:
+		Finalizer* next;
+		void* object;
+		void (*destroy)(void*);
+	};
+
+	Arena m_storage;
+	Finalizer* m_finalizers = nullptr;
+
+	size_type m_nodeCount = 0;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
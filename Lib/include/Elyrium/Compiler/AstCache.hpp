@@ -0,0 +1,87 @@
+/*************************
+ * @file AstCache.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Binary serialization of syntax trees, cached on disk and read back instead of parsing again
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Context.hpp>
+
+#include <Elyrium/Compiler/AST.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+
+#include <mutex>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Writes and maps cache files of parsed modules
+ *
+ * @note A cache file starts with a magic number, the format version, the compiler version and the hash and size of its source.
+ * It continues with a table of the names of the identifiers, a table of the string literals and the declarations of the module in preorder.
+ * Node tags, counts, table indices and the source offsets of tokens, as deltas from the previous token, are varints.
+ * Loading rebuilds the tree in a new arena, whose tokens point into the source again, so errors are still reported at their positions.
+ * Only the string literals are left in the mapped file, which the module keeps alive.
+ */
+class AstCache {
+public:
+	static constexpr uint32 formatVersion = 4;
+	static constexpr lsd::StringView extension = ".elyc";
+
+	/**
+	 * @param directory Directory the cache files are written to named by the hash of their source, they are written next to the sources if empty
+	 */
+	AstCache(Context& context, lsd::StringView directory = lsd::StringView());
+
+	/**
+	 * @brief Loads the cached tree of a source
+	 *
+	 * @note Interns the identifiers of the tree into the symbol table of the context
+	 *
+	 * @param symbolsMutex Mutex guarding the symbol table of the context, which is only held while the identifiers are interned
+	 *
+	 * @return False if there is no cache, or if it was written for a different source or compiler version
+	 */
+	bool load(lsd::StringView path, lsd::StringView source, ast::Module& module, std::mutex* symbolsMutex = nullptr) const;
+	/**
+	 * @brief Writes the tree of a source to its cache file, failing silently since the cache is only an optimization
+	 *
+	 * @note The bodies of lazily parsed functions have to be parsed first
+	 */
+	void store(lsd::StringView path, lsd::StringView source, const ast::Module& module) const;
+
+	[[nodiscard]] lsd::String cachePath(lsd::StringView path, uint64 sourceHash) const;
+
+	/**
+	 * @brief Writes the tree of a module, throwing an Exception for lazily parsed bodies and expressions nested too deeply to be cached
+	 */
+	[[nodiscard]] static lsd::Vector<uint8> serialize(const ast::Module& module, lsd::StringView source);
+	/**
+	 * @brief Reads a serialized tree, whose tokens point into the source and whose string literals point into the data
+	 *
+	 * @return False if the data is malformed or was written for a different source or compiler version
+	 */
+	[[nodiscard]] static bool deserialize(lsd::StringView data, lsd::StringView source, SymbolTable& symbols, ast::Module& module, std::mutex* symbolsMutex = nullptr);
+
+	[[nodiscard]] static uint64 hashSource(lsd::StringView source) noexcept;
+
+private:
+	Context& m_context;
+	lsd::String m_directory;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
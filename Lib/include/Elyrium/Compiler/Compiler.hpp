@@ -7,3 +7,320 @@
  * @date 2025-03-30
  * @copyright Copyright (c) 2025
  *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/AST.hpp>
+#include <Elyrium/Compiler/Resolver.hpp>
+#include <Elyrium/Compiler/TypeChecker.hpp>
+#include <Elyrium/Compiler/Optimizer.hpp>
+
+#include <Elyrium/Interpreter/Opcodes.hpp>
+#include <Elyrium/Interpreter/Bytecode.hpp>
+#include <Elyrium/Interpreter/Encoding.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Lowers a module into register based bytecode with three address instructions
+ *
+ * @note Locals and parameters live in registers of their function and temporaries are allocated on top of them like a stack,
+ * so operands which are locals are used in place instead of being copied.
+ * Names are resolved before compiling, so the compiler only maps the locals of the resolver to registers.
+ * Operations on values whose types the type checker knows are compiled into opcodes specialized for them.
+ */
+class Compiler {
+public:
+	using operand_type = bytecode::operand_type;
+
+	static constexpr operand_type noRegister = ~operand_type { 0 };
+
+	/**
+	 * @param source Source the module was parsed from, which errors are located in
+	 *
+	 * @param level Optimizations applied to every function before it is encoded
+	 *
+	 * @note Lazily parsed function bodies are parsed while compiling, so the tokens of the module have to be alive
+	 */
+	Compiler(ast::Module& module, lsd::StringView source, lsd::StringView path, OptimizationLevel level = OptimizationLevel::none);
+
+	/**
+	 * @brief Compiles the module, throwing a CompileError for constructs the compiler can't lower
+	 */
+	[[nodiscard]] bytecode::Program compile();
+
+private:
+	struct Local {
+	public:
+		operand_type reg;
+		bool captured;
+	};
+
+	struct Loop {
+	public:
+		lsd::Vector<size_type> breaks;
+		lsd::Vector<size_type> continues;
+		size_type localCount; // Locals in scope outside of the loop
+	};
+
+	struct FunctionState {
+	public:
+		size_type function; // Index of the function in the program
+		lsd::Vector<bytecode::Instruction> code; // Jump targets are instruction indices until the function is assembled
+
+		lsd::Vector<Local> locals; // Locals in scope, in order of declaration
+		lsd::Vector<operand_type> registers; // Register of every local of the resolver, indexed by its number
+		lsd::Vector<Loop> loops;
+
+		operand_type localTop = 0; // Registers below are occupied by locals in scope
+		operand_type free = 0; // First register which isn't used by a local or temporary
+	};
+
+	/**
+	 * @brief Location an assignment or increment stores into
+	 */
+	struct Place {
+	public:
+		enum class Kind : uint8 {
+			local, // Register object
+			upvalue, // Upvalue key
+			global, // Global slot key
+			member, // Object register and name constant key
+			index // Object and index registers
+		};
+
+		Kind kind;
+		operand_type object = noRegister;
+		operand_type key = noRegister;
+		operand_type value = noRegister; // Temporary already holding the value stored at the place, if any
+		Type type = Type::unknown; // Type of the values loaded from the place
+	};
+
+	/**
+	 * @brief Suspended lowering of an expression, resumed once the operand it is waiting for was compiled
+	 */
+	struct ExpressionFrame {
+	public:
+		enum class Kind : uint8 {
+			value, // Compiles the expression into the target register, or only for its effects if the target is noRegister
+			place, // Compiles the expression a value is stored into and returns the place
+			branch // Emits jumps which are taken if the truthiness of the expression equals when
+		};
+
+		enum class Stage : uint8 {
+			start,
+			element, // Next element of the chain of a member expression
+			argument, // Next argument of a call
+			subscript,
+			left, // Operands of infix expressions and comparisons
+			right,
+			place, // Place of an assignment or prefix increment
+			value, // Value of an assignment, place of a postfix increment, object of a place or operand of a branch
+			skip, // Left operand of a conjunction or disjunction which jumps past the right one
+			jump // Conjunction or disjunction whose jumps are emitted
+		};
+
+		const ast::Expression* expression;
+		Kind kind;
+		Stage stage = Stage::start;
+		bool restore = true; // The registers the expression allocated are freed once it was compiled
+		bool when = false;
+
+		operand_type target = noRegister;
+		operand_type mark = 0; // First free register when the expression started
+		operand_type value = noRegister; // Left operand, or the value of the chain of a member expression compiled so far
+		operand_type right = noRegister;
+
+		// Position in the chain of a member expression, which is only compiled up to count
+		size_type count = ~size_type { 0 };
+		size_type element = 0;
+		size_type argument = 0;
+		operand_type base = noRegister; // Register of a call
+		operand_type destination = noRegister; // Register of an element
+		bool method = false;
+		bool inPlace = false;
+
+		// Jump lists, indices into the stack of jump lists
+		size_type jumps = 0; // Taken by a branch, or the false jumps of a conjunction or disjunction which is compiled into a value
+		size_type skip = 0; // Skip the right operand of a branch
+
+		Place place { }; // Place of an assignment
+	};
+
+	ast::Module* m_module;
+
+	lsd::StringView m_source;
+	lsd::StringView m_path;
+	LineTable m_lines;
+	OptimizationLevel m_level;
+
+	Resolution m_resolution;
+	Typing m_typing;
+	bytecode::Program m_program;
+	lsd::Vector<FunctionState> m_functions; // Functions currently being compiled, innermost last
+
+	Token m_token; // Last token compiled, which errors are reported at
+
+	lsd::Vector<ExpressionFrame> m_frames; // Stack of the expressions being compiled, so nesting doesn't recurse
+	lsd::Vector<lsd::Vector<size_type>> m_jumps; // Jump lists of the branches being compiled, referred to by index since frames move
+	Place m_place { }; // Place the last place frame resulted in
+
+	[[noreturn]] void error(error::Message message) const;
+
+	[[nodiscard]] FunctionState& state() noexcept {
+		return m_functions.back();
+	}
+	[[nodiscard]] bytecode::Function& function() noexcept {
+		return m_program.functions[m_functions.back().function];
+	}
+	[[nodiscard]] bool temporary(operand_type reg) noexcept {
+		return reg >= state().localTop;
+	}
+
+	// Emission
+
+	size_type emit(Opcode opcode, operand_type a = 0, operand_type b = 0, operand_type c = 0);
+	/**
+	 * @brief Points the target operand of a jump to an instruction
+	 */
+	void patch(size_type jump, size_type target);
+	void patch(const lsd::Vector<size_type>& jumps, size_type target);
+	[[nodiscard]] size_type here() noexcept {
+		return state().code.size();
+	}
+
+	operand_type allocate();
+	operand_type constant(const bytecode::Constant& constant);
+	operand_type symbol(const Token& identifier);
+	/**
+	 * @brief Loads an integral literal as a value of the type the type checker gave it
+	 */
+	void integral(int64 value, Type type, operand_type target);
+	/**
+	 * @brief Loads the value variables without an initializer start out with, which is the zero of their type or null
+	 */
+	void initial(Type type, operand_type target);
+	/**
+	 * @brief Emits a check of a value stored by a node, if the type checker requires one
+	 */
+	void check(const void* node, operand_type value);
+
+	// Scopes
+
+	void declareLocal(const Token& identifier, operand_type reg);
+	void endScope(size_type localCount);
+	/**
+	 * @brief Emits a close for the captured locals declared after the first localCount ones, if there are any
+	 */
+	void close(size_type localCount);
+
+	// Declarations
+
+	/**
+	 * @brief Compiles a function declaration or closure into a new function of the program
+	 */
+	template <class Node> size_type compileFunction(const Node& node, symbol_id name);
+	/**
+	 * @brief Optimizes and encodes the instructions of the innermost function and stops compiling it
+	 */
+	void finishFunction();
+	/**
+	 * @brief Compiles a module or namespace level declaration, storing its values into their global slots
+	 */
+	void declaration(ast::Declaration* declaration);
+
+	// Statements
+
+	void statement(ast::Statement* statement);
+	void block(const ast::BlockStmt& block);
+	void variableDeclaration(const ast::VariableDecl& declaration);
+	void ifStatement(const ast::IfStmt& statement);
+	void forStatement(const ast::ForStmt& statement);
+	void jumpStatement(const ast::JumpStmt& statement);
+
+	// Expressions
+
+	/**
+	 * @brief Compiles an expression into a register
+	 */
+	void expression(const ast::Expression* expression, operand_type target);
+	/**
+	 * @brief Returns a register holding the value of an expression, which is the register of a local or a new temporary
+	 */
+	operand_type operand(const ast::Expression* expression);
+	/**
+	 * @brief Checks if an expression is a local of the current function and returns its register
+	 */
+	[[nodiscard]] bool local(const ast::Expression* expression, operand_type& reg);
+	/**
+	 * @brief Compiles an expression only for its side effects
+	 */
+	void effect(const ast::Expression* expression);
+	/**
+	 * @brief Emits jumps which are taken if the truthiness of an expression equals when, fusing comparisons into the jumps
+	 */
+	void branch(const ast::Expression* expression, bool when, lsd::Vector<size_type>& jumps);
+
+	/**
+	 * @brief Compiles the frame on top of the stack and every frame it pushes, with an explicit stack instead of native recursion
+	 */
+	void evaluate();
+	/**
+	 * @brief Suspends the frame on top of the stack until an operand of it was compiled
+	 *
+	 * @param restore Free the registers the operand allocates once it was compiled
+	 */
+	void call(const ast::Expression* expression, ExpressionFrame::Kind kind, operand_type target = noRegister, bool restore = true);
+	/**
+	 * @brief Suspends the frame on top of the stack until a branch on an operand emitted its jumps into a jump list
+	 */
+	void callBranch(const ast::Expression* expression, bool when, size_type jumps);
+	/**
+	 * @brief Compiles an operand into a register like operand(), returns true if the frame on top of the stack has to wait for it
+	 */
+	bool callOperand(const ast::Expression* expression, operand_type& reg);
+	void finish();
+	void finishPlace(const Place& place);
+
+	void atomic(const ast::AtomicExpr& expression, operand_type target);
+	/**
+	 * @brief Compiles the base and the first count elements of the chain of a member expression
+	 */
+	void continueMember(const ast::MemberExpr& expression);
+	void continueUnary(const ast::UnaryExpr& expression);
+	void continueInfix(const ast::InfixExpr& expression);
+	/**
+	 * @note Assignments discarding their value have noRegister as target
+	 */
+	void continueAssignment(const ast::InfixExpr& expression);
+	/**
+	 * @brief Emits a binary arithmetic instruction with an immediate operand, if the right operand is a small integral literal
+	 *
+	 * @param type Type of the left operand
+	 */
+	bool immediateArithmetic(Opcode opcode, operand_type target, operand_type left, Type type, const ast::Expression* right);
+	void continuePlace();
+	void continueBranch();
+
+	[[nodiscard]] Place variable(const Token& identifier);
+	void load(const Place& place, operand_type target);
+	void store(const Place& place, operand_type value);
+	/**
+	 * @param node Increment expression, whose incremented value may have to be checked
+	 */
+	operand_type increment(Place& place, int32 delta, const void* node);
+};
+
+} // namespace compiler
+
+} // namespace elyrium
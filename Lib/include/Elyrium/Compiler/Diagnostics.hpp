@@ -0,0 +1,96 @@
+/*************************
+ * @file Diagnostics.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Sink collecting the errors of a lexer and parser run instead of throwing the first one
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Records errors as compact entries while lexing and parsing continue, formatting them only when they are printed
+ *
+ * @note Offsets are relative to the source the diagnostics were created for, which has to outlive them
+ */
+class Diagnostics {
+public:
+	struct Diagnostic {
+	public:
+		error::Message message;
+		char expected; // Character expected by expectedDifferent
+		uint32 offset;
+	};
+
+	Diagnostics(lsd::StringView source, lsd::StringView path) : m_path(path), m_lines(source) { }
+
+	void report(error::Message message, size_type offset, char expected = '\0') {
+		m_diagnostics.pushBack(Diagnostic { message, expected, static_cast<uint32>(offset) });
+	}
+	void clear() noexcept {
+		m_diagnostics.clear();
+	}
+	/**
+	 * @brief Orders the diagnostics by their position in the source
+	 */
+	void sort();
+
+	[[nodiscard]] SourceLocation location(const Diagnostic& diagnostic) const {
+		return m_lines.location(diagnostic.offset);
+	}
+	/**
+	 * @brief Formats a diagnostic exactly like the SyntaxError thrown for it would be
+	 */
+	[[nodiscard]] lsd::String format(const Diagnostic& diagnostic) const;
+	/**
+	 * @brief Formats all diagnostics in the order they were reported
+	 */
+	[[nodiscard]] lsd::String format() const;
+	/**
+	 * @brief Constructs the exception of a diagnostic, for callers which stop at the first error
+	 */
+	[[nodiscard]] SyntaxError exception(const Diagnostic& diagnostic) const;
+
+	[[nodiscard]] const Diagnostic& operator[](size_type index) const noexcept {
+		return m_diagnostics[index];
+	}
+	[[nodiscard]] const Diagnostic* begin() const noexcept {
+		return m_diagnostics.data();
+	}
+	[[nodiscard]] const Diagnostic* end() const noexcept {
+		return m_diagnostics.data() + m_diagnostics.size();
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_diagnostics.size();
+	}
+	[[nodiscard]] bool empty() const noexcept {
+		return m_diagnostics.empty();
+	}
+	[[nodiscard]] lsd::StringView path() const noexcept {
+		return m_path;
+	}
+
+private:
+	lsd::StringView m_path;
+	LineTable m_lines;
+
+	lsd::Vector<Diagnostic> m_diagnostics;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,199 @@
+/*************************
+ * @file FlatAST.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Flat, index based syntax tree with struct-of-arrays node storage
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/TokenBuffer.hpp>
+
+#include <LSD/Vector.h>
+
+#include <cassert>
+#include <initializer_list>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace ast {
+
+using node_index = uint32;
+
+/**
+ * @brief Tag of a node in a flat tree, which also decides how the fields of the node are read
+ *
+ * @note Lists and records are offsets into the extra data of the tree, lists start with their element count
+ */
+enum class NodeKind : uint8 {
+	// Expressions
+	atomicExpr, // token: value
+	memberExpr, // lhs: base expression, rhs: list of chain nodes
+	callChain, // lhs: list of argument expressions
+	subscriptChain, // lhs: index expression
+	memberChain, // token: member identifier
+	unaryExpr, // token: postfix operator or none, lhs: operand, rhs: list of prefix operator tokens
+	infixExpr, // token: operator, lhs: left expression, rhs: right expression
+	closureExpr, // lhs: list of captures, rhs: function record
+
+	// Statements
+	nullStmt,
+	exprStmt, // lhs: expression
+	jumpStmt, // token: keyword, lhs: expression or none
+	blockStmt, // lhs: list of statements
+	ifStmt, // lhs: record of init statement, condition and statement, rhs: else statement or none
+	forStmt, // lhs: record of init statement, condition or range, list of loop expressions or items and whether the loop is range based, rhs: statement
+	tryCatchStmt, // lhs: try statement, rhs: list of catch clauses
+	catchClause, // token: identifier or none if nothing is caught by name, lhs: type or none, rhs: statement
+
+	// Declarations
+	nullDecl,
+	namespaceDecl, // token: identifier, lhs: list of declarations
+	importDecl, // lhs: list of module tokens
+	variableDecl, // lhs: list of attribute tokens, rhs: list of identifier declarations
+	functionDecl, // token: identifier, lhs: list of attribute tokens, rhs: function record
+	classDecl, // token: identifier, lhs: list of attribute tokens, rhs: list of declarations
+	enumDecl, // token: identifier, lhs: list of attribute tokens, rhs: record of type and list of values
+
+	// Utility nodes
+	typeIdentifier, // token: identifier or none, lhs: pointer indirection count, rhs: list of generics
+	identifierDecl // token: identifier, lhs: type or none, rhs: expression or none
+};
+
+/**
+ * @brief Module whose nodes are stored in contiguous arrays and reference their children by index
+ *
+ * @note A function record consists of the list of parameters, the return type and the body
+ */
+class FlatModule {
+public:
+	using token_index = TokenBuffer::index_type;
+
+	static constexpr node_index none = ~node_index { 0 };
+	static constexpr node_index emptyList = 0;
+
+	class NodeList {
+	public:
+		constexpr NodeList(const node_index* first, size_type size) noexcept : m_first(first), m_size(size) { }
+
+		[[nodiscard]] constexpr const node_index* begin() const noexcept {
+			return m_first;
+		}
+		[[nodiscard]] constexpr const node_index* end() const noexcept {
+			return m_first + m_size;
+		}
+		[[nodiscard]] constexpr node_index operator[](size_type index) const noexcept {
+			return m_first[index];
+		}
+		[[nodiscard]] constexpr size_type size() const noexcept {
+			return m_size;
+		}
+		[[nodiscard]] constexpr bool empty() const noexcept {
+			return m_size == 0;
+		}
+
+	private:
+		const node_index* m_first;
+		size_type m_size;
+	};
+
+	FlatModule() {
+		m_extra.pushBack(0); // Every empty list shares the first entry
+	}
+
+	node_index pushNode(NodeKind kind, token_index token = none, node_index lhs = none, node_index rhs = none);
+	/**
+	 * @brief Copies a list into the extra data and returns its offset
+	 */
+	node_index pushList(const node_index* first, size_type count);
+	/**
+	 * @brief Copies the fields of a record into the extra data and returns its offset
+	 */
+	node_index pushRecord(std::initializer_list<node_index> fields);
+
+	void setLhs(node_index node, node_index lhs) noexcept {
+		m_lhs[node] = lhs;
+	}
+	void setRhs(node_index node, node_index rhs) noexcept {
+		m_rhs[node] = rhs;
+	}
+	void setField(node_index record, size_type field, node_index value) noexcept {
+		m_extra[record + field] = value;
+	}
+
+	void bindDeclaration(node_index decl) {
+		m_declarations.pushBack(decl);
+	}
+	void bindTokens(TokenBuffer&& tokens) {
+		m_tokenBuffer = std::move(tokens);
+	}
+	void print() const;
+
+	[[nodiscard]] NodeKind kind(node_index node) const noexcept {
+		return m_kinds[node];
+	}
+	[[nodiscard]] token_index token(node_index node) const noexcept {
+		return m_tokens[node];
+	}
+	[[nodiscard]] node_index lhs(node_index node) const noexcept {
+		return m_lhs[node];
+	}
+	[[nodiscard]] node_index rhs(node_index node) const noexcept {
+		return m_rhs[node];
+	}
+	[[nodiscard]] node_index field(node_index record, size_type field) const noexcept {
+		return m_extra[record + field];
+	}
+	[[nodiscard]] NodeList list(node_index offset) const noexcept {
+		return NodeList(m_extra.data() + offset + 1, m_extra[offset]);
+	}
+
+	[[nodiscard]] const lsd::Vector<node_index>& declarations() const noexcept {
+		return m_declarations;
+	}
+	[[nodiscard]] const TokenBuffer& tokens() const noexcept {
+		return m_tokenBuffer;
+	}
+	[[nodiscard]] const LiteralArena& literals() const noexcept {
+		return m_tokenBuffer.literals();
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_kinds.size();
+	}
+	/**
+	 * @brief Bytes used by the nodes and their extra data, excluding the tokens
+	 */
+	[[nodiscard]] size_type nodeBytes() const noexcept {
+		return m_kinds.size() * (sizeof(NodeKind) + sizeof(token_index) + 2 * sizeof(node_index)) + m_extra.size() * sizeof(node_index);
+	}
+
+private:
+	lsd::Vector<NodeKind> m_kinds;
+	lsd::Vector<token_index> m_tokens;
+	lsd::Vector<node_index> m_lhs;
+	lsd::Vector<node_index> m_rhs;
+
+	lsd::Vector<node_index> m_extra;
+	lsd::Vector<node_index> m_declarations;
+
+	TokenBuffer m_tokenBuffer;
+
+	void printNode(node_index node, int level) const;
+	void printAttributes(node_index list, int level) const;
+	void printFunction(node_index record, int level) const;
+	void printTypeIdentifier(node_index node, int level) const;
+	void printIdentifierDecl(node_index node, int level) const;
+};
+
+} // namespace ast
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,145 @@
+/*************************
+ * @file IR.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief SSA form of compiled functions, which the optimizer works on
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Interpreter/Opcodes.hpp>
+#include <Elyrium/Interpreter/Bytecode.hpp>
+
+#include <LSD/Vector.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace ir {
+
+using operand_type = bytecode::operand_type;
+using value_id = uint32;
+using block_id = uint32;
+
+inline constexpr value_id noValue = ~value_id { 0 };
+inline constexpr block_id noBlock = ~block_id { 0 };
+
+/**
+ * @brief Properties of an opcode which decide if the optimizer may merge, move or remove an instruction
+ */
+struct Traits {
+public:
+	bool pure = false; // Only depends on its operands, so instructions with equal operands compute equal values
+	bool throws = false; // May raise an error, so it may not execute where it didn't before
+	bool reads = false; // Reads globals, upvalues or members of objects
+	bool writes = false; // Writes globals, upvalues or members of objects, or calls code which may do so
+	bool control = false; // Jumps or returns
+};
+
+[[nodiscard]] Traits traits(Opcode opcode) noexcept;
+
+/**
+ * @brief Value written by an instruction or phi, or held by a register on entry
+ *
+ * @note Values of registers on entry come first and are numbered like their registers.
+ */
+struct Value {
+public:
+	operand_type reg; // Register the value is stored in
+	block_id block = noBlock; // Block defining the value, none for values the register holds on entry
+	bool pinned = false; // The register is captured by a closure, so its content may change through upvalues
+	bool moved = false; // The value was given a register of its own, since it is used where its original register may hold another value
+};
+
+struct Instruction {
+public:
+	bytecode::Instruction code; // Register operands are replaced by the registers of the values when lowering
+	value_id results[2] = { noValue, noValue }; // Only loadMethod writes a second value
+	lsd::Vector<value_id> operands; // Values read in the order of the register operands, calls read the callee and then every argument
+};
+
+struct Phi {
+public:
+	value_id result;
+	lsd::Vector<value_id> operands; // One for every predecessor, in the same order
+};
+
+struct Block {
+public:
+	lsd::Vector<Phi> phis;
+	lsd::Vector<Instruction> instructions; // A jump or return is always the last instruction
+	lsd::Vector<block_id> predecessors;
+	lsd::Vector<block_id> successors; // The target of a jump first and the block execution falls through to last
+
+	block_id dominator = noBlock; // Immediate dominator, none for the entry
+	bool removed = false;
+};
+
+/**
+ * @brief Control flow graph of a function in SSA form, built from the instructions the compiler emitted
+ *
+ * @note Values stay in the registers the compiler allocated for them, so lowering doesn't need a register allocator.
+ * Only values the optimizer extends the lifetime of are moved into registers of their own, above the ones of the compiler,
+ * which is why phis and call operands only need moves for moved values.
+ */
+struct Function {
+public:
+	lsd::Vector<Block> blocks; // The first one is the entry
+	lsd::Vector<block_id> layout; // Order of the blocks in the lowered code
+	lsd::Vector<block_id> reversePostorder; // Reachable blocks, updated by computeDominators()
+	lsd::Vector<Value> values;
+
+	bytecode::Function* function; // Function the code belongs to, which receives new constants and registers
+	operand_type registerCount = 0; // Registers the compiler allocated
+
+	value_id addValue(operand_type reg, block_id block, bool pinned = false);
+	/**
+	 * @brief Moves a value into a new register, which is only ever written by the instruction defining it
+	 */
+	void moveValue(value_id value);
+	[[nodiscard]] operand_type addRegister();
+
+	/**
+	 * @brief Computes the reverse postorder and the immediate dominators, removing blocks which aren't reachable anymore
+	 */
+	void computeDominators();
+	[[nodiscard]] bool dominates(block_id dominator, block_id block) const noexcept;
+	/**
+	 * @brief Returns the blocks every reachable block immediately dominates
+	 */
+	[[nodiscard]] lsd::Vector<lsd::Vector<block_id>> dominatorTree() const;
+
+	/**
+	 * @brief Removes every edge between two blocks, together with the phi operands belonging to them
+	 */
+	void removeEdge(block_id from, block_id to);
+	/**
+	 * @brief Replaces the uses of values, replacements[value] being the value to use instead or noValue to keep it
+	 */
+	void replaceUses(const lsd::Vector<value_id>& replacements);
+};
+
+/**
+ * @brief Builds the SSA form of a function from instructions whose jump targets are instruction indices
+ *
+ * @param program Program holding the functions the closures of the function are created from, which have to be compiled already
+ */
+[[nodiscard]] Function build(const lsd::Vector<bytecode::Instruction>& code, bytecode::Function& function, const bytecode::Program& program);
+/**
+ * @brief Lowers a function back into instructions whose jump targets are instruction indices
+ *
+ * @note Moved values are given consecutive registers above the ones of the compiler again, dropping the ones of removed values.
+ */
+[[nodiscard]] lsd::Vector<bytecode::Instruction> lower(Function& function);
+
+} // namespace ir
+
+} // namespace compiler
+
+} // namespace elyrium
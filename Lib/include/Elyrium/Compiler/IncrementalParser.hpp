@@ -0,0 +1,118 @@
+/*************************
+ * @file IncrementalParser.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Parser which keeps a module up to date with edits of its source, reparsing only the declarations an edit touches
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Context.hpp>
+
+#include <Elyrium/Compiler/AST.hpp>
+#include <Elyrium/Compiler/AstArena.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+#include <LSD/UniquePointer.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Owns the source of a module split into segments of whole top level declarations, which are reparsed on their own when edited
+ *
+ * @note Segments always start at the beginning of a line, so the tokens of a segment are lexed the same way no matter what comes before it.
+ * A segment is only reused if the parse of the edited text ends exactly at its beginning, otherwise the reparsed region grows until it does.
+ */
+class IncrementalParser {
+public:
+	IncrementalParser(Context& context, lsd::StringView source, lsd::StringView path);
+	IncrementalParser(const IncrementalParser&) = delete;
+	IncrementalParser(IncrementalParser&&) = default;
+
+	IncrementalParser& operator=(const IncrementalParser&) = delete;
+	IncrementalParser& operator=(IncrementalParser&&) = delete;
+
+	/**
+	 * @brief Replaces a range of the source with other text and reparses the declarations around it
+	 *
+	 * @note If the edit leaves the source with a syntax error, the error is thrown and the declarations the edit touched are removed from the module until a later edit fixes them
+	 *
+	 * @param offset Byte offset of the edit in the current source
+	 * @param removed Amount of bytes removed at the offset
+	 * @param inserted Text inserted at the offset
+	 */
+	void edit(size_type offset, size_type removed, lsd::StringView inserted);
+
+	/**
+	 * @brief Assembles the current source of the module from its segments
+	 */
+	[[nodiscard]] lsd::String source() const;
+
+	[[nodiscard]] const ast::Module& module() const noexcept {
+		return m_module;
+	}
+	[[nodiscard]] ast::Module& module() noexcept {
+		return m_module;
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_size;
+	}
+	[[nodiscard]] size_type segmentCount() const noexcept {
+		return m_segments.size();
+	}
+	/**
+	 * @brief Amount of bytes lexed and parsed by the last edit
+	 */
+	[[nodiscard]] size_type reparsedBytes() const noexcept {
+		return m_reparsedBytes;
+	}
+
+private:
+	/**
+	 * @brief Text and nodes of one reparse, shared by all segments created by it
+	 */
+	struct Chunk {
+	public:
+		lsd::String text;
+		AstArena arena;
+
+		size_type segments = 0;
+	};
+
+	struct Segment {
+	public:
+		Chunk* chunk;
+		lsd::StringView text;
+
+		size_type lines; // Amount of line breaks in the text
+		size_type declarations;
+
+		bool failed; // If the text of the segment didn't parse, its declarations are missing from the module
+	};
+
+	Context& m_context;
+	lsd::String m_path;
+
+	ast::Module m_module;
+
+	lsd::Vector<lsd::UniquePointer<Chunk>> m_chunks;
+	lsd::Vector<Segment> m_segments;
+
+	size_type m_size = 0;
+	size_type m_reparsedBytes = 0;
+
+	void replaceSegments(size_type first, size_type count, lsd::Vector<Segment>&& segments);
+};
+
+} // namespace compiler
+
+} // namespace elyrium
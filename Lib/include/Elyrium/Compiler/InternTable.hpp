@@ -0,0 +1,75 @@
+/*************************
+ * @file InternTable.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Open addressing table which maps distinct strings to stable integer ids
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Arena.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Storage shared by the symbol table and the literal arena, ids are assigned in insertion order
+ */
+class InternTable {
+public:
+	using id_type = uint32;
+
+	static constexpr id_type none = ~id_type { 0 };
+
+	InternTable() = default;
+	InternTable(const InternTable&) = delete;
+	InternTable(InternTable&&) = default;
+
+	InternTable& operator=(const InternTable&) = delete;
+	InternTable& operator=(InternTable&&) = default;
+
+	/**
+	 * @brief Returns the id of a string, inserting it if it wasn't interned yet
+	 *
+	 * @param copy Copy the string into the table, otherwise it has to outlive the table
+	 */
+	id_type intern(lsd::StringView string, bool copy);
+	/**
+	 * @brief Returns the id of a string, or none if it wasn't interned
+	 */
+	[[nodiscard]] id_type find(lsd::StringView string) const noexcept;
+
+	[[nodiscard]] lsd::StringView string(id_type id) const noexcept {
+		return m_strings[id];
+	}
+	[[nodiscard]] size_type hash(id_type id) const noexcept {
+		return m_hashes[id];
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_strings.size();
+	}
+
+	[[nodiscard]] static size_type hashString(lsd::StringView string) noexcept;
+
+private:
+	Arena m_storage;
+
+	lsd::Vector<lsd::StringView> m_strings;
+	lsd::Vector<size_type> m_hashes;
+	lsd::Vector<id_type> m_slots; // The size is always zero or a power of two
+
+	[[nodiscard]] id_type find(lsd::StringView string, size_type hash, size_type& slot) const noexcept;
+	void grow();
+};
+
+} // namespace compiler
+
+} // namespace elyrium
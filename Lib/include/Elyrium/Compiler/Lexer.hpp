@@ -13,47 +13,116 @@
 
 #include <Elyrium/Core/Common.hpp>
 #include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/LineTable.hpp>
 
 #include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/TokenBuffer.hpp>
+#include <Elyrium/Compiler/SymbolTable.hpp>
+#include <Elyrium/Compiler/LiteralArena.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
 
 #include <LSD/Vector.h>
 #include <LSD/String.h>
 
+#include <limits>
+
 namespace elyrium {
 
 namespace compiler {
 
 class Lexer {
 public:
-	Lexer(lsd::StringView source, lsd::StringView path) : m_path(path), m_source(source), m_iter(m_source.begin()) { }
-
+	Lexer(lsd::StringView source, lsd::StringView path, SymbolTable& symbols) : 
+		m_path(path), m_source(checkedSource(source, path)), m_iter(m_source.begin()), m_lines(m_source), m_symbols(symbols) { }
+	/**
+	 * @param base Location of the first character of source, for lexers over a window into a larger input
+	 */
+	Lexer(lsd::StringView source, lsd::StringView path, SymbolTable& symbols, SourceLocation base) : 
+		m_path(path), m_source(checkedSource(source, path)), m_iter(m_source.begin()), m_lines(m_source), m_base(base), m_symbols(symbols) { }
+	/**
+	 * @brief Reports errors to diagnostics instead of throwing them, skipping over the malformed parts of tokens to lex the whole source
+	 */
+	Lexer(lsd::StringView source, lsd::StringView path, SymbolTable& symbols, Diagnostics& diagnostics) : 
+		m_path(path), m_source(checkedSource(source, path)), m_iter(m_source.begin()), m_lines(m_source), m_symbols(symbols), m_diagnostics(&diagnostics) { }
+
+	static constexpr size_type parallelChunkSize = 1 << 20; // Minimum amount of bytes lexed by a single thread
+	static constexpr size_type sourceLimit = std::numeric_limits<TokenBuffer::offset_type>::max(); // Tokens and lines are located by offsets of this size
+
+	/**
+	 * @brief Lexes the entire remaining source at once, with a terminating eof token
+	 */
+	TokenBuffer tokenize();
+	/**
+	 * @brief Lexes the entire source on multiple threads, producing exactly the same tokens, symbols and errors as tokenize()
+	 * 
+	 * @param threadCount Maximum amount of threads to use, zero uses the hardware concurrency
+	 * @param chunkSize Minimum amount of bytes lexed by a single thread
+	 */
+	TokenBuffer tokenizeParallel(size_type threadCount = 0, size_type chunkSize = parallelChunkSize);
 	Token nextToken();
 
 private:
+	struct Chunk;
+
 	lsd::StringView m_path;
 
 	lsd::StringView m_source;
 	lsd::StringView::iterator m_iter;
 
-	size_type m_line { };
-	size_type m_column { };
+	LineTable m_lines;
+	SourceLocation m_base;
+	size_type m_baseSpaces = 0; // Additional spaces of tabs on the first line which are in front of the source
+	bool m_partial = false; // If the source might continue past its end
+
+	SymbolTable& m_symbols;
+	LiteralArena m_literals;
 
-	void throwSyntaxError(error::Message message, char expected = '\0');
+	lsd::String m_scratch; // Reused buffer for decoding string literals with escape sequences
 
-	Token singleCharTok(Token::Type type);
-	Token doubleCharTok(Token::Type singleChar, Token::Type doubleChar);
-	Token singleCharEqualTok(Token::Type singleChar, Token::Type equal);
-	Token singleCharEqualOrDoubleCharTok(Token::Type singleChar, Token::Type doubleChar, Token::Type equal);
+	Diagnostics* m_diagnostics = nullptr;
+	bool m_tokenFailed = false; // Only the first error inside of a token is reported
 
+	/**
+	 * @brief Throws a syntax error for sources larger than sourceLimit, which offsets can't locate
+	 */
+	static lsd::StringView checkedSource(lsd::StringView source, lsd::StringView path);
+	/**
+	 * @brief Throws a syntax error at the current position, or reports it if the lexer has diagnostics in which case the caller has to recover
+	 */
+	void syntaxError(error::Message message, char expected = '\0');
+
+	void lexChunk(Chunk& chunk) const;
+
+	Token operatorTok();
 	Token numericLiteral(bool guaranteedFloat);
+	Token integralLiteral(const char* begin, uint64 value, bool overflow, bool decimal);
+	Token floatingLiteral(const char* begin);
+	/**
+	 * @brief Consumes digits of a base separated by single underscores and returns how many digits were read
+	 * 
+	 * @param value If not null, the digits are accumulated into it and overflow is set once the value exceeds 64 bits
+	 */
+	size_type digitSequence(uint32 base, uint64* value, bool* overflow);
 	Token keywordOrIdentifier();
+	symbol_id intern(lsd::StringView name);
 
-	void verifyEscapeSequence();
+	Token stringLiteral();
+	/**
+	 * @brief Decodes the escape sequence starting at the current backslash and moves behind it
+	 * 
+	 * @return Byte value of simple and hexadecimal byte escapes, code point of unicode escapes
+	 */
+	char32 escapeSequence();
+	static void appendUtf8(lsd::String& output, char32 codePoint);
+
+	friend class StreamLexer;
 
 	void skipEmpty();
+	/**
+	 * @brief Reports a null character in whitespace or comments and steps over it, only when collecting diagnostics
+	 */
+	bool skipDisallowed(const char*& it);
 	char next();
-
-	lsd::String currentLine(std::size_t& additionalSpaces);
 };
 
 } // namespace compiler
@@ -0,0 +1,64 @@
+/*************************
+ * @file LiteralArena.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Deduplicating storage for the decoded contents of string literals
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/InternTable.hpp>
+
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+using literal_id = InternTable::id_type;
+
+class LiteralArena {
+public:
+	static constexpr literal_id none = InternTable::none;
+
+	LiteralArena() = default;
+	LiteralArena(const LiteralArena&) = delete;
+	LiteralArena(LiteralArena&&) = default;
+
+	LiteralArena& operator=(const LiteralArena&) = delete;
+	LiteralArena& operator=(LiteralArena&&) = default;
+
+	/**
+	 * @brief Returns the literal of a decoded string, copying it into the arena if it wasn't stored yet
+	 */
+	literal_id insert(lsd::StringView string) {
+		return m_table.intern(string, true);
+	}
+	/**
+	 * @brief Returns the literal of a string which is referenced without being copied
+	 * 
+	 * @note The string has to outlive the arena, this is meant for literals without escape sequences which can point into the source
+	 */
+	literal_id view(lsd::StringView string) {
+		return m_table.intern(string, false);
+	}
+
+	[[nodiscard]] lsd::StringView string(literal_id literal) const noexcept {
+		return m_table.string(literal);
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_table.size();
+	}
+
+private:
+	InternTable m_table;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
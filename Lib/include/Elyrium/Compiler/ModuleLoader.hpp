@@ -0,0 +1,168 @@
+/*************************
+ * @file ModuleLoader.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Loads a module and every module it imports, parsing them in parallel
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/File.hpp>
+
+#include <Elyrium/Context.hpp>
+
+#include <Elyrium/Compiler/TokenBuffer.hpp>
+#include <Elyrium/Compiler/AST.hpp>
+#include <Elyrium/Compiler/AstCache.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+#include <LSD/UniquePointer.h>
+#include <LSD/UnorderedFlatMap.h>
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Resolves the import declarations of modules to files and parses the whole import graph on a pool of workers
+ *
+ * @note An import like import "io"; is looked up as io.ely next to the importing module first and in the search paths after that.
+ * Imports are scheduled as soon as the importing module is lexed, so modules are parsed while their importers are still being parsed.
+ */
+class ModuleLoader {
+public:
+	static constexpr lsd::StringView extension = ".ely";
+	static constexpr TokenBuffer::index_type noToken = ~TokenBuffer::index_type { 0 };
+
+	struct Import {
+	public:
+		size_type unit;
+		TokenBuffer::index_type token; // String token of the import, noToken if the importing module was loaded from the cache
+	};
+
+	class Unit {
+	public:
+		[[nodiscard]] lsd::StringView path() const noexcept {
+			return m_path;
+		}
+		[[nodiscard]] const ast::Module& module() const noexcept {
+			return m_module;
+		}
+		[[nodiscard]] ast::Module& module() noexcept {
+			return m_module;
+		}
+		/**
+		 * @brief Modules imported by this one in order of appearance, which only contain the modules which were found at load time
+		 */
+		[[nodiscard]] const lsd::Vector<Import>& imports() const noexcept {
+			return m_imports;
+		}
+
+	private:
+		lsd::String m_path;
+		filesys::SourceBuffer m_source; // Declared before the module, since its tokens point into the source
+
+		ast::Module m_module;
+		lsd::Vector<Import> m_imports;
+
+		friend class ModuleLoader;
+	};
+
+	/**
+	 * @param threadCount Number of workers, uses the hardware concurrency if zero
+	 * @param lazyBodies Passed to the parser of every module
+	 */
+	ModuleLoader(Context& context, size_type threadCount = 0, bool lazyBodies = false) :
+		m_context(context), m_threadCount(threadCount), m_lazyBodies(lazyBodies) { }
+	ModuleLoader(const ModuleLoader&) = delete;
+	ModuleLoader(ModuleLoader&&) = delete;
+
+	ModuleLoader& operator=(const ModuleLoader&) = delete;
+	ModuleLoader& operator=(ModuleLoader&&) = delete;
+
+	void addSearchPath(lsd::StringView path);
+	/**
+	 * @brief Loads modules from a cache instead of parsing them if it is up to date, and writes the trees of modules which had to be parsed to it
+	 *
+	 * @note Modules are never written to the cache if function bodies are parsed lazily
+	 */
+	void bindCache(const AstCache& cache) noexcept {
+		m_cache = &cache;
+	}
+
+	/**
+	 * @brief Loads a module with all modules it imports, of which each is only loaded once
+	 *
+	 * @note Throws the first error any of the modules raised, missing modules and circular imports are reported at the import declaration.
+	 * The units of the modules scheduled by a load which failed are removed, so loading them again parses them again.
+	 *
+	 * @return Index of the unit of the module
+	 */
+	size_type load(lsd::StringView path);
+
+	[[nodiscard]] const Unit& unit(size_type index) const noexcept {
+		return *m_units[index];
+	}
+	[[nodiscard]] Unit& unit(size_type index) noexcept {
+		return *m_units[index];
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_units.size();
+	}
+
+private:
+	Context& m_context;
+
+	size_type m_threadCount;
+	bool m_lazyBodies;
+
+	const AstCache* m_cache = nullptr;
+
+	lsd::Vector<lsd::String> m_searchPaths;
+
+	filesys::FileSystem m_fileSystem;
+
+	lsd::Vector<lsd::UniquePointer<Unit>> m_units;
+	lsd::UnorderedFlatMap<lsd::String, size_type> m_paths; // Canonical path to index of the unit
+
+	// Scheduling state, only accessed while holding the mutex
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+
+	lsd::Vector<size_type> m_queue;
+	size_type m_running = 0;
+
+	std::exception_ptr m_error; // First error raised by any of the workers
+
+	void work();
+	void loadUnit(size_type index);
+	/**
+	 * @brief Loads a module from the cache and schedules its imports
+	 *
+	 * @return False if the module has to be parsed, which is also the case if its imports can't be resolved so the parser reports them
+	 */
+	bool loadCachedUnit(size_type index, Unit& unit);
+
+	/**
+	 * @brief Returns the index of the unit of a canonical path, scheduling it if it wasn't known yet
+	 */
+	size_type schedule(lsd::String&& path);
+	[[nodiscard]] bool reaches(size_type from, size_type to) const;
+
+	[[nodiscard]] lsd::String resolve(lsd::StringView importer, lsd::StringView name) const;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,67 @@
+/*************************
+ * @file Optimizer.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Optimization passes over the SSA form of compiled functions
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/IR.hpp>
+
+#include <Elyrium/Interpreter/Bytecode.hpp>
+
+#include <LSD/Vector.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+enum class OptimizationLevel : uint8 {
+	none,	// Instructions are assembled as they were emitted
+	basic,	// Constant propagation and dead code elimination
+	full	// Additionally common subexpression elimination and loop invariant code motion
+};
+
+namespace ir {
+
+/**
+ * @brief Sparse conditional constant propagation, which folds constant computations and branches and removes blocks which never execute
+ *
+ * @note Only integers, booleans and null are propagated. Integer operations which would overflow aren't folded.
+ */
+void propagateConstants(Function& function);
+/**
+ * @brief Replaces computations by equal ones dominating them, and loads by earlier loads or stores of the same block
+ */
+void eliminateCommonSubexpressions(Function& function);
+/**
+ * @brief Moves computations which are the same in every iteration of a loop in front of it
+ *
+ * @note Only loops entered from a single block which only continues into the loop are optimized,
+ * and instructions which may throw are only moved if the loop would have executed them first anyways.
+ */
+void hoistLoopInvariants(Function& function);
+/**
+ * @brief Removes instructions and phis whose values are never used and which have no effects
+ */
+void eliminateDeadCode(Function& function);
+
+} // namespace ir
+
+/**
+ * @brief Optimizes the instructions of a function, whose jump targets are instruction indices
+ *
+ * @param function Function the instructions belong to, which may receive new constants and registers
+ * @param program Program holding the functions the closures of the function are created from
+ */
+[[nodiscard]] lsd::Vector<bytecode::Instruction> optimize(const lsd::Vector<bytecode::Instruction>& code, bytecode::Function& function, const bytecode::Program& program, OptimizationLevel level);
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -11,11 +11,18 @@
 #pragma once
 
 #include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/File.hpp>
+
+#include <Elyrium/Context.hpp>
 
 #include <Elyrium/Compiler/Lexer.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
 
 #include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/TokenBuffer.hpp>
 #include <Elyrium/Compiler/AST.hpp>
+#include <Elyrium/Compiler/AstArena.hpp>
+#include <Elyrium/Compiler/FlatAST.hpp>
 
 #include <LSD/String.h>
 
@@ -24,8 +31,8 @@ namespace elyrium {
 namespace compiler {
 
 class Parser {
-private:
-	enum class Precedence {
+public:
+	enum class Precedence : uint8 {
 		assign,
 		assignLeft = assign,
 		assignRight,
@@ -45,32 +52,138 @@ private:
 		atomic,
 	};
 
-public:
-	Parser(lsd::StringView source, lsd::StringView path);
+	/**
+	 * @brief Lexes the source on the amount of threads set in the context, which is sequential by default
+	 *
+	 * @param lazyBodies Only pre-parse the bodies of functions and closures, which are parsed once they are needed with parseLazyBody()
+	 */
+	Parser(Context& context, lsd::StringView source, lsd::StringView path, bool lazyBodies = false);
+	/**
+	 * @brief Parses tokens which were already lexed, with their symbols belonging to the symbol table of the context they are used in
+	 */
+	Parser(TokenBuffer&& tokens, lsd::StringView path, bool lazyBodies = false);
+	/**
+	 * @brief Reports errors of both lexing and parsing to the diagnostics instead of throwing, recovering at the next statement after every error
+	 *
+	 * @note The tree parsed from a source with errors is incomplete and may only be inspected if the diagnostics are empty
+	 */
+	Parser(Context& context, lsd::StringView source, lsd::StringView path, Diagnostics& diagnostics, bool lazyBodies = false);
+	/**
+	 * @brief Lexes input while it is still being read, like the standard input of the command line
+	 *
+	 * @param source Receives all of the input, which has to outlive the parsed module
+	 */
+	Parser(Context& context, filesys::InputStream& input, lsd::String& source, lsd::StringView path, bool lazyBodies = false);
 
 	ast::Module parse();
+	/**
+	 * @brief Parses the body of a function which was only pre-parsed
+	 * 
+	 * @note The source and path of the module still have to be alive, and the module may not be accessed by another thread meanwhile
+	 */
+	static void parseLazyBody(ast::Module& module, ast::FunctionDecl& function);
+	static void parseLazyBody(ast::Module& module, ast::ClosureExpr& closure);
+	/**
+	 * @brief Parses the source into a flat tree, which takes over the tokens of the parser
+	 */
+	ast::FlatModule parseFlat();
 
 private:
+	/**
+	 * @brief Suspended call of the expression grammar, resumed once the expression it is waiting for was parsed
+	 */
+	struct ExpressionFrame {
+	public:
+		enum class Resume : uint8 {
+			first, // First operand of an expression
+			right, // Operand right of an infix operator
+			nested, // Expression of higher precedence right of an infix operator
+			base, // Parenthesized base of a member expression
+			argument, // Argument of a call
+			subscript // Subscript expression
+		};
+
+		ast::expr_ptr expression;
+		ast::expr_ptr rightExpr;
+		ast::member_expr_ptr member;
+		ast::detail::arg_t arguments;
+
+		// Prefix operators in front of a member expression, which are only bound once the member expression was parsed
+		TokenBuffer::index_type prefixes { };
+		TokenBuffer::index_type prefixCount { };
+
+		Precedence precedence { };
+		Resume resume { };
+		bool grouped = false;
+	};
+
+	enum class ExpressionStep : uint8 {
+		expression,
+		operand,
+		resume
+	};
+
 	lsd::StringView m_path;
 	lsd::StringView m_source;
 
-	Lexer m_lexer;
-	Token m_current;
-	Token m_last;
+	TokenBuffer m_tokens;
+	TokenBuffer::index_type m_current { };
+	TokenBuffer::index_type m_last { };
+
+	bool m_lazyBodies;
+	lsd::Vector<Token::Type> m_brackets; // Closing brackets expected by the pre-parser
+
+	AstArena m_arena;
+
+	Diagnostics* m_diagnostics = nullptr;
+	bool m_panic = false; // Set after reporting an error until the parser synchronized, errors are not reported meanwhile
+
+	ast::FlatModule m_flat;
+	lsd::Vector<ast::node_index> m_scratch; // Stack of the elements of the flat lists currently being parsed
+
+	lsd::Vector<ExpressionFrame> m_frames; // Stack of the expression parser
+
+	template <class Node> static void parseLazyBody(ast::Module& module, Node& node);
+
+	Token::Type next();
+	[[nodiscard]] Token::Type currentType() const noexcept {
+		return m_tokens.type(m_current);
+	}
+	[[nodiscard]] Token currentToken() const noexcept {
+		return m_tokens.token(m_current);
+	}
 
-	Token& next();
 	void consume(bool type, error::Message message, char expected = '\0');
-	void verify(bool type, error::Message message, char expected = '\0') const;
+	/**
+	 * @brief Throws a syntax error if the condition is false, or reports it if the parser has diagnostics
+	 *
+	 * @return The condition, callers only have to recover if they can't continue with a wrong token
+	 */
+	bool verify(bool type, error::Message message, char expected = '\0');
+	/**
+	 * @brief Skips behind the next semicolon or block at the current nesting depth, or onto the closing brace of the enclosing block, after an error was reported
+	 *
+	 * @param start Token the failed construct started at, which is skipped if nothing was consumed since
+	 *
+	 * @return False if the end of the source was reached, in which case the parser stays panicking to suppress follow up errors
+	 */
+	bool synchronize(TokenBuffer::index_type start);
 
 	// Expression parser
 
-	ast::expr_ptr parseExpression(Precedence precedence = Precedence::atomic, ast::expr_ptr&& expr = nullptr);
-	ast::expr_ptr parseUnaryExpression();
-	ast::expr_ptr parseAtomicMemberExpression();
+	/**
+	 * @brief Parses an expression with the same grammar as parseFlatExpression(), turning its recursive calls into frames on an explicit stack
+	 */
+	ast::expr_ptr parseExpression();
 	ast::infix_expr_ptr parseInfixExpression(ast::expr_ptr&& rightExpr);
 
 	ast::expr_ptr parseClosure();
 
+	ExpressionStep continueInfixExpression(ast::expr_ptr& value, Precedence& precedence);
+	ExpressionStep continueMemberExpression(ast::expr_ptr& value);
+	ExpressionStep finishCall(ast::expr_ptr& value);
+	ast::expr_ptr finishOperand(ast::expr_ptr&& operand, TokenBuffer::index_type prefixes, TokenBuffer::index_type prefixCount);
+
 	// Statement parsers
 	
 	ast::stmt_ptr parseStatement();
@@ -101,8 +214,48 @@ private:
 	ast::detail::FunctionConstruct parseFunctionConstruct();
 
 	ast::BlockStmt parseBlockStatement();
+	ast::detail::LazyBody preParseBlockStatement();
 	
 	bool basicParseObjectDeclaration(ast::obj_decl_ptr& value);
+
+	// Flat tree parsers, which follow the same grammar as the parsers above
+
+	ast::node_index flushScratch(size_type top);
+	void bindFlatRight(ast::node_index expr, ast::node_index right);
+
+	ast::node_index parseFlatExpression(Precedence precedence = Precedence::atomic, ast::node_index expr = ast::FlatModule::none);
+	ast::node_index parseFlatUnaryExpression();
+	ast::node_index parseFlatAtomicMemberExpression();
+	ast::node_index parseFlatInfixExpression(ast::node_index rightExpr);
+	ast::node_index parseFlatClosure();
+
+	ast::node_index parseFlatStatement();
+	ast::node_index parseFlatStatementAndObjDeclaration();
+	ast::node_index parseFlatExprStatement();
+	ast::node_index parseFlatIfStatement();
+	ast::node_index parseFlatForStatement();
+	ast::node_index parseFlatTryCatchStatement();
+
+	ast::node_index parseFlatDeclaration();
+	ast::node_index parseFlatNamespaceDeclaration();
+	ast::node_index parseFlatImportDeclaration();
+	ast::node_index parseFlatObjectDeclaration();
+	ast::node_index parseFlatVariableDeclaration(ast::node_index attributes);
+	ast::node_index parseFlatFunctionDeclaration(ast::node_index attributes);
+	ast::node_index parseFlatClassDeclaration(ast::node_index attributes);
+	ast::node_index parseFlatEnumDeclaration(ast::node_index attributes);
+
+	ast::node_index parseFlatTypeIdentifier();
+	ast::node_index parseFlatIdentifierDeclaration();
+	ast::node_index parseFlatAttributes();
+	void parseFlatIfConstruct(ast::node_index& init, ast::node_index& condition);
+	ast::node_index parseFlatForConstruct();
+	ast::node_index parseFlatFunctionConstruct();
+	ast::node_index parseFlatBlockStatement();
+
+	bool basicParseFlatObjectDeclaration(ast::node_index& value);
+
+	friend class IncrementalParser;
 };
 
 } // namespace compiler
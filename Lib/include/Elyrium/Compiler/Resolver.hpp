@@ -0,0 +1,195 @@
+/*************************
+ * @file Resolver.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Resolution of identifiers to the storage they refer to
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/AST.hpp>
+
+#include <Elyrium/Interpreter/Bytecode.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/StringView.h>
+#include <LSD/UnorderedFlatMap.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Storage an identifier refers to
+ */
+struct Binding {
+public:
+	enum class Kind : uint8 {
+		local,			// Local of the function, numbered in declaration order with the parameters first
+		upvalue,		// Upvalue of the closure
+		global,			// Global slot of a module level declaration or of a name the module doesn't declare
+		staticMember	// Global slot of a declaration inside of a namespace
+	};
+
+	Kind kind = Kind::global;
+	bool captured = false; // Only set for declarations of locals which closures capture
+	uint32 index = 0;
+	uint32 consumed = 0; // Elements of the chain of a member expression which were resolved through namespaces
+};
+
+/**
+ * @brief Bindings of every identifier of a module, keyed by the address of the token or node they belong to
+ */
+class Resolution {
+public:
+	struct Function {
+	public:
+		lsd::Vector<bytecode::Capture> captures; // Locals are referred to by their number until the compiler assigns them registers
+		uint32 localCount = 0;
+	};
+
+	/**
+	 * @brief Returns the binding of a declaring or using identifier, or the static member a member expression starts with
+	 */
+	[[nodiscard]] const Binding* find(const void* node) const noexcept {
+		auto found = m_bindings.find(node);
+		return (found == m_bindings.end()) ? nullptr : &found->second;
+	}
+	[[nodiscard]] const Binding& binding(const Token& identifier) const noexcept {
+		auto binding = find(&identifier);
+		assert(binding && "elyrium::compiler::Resolution::binding(): Identifier was not resolved, aborting!");
+
+		return *binding;
+	}
+	/**
+	 * @param node Declaration of the function or closure
+	 */
+	[[nodiscard]] const Function& function(const void* node) const noexcept {
+		auto found = m_functions.find(node);
+		assert(found != m_functions.end() && "elyrium::compiler::Resolution::function(): Function was not resolved, aborting!");
+
+		return found->second;
+	}
+	[[nodiscard]] const lsd::Vector<bytecode::Global>& globals() const noexcept {
+		return m_globals;
+	}
+
+private:
+	lsd::UnorderedFlatMap<const void*, Binding> m_bindings;
+	lsd::UnorderedFlatMap<const void*, Function> m_functions;
+	lsd::Vector<bytecode::Global> m_globals;
+
+	friend class Resolver;
+};
+
+/**
+ * @brief Resolves every identifier of a module to a local, upvalue or global slot, so no names are looked up at runtime
+ *
+ * @note Module and namespace members are visible in their whole scope, locals only after their declaration.
+ * Namespaces aren't values, so their members are resolved to slots of their own.
+ * Lazily parsed function bodies are parsed while resolving.
+ */
+class Resolver {
+public:
+	Resolver(ast::Module& module, const LineTable& lines, lsd::StringView source, lsd::StringView path) :
+		m_module(&module), m_lines(&lines), m_source(source), m_path(path) { }
+
+	/**
+	 * @brief Resolves the module, throwing a CompileError for redeclared names and invalid uses of namespaces
+	 */
+	[[nodiscard]] Resolution resolve();
+
+private:
+	static constexpr uint32 none = ~uint32 { 0 };
+
+	struct Name {
+	public:
+		symbol_id symbol;
+		Binding binding;
+		const Token* declaration = nullptr;
+		uint32 nameSpace = none; // Index of the namespace the name refers to, if it refers to one
+	};
+
+	struct Namespace {
+	public:
+		lsd::Vector<Name> members;
+		lsd::Vector<symbol_id> path;
+	};
+
+	struct Scope {
+	public:
+		lsd::Vector<Name> names;
+		size_type function; // Function the scope belongs to, which is the first one for the module and namespaces
+		uint32 nameSpace = none; // Namespace whose members are visible in the scope
+	};
+
+	/**
+	 * @brief Expression which is left to resolve
+	 */
+	struct PendingExpression {
+	public:
+		ast::Expression* expression;
+		bool body = false; // The captures of the closure were resolved, so its body is resolved next
+	};
+
+	ast::Module* m_module;
+	const LineTable* m_lines;
+
+	lsd::StringView m_source;
+	lsd::StringView m_path;
+
+	Resolution m_resolution;
+
+	lsd::Vector<Namespace> m_namespaces;
+	lsd::Vector<Scope> m_scopes;
+	lsd::Vector<Resolution::Function> m_functions; // Functions currently being resolved, the first one initializes the module
+	lsd::UnorderedFlatMap<symbol_id, uint32> m_externals; // Slots of names the module doesn't declare
+	lsd::Vector<PendingExpression> m_expressions; // Stack of the expressions left to resolve, so nesting doesn't recurse
+
+	[[noreturn]] void error(const Token& token, error::Message message) const;
+
+	// Names
+
+	/**
+	 * @brief Declares the module or namespace level declarations, before any of them are resolved
+	 */
+	[[nodiscard]] lsd::Vector<Name> declareMembers(const lsd::Vector<ast::decl_ptr>& declarations, const lsd::Vector<symbol_id>& path);
+	uint32 declareSlot(const Token& identifier, lsd::Vector<Name>& members, const lsd::Vector<symbol_id>& path);
+	void declareLocal(const Token& identifier);
+
+	[[nodiscard]] const Name* find(const Token& identifier, size_type& function) const noexcept;
+	/**
+	 * @brief Looks up a name and records its binding for the identifier
+	 */
+	Name lookup(const Token& identifier);
+	/**
+	 * @brief Returns the upvalue a function accesses a local of an enclosing function through, capturing it in every function in between
+	 */
+	uint32 capture(size_type function, size_type owner, uint32 local);
+
+	// Traversal
+
+	void declaration(ast::Declaration* declaration);
+	template <class Node> void function(Node& node);
+	void statement(ast::Statement* statement);
+	/**
+	 * @brief Resolves an expression in the order a recursive traversal would, with an explicit stack instead of native recursion
+	 */
+	void expression(ast::Expression* expression);
+	/**
+	 * @brief Resolves the names a member expression starts with and pushes its operands onto the stack of pending expressions
+	 */
+	void member(ast::MemberExpr& expression);
+};
+
+} // namespace compiler
+
+} // namespace elyrium
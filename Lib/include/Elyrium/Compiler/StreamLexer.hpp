@@ -0,0 +1,97 @@
+/*************************
+ * @file StreamLexer.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Lexer over input which is read piece by piece instead of being held in memory as a whole
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/File.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/Lexer.hpp>
+#include <Elyrium/Compiler/TokenBuffer.hpp>
+#include <Elyrium/Compiler/SymbolTable.hpp>
+#include <Elyrium/Compiler/LiteralArena.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+#include <LSD/UniquePointer.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Lexes input through a window which slides over it, so that memory use only depends on the chunk size and the longest token
+ * 
+ * @note The data of a returned token stays valid until the next call to nextToken()
+ */
+class StreamLexer {
+public:
+	static constexpr size_type defaultChunkSize = 1 << 16;
+
+	StreamLexer(filesys::InputStream& input, lsd::StringView path, SymbolTable& symbols, size_type chunkSize = defaultChunkSize);
+
+	Token nextToken();
+	/**
+	 * @brief Lexes the entire input into a buffer for the parser, with a terminating eof token
+	 * 
+	 * @param source Receives all of the input, which the tokens point into and which has to outlive them
+	 * 
+	 * @note Input is lexed while it is being read, but can't be discarded since the parser needs all of it.
+	 * Input larger than Lexer::sourceLimit is rejected with a syntax error.
+	 */
+	TokenBuffer tokenize(lsd::String& source);
+
+	/**
+	 * @brief Location of the last token returned by nextToken()
+	 */
+	[[nodiscard]] SourceLocation location() const;
+	/**
+	 * @brief Decoded string literals, which are always copied since the window doesn't outlive them
+	 */
+	[[nodiscard]] const LiteralArena& literals() const noexcept {
+		return m_literals;
+	}
+	[[nodiscard]] LiteralArena releaseLiterals() noexcept {
+		return std::move(m_literals);
+	}
+
+private:
+	filesys::InputStream& m_input;
+	lsd::StringView m_path;
+
+	SymbolTable& m_symbols;
+	LiteralArena m_literals;
+
+	size_type m_chunkSize;
+	bool m_exhausted = false;
+
+	lsd::Vector<char> m_window;
+	size_type m_position = 0; // Offset in the window the next token is lexed from
+	size_type m_tokenOffset = 0; // Offset in the window of the last returned token's data
+	size_type m_windowOffset = 0; // Offset of the window in the input
+	SourceLocation m_base; // Location of the first character of the window
+	size_type m_baseTabs = 0; // Tabs on the line of the first character of the window which were already discarded
+
+	lsd::UniquePointer<Lexer> m_lexer;
+
+	lsd::String* m_transcript = nullptr; // Receives all input read while tokenize() runs
+
+	/**
+	 * @brief Discards the window up to the line of the current position and reads at least one more chunk behind it
+	 */
+	void refill();
+};
+
+} // namespace compiler
+
+} // namespace elyrium
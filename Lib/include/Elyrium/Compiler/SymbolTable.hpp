@@ -0,0 +1,65 @@
+/*************************
+ * @file SymbolTable.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Interning table which maps identifier names to stable integer symbols
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/InternTable.hpp>
+
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+using symbol_id = InternTable::id_type;
+
+class SymbolTable {
+public:
+	static constexpr symbol_id none = InternTable::none;
+
+	SymbolTable() = default;
+	SymbolTable(const SymbolTable&) = delete;
+	SymbolTable(SymbolTable&&) = default;
+
+	SymbolTable& operator=(const SymbolTable&) = delete;
+	SymbolTable& operator=(SymbolTable&&) = default;
+
+	/**
+	 * @brief Returns the symbol of a string, inserting a copy of it if it wasn't interned yet
+	 */
+	symbol_id intern(lsd::StringView string) {
+		return m_table.intern(string, true);
+	}
+	/**
+	 * @brief Returns the symbol of a string, or none if it wasn't interned
+	 */
+	[[nodiscard]] symbol_id find(lsd::StringView string) const noexcept {
+		return m_table.find(string);
+	}
+
+	[[nodiscard]] lsd::StringView string(symbol_id symbol) const noexcept {
+		return m_table.string(symbol);
+	}
+	[[nodiscard]] size_type hash(symbol_id symbol) const noexcept {
+		return m_table.hash(symbol);
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_table.size();
+	}
+
+private:
+	InternTable m_table;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
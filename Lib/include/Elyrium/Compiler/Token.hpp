@@ -11,6 +11,11 @@
 #pragma once
 
 #include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Compiler/SymbolTable.hpp>
+#include <Elyrium/Compiler/LiteralArena.hpp>
 
 #include <LSD/String.h>
 #include <LSD/StringView.h>
@@ -21,7 +26,7 @@ namespace compiler {
 
 class Token {
 public:
-	using type_tag = size_type;
+	using type_tag = uint8;
 
 	enum class Type : type_tag {
 		none,
@@ -151,12 +156,24 @@ public:
 		attribute,
 	};
 
+	/**
+	 * @brief Payload decoded by the lexer, the active member depends on the token type
+	 */
+	union Value {
+		symbol_id symbol = SymbolTable::none; 	// identifier and attribute
+		int64 integral;							// integral
+		uint64 unsignedIntegral;				// unsignedIntegral
+		float64 floating;						// floating
+		char32 character;						// character
+		literal_id literal;						// string
+	};
+
 	Token() = default;
 	Token(Type type) : m_type(type) { }
-	Token(Type type, lsd::StringView data, size_type line, size_type column) : m_type(type), m_data(data), m_line(line), m_column(column) { }
+	Token(Type type, lsd::StringView data) : m_type(type), m_data(data) { }
+	Token(Type type, lsd::StringView data, Value value) : m_type(type), m_data(data), m_value(value) { }
 
 	lsd::String stringify() const;
-	lsd::String lineSource(std::size_t& additionalSpaces) const noexcept;
 
 	[[nodiscard]] Type type() const noexcept {
 		return m_type;
@@ -164,21 +181,47 @@ public:
 	[[nodiscard]] lsd::StringView data() const noexcept {
 		return m_data;
 	}
-	[[nodiscard]] size_type line() const noexcept {
-		return m_line;
+	[[nodiscard]] Value value() const noexcept {
+		return m_value;
+	}
+	/**
+	 * @brief Interned name of identifier and attribute tokens
+	 */
+	[[nodiscard]] symbol_id symbol() const noexcept {
+		return m_value.symbol;
+	}
+	[[nodiscard]] int64 integral() const noexcept {
+		return m_value.integral;
 	}
-	[[nodiscard]] size_type column() const noexcept {
-		return m_column;
+	[[nodiscard]] uint64 unsignedIntegral() const noexcept {
+		return m_value.unsignedIntegral;
+	}
+	[[nodiscard]] float64 floating() const noexcept {
+		return m_value.floating;
+	}
+	[[nodiscard]] char32 character() const noexcept {
+		return m_value.character;
+	}
+	/**
+	 * @brief Decoded contents of string tokens inside of the literal arena of their module
+	 */
+	[[nodiscard]] literal_id literal() const noexcept {
+		return m_value.literal;
 	}
 
 private:
 	Type m_type { };
 	lsd::StringView m_data;
-
-	size_type m_line { };
-	size_type m_column { };
+	Value m_value;
 };
 
+/**
+ * @brief Builds the error a pass over the syntax tree of a source raises at one of its tokens
+ *
+ * @note Tokens made up by the parser have no data, so they are reported at the start of the source
+ */
+[[nodiscard]] CompileError compileError(const Token& token, lsd::StringView source, const LineTable& lines, lsd::StringView path, error::Message message);
+
 } // namespace compiler
 
 } // namespace elyrium
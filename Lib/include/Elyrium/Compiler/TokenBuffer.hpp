@@ -0,0 +1,140 @@
+/*************************
+ * @file TokenBuffer.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Compact struct-of-arrays storage for a fully tokenized source
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Compiler/Token.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+class TokenBuffer {
+public:
+	using index_type = uint32;
+	using offset_type = uint32;
+
+	TokenBuffer() = default;
+	TokenBuffer(lsd::StringView source) : m_source(source), m_lines(m_source) { }
+	/**
+	 * @param base Location of the first character of source, for buffers over a window into a larger input
+	 */
+	TokenBuffer(lsd::StringView source, SourceLocation base) : m_source(source), m_lines(m_source), m_base(base) { }
+
+	void reserve(size_type count);
+	void pushBack(const Token& token);
+	void pushBack(Token::Type type, offset_type offset, offset_type length, uint32 payload = SymbolTable::none);
+	/**
+	 * @brief Appends the tokens of another buffer over the same source starting at an index
+	 * 
+	 * @param symbols Maps the symbols of the other buffer's tokens to the symbols of this buffer
+	 * @param literals Maps the literals of the other buffer's tokens to the literals of this buffer
+	 */
+	void append(const TokenBuffer& other, index_type first, const lsd::Vector<symbol_id>& symbols, const lsd::Vector<literal_id>& literals);
+	/**
+	 * @brief Replaces the symbols of all identifiers and attributes, used to move tokens lexed against a local symbol table to another one
+	 * 
+	 * @param symbols Maps the current symbols of the tokens to their new symbols
+	 */
+	void remapSymbols(const lsd::Vector<symbol_id>& symbols) noexcept;
+	/**
+	 * @brief Replaces the literals of all strings, used to move tokens to a literal arena shared with other buffers
+	 * 
+	 * @param literals Maps the current literals of the tokens to their new literals
+	 */
+	void remapLiterals(const lsd::Vector<literal_id>& literals) noexcept;
+
+	void bindLiterals(LiteralArena&& literals) {
+		m_literals = std::move(literals);
+	}
+	[[nodiscard]] LiteralArena releaseLiterals() noexcept {
+		return std::move(m_literals);
+	}
+
+	/**
+	 * @brief Materializes the token at an index
+	 */
+	[[nodiscard]] Token token(index_type index) const noexcept {
+		return Token(type(index), data(index), value(index));
+	}
+	/**
+	 * @brief Returns the decoded payload of the token at an index
+	 */
+	[[nodiscard]] Token::Value value(index_type index) const noexcept;
+	
+	[[nodiscard]] SourceLocation location(index_type index) const {
+		auto location = m_lines.location(m_offsets[index]);
+
+		if (location.line == 0) location.column += m_base.column;
+		location.line += m_base.line;
+
+		return location;
+	}
+	[[nodiscard]] lsd::String lineSource(index_type index, size_type& additionalSpaces) const {
+		return m_lines.lineSource(m_offsets[index], additionalSpaces);
+	}
+
+	[[nodiscard]] Token::Type type(index_type index) const noexcept {
+		return static_cast<Token::Type>(m_types[index]);
+	}
+	[[nodiscard]] offset_type offset(index_type index) const noexcept {
+		return m_offsets[index];
+	}
+	[[nodiscard]] offset_type length(index_type index) const noexcept {
+		return m_lengths[index];
+	}
+	[[nodiscard]] symbol_id symbol(index_type index) const noexcept {
+		return m_payloads[index];
+	}
+	[[nodiscard]] lsd::StringView data(index_type index) const noexcept {
+		return lsd::StringView(m_source.data() + m_offsets[index], m_lengths[index]);
+	}
+	
+	[[nodiscard]] lsd::StringView source() const noexcept {
+		return m_source;
+	}
+	[[nodiscard]] const LineTable& lines() const noexcept {
+		return m_lines;
+	}
+	[[nodiscard]] const LiteralArena& literals() const noexcept {
+		return m_literals;
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_types.size();
+	}
+	[[nodiscard]] bool empty() const noexcept {
+		return m_types.empty();
+	}
+
+private:
+	lsd::StringView m_source;
+	LineTable m_lines;
+	SourceLocation m_base;
+
+	lsd::Vector<Token::type_tag> m_types;
+	lsd::Vector<offset_type> m_offsets;
+	lsd::Vector<offset_type> m_lengths;
+	lsd::Vector<uint32> m_payloads; // Symbol of identifiers and attributes, literal of strings, code point of characters or index into m_constants for numeric literals
+
+	lsd::Vector<uint64> m_constants; // Bit patterns of decoded numeric literals
+
+	LiteralArena m_literals;
+};
+
+} // namespace compiler
+
+} // namespace elyrium
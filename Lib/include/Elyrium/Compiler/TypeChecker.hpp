@@ -0,0 +1,233 @@
+/*************************
+ * @file TypeChecker.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Inference and checking of the static types of values
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Compiler/Token.hpp>
+#include <Elyrium/Compiler/AST.hpp>
+#include <Elyrium/Compiler/Resolver.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/StringView.h>
+#include <LSD/UnorderedFlatMap.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+/**
+ * @brief Static types the compiler specializes instructions for, every other value is typed dynamically
+ */
+enum class Type : uint8 {
+	unknown,
+	integral,			// int
+	unsignedIntegral,	// uint
+	floating,			// float
+	boolean				// bool
+};
+
+/**
+ * @brief Static types of the expressions of a module and the values the compiler has to check, keyed by the address of the node they belong to
+ */
+class Typing {
+public:
+	/**
+	 * @brief Returns the type of every value of an expression, or the declared type of a variable or parameter
+	 *
+	 * @note Integral literals have the type of the value they are combined with or stored as, if they fit into it.
+	 */
+	[[nodiscard]] Type type(const void* node) const noexcept {
+		auto found = m_types.find(node);
+		return (found == m_types.end()) ? Type::unknown : found->second;
+	}
+	/**
+	 * @brief Returns the type the value stored by a declaration, parameter, assignment, increment or return statement has to be checked for when it is stored
+	 *
+	 * @note Values are only checked if their type is unknown, values which certainly have a different type are rejected by the type checker.
+	 */
+	[[nodiscard]] Type check(const void* node) const noexcept {
+		auto found = m_checks.find(node);
+		return (found == m_checks.end()) ? Type::unknown : found->second;
+	}
+
+private:
+	lsd::UnorderedFlatMap<const void*, Type> m_types;
+	lsd::UnorderedFlatMap<const void*, Type> m_checks;
+
+	friend class TypeChecker;
+};
+
+/**
+ * @brief Infers the types of the expressions of a module from literals and the type annotations of variables, parameters and functions
+ *
+ * @note Declared types are enforced everywhere a variable is stored, so they are known wherever it is read.
+ * Locals without a declared type which closures don't capture have the type of every value stored into them, if that is always the same.
+ * Globals may be stored by other modules, so only their stores are checked.
+ */
+class TypeChecker {
+public:
+	TypeChecker(ast::Module& module, const Resolution& resolution, const LineTable& lines, lsd::StringView source, lsd::StringView path) :
+		m_module(&module), m_resolution(&resolution), m_lines(&lines), m_source(source), m_path(path) { }
+
+	/**
+	 * @brief Types the module, throwing a CompileError for values which don't have the type they are declared with
+	 */
+	[[nodiscard]] Typing check();
+
+private:
+	struct Local {
+	public:
+		Type type = Type::unknown;
+		bool declared = false; // The type was declared, so it doesn't depend on the stored values
+		bool assigned = false; // A value was stored into the local, which is always the case once it is read
+	};
+
+	struct FunctionState {
+	public:
+		lsd::Vector<Local> locals; // Indexed by the numbers of the resolver
+		lsd::Vector<Type> upvalues; // Declared types of the locals the upvalues refer to
+		Type result = Type::unknown;
+		bool changed = false; // The type of a local changed while checking the body
+	};
+
+	/**
+	 * @brief Storage a value is stored into
+	 */
+	struct Target {
+	public:
+		enum class Kind : uint8 {
+			none, // Members and elements, which aren't typed
+			local,
+			upvalue,
+			global
+		};
+
+		Kind kind = Kind::none;
+		uint32 index = 0;
+	};
+
+	/**
+	 * @brief Suspended check of an expression, resumed once the operand it is waiting for was checked
+	 */
+	struct ExpressionFrame {
+	public:
+		enum class Kind : uint8 {
+			value, // Types the expression
+			target // Types the expression a value is stored into and returns where it is stored
+		};
+
+		const ast::Expression* expression;
+		Kind kind;
+		uint8 stage = 0; // Point the check resumes at once the operand it waits for was checked
+
+		Type type = Type::unknown; // Type of the left operand of an infix expression
+		Target target { }; // Target of the left operand of an assignment
+
+		// Position in the chain of a member expression, or in the captures of a closure
+		size_type element = 0;
+		size_type operand = 0;
+	};
+
+	/**
+	 * @brief Result of the last expression which was checked
+	 */
+	struct ExpressionResult {
+	public:
+		Type type = Type::unknown;
+		Target target;
+	};
+
+	ast::Module* m_module;
+	const Resolution* m_resolution;
+	const LineTable* m_lines;
+
+	lsd::StringView m_source;
+	lsd::StringView m_path;
+
+	Typing m_typing;
+
+	lsd::Vector<Type> m_globals; // Declared types of the global slots
+	lsd::Vector<FunctionState> m_functions; // Functions currently being checked, the first one initializes the module
+	bool m_final = true; // The types of the locals are final, so types are recorded and errors are reported
+	lsd::Vector<ExpressionFrame> m_frames; // Stack of the expressions being checked, so nesting doesn't recurse
+
+	[[noreturn]] void error(const Token& token, error::Message message) const;
+
+	[[nodiscard]] FunctionState& state() noexcept {
+		return m_functions.back();
+	}
+
+	void record(const void* node, Type type);
+	void declareGlobals(const lsd::Vector<ast::decl_ptr>& declarations);
+
+	// Storage
+
+	/**
+	 * @brief Declares a local, which has the declared type or the type of the values stored into it otherwise
+	 */
+	void declareLocal(const ast::detail::IdentifierDecl& identifier, Type value, const ast::Expression* expression);
+	[[nodiscard]] Type read(const Target& target) noexcept;
+	/**
+	 * @brief Checks a value stored into a target and returns the type of the stored value
+	 *
+	 * @param expression Expression the value was computed by, whose type is changed if it is a literal which fits into the declared type
+	 * @param node Node the check of the value is recorded for
+	 */
+	Type store(const Target& target, Type value, const ast::Expression* expression, const void* node, const Token& token);
+	/**
+	 * @brief Changes the type of an integral literal to the type it is used as, if the literal fits into it
+	 */
+	bool convert(const ast::Expression* expression, Type type);
+	/**
+	 * @brief Returns the type both operands of an operation are specialized for, or unknown if it can't be specialized
+	 */
+	Type operands(const ast::Expression* left, Type leftType, const ast::Expression* right, Type rightType, bool bitwise);
+
+	// Traversal
+
+	void declaration(ast::Declaration* declaration);
+	template <class Node> void function(const Node& node);
+	void statement(ast::Statement* statement);
+	Type expression(const ast::Expression* expression);
+	/**
+	 * @brief Types the expression a value is stored into and returns where it is stored
+	 */
+	Target target(const ast::Expression* expression);
+
+	// Expressions
+
+	/**
+	 * @brief Checks the frame on top of the stack and every frame it pushes, with an explicit stack instead of native recursion
+	 */
+	ExpressionResult evaluate();
+	/**
+	 * @brief Suspends the frame on top of the stack until an operand of it was checked
+	 */
+	void call(const ast::Expression* expression, ExpressionFrame::Kind kind);
+	void finishValue(ExpressionResult& result, Type type);
+	void finishTarget(ExpressionResult& result, const Target& target);
+
+	[[nodiscard]] Type atomic(const ast::AtomicExpr& expression);
+	[[nodiscard]] Target variable(const Token& identifier) const noexcept;
+
+	void continueTarget(ExpressionResult& result);
+	void continueMember(const ast::MemberExpr& expression, ExpressionResult& result);
+	void continueUnary(const ast::UnaryExpr& expression, ExpressionResult& result);
+	void continueInfix(const ast::InfixExpr& expression, ExpressionResult& result);
+	void continueClosure(const ast::ClosureExpr& expression, ExpressionResult& result);
+};
+
+} // namespace compiler
+
+} // namespace elyrium
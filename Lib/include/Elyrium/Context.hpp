@@ -0,0 +1,51 @@
+/*************************
+ * @file Context.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief State shared between all modules compiled and run together
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/SymbolTable.hpp>
+
+namespace elyrium {
+
+class Context {
+public:
+	Context() = default;
+	Context(const Context&) = delete;
+	Context(Context&&) = default;
+
+	Context& operator=(const Context&) = delete;
+	Context& operator=(Context&&) = default;
+
+	[[nodiscard]] compiler::SymbolTable& symbols() noexcept {
+		return m_symbols;
+	}
+	[[nodiscard]] const compiler::SymbolTable& symbols() const noexcept {
+		return m_symbols;
+	}
+
+	/**
+	 * @brief Sets the amount of threads parsers created with this context lex their source on, zero uses the hardware concurrency
+	 */
+	void setLexerThreadCount(size_type threadCount) noexcept {
+		m_lexerThreadCount = threadCount;
+	}
+	[[nodiscard]] size_type lexerThreadCount() const noexcept {
+		return m_lexerThreadCount;
+	}
+
+private:
+	compiler::SymbolTable m_symbols;
+
+	size_type m_lexerThreadCount = 1; // Sources are lexed sequentially unless parallel lexing is requested
+};
+
+} // namespace elyrium
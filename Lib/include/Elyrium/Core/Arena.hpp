@@ -0,0 +1,84 @@
+/*************************
+ * @file Arena.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Bump pointer allocator which releases all of its memory at once
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <LSD/StringView.h>
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace elyrium {
+
+class Arena {
+public:
+	static constexpr size_type defaultBlockSize = 16384;
+
+	Arena(size_type blockSize = defaultBlockSize) noexcept : m_blockSize(blockSize) { }
+	Arena(const Arena&) = delete;
+	Arena(Arena&& other) noexcept;
+	~Arena();
+
+	Arena& operator=(const Arena&) = delete;
+	Arena& operator=(Arena&& other) noexcept;
+
+	[[nodiscard]] void* allocate(size_type size, size_type alignment = alignof(std::max_align_t)) {
+		auto current = (m_current + (alignment - 1)) & ~(alignment - 1);
+
+		if (current + size > m_end) {
+			addBlock(size + alignment);
+			current = (m_current + (alignment - 1)) & ~(alignment - 1);
+		}
+
+		m_current = current + size;
+		return reinterpret_cast<void*>(current);
+	}
+
+	/**
+	 * @brief Constructs an object inside of the arena
+	 * 
+	 * @note The destructor of the object is never called by the arena
+	 */
+	template <class Ty, class... Args> [[nodiscard]] Ty* construct(Args&&... args) {
+		return ::new (allocate(sizeof(Ty), alignof(Ty))) Ty(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Copies a string into the arena, the result is null terminated
+	 */
+	[[nodiscard]] lsd::StringView copy(lsd::StringView string);
+
+	void release() noexcept;
+
+	[[nodiscard]] size_type allocatedBytes() const noexcept {
+		return m_allocatedBytes;
+	}
+
+private:
+	struct Block {
+	public:
+		Block* previous;
+		size_type size;
+	};
+
+	Block* m_head = nullptr;
+	uintptr m_current = 0;
+	uintptr m_end = 0;
+
+	size_type m_blockSize;
+	size_type m_allocatedBytes = 0;
+
+	void addBlock(size_type minimumSize);
+};
+
+} // namespace elyrium
@@ -26,6 +26,14 @@
 #define ELYRIUM_ALT_OS
 #endif
 
+#if defined(__AVX2__)
+#define ELYRIUM_AVX2
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ELYRIUM_SSE2
+#endif
+
 namespace elyrium {
 
 namespace config {
@@ -24,6 +24,7 @@ enum class Message {
 	invalidSyntax,
 
 	invalidNumericLiteral,
+	numericLiteralOutOfRange,
 	disallowedChar,
 
 	invalidEscape,
@@ -31,6 +32,7 @@ enum class Message {
 	emptyChar,
 
 	unclosedBlockComment,
+	sourceTooLarge,
 
 	expectedDifferent,
 	expectedIdentifier,
@@ -39,8 +41,37 @@ enum class Message {
 
 	noCatchBehindTry,
 	importDeclRequiresStrOrConst,
+
+	// Import errors
+
+	moduleNotFound,
+	circularImport,
+
+	// Resolve errors
+
+	redeclaration,
+	unknownMember,
+	namespaceAsValue,
+
+	// Compile errors
+
+	unsupportedConstruct,
+	invalidAssignment,
+	jumpOutsideOfLoop,
+	tooManyRegisters,
+	tooManyConstants,
+	functionTooLarge,
+
+	// Type errors
+
+	typeMismatch,
 };
 
+/**
+ * @brief Returns the description of a message, which is a static string
+ */
+[[nodiscard]] const char* describe(Message message) noexcept;
+
 } // namespace error
 
 
@@ -80,4 +111,31 @@ public:
 		char expected = '\0');
 };
 
+
+// Import errors
+
+class ImportError : public Exception {
+public:
+	ImportError(
+		lsd::StringView fileName, 
+		size_type line,
+		size_type column,
+		lsd::StringView lineSource, 
+		error::Message message,
+		lsd::StringView module);
+};
+
+
+// Compile errors
+
+class CompileError : public Exception {
+public:
+	CompileError(
+		lsd::StringView fileName, 
+		size_type line,
+		size_type column,
+		lsd::StringView lineSource, 
+		error::Message message);
+};
+
 } // namespace elyrium
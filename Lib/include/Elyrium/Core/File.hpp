@@ -236,6 +236,64 @@ using File = BasicFile<char>;
 using WFile = BasicFile<wchar_t>;
 
 
+/**
+ * @brief Read only contents of a whole file, memory mapped where possible
+ * 
+ * @note The byte behind the last character of the contents is always a null character, which is not part of view()
+ */
+class SourceBuffer {
+public:
+	SourceBuffer() = default;
+	SourceBuffer(const SourceBuffer&) = delete;
+	SourceBuffer(SourceBuffer&& other) noexcept;
+	~SourceBuffer();
+
+	SourceBuffer& operator=(const SourceBuffer&) = delete;
+	SourceBuffer& operator=(SourceBuffer&& other) noexcept;
+
+	[[nodiscard]] lsd::StringView view() const noexcept {
+		return lsd::StringView(m_data, m_size);
+	}
+	[[nodiscard]] const char* data() const noexcept {
+		return m_data;
+	}
+	[[nodiscard]] size_type size() const noexcept {
+		return m_size;
+	}
+	[[nodiscard]] bool mapped() const noexcept {
+		return m_mappedSize != 0;
+	}
+
+private:
+	char* m_data = nullptr;
+	size_type m_size = 0;
+	size_type m_mappedSize = 0; // Size of the mapping including the sentinel page, zero if the contents were read into the heap
+
+	void release() noexcept;
+
+	friend class FileSystem;
+};
+
+
+/**
+ * @brief Sequential reader which pulls the contents of a file or file descriptor in pieces
+ */
+class InputStream {
+public:
+	InputStream(File& file) noexcept : m_file(&file) { }
+	InputStream(int descriptor) noexcept : m_descriptor(descriptor) { }
+
+	/**
+	 * @brief Reads up to size bytes into buffer and returns how many were read, which is zero only once the input is exhausted
+	 */
+	size_type read(char* buffer, size_type size);
+
+private:
+	File* m_file = nullptr;
+	int m_descriptor = -1;
+};
+
+
 class FileSystem {
 public:
 	static constexpr size_type bufferSize = BUFSIZ;
@@ -244,6 +302,10 @@ public:
 	bool exists(lsd::StringView path) const;
 
 	[[nodiscard]] File load(lsd::StringView path, OpenMode mode, bool buffered = true);
+	/**
+	 * @brief Maps the contents of a file into memory for sequential reading, or reads it with a single bulk read if mapping isn't possible
+	 */
+	[[nodiscard]] SourceBuffer map(lsd::StringView path) const;
 	[[nodiscard]] File tmpFile();
 
 private:
@@ -0,0 +1,35 @@
+/*************************
+ * @file Hash.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Hash function for strings and byte sequences
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+/**
+ * @brief Hashes the bytes of a string with 64 bit FNV-1a
+ *
+ * @note The result is written into cached files, so it must not change between versions
+ */
+[[nodiscard]] inline uint64 hashBytes(lsd::StringView string) noexcept {
+	uint64 hash = 0xcbf29ce484222325;
+
+	for (auto c : string) {
+		hash ^= static_cast<uint8>(c);
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
+} // namespace elyrium
@@ -0,0 +1,60 @@
+/*************************
+ * @file LineTable.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Lazily built table of line offsets for resolving source positions
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+
+namespace elyrium {
+
+struct SourceLocation {
+public:
+	size_type line = 0;
+	size_type column = 0;
+};
+
+class LineTable {
+public:
+	using offset_type = uint32;
+
+	LineTable() = default;
+	LineTable(lsd::StringView source) : m_source(source) { }
+
+	/**
+	 * @brief Resolves a byte offset into the source to a zero-based line and column
+	 * 
+	 * @note The table of line offsets is only built on the first query
+	 */
+	[[nodiscard]] SourceLocation location(size_type offset) const;
+	/**
+	 * @brief Returns the line an offset is in, with tabs expanded to four spaces
+	 * 
+	 * @param additionalSpaces Incremented by the amount of spaces inserted before the offset
+	 */
+	[[nodiscard]] lsd::String lineSource(size_type offset, size_type& additionalSpaces) const;
+	[[nodiscard]] lsd::StringView line(size_type line) const;
+
+	[[nodiscard]] size_type lineCount() const;
+	[[nodiscard]] lsd::StringView source() const noexcept {
+		return m_source;
+	}
+
+private:
+	lsd::StringView m_source;
+	mutable lsd::Vector<offset_type> m_lineBegins;
+
+	void build() const;
+};
+
+} // namespace elyrium
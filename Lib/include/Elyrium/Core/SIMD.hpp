@@ -0,0 +1,139 @@
+/*************************
+ * @file SIMD.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Vectorized byte scanning utilities with scalar fallbacks
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <bit>
+#include <cstring>
+
+#if defined(ELYRIUM_AVX2) || defined(ELYRIUM_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace elyrium {
+
+namespace simd {
+
+namespace detail {
+
+#if defined(ELYRIUM_AVX2)
+
+using register_type = __m256i;
+inline constexpr size_type registerSize = 32;
+inline constexpr uint32 registerMask = 0xFFFFFFFF;
+
+inline register_type load(const char* data) noexcept {
+	return _mm256_loadu_si256(reinterpret_cast<const register_type*>(data));
+}
+
+inline uint32 equal(register_type reg, char c) noexcept {
+	return static_cast<uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(reg, _mm256_set1_epi8(c))));
+}
+
+inline uint32 between(register_type reg, char low, char high) noexcept { // Only valid for ASCII bounds
+	return static_cast<uint32>(_mm256_movemask_epi8(_mm256_and_si256(
+		_mm256_cmpgt_epi8(reg, _mm256_set1_epi8(low - 1)),
+		_mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), reg))));
+}
+
+#elif defined(ELYRIUM_SSE2)
+
+using register_type = __m128i;
+inline constexpr size_type registerSize = 16;
+inline constexpr uint32 registerMask = 0x0000FFFF;
+
+inline register_type load(const char* data) noexcept {
+	return _mm_loadu_si128(reinterpret_cast<const register_type*>(data));
+}
+
+inline uint32 equal(register_type reg, char c) noexcept {
+	return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(reg, _mm_set1_epi8(c))));
+}
+
+inline uint32 between(register_type reg, char low, char high) noexcept { // Only valid for ASCII bounds
+	return static_cast<uint32>(_mm_movemask_epi8(_mm_and_si128(
+		_mm_cmpgt_epi8(reg, _mm_set1_epi8(low - 1)),
+		_mm_cmplt_epi8(reg, _mm_set1_epi8(high + 1)))));
+}
+
+#endif
+
+/**
+ * @brief Advances until stop returns true for a byte
+ *
+ * @param vectorStop Returns a bitmask of the bytes in a register the scan should stop at
+ * @param scalarStop Returns if the scan should stop at a single byte
+ */
+template <class VectorStop, class ScalarStop>
+inline const char* scan(const char* it, const char* end, VectorStop&& vectorStop, ScalarStop&& scalarStop) noexcept {
+#if defined(ELYRIUM_AVX2) || defined(ELYRIUM_SSE2)
+	for (; static_cast<size_type>(end - it) >= registerSize; it += registerSize) {
+		if (uint32 stopMask = vectorStop(load(it)); stopMask != 0)
+			return it + std::countr_zero(stopMask);
+	}
+#endif
+
+	for (; it != end; it++)
+		if (scalarStop(*it)) return it;
+
+	return it;
+}
+
+} // namespace detail
+
+
+// Returns the first byte which is not a space, tab, newline or other blank character
+
+inline const char* skipBlank(const char* it, const char* end) noexcept {
+	return detail::scan(it, end,
+#if defined(ELYRIUM_AVX2) || defined(ELYRIUM_SSE2)
+		[](detail::register_type reg) {
+			return ~(detail::equal(reg, ' ') | detail::between(reg, '\t', '\r')) & detail::registerMask;
+		},
+#else
+		nullptr,
+#endif
+		[](char c) {
+			return c != ' ' && (c < '\t' || c > '\r');
+		}
+	);
+}
+
+// Returns the first byte which might start or end a block comment, or the first disallowed null character
+
+inline const char* findCommentBoundary(const char* it, const char* end) noexcept {
+	return detail::scan(it, end,
+#if defined(ELYRIUM_AVX2) || defined(ELYRIUM_SSE2)
+		[](detail::register_type reg) {
+			return detail::equal(reg, '*') | detail::equal(reg, '/') | detail::equal(reg, '\0');
+		},
+#else
+		nullptr,
+#endif
+		[](char c) {
+			return c == '*' || c == '/' || c == '\0';
+		}
+	);
+}
+
+// Returns the next newline or end
+
+inline const char* findLineEnd(const char* it, const char* end) noexcept {
+	if (auto r = static_cast<const char*>(std::memchr(it, '\n', end - it)); r)
+		return r;
+
+	return end;
+}
+
+} // namespace simd
+
+} // namespace elyrium
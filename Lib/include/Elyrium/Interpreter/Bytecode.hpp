@@ -0,0 +1,150 @@
+/*************************
+ * @file Bytecode.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Compiled functions and the instructions and constants they consist of
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/SymbolTable.hpp>
+#include <Elyrium/Compiler/LiteralArena.hpp>
+
+#include <Elyrium/Interpreter/Opcodes.hpp>
+
+#include <LSD/Vector.h>
+
+#include <bit>
+
+namespace elyrium {
+
+namespace bytecode {
+
+using operand_type = uint32;
+
+/**
+ * @brief Decoded instruction, which is encoded into a variable amount of bytes by the helpers in Encoding.hpp
+ *
+ * @note Signed operands are stored as their two's complement. Targets are instruction indices before assembly and byte offsets after decoding.
+ */
+struct Instruction {
+public:
+	Opcode opcode = Opcode::nop;
+	operand_type a = 0;
+	operand_type b = 0;
+	operand_type c = 0;
+
+	/**
+	 * @brief Returns an operand interpreted as a signed immediate or offset
+	 */
+	[[nodiscard]] static constexpr int32 immediate(operand_type operand) noexcept {
+		return static_cast<int32>(operand);
+	}
+};
+
+/**
+ * @brief Value a function loads from its constant table, stored as the raw bits of the value and its type
+ */
+class Constant {
+public:
+	enum class Type : uint8 {
+		integral,
+		unsignedIntegral,
+		floating,
+		character,
+		string,		// Literal in the string arena of the program
+		symbol		// Name of a member
+	};
+
+	constexpr Constant() = default;
+	constexpr Constant(Type type, uint64 bits) noexcept : m_type(type), m_bits(bits) { }
+
+	[[nodiscard]] static constexpr Constant fromIntegral(int64 value) noexcept {
+		return Constant(Type::integral, static_cast<uint64>(value));
+	}
+	[[nodiscard]] static constexpr Constant fromFloating(float64 value) noexcept {
+		return Constant(Type::floating, std::bit_cast<uint64>(value));
+	}
+
+	[[nodiscard]] constexpr bool operator==(const Constant&) const noexcept = default;
+
+	[[nodiscard]] constexpr Type type() const noexcept {
+		return m_type;
+	}
+	[[nodiscard]] constexpr uint64 bits() const noexcept {
+		return m_bits;
+	}
+	[[nodiscard]] constexpr int64 integral() const noexcept {
+		return static_cast<int64>(m_bits);
+	}
+	[[nodiscard]] constexpr uint64 unsignedIntegral() const noexcept {
+		return m_bits;
+	}
+	[[nodiscard]] constexpr float64 floating() const noexcept {
+		return std::bit_cast<float64>(m_bits);
+	}
+	[[nodiscard]] constexpr char32 character() const noexcept {
+		return static_cast<char32>(m_bits);
+	}
+	[[nodiscard]] constexpr compiler::literal_id string() const noexcept {
+		return static_cast<compiler::literal_id>(m_bits);
+	}
+	[[nodiscard]] constexpr compiler::symbol_id symbol() const noexcept {
+		return static_cast<compiler::symbol_id>(m_bits);
+	}
+
+private:
+	Type m_type = Type::integral;
+	uint64 m_bits = 0;
+};
+
+/**
+ * @brief Value a closure captures when it is created, which it accesses as an upvalue
+ */
+struct Capture {
+public:
+	bool local; // Register of the function creating the closure if true, upvalue of it otherwise
+	operand_type index;
+};
+
+/**
+ * @brief Slot of a module level variable or function, or of a static member of a namespace
+ */
+struct Global {
+public:
+	lsd::Vector<compiler::symbol_id> path; // Enclosing namespaces and the name of the slot
+	bool external = false; // Not declared by the module, so it is bound by name when the module is linked
+};
+
+struct Function {
+public:
+	compiler::symbol_id name = compiler::SymbolTable::none; // None for the function initializing the module
+	operand_type parameterCount = 0;
+	operand_type registerCount = 0;
+
+	lsd::Vector<uint8> code; // Encoded instructions
+	lsd::Vector<Constant> constants;
+	lsd::Vector<Capture> captures;
+};
+
+/**
+ * @brief Functions compiled from a module, the first of which initializes the globals of the module
+ *
+ * @note Globals are accessed by their slot, names are only used to bind external slots when linking.
+ * Symbols belong to the symbol table of the context the module was parsed in.
+ */
+struct Program {
+public:
+	lsd::Vector<Function> functions;
+	lsd::Vector<Global> globals;
+	compiler::LiteralArena strings;
+};
+
+} // namespace bytecode
+
+} // namespace elyrium
@@ -0,0 +1,34 @@
+/*************************
+ * @file Disassembler.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Textual listing of compiled bytecode
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Compiler/SymbolTable.hpp>
+
+#include <Elyrium/Interpreter/Bytecode.hpp>
+
+#include <LSD/String.h>
+
+namespace elyrium {
+
+namespace bytecode {
+
+/**
+ * @brief Lists the globals and every function of a program with its instructions, one per line, and the constants and globals they use
+ *
+ * @param symbols Symbol table the program was compiled with, which names of globals and members are looked up in
+ */
+[[nodiscard]] lsd::String disassemble(const Program& program, const compiler::SymbolTable& symbols);
+
+} // namespace bytecode
+
+} // namespace elyrium
@@ -0,0 +1,104 @@
+/*************************
+ * @file Encoding.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ * 
+ * @brief Byte encoding of instructions
+ * 
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <Elyrium/Interpreter/Opcodes.hpp>
+#include <Elyrium/Interpreter/Bytecode.hpp>
+
+#include <LSD/Vector.h>
+
+namespace elyrium {
+
+namespace bytecode {
+
+/**
+ * @brief Size of every operand of an instruction in bytes
+ *
+ * @note An instruction is its opcode followed by its operands, which are one byte wide unless the instruction is prefixed by a wide or extraWide opcode.
+ * Operands are stored in little endian order.
+ */
+enum class Width : uint8 {
+	narrow = 1,
+	wide = 2,
+	extraWide = 4
+};
+
+/**
+ * @brief Returns the narrowest width every operand of an instruction fits into
+ */
+[[nodiscard]] Width width(const Instruction& instruction) noexcept;
+/**
+ * @brief Returns the amount of bytes an instruction occupies at a width, including its prefix
+ */
+[[nodiscard]] size_type encodedSize(Opcode opcode, Width width) noexcept;
+
+/**
+ * @brief Appends an instruction at the narrowest width possible, its target operand has to be an offset already
+ */
+void encode(lsd::Vector<uint8>& code, const Instruction& instruction);
+/**
+ * @brief Appends an instruction at a width, which has to be at least as wide as its operands require
+ */
+void encode(lsd::Vector<uint8>& code, const Instruction& instruction, Width width);
+/**
+ * @brief Encodes the instructions of a function, turning jump targets from instruction indices into byte offsets
+ *
+ * @note Jumps are widened until every offset fits into them, which terminates since widening only ever grows the code.
+ */
+[[nodiscard]] lsd::Vector<uint8> assemble(const lsd::Vector<Instruction>& instructions);
+
+/**
+ * @brief Decodes the instruction starting at code, including its prefix
+ *
+ * @return Size of the instruction in bytes
+ */
+size_type decode(const uint8* code, Instruction& instruction) noexcept;
+
+/**
+ * @brief Reads an unsigned operand of an instruction, operands pointing to the first byte after the opcode
+ */
+[[nodiscard]] inline operand_type readOperand(const uint8* operands, Width width, size_type index) noexcept {
+	switch (width) {
+		case Width::narrow:
+			return operands[index];
+
+		case Width::wide:
+			operands += index * 2;
+			return static_cast<operand_type>(operands[0] | (operands[1] << 8));
+
+		default:
+			operands += index * 4;
+			return static_cast<operand_type>(operands[0]) | (static_cast<operand_type>(operands[1]) << 8) |
+				(static_cast<operand_type>(operands[2]) << 16) | (static_cast<operand_type>(operands[3]) << 24);
+	}
+}
+/**
+ * @brief Reads a signed operand of an instruction, sign extended to the size of a full operand
+ */
+[[nodiscard]] inline operand_type readSignedOperand(const uint8* operands, Width width, size_type index) noexcept {
+	auto operand = readOperand(operands, width, index);
+
+	switch (width) {
+		case Width::narrow:
+			return static_cast<operand_type>(static_cast<int32>(static_cast<int8>(operand)));
+		case Width::wide:
+			return static_cast<operand_type>(static_cast<int32>(static_cast<int16>(operand)));
+
+		default:
+			return operand;
+	}
+}
+
+} // namespace bytecode
+
+} // namespace elyrium
@@ -10,62 +10,177 @@
 
 #pragma once
 
+#include <Elyrium/Core/Common.hpp>
+
 namespace elyrium {
 
-enum class Opcode {
-	nop = 0,
-
-	load = 16,
-	store,
-	swap,
-
-	add = 32,
-	subtract,
-	multiply,
-	divivde,
-	modulo,
-	negate,
-	positive,
-
-	adds,
-	subtracts,
-	multiplys,
-	divivdes,
-	modulos,
-
-	bitShiftLeft = 46,
-	bitShiftRight,
-
-	bitNot = 48,
-	bitAnd,
-	bitOr,
-	bitXOr,
-	compare,
-
-	jump = 64,
-	ret,
-	syscall,
-
-	jumpIfEqual = 72,
-	jumpIfNotEqual,
-	jumpIfLarger,
-	jumpIfSmaller,
-	jumpIfCarrySet,
-	jumpIfCarryClear,
-	jumpIfOverflowSet,
-	jumpIfOverflowClear,
-	jumpIfZero,
-	jumpIfPositive,
-	jumpIfNegative,
-	jumpIfInf,
-	jumpIfNan,
-
-	clearCarry = 96,
-	setCarry,
-	clearOverflow,
-	setOverflow,
-	clearFlags,
-	setFlags
+/**
+ * @brief Opcodes of the register machine, every instruction has up to three operands A, B and C
+ *
+ * @note R[x] is a register, K[x] a constant of the function, U[x] an upvalue of the closure, G[x] a global slot of the module and sx a signed immediate operand.
+ * Jump offsets are signed and relative to the first byte of the jump, including its prefix.
+ * Ordered comparisons are total, as all of them are defined through compare, so the compiler negates a condition by emitting the complementary jump.
+ */
+enum class Opcode : uint8 {
+	nop,
+
+	wide,					// Operands of the next instruction are 16 bit wide
+	extraWide,				// Operands of the next instruction are 32 bit wide
+
+	move,					// R[A] = R[B]
+	loadConstant,			// R[A] = K[B]
+	loadInteger,			// R[A] = sB
+	loadNull,				// R[A] = null
+	loadTrue,				// R[A] = true
+	loadFalse,				// R[A] = false
+	loadGlobal,				// R[A] = G[B]
+	storeGlobal,			// G[A] = R[B]
+	loadUpvalue,			// R[A] = U[B]
+	storeUpvalue,			// U[A] = R[B]
+	loadMember,				// R[A] = R[B].K[C]
+	storeMember,			// R[A].K[B] = R[C]
+	loadIndex,				// R[A] = R[B][R[C]]
+	storeIndex,				// R[A][R[B]] = R[C]
+	loadMethod,				// R[A + 1] = R[B], R[A] = R[B].K[C]
+
+	add,					// R[A] = R[B] + R[C]
+	subtract,				// R[A] = R[B] - R[C]
+	multiply,				// R[A] = R[B] * R[C]
+	divide,					// R[A] = R[B] / R[C]
+	modulo,					// R[A] = R[B] % R[C]
+	addImmediate,			// R[A] = R[B] + sC
+	negate,					// R[A] = -R[B]
+	positive,				// R[A] = +R[B]
+
+	bitShiftLeft,			// R[A] = R[B] << R[C]
+	bitShiftRight,			// R[A] = R[B] >> R[C]
+	bitNot,					// R[A] = ~R[B]
+	bitAnd,					// R[A] = R[B] & R[C]
+	bitOr,					// R[A] = R[B] | R[C]
+	bitXOr,					// R[A] = R[B] ^ R[C]
+	compare,				// R[A] = R[B] <=> R[C]
+	equal,					// R[A] = R[B] == R[C]
+	notEqual,				// R[A] = R[B] != R[C]
+	less,					// R[A] = R[B] < R[C]
+	lessEqual,				// R[A] = R[B] <= R[C]
+	logicNot,				// R[A] = !R[B]
+
+	jump,					// Jump by sA
+	ret,					// Return R[A] if B is 1, null otherwise
+	call,					// R[A] = R[A](R[A + 1], ..., R[A + B])
+	closure,				// R[A] = closure of function B of the program, capturing the values listed by the function
+	close,					// Moves the values of registers from R[A] on captured by closures out of the frame
+
+	jumpIfEqual,			// Jump by sC if R[A] == R[B]
+	jumpIfNotEqual,			// Jump by sC if R[A] != R[B]
+	jumpIfLarger,			// Jump by sC if R[A] > R[B]
+	jumpIfSmaller,			// Jump by sC if R[A] < R[B]
+	jumpIfLargerEqual,		// Jump by sC if R[A] >= R[B]
+	jumpIfSmallerEqual,		// Jump by sC if R[A] <= R[B]
+	jumpIfTrue,				// Jump by sB if R[A] is truthy
+	jumpIfFalse,			// Jump by sB if R[A] is falsy
+
+	// Opcodes for operands whose type the compiler proved, which neither check nor dispatch on the types of their operands.
+	// Integral operations wrap around on overflow and only raise an error if they divide by zero.
+
+	checkI64,				// Raise an error unless R[A] is a signed integral
+	checkU64,				// Raise an error unless R[A] is an unsigned integral
+	checkF64,				// Raise an error unless R[A] is a floating point number
+	checkBool,				// Raise an error unless R[A] is a boolean
+
+	addI64,					// R[A] = R[B] + R[C]
+	subtractI64,			// R[A] = R[B] - R[C]
+	multiplyI64,			// R[A] = R[B] * R[C]
+	divideI64,				// R[A] = R[B] / R[C]
+	moduloI64,				// R[A] = R[B] % R[C]
+	addImmediateI64,		// R[A] = R[B] + sC
+	negateI64,				// R[A] = -R[B]
+	bitShiftLeftI64,		// R[A] = R[B] << R[C]
+	bitShiftRightI64,		// R[A] = R[B] >> R[C]
+	bitNotI64,				// R[A] = ~R[B]
+	bitAndI64,				// R[A] = R[B] & R[C]
+	bitOrI64,				// R[A] = R[B] | R[C]
+	bitXOrI64,				// R[A] = R[B] ^ R[C]
+	compareI64,				// R[A] = R[B] <=> R[C]
+	equalI64,				// R[A] = R[B] == R[C]
+	notEqualI64,			// R[A] = R[B] != R[C]
+	lessI64,				// R[A] = R[B] < R[C]
+	lessEqualI64,			// R[A] = R[B] <= R[C]
+	jumpIfEqualI64,			// Jump by sC if R[A] == R[B]
+	jumpIfNotEqualI64,		// Jump by sC if R[A] != R[B]
+	jumpIfLargerI64,		// Jump by sC if R[A] > R[B]
+	jumpIfSmallerI64,		// Jump by sC if R[A] < R[B]
+	jumpIfLargerEqualI64,	// Jump by sC if R[A] >= R[B]
+	jumpIfSmallerEqualI64,	// Jump by sC if R[A] <= R[B]
+
+	addU64,					// R[A] = R[B] + R[C]
+	subtractU64,			// R[A] = R[B] - R[C]
+	multiplyU64,			// R[A] = R[B] * R[C]
+	divideU64,				// R[A] = R[B] / R[C]
+	moduloU64,				// R[A] = R[B] % R[C]
+	addImmediateU64,		// R[A] = R[B] + sC
+	bitShiftLeftU64,		// R[A] = R[B] << R[C]
+	bitShiftRightU64,		// R[A] = R[B] >> R[C]
+	bitNotU64,				// R[A] = ~R[B]
+	bitAndU64,				// R[A] = R[B] & R[C]
+	bitOrU64,				// R[A] = R[B] | R[C]
+	bitXOrU64,				// R[A] = R[B] ^ R[C]
+	compareU64,				// R[A] = R[B] <=> R[C]
+	equalU64,				// R[A] = R[B] == R[C]
+	notEqualU64,			// R[A] = R[B] != R[C]
+	lessU64,				// R[A] = R[B] < R[C]
+	lessEqualU64,			// R[A] = R[B] <= R[C]
+	jumpIfEqualU64,			// Jump by sC if R[A] == R[B]
+	jumpIfNotEqualU64,		// Jump by sC if R[A] != R[B]
+	jumpIfLargerU64,		// Jump by sC if R[A] > R[B]
+	jumpIfSmallerU64,		// Jump by sC if R[A] < R[B]
+	jumpIfLargerEqualU64,	// Jump by sC if R[A] >= R[B]
+	jumpIfSmallerEqualU64,	// Jump by sC if R[A] <= R[B]
+
+	addF64,					// R[A] = R[B] + R[C]
+	subtractF64,			// R[A] = R[B] - R[C]
+	multiplyF64,			// R[A] = R[B] * R[C]
+	divideF64,				// R[A] = R[B] / R[C]
+	moduloF64,				// R[A] = R[B] % R[C]
+	addImmediateF64,		// R[A] = R[B] + sC
+	negateF64,				// R[A] = -R[B]
+	compareF64,				// R[A] = R[B] <=> R[C]
+	equalF64,				// R[A] = R[B] == R[C]
+	notEqualF64,			// R[A] = R[B] != R[C]
+	lessF64,				// R[A] = R[B] < R[C]
+	lessEqualF64,			// R[A] = R[B] <= R[C]
+	jumpIfEqualF64,			// Jump by sC if R[A] == R[B]
+	jumpIfNotEqualF64,		// Jump by sC if R[A] != R[B]
+	jumpIfLargerF64,		// Jump by sC if R[A] > R[B]
+	jumpIfSmallerF64,		// Jump by sC if R[A] < R[B]
+	jumpIfLargerEqualF64,	// Jump by sC if R[A] >= R[B]
+	jumpIfSmallerEqualF64,	// Jump by sC if R[A] <= R[B]
+};
+
+/**
+ * @brief Meaning of an operand, used to print and check instructions
+ */
+enum class Operand : uint8 {
+	none,
+	reg,		// Register
+	constant,	// Index into the constants of the function
+	immediate,	// Signed value stored in the operand itself
+	target,		// Signed offset of the instruction a jump continues at
+	function,	// Index of a function in the program
+	upvalue,	// Index into the upvalues of the closure
+	global,		// Global slot of the module
+	count		// Unsigned amount, like the arguments of a call
+};
+
+struct OpcodeInfo {
+public:
+	const char* name;
+	Operand operands[3];
 };
 
+/**
+ * @brief Returns the name and operand layout of an opcode
+ */
+[[nodiscard]] const OpcodeInfo& describe(Opcode opcode) noexcept;
+
 } // namespace elyrium
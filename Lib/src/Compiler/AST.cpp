@@ -131,6 +131,13 @@ void FunctionConstruct::print(int level) const {
 	if (type) type->print(level);
 }
 
+
+// Lazy bodies
+
+void LazyBody::print(int) const {
+	std::printf("Lazy block statement: [ tokens %u to %u ]\n", static_cast<unsigned>(first), static_cast<unsigned>(last));
+}
+
 } // namespace detail
 
 
@@ -140,6 +147,20 @@ void Module::bindDeclaration(decl_ptr&& decl) {
 	m_declarations.emplaceBack(std::move(decl));
 }
 
+void Module::replaceDeclarations(size_type first, size_type count, lsd::Vector<decl_ptr>&& declarations) {
+	lsd::Vector<decl_ptr> result;
+	result.reserve(m_declarations.size() - count + declarations.size());
+
+	for (size_type i = 0; i < first; i++)
+		result.emplaceBack(std::move(m_declarations[i]));
+	for (auto& decl : declarations)
+		result.emplaceBack(std::move(decl));
+	for (size_type i = first + count; i < m_declarations.size(); i++)
+		result.emplaceBack(std::move(m_declarations[i]));
+
+	m_declarations = std::move(result);
+}
+
 void Module::print() const {
 	for (const auto& decl : m_declarations)
 		decl->print();
@@ -159,7 +180,7 @@ void AtomicExpr::print(int) const {
 	std::printf("Atomic expression: [ %.*s | %zu ]\n",
 				static_cast<int>(m_value.data().size()),
 				m_value.data().data(),
-				std::to_underlying<Token::Type>(m_value.type()));
+				static_cast<size_type>(m_value.type()));
 }
 
 
@@ -254,7 +275,7 @@ void UnaryExpr::print(int level) const {
 								   level,
 								   static_cast<int>(op.data().size()),
 								   op.data().data(),
-								   std::to_underlying<Token::Type>(op.type()));
+								   static_cast<size_type>(op.type()));
 	}
 	
 	ELYRIUM_PRINT_INDENT(level);
@@ -265,7 +286,7 @@ void UnaryExpr::print(int level) const {
 								   level,
 								   static_cast<int>(m_postfix.data().size()),
 								   m_postfix.data().data(),
-								   std::to_underlying<Token::Type>(m_postfix.type()));
+								   static_cast<size_type>(m_postfix.type()));
 	}
 }
 
@@ -284,7 +305,7 @@ void InfixExpr::print(int level) const {
 							   level,
 							   static_cast<int>(m_operator.data().size()),
 							   m_operator.data().data(),
-							   std::to_underlying<Token::Type>(m_operator.type()));
+							   static_cast<size_type>(m_operator.type()));
 	ELYRIUM_PRINT_INDENTED_AST("Left expression -> ", level);
 	m_left->print(level);
 	ELYRIUM_PRINT_INDENTED_AST("Right expression -> ", level);
@@ -318,7 +339,7 @@ void JumpStmt::print(int level) const {
 	std::printf("Jump statement [ %.*s | %zu ]",
 				static_cast<int>(m_keyword.data().size()),
 				m_keyword.data().data(),
-				std::to_underlying<Token::Type>(m_keyword.type()));
+				static_cast<size_type>(m_keyword.type()));
 
 	if (m_expr) {
 		std::printf(" -> ");
@@ -481,6 +502,12 @@ void FunctionDecl::bindConstruct(detail::FunctionConstruct&& construct) {
 
 void FunctionDecl::bindBody(BlockStmt&& body) {
 	m_body = std::move(body);
+	m_lazy = false;
+}
+
+void FunctionDecl::bindLazyBody(const detail::LazyBody& body) {
+	m_lazyBody = body;
+	m_lazy = true;
 }
 
 void FunctionDecl::print(int level) const {
@@ -491,7 +518,8 @@ void FunctionDecl::print(int level) const {
 	m_construct.print(level);
 
 	ELYRIUM_PRINT_INDENTED_AST("Function body -> ", level);
-	m_body.print(level);
+	if (m_lazy) m_lazyBody.print(level);
+	else m_body.print(level);
 
 }
 
@@ -560,6 +588,12 @@ void ClosureExpr::bindConstruct(detail::FunctionConstruct&& construct) {
 
 void ClosureExpr::bindBody(BlockStmt&& body) {
 	m_body = std::move(body);
+	m_lazy = false;
+}
+
+void ClosureExpr::bindLazyBody(const detail::LazyBody& body) {
+	m_lazyBody = body;
+	m_lazy = true;
 }
 
 void ClosureExpr::print(int level) const {
@@ -568,14 +602,17 @@ void ClosureExpr::print(int level) const {
 	++level;
 	if (m_captures.size() > 0) {
 		ELYRIUM_PRINT_INDENTED_AST("Captures:\n", level);
-		for (const auto& capture : m_captures)
+		for (const auto& capture : m_captures) {
+			ELYRIUM_PRINT_INDENT(level + 1);
 			capture->print(level + 1);
+		}
 	}
 
-	m_construct.print();
+	m_construct.print(level);
 
 	ELYRIUM_PRINT_INDENTED_AST("Closure body -> ", level);
-	m_body.print(level);
+	if (m_lazy) m_lazyBody.print(level);
+	else m_body.print(level);
 }
 
 } // namespace ast
@@ -0,0 +1,39 @@
+#include <Elyrium/Compiler/AstArena.hpp>
+
+namespace elyrium {
+
+namespace compiler {
+
+AstArena::AstArena(AstArena&& other) noexcept :
+	m_storage(std::move(other.m_storage)),
+	m_finalizers(std::exchange(other.m_finalizers, nullptr)),
+	m_nodeCount(std::exchange(other.m_nodeCount, 0)) { }
+
+AstArena::~AstArena() {
+	release();
+}
+
+AstArena& AstArena::operator=(AstArena&& other) noexcept {
+	if (this != &other) {
+		release();
+
+		m_storage = std::move(other.m_storage);
+		m_finalizers = std::exchange(other.m_finalizers, nullptr);
+		m_nodeCount = std::exchange(other.m_nodeCount, 0);
+	}
+
+	return *this;
+}
+
+void AstArena::release() noexcept {
+	// Nodes are finalized newest first, so parents are destroyed before the children they were built from
+	for (; m_finalizers; m_finalizers = m_finalizers->next)
+		m_finalizers->destroy(m_finalizers->object);
+
+	m_storage.release();
+	m_nodeCount = 0;
+}
+
+} // namespace compiler
+
+} // namespace elyrium
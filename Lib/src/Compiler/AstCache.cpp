@@ -0,0 +1,1023 @@
+#include <Elyrium/Compiler/AstCache.hpp>
+
+#include <Elyrium/Core/Config.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Core/File.hpp>
+#include <Elyrium/Core/Hash.hpp>
+
+#include <LSD/UnorderedFlatMap.h>
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+#ifdef ELYRIUM_POSIX
+#include <unistd.h>
+#elif defined(ELYRIUM_WINDOWS)
+#include <process.h>
+#endif
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace {
+
+constexpr char magic[] = { 'E', 'L', 'Y', 'A' };
+constexpr size_type nestingLimit = 1 << 12; // Trees are written and read recursively, so modules with expressions nested deeper aren't cached
+
+enum class Tag : uint8 {
+	null,
+
+	atomicExpr,
+	memberExpr,
+	unaryExpr,
+	infixExpr,
+	closureExpr,
+
+	nullStmt,
+	exprStmt,
+	jumpStmt,
+	blockStmt,
+	ifStmt,
+	forStmt,
+	tryCatchStmt,
+
+	nullDecl,
+	namespaceDecl,
+	importDecl,
+	variableDecl,
+	functionDecl,
+	classDecl,
+	enumDecl
+};
+
+// Elements of the chain of a member expression, in the order of the alternatives of its variant
+enum class ChainTag : uint8 {
+	call,
+	subscript,
+	member
+};
+
+[[nodiscard]] constexpr uint64 zigzag(int64 value) noexcept {
+	return (static_cast<uint64>(value) << 1) ^ ((value < 0) ? ~uint64 { 0 } : 0);
+}
+
+[[nodiscard]] constexpr int64 unzigzag(uint64 value) noexcept {
+	return static_cast<int64>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * @brief Returns the id of the running process, which tells apart the temporary files of processes sharing a cache directory
+ */
+[[nodiscard]] unsigned long long processId() noexcept {
+#ifdef ELYRIUM_POSIX
+	return static_cast<unsigned long long>(getpid());
+#elif defined(ELYRIUM_WINDOWS)
+	return static_cast<unsigned long long>(_getpid());
+#else
+	return 0;
+#endif
+}
+
+
+// Serialization
+
+class Writer {
+public:
+	void varint(uint64 value) {
+		while (value >= 0x80) {
+			m_bytes.pushBack(static_cast<uint8>(value | 0x80));
+			value >>= 7;
+		}
+
+		m_bytes.pushBack(static_cast<uint8>(value));
+	}
+	void raw(lsd::StringView data) {
+		for (auto c : data)
+			m_bytes.pushBack(static_cast<uint8>(c));
+	}
+	void string(lsd::StringView data) {
+		varint(data.size());
+		raw(data);
+	}
+	void tag(Tag tag) {
+		m_bytes.pushBack(static_cast<uint8>(tag));
+	}
+	void flag(bool value) {
+		m_bytes.pushBack(static_cast<uint8>(value));
+	}
+
+	[[nodiscard]] lsd::Vector<uint8>& bytes() noexcept {
+		return m_bytes;
+	}
+
+private:
+	lsd::Vector<uint8> m_bytes;
+};
+
+class TreeWriter {
+public:
+	TreeWriter(const ast::Module& module, lsd::StringView source) : m_module(module), m_source(source) { }
+
+	void declarations(const lsd::Vector<ast::decl_ptr>& declarations) {
+		m_writer.varint(declarations.size());
+
+		for (const auto& declaration : declarations)
+			statement(declaration.get());
+	}
+
+	void symbols(Writer& writer) const {
+		writer.varint(m_symbols.size());
+
+		for (const auto& symbol : m_symbols)
+			writer.string(symbol);
+	}
+
+	void strings(Writer& writer) const {
+		writer.varint(m_strings.size());
+
+		for (const auto& string : m_strings)
+			writer.string(string);
+	}
+
+	[[nodiscard]] lsd::Vector<uint8>& bytes() noexcept {
+		return m_writer.bytes();
+	}
+
+private:
+	const ast::Module& m_module;
+	lsd::StringView m_source;
+	Writer m_writer;
+
+	size_type m_offset = 0; // Source offset of the previous token
+	size_type m_depth = 0; // Nesting depth of the current expression
+
+	lsd::Vector<lsd::StringView> m_symbols; // Names of the symbols of the module, which are numbered in the order they appear
+	lsd::UnorderedFlatMap<symbol_id, size_type> m_symbolIndices;
+
+	lsd::Vector<lsd::String> m_strings;
+	lsd::UnorderedFlatMap<lsd::String, size_type> m_stringIndices;
+
+	void symbol(const Token& token) {
+		auto found = m_symbolIndices.find(token.symbol());
+		if (found == m_symbolIndices.end()) {
+			found = m_symbolIndices.emplace(token.symbol(), m_symbols.size()).first;
+			m_symbols.pushBack(token.data());
+		}
+
+		m_writer.varint(found->second);
+	}
+
+	void string(lsd::StringView string) {
+		lsd::String key;
+		key.append(string);
+
+		auto found = m_stringIndices.find(key);
+		if (found == m_stringIndices.end()) {
+			found = m_stringIndices.emplace(key, m_strings.size()).first;
+			m_strings.pushBack(std::move(key));
+		}
+
+		m_writer.varint(found->second);
+	}
+
+	void position(lsd::StringView data) {
+		// Tokens the parser made up for missing operators have no data in the source, empty tokens like the literal "" still have a position
+		if (!data.data() || data.data() < m_source.data() || data.data() + data.size() > m_source.data() + m_source.size()) {
+			m_writer.varint(0);
+			return;
+		}
+
+		auto offset = static_cast<size_type>(data.data() - m_source.data());
+
+		// Tokens are mostly written in source order, so the offset relative to the previous one is usually a single byte
+		m_writer.varint(data.size() + 1);
+		m_writer.varint(zigzag(static_cast<int64>(offset) - static_cast<int64>(m_offset)));
+
+		m_offset = offset;
+	}
+
+	void token(const Token& token) {
+		m_writer.varint(static_cast<Token::type_tag>(token.type()));
+		position(token.data());
+
+		switch (token.type()) {
+			case Token::Type::identifier:
+			case Token::Type::attribute:
+				symbol(token);
+				break;
+			case Token::Type::integral:
+				m_writer.varint(zigzag(token.integral()));
+				break;
+			case Token::Type::unsignedIntegral:
+				m_writer.varint(token.unsignedIntegral());
+				break;
+			case Token::Type::floating: {
+				auto bits = std::bit_cast<uint64>(token.floating());
+				for (size_type i = 0; i < 8; i++)
+					m_writer.bytes().pushBack(static_cast<uint8>(bits >> (i * 8)));
+				break;
+			}
+			case Token::Type::character:
+				m_writer.varint(token.character());
+				break;
+			case Token::Type::string:
+				string(m_module.literals().string(token.literal()));
+				break;
+			default:
+				break;
+		}
+	}
+
+	void tokens(const lsd::Vector<Token>& tokens) {
+		m_writer.varint(tokens.size());
+
+		for (const auto& t : tokens)
+			token(t);
+	}
+
+	void type(const ast::detail::TypeIdentifier& type) {
+		token(type.identifier);
+
+		m_writer.varint(type.generics.size());
+		for (const auto& generic : type.generics)
+			this->type(generic);
+
+		m_writer.varint(type.pointerCount);
+	}
+
+	void type(const ast::detail::type_ident_ptr& type) {
+		m_writer.flag(static_cast<bool>(type));
+		if (type) this->type(*type);
+	}
+
+	void identifiers(const lsd::Vector<ast::detail::IdentifierDecl>& identifiers) {
+		m_writer.varint(identifiers.size());
+
+		for (const auto& identifier : identifiers) {
+			token(identifier.identifier);
+			type(identifier.type);
+			expression(identifier.expression.get());
+		}
+	}
+
+	void function(const ast::detail::FunctionConstruct& construct) {
+		identifiers(construct.parameters);
+		type(construct.type);
+	}
+
+	void block(const ast::BlockStmt& block) {
+		m_writer.varint(block.statements().size());
+
+		for (const auto& statement : block.statements())
+			this->statement(statement.get());
+	}
+
+	void expressions(const lsd::Vector<ast::expr_ptr>& expressions) {
+		m_writer.varint(expressions.size());
+
+		for (const auto& expression : expressions)
+			this->expression(expression.get());
+	}
+
+	void expression(const ast::Expression* expression) {
+		if (++m_depth > nestingLimit) throw Exception("Expression is nested too deeply to be cached");
+
+		if (!expression) {
+			m_writer.tag(Tag::null);
+		} else if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression)) {
+			m_writer.tag(Tag::atomicExpr);
+			token(atomic->value());
+		} else if (auto member = dynamic_cast<const ast::MemberExpr*>(expression)) {
+			m_writer.tag(Tag::memberExpr);
+			this->expression(member->value().get());
+
+			m_writer.varint(member->chain().size());
+			for (const auto& element : member->chain()) {
+				m_writer.varint(element.index());
+
+				switch (static_cast<ChainTag>(element.index())) {
+					case ChainTag::call:
+						expressions(std::get<ast::detail::arg_t>(element));
+						break;
+					case ChainTag::subscript:
+						this->expression(std::get<ast::detail::subscript_t>(element).get());
+						break;
+					case ChainTag::member:
+						token(std::get<Token>(element));
+						break;
+				}
+			}
+		} else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression)) {
+			m_writer.tag(Tag::unaryExpr);
+			tokens(unary->prefix());
+			this->expression(unary->expr().get());
+			token(unary->postfix());
+		} else if (auto infix = dynamic_cast<const ast::InfixExpr*>(expression)) {
+			m_writer.tag(Tag::infixExpr);
+			token(infix->op());
+			this->expression(infix->left().get());
+			this->expression(infix->right().get());
+		} else if (auto closure = dynamic_cast<const ast::ClosureExpr*>(expression)) {
+			if (closure->lazy())
+				throw Exception("Closure with a lazily parsed body can't be cached");
+
+			m_writer.tag(Tag::closureExpr);
+			expressions(closure->captures());
+			function(closure->construct());
+			block(closure->body());
+		} else
+			throw Exception("Unknown expression node can't be cached");
+
+		--m_depth;
+	}
+
+	void statement(const ast::Statement* statement) {
+		if (!statement) {
+			m_writer.tag(Tag::null);
+		} else if (dynamic_cast<const ast::NullStmt*>(statement)) {
+			m_writer.tag(Tag::nullStmt);
+		} else if (auto expr = dynamic_cast<const ast::ExprStmt*>(statement)) {
+			m_writer.tag(Tag::exprStmt);
+			expression(expr->expr().get());
+		} else if (auto jump = dynamic_cast<const ast::JumpStmt*>(statement)) {
+			m_writer.tag(Tag::jumpStmt);
+			token(jump->keyword());
+			expression(jump->expr().get());
+		} else if (auto blockStmt = dynamic_cast<const ast::BlockStmt*>(statement)) {
+			m_writer.tag(Tag::blockStmt);
+			block(*blockStmt);
+		} else if (auto ifStmt = dynamic_cast<const ast::IfStmt*>(statement)) {
+			m_writer.tag(Tag::ifStmt);
+			this->statement(ifStmt->construct().init.get());
+			expression(ifStmt->construct().condition.get());
+			this->statement(ifStmt->statement().get());
+			this->statement(ifStmt->elseStatement().get());
+		} else if (auto forStmt = dynamic_cast<const ast::ForStmt*>(statement)) {
+			const auto& construct = forStmt->construct();
+
+			m_writer.tag(Tag::forStmt);
+			this->statement(construct.init.get());
+			m_writer.flag(construct.rangeBased);
+			expression(construct.condition().get());
+			expressions(construct.loop());
+			this->statement(forStmt->statement().get());
+		} else if (auto tryCatch = dynamic_cast<const ast::TryCatchStmt*>(statement)) {
+			m_writer.tag(Tag::tryCatchStmt);
+			this->statement(tryCatch->tryBlock().get());
+
+			m_writer.varint(tryCatch->catchBlocks().size());
+			for (const auto& [catchBlock, construct] : tryCatch->catchBlocks()) {
+				this->statement(catchBlock.get());
+
+				m_writer.flag(static_cast<bool>(construct));
+				if (construct) {
+					token(construct->identifier);
+					type(construct->type);
+				}
+			}
+		} else if (dynamic_cast<const ast::NullDecl*>(statement)) {
+			m_writer.tag(Tag::nullDecl);
+		} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(statement)) {
+			m_writer.tag(Tag::namespaceDecl);
+			token(namespaceDecl->identifier());
+			declarations(namespaceDecl->declarations());
+		} else if (auto import = dynamic_cast<const ast::ImportDecl*>(statement)) {
+			m_writer.tag(Tag::importDecl);
+			tokens(import->modules());
+		} else if (auto variable = dynamic_cast<const ast::VariableDecl*>(statement)) {
+			m_writer.tag(Tag::variableDecl);
+			tokens(variable->attributes().attributes);
+			identifiers(variable->identifiers());
+		} else if (auto function = dynamic_cast<const ast::FunctionDecl*>(statement)) {
+			if (function->lazy())
+				throw Exception("Function with a lazily parsed body can't be cached");
+
+			m_writer.tag(Tag::functionDecl);
+			tokens(function->attributes().attributes);
+			token(function->identifier());
+			this->function(function->construct());
+			block(function->body());
+		} else if (auto classDecl = dynamic_cast<const ast::ClassDecl*>(statement)) {
+			m_writer.tag(Tag::classDecl);
+			tokens(classDecl->attributes().attributes);
+			token(classDecl->identifier());
+			declarations(classDecl->declarations());
+		} else if (auto enumDecl = dynamic_cast<const ast::EnumDecl*>(statement)) {
+			m_writer.tag(Tag::enumDecl);
+			tokens(enumDecl->attributes().attributes);
+			token(enumDecl->identifier());
+			type(enumDecl->type());
+			expressions(enumDecl->values());
+		} else
+			throw Exception("Unknown statement node can't be cached");
+	}
+};
+
+
+// Deserialization
+
+struct MalformedCache { };
+
+class Reader {
+public:
+	Reader(lsd::StringView data) noexcept : m_data(data) { }
+
+	[[nodiscard]] uint64 varint() {
+		uint64 value = 0;
+
+		for (uint32 shift = 0; shift < 64; shift += 7) {
+			auto byte = this->byte();
+			value |= static_cast<uint64>(byte & 0x7F) << shift;
+
+			if ((byte & 0x80) == 0)
+				return value;
+		}
+
+		throw MalformedCache { };
+	}
+	[[nodiscard]] size_type count() {
+		// Every element takes at least one byte, which bounds counts of corrupt files before anything is reserved
+		auto count = varint();
+		if (count > m_data.size() - m_position) throw MalformedCache { };
+
+		return static_cast<size_type>(count);
+	}
+	[[nodiscard]] lsd::StringView raw(size_type size) {
+		if (size > m_data.size() - m_position) throw MalformedCache { };
+
+		lsd::StringView data(m_data.data() + m_position, size);
+		m_position += size;
+
+		return data;
+	}
+	[[nodiscard]] lsd::StringView string() {
+		return raw(count());
+	}
+	[[nodiscard]] uint8 byte() {
+		if (m_position == m_data.size()) throw MalformedCache { };
+
+		return static_cast<uint8>(m_data[m_position++]);
+	}
+	[[nodiscard]] Tag tag() {
+		auto tag = byte();
+		if (tag > static_cast<uint8>(Tag::enumDecl)) throw MalformedCache { };
+
+		return static_cast<Tag>(tag);
+	}
+	[[nodiscard]] bool flag() {
+		return byte() != 0;
+	}
+
+	[[nodiscard]] bool atEnd() const noexcept {
+		return m_position == m_data.size();
+	}
+
+private:
+	lsd::StringView m_data;
+	size_type m_position = 0;
+};
+
+class TreeReader {
+public:
+	TreeReader(Reader& reader, lsd::StringView source, const lsd::Vector<symbol_id>& symbols, ast::Module& module) :
+		m_reader(reader), m_source(source), m_symbols(symbols), m_module(module) {
+		auto count = m_reader.count();
+		m_strings.reserve(count);
+
+		for (size_type i = 0; i < count; i++)
+			m_strings.pushBack(m_reader.string());
+	}
+
+	[[nodiscard]] AstArena& arena() noexcept {
+		return m_arena;
+	}
+
+	template <class Node> void declarations(Node& node) {
+		auto count = m_reader.count();
+
+		for (size_type i = 0; i < count; i++)
+			node.bindDecl(declaration(m_reader.tag()));
+	}
+
+	void moduleDeclarations() {
+		auto count = m_reader.count();
+
+		for (size_type i = 0; i < count; i++)
+			m_module.bindDeclaration(declaration(m_reader.tag()));
+	}
+
+private:
+	Reader& m_reader;
+	lsd::StringView m_source;
+	const lsd::Vector<symbol_id>& m_symbols; // Symbols of the context the symbols of the file were interned as
+	ast::Module& m_module;
+
+	AstArena m_arena;
+	lsd::Vector<lsd::StringView> m_strings;
+
+	size_type m_offset = 0; // Source offset of the previous token
+	size_type m_depth = 0; // Nesting depth of the current expression
+
+	[[nodiscard]] lsd::StringView string() {
+		auto index = m_reader.varint();
+		if (index >= m_strings.size()) throw MalformedCache { };
+
+		return m_strings[static_cast<size_type>(index)];
+	}
+
+	[[nodiscard]] lsd::StringView position() {
+		auto size = m_reader.varint();
+		if (size == 0) return lsd::StringView();
+
+		auto offset = static_cast<int64>(m_offset) + unzigzag(m_reader.varint());
+		if (offset < 0 || static_cast<uint64>(offset) > m_source.size() || size - 1 > m_source.size() - static_cast<uint64>(offset))
+			throw MalformedCache { };
+
+		m_offset = static_cast<size_type>(offset);
+
+		return lsd::StringView(m_source.data() + m_offset, static_cast<size_type>(size - 1));
+	}
+
+	[[nodiscard]] Token token() {
+		auto type = m_reader.varint();
+		if (type > static_cast<Token::type_tag>(Token::Type::attribute)) throw MalformedCache { };
+
+		auto data = position();
+		Token::Value value;
+
+		switch (static_cast<Token::Type>(type)) {
+			case Token::Type::identifier:
+			case Token::Type::attribute: {
+				auto symbol = m_reader.varint();
+				if (symbol >= m_symbols.size()) throw MalformedCache { };
+
+				value.symbol = m_symbols[static_cast<size_type>(symbol)];
+				break;
+			}
+			case Token::Type::integral:
+				value.integral = unzigzag(m_reader.varint());
+				break;
+			case Token::Type::unsignedIntegral:
+				value.unsignedIntegral = m_reader.varint();
+				break;
+			case Token::Type::floating: {
+				uint64 bits = 0;
+				for (size_type i = 0; i < 8; i++)
+					bits |= static_cast<uint64>(m_reader.byte()) << (i * 8);
+
+				value.floating = std::bit_cast<float64>(bits);
+				break;
+			}
+			case Token::Type::character:
+				value.character = static_cast<char32>(m_reader.varint());
+				break;
+			case Token::Type::string:
+				value.literal = m_module.literals().view(string());
+				break;
+			default:
+				break;
+		}
+
+		return Token(static_cast<Token::Type>(type), data, value);
+	}
+
+	[[nodiscard]] lsd::Vector<Token> tokens() {
+		auto count = m_reader.count();
+
+		lsd::Vector<Token> tokens;
+		tokens.reserve(count);
+
+		for (size_type i = 0; i < count; i++)
+			tokens.pushBack(token());
+
+		return tokens;
+	}
+
+	[[nodiscard]] ast::detail::TypeIdentifier typeIdentifier() {
+		ast::detail::TypeIdentifier type;
+		type.identifier = token();
+
+		auto count = m_reader.count();
+		for (size_type i = 0; i < count; i++)
+			type.generics.pushBack(typeIdentifier());
+
+		type.pointerCount = static_cast<size_type>(m_reader.varint());
+
+		return type;
+	}
+
+	[[nodiscard]] ast::detail::type_ident_ptr type() {
+		if (!m_reader.flag()) return nullptr;
+
+		return m_arena.create<ast::detail::TypeIdentifier>(typeIdentifier());
+	}
+
+	[[nodiscard]] ast::detail::param_t identifiers() {
+		auto count = m_reader.count();
+		ast::detail::param_t identifiers;
+
+		for (size_type i = 0; i < count; i++) {
+			auto identifier = token();
+			auto type = this->type();
+
+			identifiers.pushBack(ast::detail::IdentifierDecl { identifier, std::move(type), expression() });
+		}
+
+		return identifiers;
+	}
+
+	[[nodiscard]] ast::detail::Attributes attributes() {
+		return ast::detail::Attributes { tokens() };
+	}
+
+	[[nodiscard]] ast::detail::FunctionConstruct function() {
+		ast::detail::FunctionConstruct construct;
+		construct.parameters = identifiers();
+		construct.type = type();
+
+		return construct;
+	}
+
+	[[nodiscard]] ast::BlockStmt block() {
+		auto count = m_reader.count();
+		ast::BlockStmt block;
+
+		for (size_type i = 0; i < count; i++)
+			block.pushStatement(statement());
+
+		return block;
+	}
+
+	[[nodiscard]] lsd::Vector<ast::expr_ptr> expressions() {
+		auto count = m_reader.count();
+		lsd::Vector<ast::expr_ptr> expressions;
+
+		for (size_type i = 0; i < count; i++)
+			expressions.emplaceBack(expression());
+
+		return expressions;
+	}
+
+	[[nodiscard]] ast::expr_ptr expression() {
+		if (++m_depth > nestingLimit) throw MalformedCache { };
+
+		auto expression = expressionNode();
+		--m_depth;
+
+		return expression;
+	}
+
+	[[nodiscard]] ast::expr_ptr expressionNode() {
+		switch (m_reader.tag()) {
+			case Tag::null:
+				return nullptr;
+
+			case Tag::atomicExpr:
+				return m_arena.create<ast::AtomicExpr>(token());
+
+			case Tag::memberExpr: {
+				auto member = m_arena.create<ast::MemberExpr>(expression());
+
+				auto count = m_reader.count();
+				for (size_type i = 0; i < count; i++) {
+					switch (static_cast<ChainTag>(m_reader.varint())) {
+						case ChainTag::call:
+							member->pushCall(expressions());
+							break;
+						case ChainTag::subscript:
+							member->pushSubscript(expression());
+							break;
+						case ChainTag::member:
+							member->pushMember(token());
+							break;
+						default:
+							throw MalformedCache { };
+					}
+				}
+
+				return member;
+			}
+
+			case Tag::unaryExpr: {
+				auto unary = m_arena.create<ast::UnaryExpr>();
+
+				for (const auto& prefix : tokens())
+					unary->pushPrefix(prefix);
+
+				unary->bindExpr(expression());
+				unary->setPostfix(token());
+
+				return unary;
+			}
+
+			case Tag::infixExpr: {
+				auto op = token();
+				auto infix = m_arena.create<ast::InfixExpr>(op, expression());
+				infix->bindRight(expression());
+
+				return infix;
+			}
+
+			case Tag::closureExpr: {
+				auto closure = m_arena.create<ast::ClosureExpr>();
+
+				for (auto& capture : expressions())
+					closure->bindCaptureExpression(std::move(capture));
+
+				closure->bindConstruct(function());
+				closure->bindBody(block());
+
+				return closure;
+			}
+
+			default:
+				throw MalformedCache { };
+		}
+	}
+
+	[[nodiscard]] ast::stmt_ptr statement() {
+		switch (auto tag = m_reader.tag()) {
+			case Tag::null:
+				return nullptr;
+
+			case Tag::nullStmt:
+				return m_arena.create<ast::NullStmt>();
+
+			case Tag::exprStmt:
+				return m_arena.create<ast::ExprStmt>(expression());
+
+			case Tag::jumpStmt: {
+				auto jump = m_arena.create<ast::JumpStmt>(token());
+				jump->bindExpr(expression());
+
+				return jump;
+			}
+
+			case Tag::blockStmt:
+				return m_arena.create<ast::BlockStmt>(block());
+
+			case Tag::ifStmt: {
+				ast::detail::IfConstruct construct;
+				construct.init = statement();
+				construct.condition = expression();
+
+				auto ifStmt = m_arena.create<ast::IfStmt>(std::move(construct), statement());
+				ifStmt->bindElseStatement(statement());
+
+				return ifStmt;
+			}
+
+			case Tag::forStmt: {
+				ast::detail::ForConstruct construct;
+				construct.init = statement();
+				construct.rangeBased = m_reader.flag();
+				construct.condition() = expression();
+				construct.loop() = expressions();
+
+				return m_arena.create<ast::ForStmt>(std::move(construct), statement());
+			}
+
+			case Tag::tryCatchStmt: {
+				auto tryCatch = m_arena.create<ast::TryCatchStmt>(statement());
+
+				auto count = m_reader.count();
+				for (size_type i = 0; i < count; i++) {
+					auto catchBlock = statement();
+
+					ast::detail::catch_construct_ptr construct;
+					if (m_reader.flag()) {
+						auto identifier = token();
+						construct = m_arena.create<ast::detail::CatchConstruct>(ast::detail::CatchConstruct { identifier, type() });
+					}
+
+					tryCatch->bindCatchBlock(std::move(catchBlock), std::move(construct));
+				}
+
+				return tryCatch;
+			}
+
+			default:
+				return declaration(tag);
+		}
+	}
+
+	[[nodiscard]] ast::decl_ptr declaration(Tag tag) {
+		switch (tag) {
+			case Tag::nullDecl:
+				return m_arena.create<ast::NullDecl>();
+
+			case Tag::namespaceDecl: {
+				auto namespaceDecl = m_arena.create<ast::NamespaceDecl>(token());
+				declarations(*namespaceDecl);
+
+				return namespaceDecl;
+			}
+
+			case Tag::importDecl: {
+				auto import = m_arena.create<ast::ImportDecl>();
+
+				for (const auto& module : tokens())
+					import->bindModule(module);
+
+				return import;
+			}
+
+			case Tag::variableDecl: {
+				auto variable = m_arena.create<ast::VariableDecl>(attributes());
+
+				for (auto& identifier : identifiers())
+					variable->bindDeclaration(std::move(identifier));
+
+				return variable;
+			}
+
+			case Tag::functionDecl: {
+				auto attributes = this->attributes();
+				auto function = m_arena.create<ast::FunctionDecl>(std::move(attributes), token());
+
+				function->bindConstruct(this->function());
+				function->bindBody(block());
+
+				return function;
+			}
+
+			case Tag::classDecl: {
+				auto attributes = this->attributes();
+				auto classDecl = m_arena.create<ast::ClassDecl>(std::move(attributes), token());
+				declarations(*classDecl);
+
+				return classDecl;
+			}
+
+			case Tag::enumDecl: {
+				auto attributes = this->attributes();
+				auto enumDecl = m_arena.create<ast::EnumDecl>(std::move(attributes), token());
+
+				enumDecl->bindType(type());
+				for (auto& value : expressions())
+					enumDecl->bindValue(std::move(value));
+
+				return enumDecl;
+			}
+
+			default:
+				throw MalformedCache { };
+		}
+	}
+};
+
+} // namespace
+
+AstCache::AstCache(Context& context, lsd::StringView directory) : m_context(context) {
+	m_directory.append(directory);
+}
+
+bool AstCache::load(lsd::StringView path, lsd::StringView source, ast::Module& module, std::mutex* symbolsMutex) const {
+	auto cache = cachePath(path, hashSource(source));
+
+	filesys::FileSystem fileSystem;
+	if (!fileSystem.exists(cache)) return false;
+
+	filesys::SourceBuffer storage;
+
+	try {
+		storage = fileSystem.map(cache);
+	} catch (const filesys::FilesystemError&) {
+		return false;
+	}
+
+	if (!deserialize(storage.view(), source, m_context.symbols(), module, symbolsMutex))
+		return false;
+
+	module.bindStorage(std::move(storage));
+
+	return true;
+}
+
+void AstCache::store(lsd::StringView path, lsd::StringView source, const ast::Module& module) const {
+	lsd::Vector<uint8> bytes;
+
+	try {
+		bytes = serialize(module, source);
+	} catch (const Exception&) {
+		return;
+	}
+	auto cache = cachePath(path, hashSource(source));
+
+	std::error_code error;
+	auto directory = std::filesystem::path(cache.begin(), cache.end()).parent_path();
+	if (!directory.empty()) std::filesystem::create_directories(directory, error);
+
+	// Written to a temporary file first so a concurrent load never maps a partially written cache, named after the process and thread writing it
+	char suffix[40];
+	std::snprintf(suffix, sizeof(suffix), ".%llx.%llx", processId(), static_cast<unsigned long long>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+
+	lsd::String temporary(cache);
+	temporary.append(suffix);
+
+	auto file = std::fopen(temporary.data(), "wb");
+	if (!file) return;
+
+	auto written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+
+	if (std::fclose(file) != 0 || !written || std::rename(temporary.data(), cache.data()) != 0)
+		std::remove(temporary.data());
+}
+
+lsd::String AstCache::cachePath(lsd::StringView path, uint64 sourceHash) const {
+	if (m_directory.empty()) {
+		std::filesystem::path cache(path.begin(), path.end());
+		cache.replace_extension(extension.data());
+
+		return lsd::String(cache.string().c_str());
+	}
+
+	char name[17];
+	std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(sourceHash));
+
+	auto cache = std::filesystem::path(m_directory.data()) / name;
+	cache += extension.data();
+
+	return lsd::String(cache.string().c_str());
+}
+
+lsd::Vector<uint8> AstCache::serialize(const ast::Module& module, lsd::StringView source) {
+	TreeWriter tree(module, source);
+	tree.declarations(module.declarations());
+
+	Writer writer;
+
+	writer.raw(lsd::StringView(magic, sizeof(magic)));
+	writer.varint(formatVersion);
+	writer.string(config::version);
+	writer.varint(hashSource(source));
+	writer.varint(source.size());
+
+	tree.symbols(writer);
+	tree.strings(writer);
+
+	for (auto byte : tree.bytes())
+		writer.bytes().pushBack(byte);
+
+	return std::move(writer.bytes());
+}
+
+bool AstCache::deserialize(lsd::StringView data, lsd::StringView source, SymbolTable& symbols, ast::Module& module, std::mutex* symbolsMutex) {
+	try {
+		Reader reader(data);
+
+		if (reader.raw(sizeof(magic)) != lsd::StringView(magic, sizeof(magic)) ||
+			reader.varint() != formatVersion ||
+			reader.string() != lsd::StringView(config::version) ||
+			reader.varint() != hashSource(source) ||
+			reader.varint() != source.size())
+			return false;
+
+		lsd::Vector<lsd::StringView> names;
+		names.resize(reader.count());
+
+		for (auto& name : names)
+			name = reader.string();
+
+		// Interning is the only step touching shared state, the rest of the tree is read without holding the lock
+		lsd::Vector<symbol_id> symbolMap;
+		symbolMap.reserve(names.size());
+
+		{
+			std::unique_lock<std::mutex> lock;
+			if (symbolsMutex) lock = std::unique_lock(*symbolsMutex);
+
+			for (const auto& name : names)
+				symbolMap.pushBack(symbols.intern(name));
+		}
+
+		// The module is only replaced once the whole tree was read, the nodes read until then die with the reader
+		ast::Module loaded;
+
+		TreeReader tree(reader, source, symbolMap, loaded);
+		tree.moduleDeclarations();
+
+		if (!reader.atEnd()) return false;
+
+		loaded.bindArena(std::move(tree.arena()));
+		module = std::move(loaded);
+	} catch (const MalformedCache&) {
+		return false;
+	}
+
+	return true;
+}
+
+uint64 AstCache::hashSource(lsd::StringView source) noexcept {
+	return hashBytes(source);
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,1448 @@
+#include <Elyrium/Compiler/Compiler.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace {
+
+constexpr size_type operandLimit = std::numeric_limits<bytecode::operand_type>::max(); // Also the value of noRegister
+constexpr size_type instructionLimit = std::numeric_limits<int32>::max() / (2 + 3 * sizeof(bytecode::operand_type)); // Jump offsets have to fit into a signed operand
+
+/**
+ * @brief Checks if an integral fits into a wide immediate, larger ones are smaller as constants
+ */
+[[nodiscard]] bool smallIntegral(int64 value) noexcept {
+	return value > std::numeric_limits<int16>::min() && value <= std::numeric_limits<int16>::max(); // Symmetric, so the value can be negated
+}
+
+/**
+ * @brief Returns the value of an integral literal which fits into an immediate operand
+ */
+[[nodiscard]] bool immediateLiteral(const ast::Expression* expression, int32& value) noexcept {
+	auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression);
+
+	if (!atomic || atomic->value().type() != Token::Type::integral || !smallIntegral(atomic->value().integral()))
+		return false;
+
+	value = static_cast<int32>(atomic->value().integral());
+	return true;
+}
+
+[[nodiscard]] bool assignmentOperator(Token::Type type) noexcept {
+	switch (type) {
+		case Token::Type::assign:
+		case Token::Type::kMove:
+		case Token::Type::assignAdd:
+		case Token::Type::assignSub:
+		case Token::Type::assignMul:
+		case Token::Type::assignDiv:
+		case Token::Type::assignMod:
+		case Token::Type::assignShiftLeft:
+		case Token::Type::assignShiftRight:
+		case Token::Type::assignBitXOr:
+		case Token::Type::assignBitNot:
+		case Token::Type::assignBitOr:
+		case Token::Type::assignBitAnd:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief Returns the opcode of a binary operator, or nop if the operator has no instruction of its own
+ */
+[[nodiscard]] Opcode binaryOpcode(Token::Type type) noexcept {
+	switch (type) {
+		case Token::Type::add:
+		case Token::Type::assignAdd:
+			return Opcode::add;
+		case Token::Type::sub:
+		case Token::Type::assignSub:
+			return Opcode::subtract;
+		case Token::Type::mul:
+		case Token::Type::assignMul:
+			return Opcode::multiply;
+		case Token::Type::div:
+		case Token::Type::assignDiv:
+			return Opcode::divide;
+		case Token::Type::mod:
+		case Token::Type::assignMod:
+			return Opcode::modulo;
+		case Token::Type::shiftLeft:
+		case Token::Type::assignShiftLeft:
+			return Opcode::bitShiftLeft;
+		case Token::Type::shiftRight:
+		case Token::Type::assignShiftRight:
+			return Opcode::bitShiftRight;
+		case Token::Type::bitAnd:
+		case Token::Type::assignBitAnd:
+			return Opcode::bitAnd;
+		case Token::Type::bitOr:
+		case Token::Type::assignBitOr:
+			return Opcode::bitOr;
+		case Token::Type::bitXOr:
+		case Token::Type::assignBitXOr:
+			return Opcode::bitXOr;
+		case Token::Type::spaceship:
+			return Opcode::compare;
+
+		default:
+			return Opcode::nop;
+	}
+}
+
+/**
+ * @brief Returns the jump taken if a comparison holds, or if it doesn't hold for when being false
+ */
+[[nodiscard]] Opcode comparisonJump(Token::Type type, bool when) noexcept {
+	switch (type) {
+		case Token::Type::equal:
+			return when ? Opcode::jumpIfEqual : Opcode::jumpIfNotEqual;
+		case Token::Type::notEqual:
+			return when ? Opcode::jumpIfNotEqual : Opcode::jumpIfEqual;
+		case Token::Type::less:
+			return when ? Opcode::jumpIfSmaller : Opcode::jumpIfLargerEqual;
+		case Token::Type::lessEqual:
+			return when ? Opcode::jumpIfSmallerEqual : Opcode::jumpIfLarger;
+		case Token::Type::greater:
+			return when ? Opcode::jumpIfLarger : Opcode::jumpIfSmallerEqual;
+		case Token::Type::greaterEqual:
+			return when ? Opcode::jumpIfLargerEqual : Opcode::jumpIfSmaller;
+
+		default:
+			return Opcode::nop;
+	}
+}
+
+[[nodiscard]] bool incrementOperator(Token::Type type) noexcept {
+	return type == Token::Type::increment || type == Token::Type::decrement;
+}
+
+/**
+ * @brief Returns the number of prefix operators in front of the increments directly in front of the operand
+ */
+[[nodiscard]] size_type outerPrefixes(const lsd::Vector<Token>& prefix) noexcept {
+	auto operators = prefix.size();
+
+	while (operators > 0 && incrementOperator(prefix[operators - 1].type()))
+		--operators;
+
+	return operators;
+}
+
+/**
+ * @brief Returns the sum of the increments and decrements after the first operators prefix operators
+ */
+[[nodiscard]] int32 incrementDelta(const lsd::Vector<Token>& prefix, size_type operators) noexcept {
+	auto delta = int32 { 0 };
+
+	for (; operators < prefix.size(); operators++)
+		delta += (prefix[operators].type() == Token::Type::increment) ? 1 : -1;
+
+	return delta;
+}
+
+[[nodiscard]] bool numeric(Type type) noexcept {
+	return type == Type::integral || type == Type::unsignedIntegral || type == Type::floating;
+}
+
+/**
+ * @brief Returns the type an operation on two operands is specialized for, which is only known if both have the same type
+ */
+[[nodiscard]] Type common(Type left, Type right) noexcept {
+	return (left == right) ? left : Type::unknown;
+}
+
+struct Specialization {
+public:
+	Opcode generic;
+	Opcode specialized[3]; // For signed integrals, unsigned integrals and floating point numbers, nop if there is none
+};
+
+inline constexpr Specialization specializations[] = {
+	{ Opcode::add, { Opcode::addI64, Opcode::addU64, Opcode::addF64 } },
+	{ Opcode::subtract, { Opcode::subtractI64, Opcode::subtractU64, Opcode::subtractF64 } },
+	{ Opcode::multiply, { Opcode::multiplyI64, Opcode::multiplyU64, Opcode::multiplyF64 } },
+	{ Opcode::divide, { Opcode::divideI64, Opcode::divideU64, Opcode::divideF64 } },
+	{ Opcode::modulo, { Opcode::moduloI64, Opcode::moduloU64, Opcode::moduloF64 } },
+	{ Opcode::addImmediate, { Opcode::addImmediateI64, Opcode::addImmediateU64, Opcode::addImmediateF64 } },
+	{ Opcode::negate, { Opcode::negateI64, Opcode::nop, Opcode::negateF64 } },
+	{ Opcode::bitShiftLeft, { Opcode::bitShiftLeftI64, Opcode::bitShiftLeftU64, Opcode::nop } },
+	{ Opcode::bitShiftRight, { Opcode::bitShiftRightI64, Opcode::bitShiftRightU64, Opcode::nop } },
+	{ Opcode::bitNot, { Opcode::bitNotI64, Opcode::bitNotU64, Opcode::nop } },
+	{ Opcode::bitAnd, { Opcode::bitAndI64, Opcode::bitAndU64, Opcode::nop } },
+	{ Opcode::bitOr, { Opcode::bitOrI64, Opcode::bitOrU64, Opcode::nop } },
+	{ Opcode::bitXOr, { Opcode::bitXOrI64, Opcode::bitXOrU64, Opcode::nop } },
+	{ Opcode::compare, { Opcode::compareI64, Opcode::compareU64, Opcode::compareF64 } },
+	{ Opcode::equal, { Opcode::equalI64, Opcode::equalU64, Opcode::equalF64 } },
+	{ Opcode::notEqual, { Opcode::notEqualI64, Opcode::notEqualU64, Opcode::notEqualF64 } },
+	{ Opcode::less, { Opcode::lessI64, Opcode::lessU64, Opcode::lessF64 } },
+	{ Opcode::lessEqual, { Opcode::lessEqualI64, Opcode::lessEqualU64, Opcode::lessEqualF64 } },
+	{ Opcode::jumpIfEqual, { Opcode::jumpIfEqualI64, Opcode::jumpIfEqualU64, Opcode::jumpIfEqualF64 } },
+	{ Opcode::jumpIfNotEqual, { Opcode::jumpIfNotEqualI64, Opcode::jumpIfNotEqualU64, Opcode::jumpIfNotEqualF64 } },
+	{ Opcode::jumpIfLarger, { Opcode::jumpIfLargerI64, Opcode::jumpIfLargerU64, Opcode::jumpIfLargerF64 } },
+	{ Opcode::jumpIfSmaller, { Opcode::jumpIfSmallerI64, Opcode::jumpIfSmallerU64, Opcode::jumpIfSmallerF64 } },
+	{ Opcode::jumpIfLargerEqual, { Opcode::jumpIfLargerEqualI64, Opcode::jumpIfLargerEqualU64, Opcode::jumpIfLargerEqualF64 } },
+	{ Opcode::jumpIfSmallerEqual, { Opcode::jumpIfSmallerEqualI64, Opcode::jumpIfSmallerEqualU64, Opcode::jumpIfSmallerEqualF64 } },
+};
+
+/**
+ * @brief Returns the opcode specialized for operands of a type, or the generic one if the operation isn't specialized for it
+ */
+[[nodiscard]] Opcode specialize(Opcode opcode, Type type) noexcept {
+	if (!numeric(type)) return opcode;
+
+	auto index = static_cast<size_type>(type) - static_cast<size_type>(Type::integral);
+
+	for (const auto& specialization : specializations)
+		if (specialization.generic == opcode && specialization.specialized[index] != Opcode::nop) return specialization.specialized[index];
+
+	return opcode;
+}
+
+} // namespace
+
+Compiler::Compiler(ast::Module& module, lsd::StringView source, lsd::StringView path, OptimizationLevel level) :
+	m_module(&module), m_source(source), m_path(path), m_lines(source), m_level(level) { }
+
+bytecode::Program Compiler::compile() {
+	m_resolution = Resolver(*m_module, m_lines, m_source, m_path).resolve();
+	m_typing = TypeChecker(*m_module, m_resolution, m_lines, m_source, m_path).check();
+	m_program.globals = m_resolution.globals();
+
+	m_program.functions.emplaceBack();
+	m_functions.emplaceBack().function = 0;
+
+	for (const auto& declaration : m_module->declarations())
+		this->declaration(declaration.get());
+
+	emit(Opcode::ret);
+	finishFunction();
+
+	return std::move(m_program);
+}
+
+void Compiler::error(error::Message message) const {
+	throw compileError(m_token, m_source, m_lines, m_path, message);
+}
+
+
+// Emission
+
+size_type Compiler::emit(Opcode opcode, operand_type a, operand_type b, operand_type c) {
+	auto& code = state().code;
+
+	code.pushBack(bytecode::Instruction { opcode, a, b, c });
+	return code.size() - 1;
+}
+
+void Compiler::patch(size_type jump, size_type target) {
+	if (target >= instructionLimit) error(error::Message::functionTooLarge);
+
+	auto& instruction = state().code[jump];
+	const auto& operands = describe(instruction.opcode).operands;
+
+	if (operands[0] == Operand::target) instruction.a = static_cast<operand_type>(target);
+	else if (operands[1] == Operand::target) instruction.b = static_cast<operand_type>(target);
+	else instruction.c = static_cast<operand_type>(target);
+}
+
+void Compiler::patch(const lsd::Vector<size_type>& jumps, size_type target) {
+	for (auto jump : jumps)
+		patch(jump, target);
+}
+
+Compiler::operand_type Compiler::allocate() {
+	auto& state = this->state();
+
+	if (state.free + 1u >= operandLimit) error(error::Message::tooManyRegisters);
+
+	auto reg = state.free++;
+	if (state.free > function().registerCount) function().registerCount = state.free;
+
+	return reg;
+}
+
+Compiler::operand_type Compiler::constant(const bytecode::Constant& constant) {
+	auto& constants = function().constants;
+
+	// Functions only hold a few hundred constants at most, so a linear search is fast enough
+	for (size_type i = 0; i < constants.size(); i++)
+		if (constants[i] == constant) return static_cast<operand_type>(i);
+
+	if (constants.size() >= operandLimit) error(error::Message::tooManyConstants);
+
+	constants.pushBack(constant);
+	return static_cast<operand_type>(constants.size() - 1);
+}
+
+Compiler::operand_type Compiler::symbol(const Token& identifier) {
+	return constant(bytecode::Constant(bytecode::Constant::Type::symbol, identifier.symbol()));
+}
+
+void Compiler::integral(int64 value, Type type, operand_type target) {
+	switch (type) {
+		case Type::unsignedIntegral:
+			emit(Opcode::loadConstant, target, constant(bytecode::Constant(bytecode::Constant::Type::unsignedIntegral, static_cast<uint64>(value))));
+			break;
+		case Type::floating:
+			emit(Opcode::loadConstant, target, constant(bytecode::Constant::fromFloating(static_cast<float64>(value))));
+			break;
+
+		default:
+			if (smallIntegral(value)) emit(Opcode::loadInteger, target, static_cast<operand_type>(value));
+			else emit(Opcode::loadConstant, target, constant(bytecode::Constant::fromIntegral(value)));
+	}
+}
+
+void Compiler::initial(Type type, operand_type target) {
+	if (type == Type::boolean) emit(Opcode::loadFalse, target);
+	else if (numeric(type)) integral(0, type, target);
+	else emit(Opcode::loadNull, target);
+}
+
+void Compiler::check(const void* node, operand_type value) {
+	switch (m_typing.check(node)) {
+		case Type::integral:
+			emit(Opcode::checkI64, value);
+			break;
+		case Type::unsignedIntegral:
+			emit(Opcode::checkU64, value);
+			break;
+		case Type::floating:
+			emit(Opcode::checkF64, value);
+			break;
+		case Type::boolean:
+			emit(Opcode::checkBool, value);
+			break;
+
+		default:
+			break;
+	}
+}
+
+
+// Scopes
+
+void Compiler::declareLocal(const Token& identifier, operand_type reg) {
+	auto& state = this->state();
+	const auto& binding = m_resolution.binding(identifier);
+
+	state.registers[binding.index] = reg;
+	state.locals.pushBack(Local { reg, binding.captured });
+	state.localTop = state.free = reg + 1;
+}
+
+void Compiler::endScope(size_type localCount) {
+	auto& state = this->state();
+
+	close(localCount);
+
+	while (state.locals.size() > localCount)
+		state.locals.popBack();
+
+	state.localTop = state.free = state.locals.empty() ? 0 : state.locals.back().reg + 1;
+}
+
+void Compiler::close(size_type localCount) {
+	const auto& locals = state().locals;
+
+	// Locals are allocated in order of declaration, so the first captured one has the lowest register
+	for (auto local = localCount; local < locals.size(); local++) {
+		if (locals[local].captured) {
+			emit(Opcode::close, locals[local].reg);
+			return;
+		}
+	}
+}
+
+
+// Declarations
+
+template <class Node> size_type Compiler::compileFunction(const Node& node, symbol_id name) {
+	const auto& resolved = m_resolution.function(&node);
+
+	auto index = m_program.functions.size();
+	m_program.functions.emplaceBack().name = name;
+
+	auto& state = m_functions.emplaceBack();
+	state.function = index;
+	state.registers = lsd::Vector<operand_type>(resolved.localCount, noRegister);
+
+	const auto& parameters = node.construct().parameters;
+
+	for (const auto& parameter : parameters) {
+		m_token = parameter.identifier;
+		if (parameter.expression) error(error::Message::unsupportedConstruct); // Default arguments
+
+		auto reg = allocate();
+
+		declareLocal(parameter.identifier, reg);
+		check(&parameter, reg);
+	}
+
+	this->function().parameterCount = static_cast<operand_type>(parameters.size());
+
+	for (const auto& statement : node.body().statements())
+		this->statement(statement.get());
+
+	emit(Opcode::ret);
+
+	// Captured locals are referred to by the register the enclosing function keeps them in
+	const auto& enclosing = m_functions[m_functions.size() - 2];
+
+	for (auto capture : resolved.captures) {
+		if (capture.local) capture.index = enclosing.registers[capture.index];
+		function().captures.pushBack(capture);
+	}
+
+	finishFunction();
+
+	return index;
+}
+
+void Compiler::finishFunction() {
+	if (m_level == OptimizationLevel::none) function().code = bytecode::assemble(state().code);
+	else function().code = bytecode::assemble(optimize(state().code, function(), m_program, m_level));
+	m_functions.popBack();
+}
+
+void Compiler::declaration(ast::Declaration* declaration) {
+	auto mark = state().free;
+
+	if (dynamic_cast<const ast::NullDecl*>(declaration)) {
+	} else if (dynamic_cast<const ast::ImportDecl*>(declaration)) {
+		// Imported modules are loaded and bound by the module loader
+	} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(declaration)) {
+		// Members of namespaces have global slots of their own, so namespaces don't exist at runtime
+		for (const auto& member : namespaceDecl->declarations())
+			this->declaration(member.get());
+	} else if (auto variable = dynamic_cast<const ast::VariableDecl*>(declaration)) {
+		for (const auto& identifier : variable->identifiers()) {
+			m_token = identifier.identifier;
+
+			operand_type value;
+
+			if (identifier.expression) {
+				value = operand(identifier.expression.get());
+			} else {
+				value = allocate();
+				initial(m_typing.type(&identifier), value);
+			}
+
+			check(&identifier, value);
+			emit(Opcode::storeGlobal, m_resolution.binding(identifier.identifier).index, value);
+			state().free = mark;
+		}
+	} else if (auto function = dynamic_cast<const ast::FunctionDecl*>(declaration)) {
+		m_token = function->identifier();
+
+		auto reg = allocate();
+		emit(Opcode::closure, reg, static_cast<operand_type>(compileFunction(*function, function->identifier().symbol())));
+		emit(Opcode::storeGlobal, m_resolution.binding(function->identifier()).index, reg);
+	} else if (auto classDecl = dynamic_cast<const ast::ClassDecl*>(declaration)) {
+		m_token = classDecl->identifier();
+		error(error::Message::unsupportedConstruct);
+	} else if (auto enumDecl = dynamic_cast<const ast::EnumDecl*>(declaration)) {
+		m_token = enumDecl->identifier();
+		error(error::Message::unsupportedConstruct);
+	} else
+		error(error::Message::unsupportedConstruct);
+
+	state().free = mark;
+}
+
+
+// Statements
+
+void Compiler::statement(ast::Statement* statement) {
+	if (dynamic_cast<const ast::NullStmt*>(statement) || dynamic_cast<const ast::NullDecl*>(statement)) {
+	} else if (auto variable = dynamic_cast<const ast::VariableDecl*>(statement)) {
+		variableDeclaration(*variable);
+	} else if (auto expr = dynamic_cast<const ast::ExprStmt*>(statement)) {
+		effect(expr->expr().get());
+	} else if (auto blockStmt = dynamic_cast<const ast::BlockStmt*>(statement)) {
+		block(*blockStmt);
+	} else if (auto ifStmt = dynamic_cast<const ast::IfStmt*>(statement)) {
+		ifStatement(*ifStmt);
+	} else if (auto forStmt = dynamic_cast<const ast::ForStmt*>(statement)) {
+		forStatement(*forStmt);
+	} else if (auto jump = dynamic_cast<const ast::JumpStmt*>(statement)) {
+		jumpStatement(*jump);
+	} else if (auto function = dynamic_cast<const ast::FunctionDecl*>(statement)) {
+		m_token = function->identifier();
+
+		// Declared before the body is compiled, so the function can capture itself
+		auto reg = allocate();
+		declareLocal(function->identifier(), reg);
+
+		emit(Opcode::closure, reg, static_cast<operand_type>(compileFunction(*function, function->identifier().symbol())));
+	} else
+		error(error::Message::unsupportedConstruct);
+
+	// Temporaries only live until the end of their statement
+	state().free = state().localTop;
+}
+
+void Compiler::block(const ast::BlockStmt& block) {
+	auto localCount = state().locals.size();
+
+	for (const auto& statement : block.statements())
+		this->statement(statement.get());
+
+	endScope(localCount);
+}
+
+void Compiler::variableDeclaration(const ast::VariableDecl& declaration) {
+	for (const auto& identifier : declaration.identifiers()) {
+		m_token = identifier.identifier;
+
+		// The local is only declared after its initializer, which still refers to shadowed names
+		auto reg = allocate();
+
+		if (identifier.expression) expression(identifier.expression.get(), reg);
+		else initial(m_typing.type(&identifier), reg);
+
+		check(&identifier, reg);
+		declareLocal(identifier.identifier, reg);
+	}
+}
+
+void Compiler::ifStatement(const ast::IfStmt& statement) {
+	auto localCount = state().locals.size();
+	const auto& construct = statement.construct();
+
+	if (construct.init) this->statement(construct.init.get());
+
+	lsd::Vector<size_type> falseJumps;
+	branch(construct.condition.get(), false, falseJumps);
+	state().free = state().localTop;
+
+	this->statement(statement.statement().get());
+
+	if (statement.elseStatement()) {
+		auto end = emit(Opcode::jump);
+
+		patch(falseJumps, here());
+		this->statement(statement.elseStatement().get());
+		patch(end, here());
+	} else patch(falseJumps, here());
+
+	endScope(localCount);
+}
+
+void Compiler::forStatement(const ast::ForStmt& statement) {
+	auto localCount = state().locals.size();
+	const auto& construct = statement.construct();
+
+	if (construct.rangeBased) error(error::Message::unsupportedConstruct);
+
+	if (construct.init) this->statement(construct.init.get());
+
+	state().loops.emplaceBack().localCount = state().locals.size();
+
+	// The condition is checked at the bottom of the loop, so every iteration only executes a single jump
+	auto entry = size_type { };
+	if (construct.condition()) entry = emit(Opcode::jump);
+
+	auto body = here();
+	this->statement(statement.statement().get());
+
+	patch(state().loops.back().continues, here());
+
+	for (const auto& loop : construct.loop()) {
+		effect(loop.get());
+		state().free = state().localTop;
+	}
+
+	if (construct.condition()) {
+		patch(entry, here());
+
+		lsd::Vector<size_type> trueJumps;
+		branch(construct.condition().get(), true, trueJumps);
+		patch(trueJumps, body);
+	} else patch(emit(Opcode::jump), body);
+
+	patch(state().loops.back().breaks, here());
+	state().loops.popBack();
+
+	endScope(localCount);
+}
+
+void Compiler::jumpStatement(const ast::JumpStmt& statement) {
+	m_token = statement.keyword();
+
+	switch (statement.keyword().type()) {
+		case Token::Type::kReturn:
+			if (statement.expr()) {
+				auto value = operand(statement.expr().get());
+
+				check(&statement, value);
+				emit(Opcode::ret, value, 1);
+			} else emit(Opcode::ret);
+
+			break;
+
+		case Token::Type::kBreak:
+		case Token::Type::kContinue: {
+			if (state().loops.empty()) error(error::Message::jumpOutsideOfLoop);
+
+			// The jump leaves the scopes of the loop body without passing their ends
+			close(state().loops.back().localCount);
+			auto jump = emit(Opcode::jump);
+
+			if (statement.keyword().type() == Token::Type::kBreak) state().loops.back().breaks.pushBack(jump);
+			else state().loops.back().continues.pushBack(jump);
+
+			break;
+		}
+
+		default: // Yielding requires coroutines
+			error(error::Message::unsupportedConstruct);
+	}
+}
+
+
+// Expressions
+
+void Compiler::expression(const ast::Expression* expression, operand_type target) {
+	call(expression, ExpressionFrame::Kind::value, target);
+	evaluate();
+}
+
+Compiler::operand_type Compiler::operand(const ast::Expression* expression) {
+	if (operand_type reg; local(expression, reg)) return reg;
+
+	auto reg = allocate();
+	this->expression(expression, reg);
+
+	return reg;
+}
+
+bool Compiler::local(const ast::Expression* expression, operand_type& reg) {
+	auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression);
+	if (!atomic || atomic->value().type() != Token::Type::identifier) return false;
+
+	const auto& binding = m_resolution.binding(atomic->value());
+	if (binding.kind != Binding::Kind::local) return false;
+
+	reg = state().registers[binding.index];
+	return true;
+}
+
+void Compiler::effect(const ast::Expression* expression) {
+	auto infix = dynamic_cast<const ast::InfixExpr*>(expression);
+
+	if (dynamic_cast<const ast::UnaryExpr*>(expression) || (infix && assignmentOperator(infix->op().type()))) {
+		call(expression, ExpressionFrame::Kind::value, noRegister, false);
+		evaluate();
+	} else {
+		this->expression(expression, allocate());
+	}
+}
+
+void Compiler::branch(const ast::Expression* expression, bool when, lsd::Vector<size_type>& jumps) {
+	auto list = m_jumps.size();
+	m_jumps.emplaceBack();
+
+	callBranch(expression, when, list);
+	evaluate();
+
+	for (auto jump : m_jumps[list]) jumps.pushBack(jump);
+	m_jumps.popBack();
+}
+
+void Compiler::evaluate() {
+	// Closures compile their bodies with another call, whose frames are stacked on top
+	auto bottom = m_frames.size() - 1;
+
+	while (m_frames.size() > bottom) {
+		const auto& frame = m_frames.back();
+		auto expression = frame.expression;
+
+		if (frame.kind == ExpressionFrame::Kind::place) continuePlace();
+		else if (frame.kind == ExpressionFrame::Kind::branch) continueBranch();
+		else if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression)) {
+			this->atomic(*atomic, frame.target);
+			finish();
+		} else if (auto member = dynamic_cast<const ast::MemberExpr*>(expression)) continueMember(*member);
+		else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression)) continueUnary(*unary);
+		else if (auto infix = dynamic_cast<const ast::InfixExpr*>(expression)) continueInfix(*infix);
+		else if (auto closure = dynamic_cast<const ast::ClosureExpr*>(expression)) {
+			// Closures capture the names they use implicitly, explicit captures would have to be copied
+			if (!closure->captures().empty()) error(error::Message::unsupportedConstruct);
+
+			auto target = frame.target;
+			emit(Opcode::closure, target, static_cast<operand_type>(compileFunction(*closure, SymbolTable::none)));
+			finish();
+		} else
+			error(error::Message::unsupportedConstruct);
+	}
+}
+
+void Compiler::call(const ast::Expression* expression, ExpressionFrame::Kind kind, operand_type target, bool restore) {
+	auto& frame = m_frames.emplaceBack();
+
+	frame.expression = expression;
+	frame.kind = kind;
+	frame.restore = restore;
+	frame.target = target;
+	frame.mark = state().free;
+}
+
+void Compiler::callBranch(const ast::Expression* expression, bool when, size_type jumps) {
+	call(expression, ExpressionFrame::Kind::branch, noRegister, false);
+
+	auto& frame = m_frames.back();
+	frame.when = when;
+	frame.jumps = jumps;
+}
+
+bool Compiler::callOperand(const ast::Expression* expression, operand_type& reg) {
+	if (local(expression, reg)) return false;
+
+	reg = allocate();
+	call(expression, ExpressionFrame::Kind::value, reg);
+
+	return true;
+}
+
+void Compiler::finish() {
+	const auto& frame = m_frames.back();
+
+	if (frame.kind == ExpressionFrame::Kind::value && frame.restore) state().free = frame.mark;
+	m_frames.popBack();
+}
+
+void Compiler::finishPlace(const Place& place) {
+	m_place = place;
+	finish();
+}
+
+void Compiler::atomic(const ast::AtomicExpr& expression, operand_type target) {
+	const auto& token = expression.value();
+	m_token = token;
+
+	switch (token.type()) {
+		case Token::Type::identifier:
+			load(variable(token), target);
+			break;
+
+		case Token::Type::kNull:
+			emit(Opcode::loadNull, target);
+			break;
+		case Token::Type::kTrue:
+			emit(Opcode::loadTrue, target);
+			break;
+		case Token::Type::kFalse:
+			emit(Opcode::loadFalse, target);
+			break;
+
+		case Token::Type::integral:
+			integral(token.integral(), m_typing.type(&expression), target);
+			break;
+		case Token::Type::unsignedIntegral:
+			emit(Opcode::loadConstant, target, constant(bytecode::Constant(bytecode::Constant::Type::unsignedIntegral, token.unsignedIntegral())));
+			break;
+		case Token::Type::floating:
+			emit(Opcode::loadConstant, target, constant(bytecode::Constant::fromFloating(token.floating())));
+			break;
+		case Token::Type::character:
+			emit(Opcode::loadConstant, target, constant(bytecode::Constant(bytecode::Constant::Type::character, token.character())));
+			break;
+		case Token::Type::string: {
+			auto literal = m_program.strings.insert(m_module->literals().string(token.literal()));
+			emit(Opcode::loadConstant, target, constant(bytecode::Constant(bytecode::Constant::Type::string, literal)));
+
+			break;
+		}
+
+		default: // This requires classes
+			error(error::Message::unsupportedConstruct);
+	}
+}
+
+void Compiler::continueMember(const ast::MemberExpr& expression) {
+	using Stage = ExpressionFrame::Stage;
+
+	auto& frame = m_frames.back();
+	const auto& chain = expression.chain();
+	auto count = std::min(frame.count, chain.size());
+	auto target = frame.target;
+
+	if (frame.stage == Stage::start) {
+		// A target on top of the temporaries isn't read by the chain, so the chain is evaluated in it instead of in new temporaries
+		frame.inPlace = temporary(target) && target + 1 == state().free;
+		frame.stage = Stage::element;
+
+		if (auto binding = m_resolution.find(&expression)) {
+			// Chains starting with namespaces start at the static member they lead to
+			frame.element = binding->consumed;
+			assert(frame.element <= count && "elyrium::compiler::Compiler::continueMember(): Static member is not part of the compiled chain, aborting!");
+
+			frame.value = (frame.inPlace || frame.element == count) ? target : allocate();
+			emit(Opcode::loadGlobal, frame.value, binding->index);
+		} else if (frame.inPlace && !local(expression.value().get(), frame.value)) {
+			frame.value = target;
+			return call(expression.value().get(), ExpressionFrame::Kind::value, target);
+		} else if (callOperand(expression.value().get(), frame.value)) return;
+	}
+
+	while (true) {
+		if (frame.stage == Stage::argument) {
+			const auto& call = std::get<ast::detail::arg_t>(chain[frame.element]);
+
+			if (frame.argument < call.size()) {
+				auto argument = call[frame.argument++].get();
+				return this->call(argument, ExpressionFrame::Kind::value, allocate());
+			}
+
+			emit(Opcode::call, frame.base, static_cast<operand_type>(call.size() + frame.method));
+			state().free = frame.base + 1;
+
+			frame.value = frame.base;
+			frame.element++;
+			frame.stage = Stage::element;
+		} else if (frame.stage == Stage::subscript) {
+			emit(Opcode::loadIndex, frame.destination, frame.value, frame.right);
+
+			frame.value = frame.destination;
+			frame.element++;
+			frame.stage = Stage::element;
+		}
+
+		if (frame.element >= count) break;
+
+		auto i = frame.element;
+		auto identifier = std::get_if<Token>(&chain[i]);
+		auto method = identifier && i + 1 < count && std::holds_alternative<ast::detail::arg_t>(chain[i + 1]);
+
+		if (method || std::holds_alternative<ast::detail::arg_t>(chain[i])) {
+			// Calls take their arguments from the registers following the called value, so they are placed at the top
+			if (temporary(frame.value) && frame.value + 1 == state().free) frame.base = frame.value;
+			else if (frame.inPlace && target + 1 == state().free) frame.base = target;
+			else frame.base = allocate();
+
+			if (method) {
+				m_token = *identifier;
+
+				emit(Opcode::loadMethod, frame.base, frame.value, symbol(*identifier));
+				if (frame.base + 1 == state().free) allocate();
+
+				frame.element++;
+			} else if (frame.base != frame.value) emit(Opcode::move, frame.base, frame.value);
+
+			frame.method = method;
+			frame.argument = 0;
+			frame.stage = Stage::argument;
+		} else {
+			// Intermediate values are kept out of the target unless it is evaluated in place, since the target may be a local the chain still reads
+			if (i + 1 == count || (frame.inPlace && !temporary(frame.value))) frame.destination = target;
+			else if (temporary(frame.value)) frame.destination = frame.value;
+			else frame.destination = allocate();
+
+			if (identifier) {
+				m_token = *identifier;
+				emit(Opcode::loadMember, frame.destination, frame.value, symbol(*identifier));
+
+				frame.value = frame.destination;
+				frame.element++;
+			} else {
+				frame.stage = Stage::subscript;
+				if (callOperand(std::get<ast::detail::subscript_t>(chain[i]).get(), frame.right)) return;
+			}
+		}
+	}
+
+	if (frame.value != target) emit(Opcode::move, target, frame.value);
+	finish();
+}
+
+void Compiler::continueUnary(const ast::UnaryExpr& expression) {
+	using Stage = ExpressionFrame::Stage;
+
+	auto& frame = m_frames.back();
+	const auto& prefix = expression.prefix();
+	const auto& postfix = expression.postfix();
+	auto target = frame.target;
+
+	// Increments directly in front of the operand are applied to it, the other prefixes to the value after that
+	auto operators = outerPrefixes(prefix);
+
+	operand_type value;
+	Type type;
+
+	switch (frame.stage) {
+		case Stage::start:
+			if (operators != prefix.size()) m_token = prefix[operators];
+
+			if (incrementOperator(postfix.type())) {
+				m_token = postfix;
+
+				if (operators != prefix.size()) error(error::Message::invalidAssignment);
+
+				frame.stage = Stage::value;
+				return call(expression.expr().get(), ExpressionFrame::Kind::place);
+			} else if (operators != prefix.size()) {
+				frame.stage = Stage::place;
+				return call(expression.expr().get(), ExpressionFrame::Kind::place);
+			} else if (operators == 1 && prefix[0].type() == Token::Type::sub && dynamic_cast<const ast::AtomicExpr*>(expression.expr().get())) {
+				// Negative literals are loaded as they are
+				const auto& literal = static_cast<const ast::AtomicExpr*>(expression.expr().get())->value();
+				m_token = literal;
+
+				if (target == noRegister) return finish();
+
+				if (literal.type() == Token::Type::integral) {
+					integral(-literal.integral(), m_typing.type(&expression), target);
+					return finish();
+				} else if (literal.type() == Token::Type::floating) {
+					emit(Opcode::loadConstant, target, constant(bytecode::Constant::fromFloating(-literal.floating())));
+					return finish();
+				}
+			}
+
+			frame.stage = Stage::right;
+			if (callOperand(expression.expr().get(), frame.value)) return;
+
+			[[fallthrough]];
+		case Stage::right:
+			value = frame.value;
+			type = m_typing.type(expression.expr().get());
+
+			break;
+
+		case Stage::value: {
+			auto place = m_place;
+			auto step = static_cast<int32>((postfix.type() == Token::Type::increment) ? 1 : -1);
+
+			if (target == noRegister && operators == 0) {
+				increment(place, step, &expression);
+				return finish();
+			}
+
+			// The value before the increment is the result
+			value = (operators == 0) ? target : allocate();
+			type = numeric(place.type) ? place.type : Type::unknown;
+			load(place, value);
+
+			if (place.kind == Place::Kind::local) {
+				emit(specialize(Opcode::addImmediate, place.type), place.object, place.object, static_cast<operand_type>(step));
+			} else {
+				auto incremented = allocate();
+
+				emit(specialize(Opcode::addImmediate, place.type), incremented, value, static_cast<operand_type>(step));
+				check(&expression, incremented);
+				store(place, incremented);
+			}
+
+			break;
+		}
+
+		default: {
+			auto place = m_place;
+
+			value = increment(place, incrementDelta(prefix, operators), &expression);
+			type = numeric(place.type) ? place.type : Type::unknown;
+
+			break;
+		}
+	}
+
+	for (; operators > 0; operators--) {
+		const auto& op = prefix[operators - 1];
+		m_token = op;
+
+		Opcode opcode;
+
+		switch (op.type()) {
+			case Token::Type::sub:
+				opcode = Opcode::negate;
+				break;
+			case Token::Type::add:
+				opcode = Opcode::positive;
+				break;
+			case Token::Type::bitNot:
+				opcode = Opcode::bitNot;
+				break;
+			case Token::Type::logicNot:
+				opcode = Opcode::logicNot;
+				break;
+
+			case Token::Type::increment:
+			case Token::Type::decrement:
+				error(error::Message::invalidAssignment);
+
+			default: // Pointers and references
+				error(error::Message::unsupportedConstruct);
+		}
+
+		auto destination = (operators == 1 && target != noRegister) ? target : (temporary(value) ? value : allocate());
+
+		if (opcode == Opcode::positive && numeric(type)) {
+			// Numbers are their own positive
+			if (destination != value) emit(Opcode::move, destination, value);
+		} else if (opcode == Opcode::logicNot) {
+			emit(opcode, destination, value);
+			type = Type::boolean;
+		} else {
+			auto specialized = specialize(opcode, type);
+			emit(specialized, destination, value);
+
+			if (specialized == opcode) type = Type::unknown;
+		}
+
+		value = destination;
+	}
+
+	if (target != noRegister && value != target) emit(Opcode::move, target, value);
+	finish();
+}
+
+void Compiler::continueInfix(const ast::InfixExpr& expression) {
+	using Stage = ExpressionFrame::Stage;
+
+	auto& frame = m_frames.back();
+	auto type = expression.op().type();
+	auto left = expression.left().get();
+	auto right = expression.right().get();
+	auto target = frame.target;
+
+	if (frame.stage == Stage::start) m_token = expression.op();
+
+	if (assignmentOperator(type)) {
+		continueAssignment(expression);
+	} else if (type == Token::Type::logicAnd || type == Token::Type::logicOr) {
+		if (frame.stage == Stage::start) {
+			frame.stage = Stage::jump;
+			frame.jumps = m_jumps.size();
+			m_jumps.emplaceBack();
+
+			return callBranch(&expression, false, frame.jumps);
+		}
+
+		emit(Opcode::loadTrue, target);
+		auto end = emit(Opcode::jump);
+
+		patch(m_jumps[frame.jumps], here());
+		emit(Opcode::loadFalse, target);
+		patch(end, here());
+
+		m_jumps.popBack();
+		finish();
+	} else if (comparisonJump(type, true) != Opcode::nop) {
+		switch (frame.stage) {
+			case Stage::start:
+				frame.stage = Stage::left;
+				if (callOperand(left, frame.value)) return;
+
+				[[fallthrough]];
+			case Stage::left:
+				frame.stage = Stage::right;
+				if (callOperand(right, frame.right)) return;
+
+				[[fallthrough]];
+			default:
+				break;
+		}
+
+		auto operands = common(m_typing.type(left), m_typing.type(right));
+
+		// Larger comparisons are smaller comparisons with the operands swapped
+		switch (type) {
+			case Token::Type::equal:
+				emit(specialize(Opcode::equal, operands), target, frame.value, frame.right);
+				break;
+			case Token::Type::notEqual:
+				emit(specialize(Opcode::notEqual, operands), target, frame.value, frame.right);
+				break;
+			case Token::Type::less:
+				emit(specialize(Opcode::less, operands), target, frame.value, frame.right);
+				break;
+			case Token::Type::lessEqual:
+				emit(specialize(Opcode::lessEqual, operands), target, frame.value, frame.right);
+				break;
+			case Token::Type::greater:
+				emit(specialize(Opcode::less, operands), target, frame.right, frame.value);
+				break;
+			default:
+				emit(specialize(Opcode::lessEqual, operands), target, frame.right, frame.value);
+				break;
+		}
+
+		finish();
+	} else if (auto opcode = binaryOpcode(type); opcode != Opcode::nop) {
+		int32 immediate;
+
+		// Addition is commutative, so literals on either side become immediates
+		if (opcode == Opcode::add && immediateLiteral(left, immediate)) {
+			if (frame.stage == Stage::start) {
+				frame.stage = Stage::right;
+				if (callOperand(right, frame.right)) return;
+			}
+
+			auto operands = common(m_typing.type(left), m_typing.type(right));
+			emit(specialize(Opcode::addImmediate, operands), target, frame.right, static_cast<operand_type>(immediate));
+
+			return finish();
+		}
+
+		switch (frame.stage) {
+			case Stage::start:
+				frame.stage = Stage::left;
+				if (callOperand(left, frame.value)) return;
+
+				[[fallthrough]];
+			case Stage::left:
+				if (immediateArithmetic(opcode, target, frame.value, m_typing.type(left), right)) return finish();
+
+				frame.stage = Stage::right;
+				if (callOperand(right, frame.right)) return;
+
+				[[fallthrough]];
+			default:
+				break;
+		}
+
+		emit(specialize(opcode, common(m_typing.type(left), m_typing.type(right))), target, frame.value, frame.right);
+		finish();
+	} else
+		error(error::Message::unsupportedConstruct);
+}
+
+void Compiler::continueAssignment(const ast::InfixExpr& expression) {
+	using Stage = ExpressionFrame::Stage;
+
+	auto& frame = m_frames.back();
+	auto type = expression.op().type();
+	auto opcode = binaryOpcode(type);
+	auto right = expression.right().get();
+	auto target = frame.target;
+
+	switch (frame.stage) {
+		case Stage::start:
+			if (type == Token::Type::assignBitNot) error(error::Message::unsupportedConstruct);
+
+			frame.stage = Stage::place;
+			return call(expression.left().get(), ExpressionFrame::Kind::place);
+
+		case Stage::place:
+			frame.place = m_place;
+			m_token = expression.op();
+
+			if (frame.place.kind == Place::Kind::local) {
+				frame.value = frame.place.object;
+
+				// Locals are written directly, which is safe since every expression only writes its target after reading all operands
+				if (opcode == Opcode::nop) {
+					frame.stage = Stage::value;
+					return call(right, ExpressionFrame::Kind::value, frame.value);
+				}
+			} else if (opcode == Opcode::nop) {
+				frame.stage = Stage::value;
+				if (callOperand(right, frame.value)) return;
+
+				break;
+			} else if (frame.place.value != noRegister) frame.value = frame.place.value;
+			else {
+				frame.value = allocate();
+				load(frame.place, frame.value);
+			}
+
+			if (immediateArithmetic(opcode, frame.value, frame.value, frame.place.type, right)) break;
+
+			frame.stage = Stage::right;
+			if (callOperand(right, frame.right)) return;
+
+			[[fallthrough]];
+		case Stage::right:
+			emit(specialize(opcode, common(frame.place.type, m_typing.type(right))), frame.value, frame.value, frame.right);
+			break;
+
+		default:
+			break;
+	}
+
+	check(&expression, frame.value);
+	if (frame.place.kind != Place::Kind::local) store(frame.place, frame.value);
+
+	if (target != noRegister && frame.value != target) emit(Opcode::move, target, frame.value);
+	finish();
+}
+
+bool Compiler::immediateArithmetic(Opcode opcode, operand_type target, operand_type left, Type type, const ast::Expression* right) {
+	int32 immediate;
+
+	if ((opcode != Opcode::add && opcode != Opcode::subtract) || !immediateLiteral(right, immediate)) return false;
+
+	type = common(type, m_typing.type(right));
+	emit(specialize(Opcode::addImmediate, type), target, left, static_cast<operand_type>((opcode == Opcode::add) ? immediate : -immediate));
+
+	return true;
+}
+
+void Compiler::continuePlace() {
+	using Stage = ExpressionFrame::Stage;
+
+	auto& frame = m_frames.back();
+	auto expression = frame.expression;
+
+	if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression); atomic && atomic->value().type() == Token::Type::identifier) {
+		auto place = variable(atomic->value());
+		place.type = m_typing.type(expression);
+
+		return finishPlace(place);
+	} else if (auto member = dynamic_cast<const ast::MemberExpr*>(expression)) {
+		const auto& chain = member->chain();
+
+		if (frame.stage == Stage::start) {
+			auto binding = m_resolution.find(member);
+
+			if (binding && binding->consumed == chain.size()) return finishPlace(Place { Place::Kind::global, noRegister, binding->index });
+			if (chain.empty() || std::holds_alternative<ast::detail::arg_t>(chain.back())) error(error::Message::invalidAssignment);
+
+			// Everything but the last element of the chain evaluates to the object which is stored into
+			frame.stage = Stage::value;
+
+			if (chain.size() == 1) {
+				if (callOperand(member->value().get(), frame.value)) return;
+			} else {
+				auto object = frame.value = allocate();
+
+				call(member, ExpressionFrame::Kind::value, object, false);
+				m_frames.back().count = chain.size() - 1;
+
+				return;
+			}
+		}
+
+		if (frame.stage == Stage::value) {
+			if (auto identifier = std::get_if<Token>(&chain.back())) {
+				m_token = *identifier;
+				return finishPlace(Place { Place::Kind::member, frame.value, symbol(*identifier) });
+			}
+
+			frame.stage = Stage::subscript;
+			if (callOperand(std::get<ast::detail::subscript_t>(chain.back()).get(), frame.right)) return;
+		}
+
+		return finishPlace(Place { Place::Kind::index, frame.value, frame.right });
+	} else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression); unary && unary->postfix().type() == Token::Type::none) {
+		// Prefix increments result in the incremented place itself
+		if (frame.stage == Stage::start) {
+			for (const auto& op : unary->prefix()) {
+				m_token = op;
+				if (!incrementOperator(op.type())) error(error::Message::invalidAssignment);
+			}
+
+			frame.stage = Stage::place;
+			return call(unary->expr().get(), ExpressionFrame::Kind::place);
+		}
+
+		auto place = m_place;
+		increment(place, incrementDelta(unary->prefix(), 0), unary);
+
+		return finishPlace(place);
+	}
+
+	error(error::Message::invalidAssignment);
+}
+
+void Compiler::continueBranch() {
+	using Stage = ExpressionFrame::Stage;
+
+	auto& frame = m_frames.back();
+	auto expression = frame.expression;
+	auto when = frame.when;
+
+	if (auto infix = dynamic_cast<const ast::InfixExpr*>(expression)) {
+		if (frame.stage == Stage::start) m_token = infix->op();
+
+		auto type = infix->op().type();
+		auto left = infix->left().get();
+		auto right = infix->right().get();
+
+		if (type == Token::Type::logicAnd || type == Token::Type::logicOr) {
+			// Jumps out of a conjunction if an operand is false and out of a disjunction if one is true
+			if (when == (type == Token::Type::logicOr)) {
+				if (frame.stage == Stage::start) {
+					frame.stage = Stage::jump;
+					return callBranch(left, when, frame.jumps);
+				}
+
+				// The right operand jumps to the same targets, so it takes over the frame
+				frame.expression = right;
+				frame.stage = Stage::start;
+				frame.mark = state().free;
+
+				return;
+			}
+
+			switch (frame.stage) {
+				case Stage::start:
+					frame.stage = Stage::skip;
+					frame.skip = m_jumps.size();
+					m_jumps.emplaceBack();
+
+					return callBranch(left, !when, frame.skip);
+				case Stage::skip:
+					frame.stage = Stage::jump;
+					return callBranch(right, when, frame.jumps);
+
+				default:
+					patch(m_jumps[frame.skip], here());
+					m_jumps.popBack();
+
+					return finish();
+			}
+		} else if (auto opcode = comparisonJump(type, when); opcode != Opcode::nop) {
+			switch (frame.stage) {
+				case Stage::start:
+					frame.stage = Stage::left;
+					if (callOperand(left, frame.value)) return;
+
+					[[fallthrough]];
+				case Stage::left:
+					frame.stage = Stage::right;
+					if (callOperand(right, frame.right)) return;
+
+					[[fallthrough]];
+				default:
+					break;
+			}
+
+			m_jumps[frame.jumps].pushBack(emit(specialize(opcode, common(m_typing.type(left), m_typing.type(right))), frame.value, frame.right));
+			state().free = frame.mark;
+
+			return finish();
+		}
+	} else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression)) {
+		const auto& prefix = unary->prefix();
+
+		if (unary->postfix().type() == Token::Type::none && !prefix.empty()) {
+			auto logicNots = size_type { 0 };
+			while (logicNots < prefix.size() && prefix[prefix.size() - 1 - logicNots].type() == Token::Type::logicNot)
+				++logicNots;
+
+			// Negations are folded into the condition
+			if (logicNots == prefix.size()) {
+				frame.expression = unary->expr().get();
+				frame.when = (logicNots % 2 == 0) == when;
+				frame.mark = state().free;
+
+				return;
+			}
+		}
+	} else if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression)) {
+		auto type = atomic->value().type();
+
+		if (type == Token::Type::kTrue || type == Token::Type::kFalse) {
+			if ((type == Token::Type::kTrue) == when) m_jumps[frame.jumps].pushBack(emit(Opcode::jump));
+			return finish();
+		}
+	}
+
+	if (frame.stage == Stage::start) {
+		frame.stage = Stage::value;
+		if (callOperand(expression, frame.value)) return;
+	}
+
+	m_jumps[frame.jumps].pushBack(emit(when ? Opcode::jumpIfTrue : Opcode::jumpIfFalse, frame.value));
+	state().free = frame.mark;
+
+	finish();
+}
+
+Compiler::Place Compiler::variable(const Token& identifier) {
+	m_token = identifier;
+
+	const auto& binding = m_resolution.binding(identifier);
+
+	switch (binding.kind) {
+		case Binding::Kind::local:
+			return Place { Place::Kind::local, state().registers[binding.index] };
+		case Binding::Kind::upvalue:
+			return Place { Place::Kind::upvalue, noRegister, binding.index };
+
+		default:
+			return Place { Place::Kind::global, noRegister, binding.index };
+	}
+}
+
+void Compiler::load(const Place& place, operand_type target) {
+	switch (place.kind) {
+		case Place::Kind::local:
+			if (place.object != target) emit(Opcode::move, target, place.object);
+			break;
+
+		case Place::Kind::upvalue:
+			emit(Opcode::loadUpvalue, target, place.key);
+			break;
+
+		case Place::Kind::global:
+			emit(Opcode::loadGlobal, target, place.key);
+			break;
+
+		case Place::Kind::member:
+			emit(Opcode::loadMember, target, place.object, place.key);
+			break;
+
+		case Place::Kind::index:
+			emit(Opcode::loadIndex, target, place.object, place.key);
+			break;
+	}
+}
+
+void Compiler::store(const Place& place, operand_type value) {
+	switch (place.kind) {
+		case Place::Kind::local:
+			if (place.object != value) emit(Opcode::move, place.object, value);
+			break;
+
+		case Place::Kind::upvalue:
+			emit(Opcode::storeUpvalue, place.key, value);
+			break;
+
+		case Place::Kind::global:
+			emit(Opcode::storeGlobal, place.key, value);
+			break;
+
+		case Place::Kind::member:
+			emit(Opcode::storeMember, place.object, place.key, value);
+			break;
+
+		case Place::Kind::index:
+			emit(Opcode::storeIndex, place.object, place.key, value);
+			break;
+	}
+}
+
+Compiler::operand_type Compiler::increment(Place& place, int32 delta, const void* node) {
+	auto opcode = specialize(Opcode::addImmediate, place.type);
+
+	if (place.kind == Place::Kind::local) {
+		emit(opcode, place.object, place.object, static_cast<operand_type>(delta));
+		return place.object;
+	}
+
+	if (place.value == noRegister) {
+		place.value = allocate();
+		load(place, place.value);
+	}
+
+	emit(opcode, place.value, place.value, static_cast<operand_type>(delta));
+	check(node, place.value);
+	store(place, place.value);
+
+	return place.value;
+}
+
+} // namespace compiler
+
+} // namespace elyrium
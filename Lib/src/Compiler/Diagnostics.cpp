@@ -0,0 +1,37 @@
+#include <Elyrium/Compiler/Diagnostics.hpp>
+
+#include <algorithm>
+
+namespace elyrium {
+
+namespace compiler {
+
+void Diagnostics::sort() {
+	std::stable_sort(m_diagnostics.begin(), m_diagnostics.end(), [](const Diagnostic& a, const Diagnostic& b) { return a.offset < b.offset; });
+}
+
+lsd::String Diagnostics::format(const Diagnostic& diagnostic) const {
+	return exception(diagnostic).what();
+}
+
+lsd::String Diagnostics::format() const {
+	lsd::String result;
+
+	for (const auto& diagnostic : m_diagnostics)
+		result.append(format(diagnostic));
+
+	return result;
+}
+
+SyntaxError Diagnostics::exception(const Diagnostic& diagnostic) const {
+	size_type additionalSpaces { };
+
+	auto source = m_lines.lineSource(diagnostic.offset, additionalSpaces);
+	auto location = m_lines.location(diagnostic.offset);
+
+	return SyntaxError(m_path, location.line, location.column + additionalSpaces, source, diagnostic.message, diagnostic.expected);
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,470 @@
+#include <Elyrium/Compiler/FlatAST.hpp>
+
+#include <cstdio>
+
+#define ELYRIUM_PRINT_INDENT(indent) for (auto i = 0; i < indent; i++) std::printf("    ")
+#define ELYRIUM_PRINT_INDENTED_AST(format, indent, ...) \
+ELYRIUM_PRINT_INDENT(indent); \
+std::printf(format __VA_OPT__(,) __VA_ARGS__)
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace ast {
+
+node_index FlatModule::pushNode(NodeKind kind, token_index token, node_index lhs, node_index rhs) {
+	m_kinds.pushBack(kind);
+	m_tokens.pushBack(token);
+	m_lhs.pushBack(lhs);
+	m_rhs.pushBack(rhs);
+
+	return static_cast<node_index>(m_kinds.size() - 1);
+}
+
+node_index FlatModule::pushList(const node_index* first, size_type count) {
+	if (count == 0)
+		return emptyList;
+
+	auto offset = static_cast<node_index>(m_extra.size());
+
+	m_extra.resize(offset + count + 1);
+	m_extra[offset] = static_cast<node_index>(count);
+	for (size_type i = 0; i < count; i++)
+		m_extra[offset + 1 + i] = first[i];
+
+	return offset;
+}
+
+node_index FlatModule::pushRecord(std::initializer_list<node_index> fields) {
+	auto offset = static_cast<node_index>(m_extra.size());
+
+	for (auto field : fields)
+		m_extra.pushBack(field);
+
+	return offset;
+}
+
+void FlatModule::print() const {
+	for (auto decl : m_declarations)
+		printNode(decl, 0);
+}
+
+void FlatModule::printNode(node_index node, int level) const {
+	// Mirrors the print functions of the pointer based nodes, so both trees of a module print identically
+
+	auto text = [this](token_index token) {
+		return (token == none) ? lsd::StringView() : m_tokenBuffer.data(token);
+	};
+	auto type = [this](token_index token) {
+		return static_cast<size_type>((token == none) ? Token::Type::none : m_tokenBuffer.type(token));
+	};
+
+	auto token = m_tokens[node];
+	auto lhs = m_lhs[node];
+	auto rhs = m_rhs[node];
+
+	switch (m_kinds[node]) {
+		// Expressions
+
+		case NodeKind::atomicExpr:
+			std::printf("Atomic expression: [ %.*s | %zu ]\n", static_cast<int>(text(token).size()), text(token).data(), type(token));
+
+			break;
+
+		case NodeKind::memberExpr: {
+			std::printf("Member expression:\n");
+
+			++level;
+			ELYRIUM_PRINT_INDENTED_AST("Base expression -> ", level);
+			printNode(lhs, level);
+
+			for (auto chain : list(rhs)) {
+				auto currLevel = level;
+
+				if (m_kinds[chain] == NodeKind::callChain) {
+					++currLevel;
+					ELYRIUM_PRINT_INDENTED_AST("Function call", currLevel);
+
+					if (auto arguments = list(m_lhs[chain]); !arguments.empty()) {
+						std::printf(" arguments:\n");
+						++currLevel;
+
+						for (auto arg : arguments) {
+							ELYRIUM_PRINT_INDENT(currLevel);
+							printNode(arg, currLevel);
+						}
+					} else std::putchar('\n');
+				} else if (m_kinds[chain] == NodeKind::subscriptChain) {
+					++currLevel;
+					ELYRIUM_PRINT_INDENTED_AST("Subscript index -> ", currLevel);
+					printNode(m_lhs[chain], currLevel);
+				} else {
+					auto member = text(m_tokens[chain]);
+					ELYRIUM_PRINT_INDENTED_AST("Class member: %.*s\n", currLevel, static_cast<int>(member.size()), member.data());
+				}
+			}
+
+			break;
+		}
+
+		case NodeKind::unaryExpr:
+			std::printf("Unary expression:\n");
+
+			++level;
+			for (auto op : list(rhs)) {
+				ELYRIUM_PRINT_INDENTED_AST("Prefix operator: [ %.*s | %zu ]\n", level, static_cast<int>(text(op).size()), text(op).data(), type(op));
+			}
+
+			ELYRIUM_PRINT_INDENT(level);
+			printNode(lhs, level);
+
+			if (token != none) {
+				ELYRIUM_PRINT_INDENTED_AST("Postfix operator: [ %.*s | %zu ]\n", level, static_cast<int>(text(token).size()), text(token).data(), type(token));
+			}
+
+			break;
+
+		case NodeKind::infixExpr:
+			std::printf("Infix expression:\n");
+
+			++level;
+			ELYRIUM_PRINT_INDENTED_AST("Operator: [ %.*s | %zu ]\n", level, static_cast<int>(text(token).size()), text(token).data(), type(token));
+			ELYRIUM_PRINT_INDENTED_AST("Left expression -> ", level);
+			printNode(lhs, level);
+			ELYRIUM_PRINT_INDENTED_AST("Right expression -> ", level);
+			printNode(rhs, level);
+
+			break;
+
+		case NodeKind::closureExpr:
+			std::printf("Closure expression:\n");
+
+			++level;
+			if (auto captures = list(lhs); !captures.empty()) {
+				ELYRIUM_PRINT_INDENTED_AST("Captures:\n", level);
+				for (auto capture : captures) {
+					ELYRIUM_PRINT_INDENT(level + 1);
+					printNode(capture, level + 1);
+				}
+			}
+
+			printFunction(rhs, level);
+
+			ELYRIUM_PRINT_INDENTED_AST("Closure body -> ", level);
+			printNode(field(rhs, 2), level);
+
+			break;
+
+		case NodeKind::callChain:
+		case NodeKind::subscriptChain:
+		case NodeKind::memberChain:
+			assert(false && "elyrium::compiler::ast::FlatModule::printNode(): Member chain elements are printed by their member expression, aborting!");
+
+			break;
+
+
+		// Statements
+
+		case NodeKind::nullStmt:
+			std::printf("Null-statement\n");
+
+			break;
+
+		case NodeKind::exprStmt:
+			std::printf("Expression statement -> ");
+			printNode(lhs, level);
+
+			break;
+
+		case NodeKind::jumpStmt:
+			std::printf("Jump statement [ %.*s | %zu ]", static_cast<int>(text(token).size()), text(token).data(), type(token));
+
+			if (lhs != none) {
+				std::printf(" -> ");
+				printNode(lhs, level);
+			} else std::printf("\n");
+
+			break;
+
+		case NodeKind::blockStmt:
+			std::printf("Block statement:\n");
+
+			++level;
+			for (auto stmt : list(lhs)) {
+				ELYRIUM_PRINT_INDENT(level);
+				printNode(stmt, level);
+			}
+
+			break;
+
+		case NodeKind::ifStmt:
+			std::printf("If statement:\n");
+
+			++level;
+			if (auto init = field(lhs, 0); init != none) {
+				ELYRIUM_PRINT_INDENTED_AST("Init statement -> ", level);
+				printNode(init, level);
+			}
+
+			ELYRIUM_PRINT_INDENTED_AST("Condition -> ", level);
+			printNode(field(lhs, 1), level);
+
+			ELYRIUM_PRINT_INDENTED_AST("Statement -> ", level);
+			printNode(field(lhs, 2), level);
+
+			if (rhs != none) {
+				--level;
+				ELYRIUM_PRINT_INDENTED_AST("Else-Statement -> ", level);
+				printNode(rhs, level);
+			}
+
+			break;
+
+		case NodeKind::forStmt: {
+			std::printf("For statement:\n");
+
+			++level;
+			auto constructLevel = level;
+
+			if (auto init = field(lhs, 0); init != none) {
+				ELYRIUM_PRINT_INDENTED_AST("Init statement -> ", constructLevel);
+				printNode(init, constructLevel);
+			}
+
+			auto conditionOrRange = field(lhs, 1);
+			auto loopOrItems = list(field(lhs, 2));
+
+			if (field(lhs, 3)) {
+				if (!loopOrItems.empty()) {
+					ELYRIUM_PRINT_INDENTED_AST("Items:\n", constructLevel);
+
+					++constructLevel;
+					for (auto item : loopOrItems) {
+						ELYRIUM_PRINT_INDENT(constructLevel);
+						printNode(item, constructLevel);
+					}
+					--constructLevel;
+				}
+
+				ELYRIUM_PRINT_INDENTED_AST("Range -> ", constructLevel);
+				printNode(conditionOrRange, constructLevel);
+			} else {
+				if (conditionOrRange != none) {
+					ELYRIUM_PRINT_INDENTED_AST("Condition -> ", constructLevel);
+					printNode(conditionOrRange, constructLevel);
+				}
+
+				if (!loopOrItems.empty()) {
+					ELYRIUM_PRINT_INDENTED_AST("Loop expression:\n", constructLevel);
+
+					++constructLevel;
+					for (auto loop : loopOrItems) {
+						ELYRIUM_PRINT_INDENT(constructLevel);
+						printNode(loop, constructLevel);
+					}
+				}
+			}
+
+			ELYRIUM_PRINT_INDENTED_AST("Statement -> ", level);
+			printNode(rhs, level);
+
+			break;
+		}
+
+		case NodeKind::tryCatchStmt:
+			std::printf("Try-catch statement:\n");
+
+			++level;
+			ELYRIUM_PRINT_INDENTED_AST("Try-block -> ", level);
+			printNode(lhs, level);
+
+			ELYRIUM_PRINT_INDENTED_AST("Catch-blocks:\n", level);
+
+			++level;
+			for (auto clause : list(rhs)) {
+				if (auto identifier = m_tokens[clause]; identifier != none) {
+					ELYRIUM_PRINT_INDENTED_AST("Catched exception:", level);
+					ELYRIUM_PRINT_INDENTED_AST("Identifier -> %.*s\n", level + 1, static_cast<int>(text(identifier).size()), text(identifier).data());
+
+					if (m_lhs[clause] != none) printTypeIdentifier(m_lhs[clause], level + 1);
+				}
+
+				ELYRIUM_PRINT_INDENTED_AST("Statement -> ", level);
+				printNode(m_rhs[clause], level);
+			}
+
+			break;
+
+		case NodeKind::catchClause:
+			assert(false && "elyrium::compiler::ast::FlatModule::printNode(): Catch clauses are printed by their try-catch statement, aborting!");
+
+			break;
+
+
+		// Declarations
+
+		case NodeKind::nullDecl:
+			std::printf("Null declaration\n");
+
+			break;
+
+		case NodeKind::namespaceDecl:
+			std::printf("Namespace declaration -> %.*s:\n", static_cast<int>(text(token).size()), text(token).data());
+
+			++level;
+			for (auto decl : list(lhs)) {
+				ELYRIUM_PRINT_INDENT(level);
+				printNode(decl, level);
+			}
+
+			break;
+
+		case NodeKind::importDecl:
+			std::printf("Import declaration:\n");
+
+			++level;
+			for (auto module : list(lhs)) {
+				ELYRIUM_PRINT_INDENTED_AST("Module name ", level);
+
+				if (m_tokenBuffer.type(module) == Token::Type::string)
+					std::printf("(string) -> \"%.*s\"\n", static_cast<int>(text(module).size()), text(module).data());
+				else std::printf("(variable) -> %.*s\n", static_cast<int>(text(module).size()), text(module).data());
+			}
+
+			break;
+
+		case NodeKind::variableDecl:
+			std::printf("Variable declaration:\n");
+
+			++level;
+			printAttributes(lhs, level);
+
+			for (auto decl : list(rhs))
+				printIdentifierDecl(decl, level);
+
+			break;
+
+		case NodeKind::functionDecl:
+			std::printf("Function declaration -> %.*s:\n", static_cast<int>(text(token).size()), text(token).data());
+
+			++level;
+			printAttributes(lhs, level);
+			printFunction(rhs, level);
+
+			ELYRIUM_PRINT_INDENTED_AST("Function body -> ", level);
+			printNode(field(rhs, 2), level);
+
+			break;
+
+		case NodeKind::classDecl:
+			std::printf("Class declaration -> %.*s:\n", static_cast<int>(text(token).size()), text(token).data());
+
+			++level;
+			printAttributes(lhs, level);
+
+			ELYRIUM_PRINT_INDENTED_AST("Declarations:\n", level);
+
+			++level;
+			for (auto decl : list(rhs)) {
+				ELYRIUM_PRINT_INDENT(level);
+				printNode(decl, level);
+			}
+
+			break;
+
+		case NodeKind::enumDecl:
+			std::printf("Enum declaration -> %.*s:\n", static_cast<int>(text(token).size()), text(token).data());
+
+			++level;
+			printAttributes(lhs, level);
+			if (field(rhs, 0) != none) printTypeIdentifier(field(rhs, 0), level);
+
+			ELYRIUM_PRINT_INDENTED_AST("Values:\n", level);
+
+			++level;
+			for (auto value : list(field(rhs, 1))) {
+				ELYRIUM_PRINT_INDENT(level);
+				printNode(value, level);
+			}
+
+			break;
+
+
+		// Utility nodes
+
+		case NodeKind::typeIdentifier:
+			printTypeIdentifier(node, level);
+
+			break;
+
+		case NodeKind::identifierDecl:
+			printIdentifierDecl(node, level);
+
+			break;
+	}
+}
+
+void FlatModule::printAttributes(node_index attributes, int level) const {
+	if (auto tokens = list(attributes); !tokens.empty()) {
+		ELYRIUM_PRINT_INDENTED_AST("Attributes -> ", level);
+
+		for (size_type i = 0; i < tokens.size(); i++) {
+			auto attr = m_tokenBuffer.data(tokens[i]);
+			std::printf("%.*s", static_cast<int>(attr.size()), attr.data());
+
+			if (i != tokens.size() - 1)
+				std::putchar(',');
+		}
+
+		std::putchar('\n');
+	}
+}
+
+void FlatModule::printFunction(node_index record, int level) const {
+	if (auto parameters = list(field(record, 0)); !parameters.empty()) {
+		ELYRIUM_PRINT_INDENTED_AST("Parameters:\n", level);
+		for (auto param : parameters)
+			printIdentifierDecl(param, level + 1);
+	}
+
+	if (field(record, 1) != none) printTypeIdentifier(field(record, 1), level);
+}
+
+void FlatModule::printTypeIdentifier(node_index node, int level) const {
+	auto identifier = (m_tokens[node] == none) ? lsd::StringView() : m_tokenBuffer.data(m_tokens[node]);
+	ELYRIUM_PRINT_INDENTED_AST("Type -> %.*s", level, static_cast<int>(identifier.size()), identifier.data());
+
+	if (m_lhs[node] > 0)
+		std::printf(" | Pointer indirection count -> %zu", static_cast<size_type>(m_lhs[node]));
+
+	if (auto generics = list(m_rhs[node]); !generics.empty()) {
+		++level;
+		std::printf(" | Generics:\n");
+
+		for (auto generic : generics)
+			printTypeIdentifier(generic, level);
+	} else std::printf("\n");
+}
+
+void FlatModule::printIdentifierDecl(node_index node, int level) const {
+	ELYRIUM_PRINT_INDENTED_AST("Identifier declaration:\n", level);
+	++level;
+
+	auto identifier = m_tokenBuffer.data(m_tokens[node]);
+	ELYRIUM_PRINT_INDENTED_AST("Identifier -> %.*s\n", level, static_cast<int>(identifier.size()), identifier.data());
+
+	if (m_lhs[node] != none)
+		printTypeIdentifier(m_lhs[node], level);
+
+	if (m_rhs[node] != none) {
+		ELYRIUM_PRINT_INDENTED_AST("Expression -> ", level);
+		printNode(m_rhs[node], level);
+	}
+}
+
+} // namespace ast
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,897 @@
+#include <Elyrium/Compiler/IR.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace ir {
+
+namespace {
+
+constexpr operand_type noRegister = ~operand_type { 0 };
+constexpr size_type noField = 3;
+
+/**
+ * @brief Register operands of an instruction as indices of its operand fields
+ *
+ * @note Calls, loadMethod and ret don't fit into this, so they are handled separately.
+ */
+struct Fields {
+public:
+	size_type written = noField;
+	size_type read[3] = { };
+	size_type readCount = 0;
+};
+
+[[nodiscard]] Fields fields(Opcode opcode) noexcept {
+	Fields fields;
+	const auto& info = describe(opcode);
+
+	auto writes = true;
+
+	switch (opcode) {
+		case Opcode::storeGlobal:
+		case Opcode::storeUpvalue:
+		case Opcode::storeMember:
+		case Opcode::storeIndex:
+		case Opcode::jumpIfEqual:
+		case Opcode::jumpIfNotEqual:
+		case Opcode::jumpIfLarger:
+		case Opcode::jumpIfSmaller:
+		case Opcode::jumpIfLargerEqual:
+		case Opcode::jumpIfSmallerEqual:
+		case Opcode::jumpIfTrue:
+		case Opcode::jumpIfFalse:
+		case Opcode::checkI64:
+		case Opcode::checkU64:
+		case Opcode::checkF64:
+		case Opcode::checkBool:
+		case Opcode::jumpIfEqualI64:
+		case Opcode::jumpIfNotEqualI64:
+		case Opcode::jumpIfLargerI64:
+		case Opcode::jumpIfSmallerI64:
+		case Opcode::jumpIfLargerEqualI64:
+		case Opcode::jumpIfSmallerEqualI64:
+		case Opcode::jumpIfEqualU64:
+		case Opcode::jumpIfNotEqualU64:
+		case Opcode::jumpIfLargerU64:
+		case Opcode::jumpIfSmallerU64:
+		case Opcode::jumpIfLargerEqualU64:
+		case Opcode::jumpIfSmallerEqualU64:
+		case Opcode::jumpIfEqualF64:
+		case Opcode::jumpIfNotEqualF64:
+		case Opcode::jumpIfLargerF64:
+		case Opcode::jumpIfSmallerF64:
+		case Opcode::jumpIfLargerEqualF64:
+		case Opcode::jumpIfSmallerEqualF64:
+			writes = false;
+			break;
+
+		case Opcode::close: // The operand is the first register to close, which isn't read
+			return fields;
+
+		default:
+			break;
+	}
+
+	for (size_type i = 0; i < 3; i++) {
+		if (info.operands[i] != Operand::reg) continue;
+
+		if (writes && fields.written == noField) fields.written = i;
+		else fields.read[fields.readCount++] = i;
+	}
+
+	return fields;
+}
+
+[[nodiscard]] operand_type& field(bytecode::Instruction& instruction, size_type index) noexcept {
+	return (index == 0) ? instruction.a : ((index == 1) ? instruction.b : instruction.c);
+}
+
+[[nodiscard]] operand_type field(const bytecode::Instruction& instruction, size_type index) noexcept {
+	return (index == 0) ? instruction.a : ((index == 1) ? instruction.b : instruction.c);
+}
+
+[[nodiscard]] size_type targetField(Opcode opcode) noexcept {
+	const auto& operands = describe(opcode).operands;
+
+	for (size_type i = 0; i < 3; i++)
+		if (operands[i] == Operand::target) return i;
+
+	return noField;
+}
+
+/**
+ * @brief Splits an instruction into the registers it reads and writes, which are renamed to values afterwards
+ */
+Instruction split(const bytecode::Instruction& code) {
+	Instruction instruction;
+	instruction.code = code;
+
+	switch (code.opcode) {
+		case Opcode::call:
+			for (operand_type i = 0; i <= code.b; i++)
+				instruction.operands.pushBack(code.a + i);
+
+			instruction.results[0] = code.a;
+			break;
+
+		case Opcode::loadMethod:
+			instruction.operands.pushBack(code.b);
+
+			instruction.results[0] = code.a;
+			instruction.results[1] = code.a + 1;
+			break;
+
+		case Opcode::ret:
+			if (code.b == 1) instruction.operands.pushBack(code.a);
+			break;
+
+		default: {
+			auto fields = ir::fields(code.opcode);
+
+			for (size_type i = 0; i < fields.readCount; i++)
+				instruction.operands.pushBack(field(instruction.code, fields.read[i]));
+
+			if (fields.written != noField) instruction.results[0] = field(instruction.code, fields.written);
+		}
+	}
+
+	return instruction;
+}
+
+struct Copy {
+public:
+	operand_type destination;
+	operand_type source;
+};
+
+/**
+ * @brief Emits copies which happen at the same time, so a copy is only emitted once no other one reads its destination
+ */
+void emitCopies(Function& function, lsd::Vector<bytecode::Instruction>& code, lsd::Vector<Copy>& copies, operand_type& scratch) {
+	while (!copies.empty()) {
+		auto emitted = false;
+
+		for (size_type i = 0; i < copies.size() && !emitted; i++) {
+			auto blocked = false;
+
+			for (size_type j = 0; j < copies.size() && !blocked; j++)
+				blocked = j != i && copies[j].source == copies[i].destination;
+
+			if (blocked) continue;
+
+			code.pushBack(bytecode::Instruction { Opcode::move, copies[i].destination, copies[i].source });
+
+			copies[i] = copies.back();
+			copies.popBack();
+
+			emitted = true;
+		}
+
+		if (!emitted) {
+			// Every remaining copy is part of a cycle, which is broken by saving one of the destinations first
+			if (scratch == noRegister) scratch = function.addRegister();
+
+			auto saved = copies[0].destination;
+			code.pushBack(bytecode::Instruction { Opcode::move, scratch, saved });
+
+			for (auto& copy : copies)
+				if (copy.source == saved) copy.source = scratch;
+		}
+	}
+}
+
+void addCopy(lsd::Vector<Copy>& copies, operand_type destination, operand_type source) {
+	if (destination != source) copies.pushBack(Copy { destination, source });
+}
+
+} // namespace
+
+Traits traits(Opcode opcode) noexcept {
+	Traits traits;
+
+	switch (opcode) {
+		case Opcode::nop:
+		case Opcode::wide:
+		case Opcode::extraWide:
+		case Opcode::closure: // Creates a new closure every time, so equal closures still aren't the same value
+			break;
+
+		case Opcode::move:
+		case Opcode::loadConstant:
+		case Opcode::loadInteger:
+		case Opcode::loadNull:
+		case Opcode::loadTrue:
+		case Opcode::loadFalse:
+			traits.pure = true;
+			break;
+
+		case Opcode::loadGlobal:
+		case Opcode::loadUpvalue:
+			traits.reads = true;
+			break;
+		case Opcode::loadMember:
+		case Opcode::loadIndex:
+		case Opcode::loadMethod:
+			traits.reads = traits.throws = true;
+			break;
+
+		case Opcode::storeGlobal:
+		case Opcode::storeUpvalue:
+		case Opcode::close:
+			traits.writes = true;
+			break;
+		case Opcode::storeMember:
+		case Opcode::storeIndex:
+			traits.writes = traits.throws = true;
+			break;
+		case Opcode::call:
+			traits.reads = traits.writes = traits.throws = true;
+			break;
+
+		case Opcode::jump:
+		case Opcode::ret:
+		case Opcode::jumpIfTrue:
+		case Opcode::jumpIfFalse:
+			traits.control = true;
+			break;
+		case Opcode::jumpIfEqual:
+		case Opcode::jumpIfNotEqual:
+		case Opcode::jumpIfLarger:
+		case Opcode::jumpIfSmaller:
+		case Opcode::jumpIfLargerEqual:
+		case Opcode::jumpIfSmallerEqual:
+			traits.control = traits.throws = true;
+			break;
+
+		case Opcode::checkI64:
+		case Opcode::checkU64:
+		case Opcode::checkF64:
+		case Opcode::checkBool:
+			traits.throws = true;
+			break;
+		case Opcode::jumpIfEqualI64:
+		case Opcode::jumpIfNotEqualI64:
+		case Opcode::jumpIfLargerI64:
+		case Opcode::jumpIfSmallerI64:
+		case Opcode::jumpIfLargerEqualI64:
+		case Opcode::jumpIfSmallerEqualI64:
+		case Opcode::jumpIfEqualU64:
+		case Opcode::jumpIfNotEqualU64:
+		case Opcode::jumpIfLargerU64:
+		case Opcode::jumpIfSmallerU64:
+		case Opcode::jumpIfLargerEqualU64:
+		case Opcode::jumpIfSmallerEqualU64:
+		case Opcode::jumpIfEqualF64:
+		case Opcode::jumpIfNotEqualF64:
+		case Opcode::jumpIfLargerF64:
+		case Opcode::jumpIfSmallerF64:
+		case Opcode::jumpIfLargerEqualF64:
+		case Opcode::jumpIfSmallerEqualF64:
+			traits.control = true;
+			break;
+
+		// Operations specialized for the types of their operands only raise errors if they divide integrals by zero
+		case Opcode::addI64:
+		case Opcode::subtractI64:
+		case Opcode::multiplyI64:
+		case Opcode::addImmediateI64:
+		case Opcode::negateI64:
+		case Opcode::bitShiftLeftI64:
+		case Opcode::bitShiftRightI64:
+		case Opcode::bitNotI64:
+		case Opcode::bitAndI64:
+		case Opcode::bitOrI64:
+		case Opcode::bitXOrI64:
+		case Opcode::compareI64:
+		case Opcode::equalI64:
+		case Opcode::notEqualI64:
+		case Opcode::lessI64:
+		case Opcode::lessEqualI64:
+		case Opcode::addU64:
+		case Opcode::subtractU64:
+		case Opcode::multiplyU64:
+		case Opcode::addImmediateU64:
+		case Opcode::bitShiftLeftU64:
+		case Opcode::bitShiftRightU64:
+		case Opcode::bitNotU64:
+		case Opcode::bitAndU64:
+		case Opcode::bitOrU64:
+		case Opcode::bitXOrU64:
+		case Opcode::compareU64:
+		case Opcode::equalU64:
+		case Opcode::notEqualU64:
+		case Opcode::lessU64:
+		case Opcode::lessEqualU64:
+		case Opcode::addF64:
+		case Opcode::subtractF64:
+		case Opcode::multiplyF64:
+		case Opcode::divideF64:
+		case Opcode::moduloF64:
+		case Opcode::addImmediateF64:
+		case Opcode::negateF64:
+		case Opcode::compareF64:
+		case Opcode::equalF64:
+		case Opcode::notEqualF64:
+		case Opcode::lessF64:
+		case Opcode::lessEqualF64:
+			traits.pure = true;
+			break;
+
+		default: // Arithmetic, bitwise operations and comparisons, which may be applied to values which don't support them
+			traits.pure = traits.throws = true;
+	}
+
+	return traits;
+}
+
+
+// Function
+
+value_id Function::addValue(operand_type reg, block_id block, bool pinned) {
+	values.pushBack(Value { reg, block, pinned });
+	return static_cast<value_id>(values.size() - 1);
+}
+
+void Function::moveValue(value_id value) {
+	auto& moved = values[value];
+	assert(!moved.pinned && "elyrium::compiler::ir::Function::moveValue(): Values of captured registers can't be moved, aborting!");
+
+	if (moved.moved) return;
+
+	moved.reg = addRegister();
+	moved.moved = true;
+}
+
+operand_type Function::addRegister() {
+	return function->registerCount++;
+}
+
+void Function::computeDominators() {
+	constexpr auto unvisited = ~uint32 { 0 };
+
+	lsd::Vector<uint32> order(blocks.size(), unvisited);
+	reversePostorder.clear();
+
+	// Postorder through an explicit stack, so deeply nested control flow doesn't overflow the native one
+	struct Frame {
+	public:
+		block_id block;
+		size_type successor;
+	};
+
+	lsd::Vector<Frame> stack;
+	stack.pushBack(Frame { 0, 0 });
+	order[0] = 0;
+
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+		const auto& successors = blocks[frame.block].successors;
+
+		if (frame.successor < successors.size()) {
+			auto successor = successors[frame.successor++];
+
+			if (order[successor] == unvisited) {
+				order[successor] = 0;
+				stack.pushBack(Frame { successor, 0 });
+			}
+		} else {
+			reversePostorder.pushBack(frame.block);
+			stack.popBack();
+		}
+	}
+
+	std::reverse(reversePostorder.begin(), reversePostorder.end());
+
+	for (size_type i = 0; i < reversePostorder.size(); i++)
+		order[reversePostorder[i]] = static_cast<uint32>(i);
+
+	for (block_id block = 0; block < blocks.size(); block++) {
+		blocks[block].dominator = noBlock;
+
+		if (order[block] == unvisited && !blocks[block].removed) {
+			auto successors = blocks[block].successors;
+
+			for (auto successor : successors)
+				removeEdge(block, successor);
+
+			blocks[block].removed = true;
+		}
+	}
+
+	// Iterative algorithm by Cooper, Harvey and Kennedy, the entry temporarily dominating itself
+	blocks[0].dominator = 0;
+
+	auto intersect = [&](block_id first, block_id second) {
+		while (first != second) {
+			while (order[first] > order[second]) first = blocks[first].dominator;
+			while (order[second] > order[first]) second = blocks[second].dominator;
+		}
+
+		return first;
+	};
+
+	for (auto changed = true; changed;) {
+		changed = false;
+
+		for (size_type i = 1; i < reversePostorder.size(); i++) {
+			auto& block = blocks[reversePostorder[i]];
+			auto dominator = noBlock;
+
+			for (auto predecessor : block.predecessors) {
+				if (blocks[predecessor].dominator == noBlock) continue;
+				dominator = (dominator == noBlock) ? predecessor : intersect(predecessor, dominator);
+			}
+
+			if (block.dominator != dominator) {
+				block.dominator = dominator;
+				changed = true;
+			}
+		}
+	}
+
+	blocks[0].dominator = noBlock;
+}
+
+bool Function::dominates(block_id dominator, block_id block) const noexcept {
+	for (; block != noBlock; block = blocks[block].dominator)
+		if (block == dominator) return true;
+
+	return false;
+}
+
+lsd::Vector<lsd::Vector<block_id>> Function::dominatorTree() const {
+	lsd::Vector<lsd::Vector<block_id>> tree(blocks.size());
+
+	for (auto block : reversePostorder)
+		if (blocks[block].dominator != noBlock) tree[blocks[block].dominator].pushBack(block);
+
+	return tree;
+}
+
+void Function::removeEdge(block_id from, block_id to) {
+	auto& source = blocks[from];
+	auto& target = blocks[to];
+
+	lsd::Vector<block_id> successors;
+
+	for (auto successor : source.successors)
+		if (successor != to) successors.pushBack(successor);
+
+	source.successors = std::move(successors);
+
+	// Phi operands are kept in the order of the predecessors, so both are filtered together
+	lsd::Vector<block_id> predecessors;
+
+	for (auto& phi : target.phis) {
+		lsd::Vector<value_id> operands;
+
+		for (size_type i = 0; i < target.predecessors.size(); i++)
+			if (target.predecessors[i] != from) operands.pushBack(phi.operands[i]);
+
+		phi.operands = std::move(operands);
+	}
+
+	for (auto predecessor : target.predecessors)
+		if (predecessor != from) predecessors.pushBack(predecessor);
+
+	target.predecessors = std::move(predecessors);
+}
+
+void Function::replaceUses(const lsd::Vector<value_id>& replacements) {
+	auto replace = [&](value_id& value) {
+		while (value < replacements.size() && replacements[value] != noValue)
+			value = replacements[value];
+	};
+
+	for (auto& block : blocks) {
+		if (block.removed) continue;
+
+		for (auto& phi : block.phis)
+			for (auto& operand : phi.operands)
+				replace(operand);
+
+		for (auto& instruction : block.instructions)
+			for (auto& operand : instruction.operands)
+				replace(operand);
+	}
+}
+
+
+// Construction
+
+Function build(const lsd::Vector<bytecode::Instruction>& code, bytecode::Function& function, const bytecode::Program& program) {
+	Function result;
+	result.function = &function;
+	result.registerCount = function.registerCount;
+
+	auto registerCount = function.registerCount;
+
+	// Blocks start at jump targets and after jumps and returns, an empty entry block comes first so no block jumps to the entry
+	lsd::Vector<uint8> leaders(code.size() + 1, 0);
+	leaders[0] = 1;
+
+	for (size_type i = 0; i < code.size(); i++) {
+		if (auto target = targetField(code[i].opcode); target != noField) {
+			leaders[field(code[i], target)] = 1;
+			leaders[i + 1] = 1;
+		} else if (code[i].opcode == Opcode::ret) leaders[i + 1] = 1;
+	}
+
+	lsd::Vector<block_id> blockOf(code.size() + 1, noBlock);
+	result.blocks.emplaceBack();
+
+	for (size_type i = 0; i < code.size(); i++) {
+		if (leaders[i]) result.blocks.emplaceBack();
+		blockOf[i] = static_cast<block_id>(result.blocks.size() - 1);
+	}
+
+	if (!code.empty()) result.blocks[0].successors.pushBack(1);
+
+	lsd::Vector<uint8> pinned(registerCount, 0);
+	lsd::Vector<uint8> global(registerCount, 0); // Registers read before being written in a block, which are the only ones needing phis
+	lsd::Vector<block_id> writtenIn(registerCount, noBlock);
+
+	for (size_type i = 0; i < code.size(); i++) {
+		auto id = blockOf[i];
+		auto& block = result.blocks[id];
+		auto& instruction = block.instructions.emplaceBack(split(code[i]));
+
+		for (auto reg : instruction.operands)
+			if (writtenIn[reg] != id) global[reg] = 1;
+
+		for (auto reg : instruction.results)
+			if (reg != noValue) writtenIn[reg] = id;
+
+		// Closures refer to the registers they capture, so the optimizer leaves every value of them alone
+		if (code[i].opcode == Opcode::closure) {
+			for (const auto& capture : program.functions[code[i].b].captures)
+				if (capture.local) pinned[capture.index] = 1;
+		}
+
+		auto last = i + 1 == code.size() || leaders[i + 1];
+		if (!last) continue;
+
+		auto opcode = code[i].opcode;
+
+		if (auto target = targetField(opcode); target != noField) {
+			block.successors.pushBack(blockOf[field(code[i], target)]);
+			if (opcode != Opcode::jump) block.successors.pushBack(id + 1);
+		} else if (opcode != Opcode::ret && i + 1 < code.size()) block.successors.pushBack(id + 1);
+	}
+
+	for (block_id id = 0; id < result.blocks.size(); id++) {
+		result.layout.pushBack(id);
+
+		for (auto successor : result.blocks[id].successors)
+			result.blocks[successor].predecessors.pushBack(id);
+	}
+
+	result.computeDominators();
+
+	for (operand_type reg = 0; reg < registerCount; reg++)
+		result.addValue(reg, noBlock, pinned[reg]);
+
+	// Phis are placed at the iterated dominance frontiers of the blocks writing a register
+	lsd::Vector<lsd::Vector<block_id>> frontiers(result.blocks.size());
+
+	for (auto id : result.reversePostorder) {
+		const auto& block = result.blocks[id];
+		if (block.predecessors.size() < 2) continue;
+
+		for (auto predecessor : block.predecessors) {
+			for (auto runner = predecessor; runner != noBlock && runner != block.dominator; runner = result.blocks[runner].dominator) {
+				auto& frontier = frontiers[runner];
+				if (frontier.empty() || frontier.back() != id) frontier.pushBack(id);
+			}
+		}
+	}
+
+	lsd::Vector<lsd::Vector<block_id>> writers(registerCount);
+
+	for (auto id : result.reversePostorder) {
+		for (const auto& instruction : result.blocks[id].instructions) {
+			for (auto reg : instruction.results) {
+				if (reg == noValue || !global[reg]) continue;
+				if (writers[reg].empty() || writers[reg].back() != id) writers[reg].pushBack(id);
+			}
+		}
+	}
+
+	lsd::Vector<operand_type> phiPlaced(result.blocks.size(), noRegister);
+	lsd::Vector<operand_type> queued(result.blocks.size(), noRegister);
+
+	for (operand_type reg = 0; reg < registerCount; reg++) {
+		auto& worklist = writers[reg];
+
+		for (auto id : worklist)
+			queued[id] = reg;
+
+		while (!worklist.empty()) {
+			auto id = worklist.back();
+			worklist.popBack();
+
+			for (auto frontier : frontiers[id]) {
+				if (phiPlaced[frontier] == reg) continue;
+				phiPlaced[frontier] = reg;
+
+				auto& block = result.blocks[frontier];
+				block.phis.pushBack(Phi { result.addValue(reg, frontier, pinned[reg]), lsd::Vector<value_id>(block.predecessors.size(), noValue) });
+
+				if (queued[frontier] != reg) {
+					queued[frontier] = reg;
+					worklist.pushBack(frontier);
+				}
+			}
+		}
+	}
+
+	// Renaming walks the dominator tree, every register holding the value of its innermost definition
+	lsd::Vector<lsd::Vector<value_id>> definitions(registerCount);
+
+	for (operand_type reg = 0; reg < registerCount; reg++)
+		definitions[reg].pushBack(reg);
+
+	auto tree = result.dominatorTree();
+
+	struct Frame {
+	public:
+		block_id block;
+		size_type child;
+		size_type defined; // Size of the log of definitions when the block was entered
+	};
+
+	lsd::Vector<operand_type> log;
+	lsd::Vector<Frame> stack;
+	stack.pushBack(Frame { 0, 0, 0 });
+
+	auto enter = [&](block_id id) {
+		auto& block = result.blocks[id];
+
+		for (const auto& phi : block.phis) {
+			auto reg = result.values[phi.result].reg;
+
+			definitions[reg].pushBack(phi.result);
+			log.pushBack(reg);
+		}
+
+		for (auto& instruction : block.instructions) {
+			for (auto& operand : instruction.operands)
+				operand = definitions[operand].back();
+
+			for (auto& written : instruction.results) {
+				if (written == noValue) continue;
+
+				auto reg = static_cast<operand_type>(written);
+				written = result.addValue(reg, id, pinned[reg]);
+
+				definitions[reg].pushBack(written);
+				log.pushBack(reg);
+			}
+		}
+
+		for (auto successor : block.successors) {
+			auto& target = result.blocks[successor];
+
+			for (size_type i = 0; i < target.predecessors.size(); i++) {
+				if (target.predecessors[i] != id) continue;
+
+				for (auto& phi : target.phis)
+					phi.operands[i] = definitions[result.values[phi.result].reg].back();
+			}
+		}
+	};
+
+	enter(0);
+
+	while (!stack.empty()) {
+		auto& frame = stack.back();
+
+		if (frame.child < tree[frame.block].size()) {
+			auto child = tree[frame.block][frame.child++];
+			auto defined = log.size();
+
+			enter(child);
+			stack.pushBack(Frame { child, 0, defined });
+		} else {
+			for (; log.size() > frame.defined; log.popBack())
+				definitions[log.back()].popBack();
+
+			stack.popBack();
+		}
+	}
+
+	return result;
+}
+
+
+// Lowering
+
+lsd::Vector<bytecode::Instruction> lower(Function& function) {
+	lsd::Vector<bytecode::Instruction> code;
+
+	struct Patch {
+	public:
+		size_type jump;
+		block_id target;
+	};
+
+	struct Trampoline {
+	public:
+		size_type jump;
+		block_id from;
+		block_id to;
+	};
+
+	lsd::Vector<Patch> patches;
+	lsd::Vector<Trampoline> trampolines;
+	lsd::Vector<size_type> starts(function.blocks.size(), 0);
+	lsd::Vector<Copy> copies;
+
+	auto scratch = noRegister;
+
+	auto reg = [&](value_id value) {
+		return function.values[value].reg;
+	};
+
+	// Phis are lowered to copies at the end of their predecessors
+	auto phiCopies = [&](block_id from, block_id to) {
+		const auto& target = function.blocks[to];
+
+		for (size_type i = 0; i < target.predecessors.size(); i++) {
+			if (target.predecessors[i] != from) continue;
+
+			for (const auto& phi : target.phis)
+				addCopy(copies, reg(phi.result), reg(phi.operands[i]));
+
+			break;
+		}
+	};
+
+	auto jump = [&](block_id target) {
+		patches.pushBack(Patch { code.size(), target });
+		code.pushBack(bytecode::Instruction { Opcode::jump });
+	};
+
+	auto rewrite = [&](const Instruction& instruction) {
+		auto lowered = instruction.code;
+
+		if (lowered.opcode == Opcode::ret) {
+			if (lowered.b == 1) lowered.a = reg(instruction.operands[0]);
+			return lowered;
+		}
+
+		auto fields = ir::fields(lowered.opcode);
+
+		for (size_type i = 0; i < fields.readCount; i++)
+			field(lowered, fields.read[i]) = reg(instruction.operands[i]);
+
+		if (fields.written != noField) field(lowered, fields.written) = reg(instruction.results[0]);
+
+		return lowered;
+	};
+
+	lsd::Vector<block_id> layout;
+
+	for (auto id : function.layout)
+		if (!function.blocks[id].removed) layout.pushBack(id);
+
+	function.function->registerCount = function.registerCount;
+
+	for (auto& value : function.values)
+		if (value.moved && value.block == noBlock) value.reg = function.addRegister();
+
+	for (auto id : layout) {
+		for (const auto& phi : function.blocks[id].phis)
+			if (function.values[phi.result].moved) function.values[phi.result].reg = function.addRegister();
+
+		for (const auto& instruction : function.blocks[id].instructions)
+			for (auto result : instruction.results)
+				if (result != noValue && function.values[result].moved) function.values[result].reg = function.addRegister();
+	}
+
+	// Values of registers on entry come first and are numbered like their registers, so moving them only needs a copy
+	for (value_id value = 0; value < function.values.size() && function.values[value].block == noBlock; value++)
+		if (function.values[value].moved) addCopy(copies, reg(value), static_cast<operand_type>(value));
+
+	emitCopies(function, code, copies, scratch);
+
+	for (size_type i = 0; i < layout.size(); i++) {
+		auto id = layout[i];
+		auto next = (i + 1 < layout.size()) ? layout[i + 1] : noBlock;
+
+		const auto& block = function.blocks[id];
+		starts[id] = code.size();
+
+		for (const auto& instruction : block.instructions) {
+			const auto& lowered = instruction.code;
+
+			switch (lowered.opcode) {
+				case Opcode::call:
+					// Arguments are passed in the registers following the callee
+					for (operand_type j = 0; j <= lowered.b; j++)
+						addCopy(copies, lowered.a + j, reg(instruction.operands[j]));
+
+					emitCopies(function, code, copies, scratch);
+					code.pushBack(lowered);
+
+					if (reg(instruction.results[0]) != lowered.a)
+						code.pushBack(bytecode::Instruction { Opcode::move, reg(instruction.results[0]), lowered.a });
+
+					break;
+
+				case Opcode::loadMethod:
+					code.pushBack(bytecode::Instruction { Opcode::loadMethod, lowered.a, reg(instruction.operands[0]), lowered.c });
+
+					for (operand_type j = 0; j < 2; j++)
+						if (reg(instruction.results[j]) != lowered.a + j)
+							code.pushBack(bytecode::Instruction { Opcode::move, reg(instruction.results[j]), lowered.a + j });
+
+					break;
+
+				case Opcode::jump:
+					phiCopies(id, block.successors[0]);
+					emitCopies(function, code, copies, scratch);
+
+					if (block.successors[0] != next) jump(block.successors[0]);
+					break;
+
+				case Opcode::ret:
+					code.pushBack(rewrite(instruction));
+					break;
+
+				default:
+					if (targetField(lowered.opcode) != noField) {
+						// Copies of the taken edge can't be placed before the jump, so it is routed through copies at the end
+						auto taken = block.successors[0];
+						phiCopies(id, taken);
+
+						if (copies.empty()) patches.pushBack(Patch { code.size(), taken });
+						else trampolines.pushBack(Trampoline { code.size(), id, taken });
+
+						copies.clear();
+						code.pushBack(rewrite(instruction));
+
+						auto fallthrough = block.successors.back();
+
+						phiCopies(id, fallthrough);
+						emitCopies(function, code, copies, scratch);
+
+						if (fallthrough != next) jump(fallthrough);
+					} else code.pushBack(rewrite(instruction));
+			}
+		}
+
+		if (!block.instructions.empty() && traits(block.instructions.back().code.opcode).control) continue;
+
+		if (!block.successors.empty()) {
+			phiCopies(id, block.successors[0]);
+			emitCopies(function, code, copies, scratch);
+
+			if (block.successors[0] != next) jump(block.successors[0]);
+		}
+	}
+
+	for (const auto& trampoline : trampolines) {
+		field(code[trampoline.jump], targetField(code[trampoline.jump].opcode)) = static_cast<operand_type>(code.size());
+
+		phiCopies(trampoline.from, trampoline.to);
+		emitCopies(function, code, copies, scratch);
+		jump(trampoline.to);
+	}
+
+	for (const auto& patch : patches)
+		field(code[patch.jump], targetField(code[patch.jump].opcode)) = static_cast<operand_type>(starts[patch.target]);
+
+	return code;
+}
+
+} // namespace ir
+
+} // namespace compiler
+
+} // namespace elyrium
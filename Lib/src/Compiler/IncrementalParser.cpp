@@ -0,0 +1,289 @@
+#include <Elyrium/Compiler/IncrementalParser.hpp>
+
+#include <Elyrium/Core/Error.hpp>
+
+#include <Elyrium/Compiler/Lexer.hpp>
+#include <Elyrium/Compiler/Parser.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace {
+
+[[nodiscard]] constexpr bool isBlank(char c) noexcept {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+/**
+ * @brief Finds the start of the line of a token, if there is nothing but whitespace in front of the token on its line
+ */
+[[nodiscard]] bool findLineStart(lsd::StringView text, size_type offset, size_type& start) noexcept {
+	while (offset > 0 && isBlank(text[offset - 1]))
+		offset--;
+
+	if (offset > 0 && text[offset - 1] != '\n')
+		return false;
+
+	start = offset;
+	return true;
+}
+
+[[nodiscard]] size_type countLines(lsd::StringView text, size_type begin, size_type end) noexcept {
+	return static_cast<size_type>(std::count(text.begin() + begin, text.begin() + end, '\n'));
+}
+
+} // namespace
+
+IncrementalParser::IncrementalParser(Context& context, lsd::StringView source, lsd::StringView path) : m_context(context) {
+	m_path.append(path);
+
+	auto& chunk = m_chunks.emplaceBack(lsd::UniquePointer<Chunk>::create());
+	chunk->segments = 1;
+
+	m_segments.pushBack(Segment { chunk.get(), lsd::StringView(), 0, 0, false });
+
+	edit(0, 0, source);
+}
+
+void IncrementalParser::edit(size_type offset, size_type removed, lsd::StringView inserted) {
+	assert(offset + removed <= m_size && "elyrium::compiler::IncrementalParser::edit(): Edit is out of range of the source, aborting!");
+
+	// Segments which failed to parse are always reparsed, since an edit after them might have fixed them
+	size_type failedFirst = m_segments.size(), failedLast = 0;
+	for (size_type i = 0; i < m_segments.size(); i++) {
+		if (m_segments[i].failed) {
+			failedFirst = std::min(failedFirst, i);
+			failedLast = i;
+		}
+	}
+
+	// An edit at the start of a segment belongs to it, an edit removing the line break in front of a segment also includes it
+	size_type first = 0, begin = 0, line = 0, declaration = 0;
+	for (; first + 1 < m_segments.size() && first != failedFirst && begin + m_segments[first].text.size() <= offset; first++) {
+		begin += m_segments[first].text.size();
+		line += m_segments[first].lines;
+		declaration += m_segments[first].declarations;
+	}
+
+	size_type last = first, end = begin + m_segments[first].text.size();
+	for (; last + 1 < m_segments.size() && (end <= offset + removed || last < failedLast); last++)
+		end += m_segments[last + 1].text.size();
+
+	lsd::String region;
+	region.reserve(end - begin);
+
+	for (auto i = first; i <= last; i++)
+		region.append(m_segments[i].text);
+
+	// The segment in front is lexed as well, since errors at the start of a declaration are reported at the token before it
+	auto lookbehind = (first > 0) ? m_segments[first - 1].text : lsd::StringView();
+	auto baseLine = line - ((first > 0) ? m_segments[first - 1].lines : 0);
+
+	lsd::String text;
+	text.reserve(lookbehind.size() + region.size() - removed + inserted.size());
+
+	text.append(lookbehind);
+	text.append(lsd::StringView(region.data(), offset - begin));
+	text.append(inserted);
+	text.append(lsd::StringView(region.data() + offset - begin + removed, end - offset - removed));
+
+	auto editedSize = text.size();
+
+	m_size = m_size - removed + inserted.size();
+	m_reparsedBytes = 0;
+
+	// Keeps the edited text as a single segment without declarations, so the edit isn't lost
+	auto fail = [&]() {
+		text.resize(editedSize);
+
+		size_type declarations = 0;
+		for (auto i = first; i <= last; i++)
+			declarations += m_segments[i].declarations;
+
+		m_module.replaceDeclarations(declaration, declarations, lsd::Vector<ast::decl_ptr>());
+
+		auto& chunk = m_chunks.emplaceBack(lsd::UniquePointer<Chunk>::create());
+		chunk->text = std::move(text);
+
+		auto edited = lsd::StringView(chunk->text.data() + lookbehind.size(), chunk->text.size() - lookbehind.size());
+
+		lsd::Vector<Segment> segments;
+		segments.pushBack(Segment { chunk.get(), edited, countLines(edited, 0, edited.size()), 0, true });
+		replaceSegments(first, last - first + 1, std::move(segments));
+	};
+
+	/**
+	 * The edited text is parsed together with the segments behind it, of which a segment can only be reused if a declaration ends right in front of it.
+	 * If the parse runs into the end of the text instead, it might have continued into the segments after it, so it is retried with more of them.
+	 */
+	auto lookahead = last + 1;
+	size_type lookaheadCount = 1;
+
+	while (true) {
+		auto available = m_segments.size() - lookahead;
+		lookaheadCount = std::min(lookaheadCount, available);
+		auto atEnd = lookaheadCount == available;
+
+		text.resize(editedSize);
+
+		lsd::Vector<size_type> boundaries;
+		for (size_type i = 0; i < lookaheadCount; i++) {
+			boundaries.pushBack(text.size());
+			text.append(m_segments[lookahead + i].text);
+		}
+
+		m_reparsedBytes += text.size();
+
+		TokenBuffer tokens;
+
+		try {
+			tokens = Lexer(lsd::StringView(text.data(), text.size()), m_path, m_context.symbols(), SourceLocation { baseLine, 0 }).tokenize();
+		} catch (const SyntaxError&) {
+			if (!atEnd) { // A comment or string might have been opened, which can only be checked by lexing everything behind the edit
+				lookaheadCount = available;
+				continue;
+			}
+
+			fail();
+			throw;
+		}
+
+		// String literals are moved into the arena of the module, which is shared by all segments
+		lsd::Vector<literal_id> literals;
+		literals.reserve(tokens.literals().size());
+
+		for (literal_id literal = 0; literal < tokens.literals().size(); literal++)
+			literals.pushBack(m_module.literals().insert(tokens.literals().string(literal)));
+
+		tokens.remapLiterals(literals);
+
+		Parser parser(std::move(tokens), m_path);
+
+		while (parser.currentType() != Token::Type::eof && parser.m_tokens.offset(parser.m_current) < lookbehind.size())
+			parser.m_last = parser.m_current++;
+
+		lsd::Vector<ast::decl_ptr> declarations;
+		lsd::Vector<Segment> segments;
+		lsd::Vector<size_type> segmentStarts { lookbehind.size() };
+
+		size_type consumed = 0, stop = 0;
+		bool retry = false;
+
+		try {
+			while (true) {
+				auto position = static_cast<size_type>(parser.m_tokens.offset(parser.m_current));
+
+				if (parser.currentType() == Token::Type::eof) {
+					retry = !atEnd;
+					stop = text.size();
+					consumed = lookaheadCount;
+
+					break;
+				}
+
+				// Stop once the next declaration is the first one of a lookahead segment
+				auto boundary = std::upper_bound(boundaries.begin(), boundaries.end(), position);
+				if (boundary != boundaries.begin() && (parser.m_current == 0 || parser.m_tokens.offset(parser.m_current - 1) < *(boundary - 1))) {
+					consumed = static_cast<size_type>(boundary - boundaries.begin()) - 1;
+					stop = *(boundary - 1);
+
+					break;
+				}
+
+				if (size_type start; !declarations.empty() && findLineStart(text, position, start) && start > segmentStarts.back()) {
+					segments.pushBack(Segment { nullptr, { }, 0, declarations.size(), false });
+					segmentStarts.pushBack(start);
+				}
+
+				declarations.emplaceBack(parser.parseDeclaration());
+			}
+		} catch (const SyntaxError&) {
+			if (parser.currentType() != Token::Type::eof || atEnd) {
+				fail();
+				throw;
+			}
+
+			retry = true;
+		}
+
+		if (retry) {
+			lookaheadCount *= 2;
+			continue;
+		}
+
+		if (stop > segmentStarts.back() || (segments.empty() && first == 0 && lookahead + consumed == m_segments.size()))
+			segments.pushBack(Segment { nullptr, { }, 0, declarations.size(), false });
+
+		// The text and the nodes of the reparsed segments are owned by a new chunk, the text behind the stop is still owned by the reused segments
+		size_type removedDeclarations = 0;
+		for (auto i = first; i < lookahead + consumed; i++)
+			removedDeclarations += m_segments[i].declarations;
+
+		auto& chunk = m_chunks.emplaceBack(lsd::UniquePointer<Chunk>::create());
+		chunk->text = std::move(text);
+		chunk->arena = std::move(parser.m_arena);
+
+		for (size_type i = segments.size(); i-- > 0; ) { // Segments hold the amount of declarations in front of their end until here
+			auto segmentEnd = (i + 1 < segments.size()) ? segmentStarts[i + 1] : stop;
+
+			segments[i].chunk = chunk.get();
+			segments[i].text = lsd::StringView(chunk->text.data() + segmentStarts[i], segmentEnd - segmentStarts[i]);
+			segments[i].lines = countLines(chunk->text, segmentStarts[i], segmentEnd);
+
+			if (i > 0) segments[i].declarations -= segments[i - 1].declarations;
+		}
+
+		m_module.replaceDeclarations(declaration, removedDeclarations, std::move(declarations));
+		replaceSegments(first, lookahead + consumed - first, std::move(segments));
+
+		return;
+	}
+}
+
+lsd::String IncrementalParser::source() const {
+	lsd::String source;
+	source.reserve(m_size);
+
+	for (const auto& segment : m_segments)
+		source.append(segment.text);
+
+	return source;
+}
+
+void IncrementalParser::replaceSegments(size_type first, size_type count, lsd::Vector<Segment>&& segments) {
+	for (auto i = first; i < first + count; i++)
+		--m_segments[i].chunk->segments;
+	for (auto& segment : segments)
+		++segment.chunk->segments;
+
+	lsd::Vector<Segment> result;
+	result.reserve(m_segments.size() - count + segments.size());
+
+	for (size_type i = 0; i < first; i++)
+		result.pushBack(m_segments[i]);
+	for (auto& segment : segments)
+		result.pushBack(segment);
+	for (auto i = first + count; i < m_segments.size(); i++)
+		result.pushBack(m_segments[i]);
+
+	m_segments = std::move(result);
+
+	// Release the text and nodes no segment refers to anymore
+	lsd::Vector<lsd::UniquePointer<Chunk>> chunks;
+	chunks.reserve(m_chunks.size());
+
+	for (auto& chunk : m_chunks) {
+		if (chunk->segments != 0)
+			chunks.emplaceBack(std::move(chunk));
+	}
+
+	m_chunks = std::move(chunks);
+}
+
+} // namespace compiler
+
+} // namespace elyrium
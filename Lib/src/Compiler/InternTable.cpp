@@ -0,0 +1,75 @@
+#include <Elyrium/Compiler/InternTable.hpp>
+
+#include <Elyrium/Core/Hash.hpp>
+
+#include <cstring>
+
+namespace elyrium {
+
+namespace compiler {
+
+InternTable::id_type InternTable::intern(lsd::StringView string, bool copy) {
+	if ((m_strings.size() + 1) * 4 > m_slots.size() * 3) // Keep the load factor below 0.75
+		grow();
+
+	auto hash = hashString(string);
+	size_type slot;
+
+	if (auto id = find(string, hash, slot); id != none)
+		return id;
+
+	auto id = static_cast<id_type>(m_strings.size());
+
+	m_strings.pushBack(copy ? m_storage.copy(string) : string);
+	m_hashes.pushBack(hash);
+	m_slots[slot] = id;
+
+	return id;
+}
+
+InternTable::id_type InternTable::find(lsd::StringView string) const noexcept {
+	if (m_slots.empty()) return none;
+
+	size_type slot;
+	return find(string, hashString(string), slot);
+}
+
+InternTable::id_type InternTable::find(lsd::StringView string, size_type hash, size_type& slot) const noexcept {
+	auto mask = m_slots.size() - 1;
+
+	for (slot = hash & mask; m_slots[slot] != none; slot = (slot + 1) & mask) {
+		auto id = m_slots[slot];
+
+		if (m_hashes[id] == hash &&
+			m_strings[id].size() == string.size() &&
+			std::memcmp(m_strings[id].data(), string.data(), string.size()) == 0)
+			return id;
+	}
+
+	return none;
+}
+
+void InternTable::grow() {
+	auto size = m_slots.empty() ? 64 : m_slots.size() * 2;
+	auto mask = size - 1;
+
+	m_slots.clear();
+	m_slots.resize(size, none);
+
+	for (id_type id = 0; id < m_strings.size(); id++) {
+		auto slot = m_hashes[id] & mask;
+		while (m_slots[slot] != none)
+			slot = (slot + 1) & mask;
+
+		m_slots[slot] = id;
+	}
+}
+
+size_type InternTable::hashString(lsd::StringView string) noexcept {
+	auto hash = hashBytes(string);
+	return static_cast<size_type>(hash ^ (hash >> 32));
+}
+
+} // namespace compiler
+
+} // namespace elyrium
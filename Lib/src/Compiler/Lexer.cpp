@@ -1,272 +1,607 @@
 #include "LSD/StringView.h"
 #include <Elyrium/Compiler/Lexer.hpp>
 
-#include <LSD/UnorderedFlatMap.h>
+#include <Elyrium/Core/SIMD.hpp>
 
+#include <LSD/Array.h>
 
-#define REPORT_INV_NUM { \
-	throwSyntaxError(error::Message::invalidNumericLiteral); \
-	return Token(); \
-}
-
-#define VALIDATE_NUM(check) \
-do { \
-	c = next(); \
-	if (check) { \
-		prevUnderscore = false; \
-		continue; \
-	} if (c == '_') { \
-		if (prevUnderscore) REPORT_INV_NUM; \
-		prevUnderscore = true; \
-		continue; \
-	} break; \
-} while (true);
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+#include <thread>
+#include <utility>
 
 
 namespace elyrium {
 
 namespace compiler {
 
-void Lexer::throwSyntaxError(error::Message message, char expected) {
-	std::size_t additionalSpaces { };
-	auto source = currentLine(additionalSpaces);
+namespace {
+
+// Character tables
+
+enum class CharType : uint8 {
+	identifier,
+	symbol,
+	dot,
+	digit,
+	string,
+	character,
+	attribute
+};
 
-	if (expected != '\0')
-		throw SyntaxError(m_path, m_line, m_column + expected, source, message, expected); \
-	else throw SyntaxError(m_path, m_line, m_column + expected, source, message); \
+enum CharFlags : uint8 {
+	identifierChar = 1 << 0,
+	attributeChar = 1 << 1
+};
+
+inline constexpr const char* identifierDelimiters = ";.,:(){}[]^~|&+-*/%=><! @\t\n\r\f\v'\"\\\b";
+inline constexpr const char* symbolChars = ";.,:(){}[]^~|&+-*/%=><!";
+
+consteval bool contains(const char* string, char c) {
+	for (; *string != '\0'; string++)
+		if (*string == c) return true;
+
+	return false;
 }
 
-Token Lexer::nextToken() {
-	if (m_iter == m_source.end()) return Token(Token::Type::eof);
-	skipEmpty();
-	if (m_iter == m_source.end()) return Token(Token::Type::eof);
+consteval lsd::Array<CharType, 256> makeCharTypes() {
+	lsd::Array<CharType, 256> types { };
 
-	switch (*m_iter) {
-		// Strings
-		case '"': {
-			auto line = m_line, col = m_column;
-			auto c = next();
-			auto begin = m_iter;
+	for (size_type i = 0; i < types.size(); i++) {
+		auto c = static_cast<char>(i);
 
-			bool finishedParsing = false;
-			while ((c = next()) != '\0') {
-				switch (c) {	
-					case '\n':
-						m_column = -1;
-						++m_line;
+		if (c >= '0' && c <= '9') types[i] = CharType::digit;
+		else if (c == '.') types[i] = CharType::dot;
+		else if (c == '"') types[i] = CharType::string;
+		else if (c == '\'') types[i] = CharType::character;
+		else if (c == '@') types[i] = CharType::attribute;
+		else if (contains(symbolChars, c)) types[i] = CharType::symbol;
+		else types[i] = CharType::identifier;
+	}
 
-						continue;
+	return types;
+}
 
-					case '\\':
-						verifyEscapeSequence();
+consteval lsd::Array<uint8, 256> makeCharFlags() {
+	lsd::Array<uint8, 256> flags { };
 
-					default:
-						m_column += 1;
+	for (size_type i = 0; i < flags.size(); i++) {
+		auto c = static_cast<char>(i);
 
-						continue;
+		if (c != '\0' && !contains(identifierDelimiters, c)) flags[i] |= identifierChar;
+		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') flags[i] |= attributeChar;
+	}
 
-					case '"':
-						finishedParsing = true;
-				}
+	return flags;
+}
 
-				break;
-			}
+consteval lsd::Array<uint8, 256> makeDigitValues() {
+	lsd::Array<uint8, 256> values { };
+
+	for (size_type i = 0; i < values.size(); i++) {
+		auto c = static_cast<char>(i);
+
+		if (c >= '0' && c <= '9') values[i] = static_cast<uint8>(c - '0');
+		else if (c >= 'a' && c <= 'f') values[i] = static_cast<uint8>(c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F') values[i] = static_cast<uint8>(c - 'A' + 10);
+		else values[i] = 0xFF;
+	}
+
+	return values;
+}
+
+inline constexpr lsd::Array<CharType, 256> charTypes = makeCharTypes();
+inline constexpr lsd::Array<uint8, 256> charFlags = makeCharFlags();
+inline constexpr lsd::Array<uint8, 256> digitValues = makeDigitValues();
+
+constexpr CharType charType(char c) noexcept {
+	return charTypes[static_cast<uint8>(c)];
+}
+
+constexpr bool hasFlag(char c, CharFlags flag) noexcept {
+	return (charFlags[static_cast<uint8>(c)] & flag) != 0;
+}
+
+
+// Operator transition table
+
+struct Spelling {
+public:
+	const char* string;
+	Token::Type type;
+};
+
+inline constexpr lsd::Array operatorSpellings {
+	Spelling { ";", Token::Type::semicolon },
+	Spelling { ".", Token::Type::dot },
+	Spelling { ",", Token::Type::comma },
+	Spelling { ":", Token::Type::colon },
+	Spelling { "(", Token::Type::parenLeft },
+	Spelling { ")", Token::Type::parenRight },
+	Spelling { "{", Token::Type::braceLeft },
+	Spelling { "}", Token::Type::braceRight },
+	Spelling { "[", Token::Type::bracketLeft },
+	Spelling { "]", Token::Type::bracketRight },
+	Spelling { "^", Token::Type::bitXOr },
+	Spelling { "~", Token::Type::bitNot },
+	Spelling { "|", Token::Type::bitOr },
+	Spelling { "&", Token::Type::bitAnd },
+	Spelling { "+", Token::Type::add },
+	Spelling { "-", Token::Type::sub },
+	Spelling { "*", Token::Type::mul },
+	Spelling { "/", Token::Type::div },
+	Spelling { "%", Token::Type::mod },
+	Spelling { "=", Token::Type::assign },
+	Spelling { ">", Token::Type::greater },
+	Spelling { "<", Token::Type::less },
+	Spelling { "!", Token::Type::logicNot },
+
+	Spelling { "==", Token::Type::equal },
+	Spelling { "!=", Token::Type::notEqual },
+	Spelling { ">=", Token::Type::greaterEqual },
+	Spelling { "<=", Token::Type::lessEqual },
+	Spelling { "<=>", Token::Type::spaceship },
+	Spelling { "||", Token::Type::logicOr },
+	Spelling { "&&", Token::Type::logicAnd },
+
+	Spelling { "++", Token::Type::increment },
+	Spelling { "--", Token::Type::decrement },
+	Spelling { "+=", Token::Type::assignAdd },
+	Spelling { "-=", Token::Type::assignSub },
+	Spelling { "*=", Token::Type::assignMul },
+	Spelling { "/=", Token::Type::assignDiv },
+	Spelling { "%=", Token::Type::assignMod },
+
+	Spelling { "<<", Token::Type::shiftLeft },
+	Spelling { ">>", Token::Type::shiftRight },
+	Spelling { "<<=", Token::Type::assignShiftLeft },
+	Spelling { ">>=", Token::Type::assignShiftRight },
+	Spelling { "^=", Token::Type::assignBitXOr },
+	Spelling { "~=", Token::Type::assignBitNot },
+	Spelling { "|=", Token::Type::assignBitOr },
+	Spelling { "&=", Token::Type::assignBitAnd },
+};
+
+// Every prefix of an operator is an operator itself, so each spelling adds exactly one state to the start state
+inline constexpr size_type operatorStateCount = operatorSpellings.size() + 1;
+inline constexpr size_type operatorClassCount = std::char_traits<char>::length(symbolChars) + 1;
+
+struct OperatorTable {
+public:
+	lsd::Array<uint8, 256> classes { }; // Column of a character in the transition table, 0 for characters which can't appear in operators
+	lsd::Array<lsd::Array<uint8, operatorClassCount>, operatorStateCount> transitions { }; // 0 rejects the next character
+	lsd::Array<Token::Type, operatorStateCount> accepting { };
+};
+
+consteval OperatorTable makeOperatorTable() {
+	OperatorTable table { };
+
+	for (size_type i = 0; symbolChars[i] != '\0'; i++)
+		table.classes[static_cast<uint8>(symbolChars[i])] = static_cast<uint8>(i + 1);
+
+	size_type stateCount = 1;
+	for (const auto& spelling : operatorSpellings) {
+		size_type state = 0;
+
+		for (auto c = spelling.string; *c != '\0'; c++) {
+			auto& next = table.transitions[state][table.classes[static_cast<uint8>(*c)]];
+			if (next == 0) next = static_cast<uint8>(stateCount++);
+
+			state = next;
+		}
+
+		table.accepting[state] = spelling.type;
+	}
 
-			if (!finishedParsing) {
-				throwSyntaxError(error::Message::expectedDifferent, '"');
+	return table;
+}
+
+inline constexpr OperatorTable operatorTable = makeOperatorTable();
+
+
+// Keyword perfect hash
+
+inline constexpr lsd::Array keywordSpellings {
+	Spelling { "null", Token::Type::kNull },
+	Spelling { "true", Token::Type::kTrue },
+	Spelling { "false", Token::Type::kFalse },
+	Spelling { "move", Token::Type::kMove },
+	Spelling { "if", Token::Type::kIf },
+	Spelling { "else", Token::Type::kElse },
+	Spelling { "for", Token::Type::kFor },
+	Spelling { "do", Token::Type::kDo },
+	Spelling { "break", Token::Type::kBreak },
+	Spelling { "continue", Token::Type::kContinue },
+	Spelling { "return", Token::Type::kReturn },
+	Spelling { "yield", Token::Type::kYield },
+	Spelling { "let", Token::Type::kLet },
+	Spelling { "func", Token::Type::kFunc },
+	Spelling { "coroutine", Token::Type::kCoroutine },
+	Spelling { "namespace", Token::Type::kNamespace },
+	Spelling { "class", Token::Type::kClass },
+	Spelling { "enum", Token::Type::kEnum },
+	Spelling { "type", Token::Type::kType },
+	Spelling { "raise", Token::Type::kRaise },
+	Spelling { "try", Token::Type::kTry },
+	Spelling { "catch", Token::Type::kCatch },
+	Spelling { "this", Token::Type::kThis },
+	Spelling { "import", Token::Type::kImport },
+};
+
+static_assert(
+	keywordSpellings.size() == static_cast<size_type>(Token::Type::kImport) - static_cast<size_type>(Token::Type::kNull) + 1,
+	"elyrium::compiler::Lexer: Every keyword token type requires a spelling!"
+);
+
+inline constexpr size_type keywordHashBits = 6;
+inline constexpr size_type keywordMinLength = 2;
+inline constexpr size_type keywordMaxLength = 9;
+
+struct KeywordEntry {
+public:
+	const char* string = nullptr;
+	size_type length = 0;
+	Token::Type type = Token::Type::identifier;
+};
+
+constexpr uint32 keywordHash(const char* string, size_type length, uint32 seed) noexcept {
+	uint32 key = static_cast<uint8>(string[0]) |
+		(static_cast<uint32>(static_cast<uint8>(string[1])) << 8) |
+		(static_cast<uint32>(static_cast<uint8>(string[length - 1])) << 16) |
+		(static_cast<uint32>(length) << 24);
+
+	return (key * seed) >> (32 - keywordHashBits);
+}
 
+consteval uint32 findKeywordSeed() {
+	for (uint32 seed = 0x9E3779B1; ; seed += 2) {
+		lsd::Array<bool, (1 << keywordHashBits)> used { };
+		bool collision = false;
+
+		for (const auto& keyword : keywordSpellings) {
+			auto& slot = used[keywordHash(keyword.string, std::char_traits<char>::length(keyword.string), seed)];
+			if (slot) {
+				collision = true;
 				break;
 			}
 
-			++m_column;
-			return Token(Token::Type::string, { begin, m_iter++ }, line, col); // m_iter++ skips the last quotation mark which couldn't be skipped above
+			slot = true;
 		}
 
+		if (!collision) return seed;
+	}
+}
 
-		// Single characters
-		case '\'': {
-			auto col = m_column;
-			auto c = next();
-			auto begin = m_iter;
+inline constexpr uint32 keywordSeed = findKeywordSeed();
 
-			switch (c) {
-				case '\0':
-					throwSyntaxError(error::Message::expectedDifferent, '\'');
+consteval lsd::Array<KeywordEntry, (1 << keywordHashBits)> makeKeywordTable() {
+	lsd::Array<KeywordEntry, (1 << keywordHashBits)> table { };
 
-					break;
+	for (const auto& keyword : keywordSpellings) {
+		auto length = std::char_traits<char>::length(keyword.string);
+		table[keywordHash(keyword.string, length, keywordSeed)] = { keyword.string, length, keyword.type };
+	}
 
-				case '\'':
-					throwSyntaxError(error::Message::emptyChar);
+	return table;
+}
 
-					break;
+inline constexpr lsd::Array<KeywordEntry, (1 << keywordHashBits)> keywordTable = makeKeywordTable();
 
-				case '\n':
-				case '\t':
-					throwSyntaxError(error::Message::unescapedChar);
+Token::Type keywordType(lsd::StringView value) noexcept {
+	if (value.size() < keywordMinLength || value.size() > keywordMaxLength)
+		return Token::Type::identifier;
 
-					break;
+	const auto& entry = keywordTable[keywordHash(value.data(), value.size(), keywordSeed)];
+	if (entry.length == value.size() && std::memcmp(entry.string, value.data(), value.size()) == 0)
+		return entry.type;
 
-				case '\\':
-					verifyEscapeSequence();
-			}
+	return Token::Type::identifier;
+}
 
-			if (next() != '\'')
-				throwSyntaxError(error::Message::expectedDifferent, '\'');
-	
-			++m_column;
-			return Token(Token::Type::character, { begin, m_iter++ }, m_line, col);
+} // namespace
 
-			break;
-		}
 
+void Lexer::syntaxError(error::Message message, char expected) {
+	auto offset = static_cast<size_type>(m_iter - m_source.begin());
 
-		// Single character tokens
+	if (m_diagnostics) {
+		if (!m_tokenFailed) m_diagnostics->report(message, offset, expected);
+		m_tokenFailed = true;
 
-		case ';':
-			return singleCharTok(Token::Type::semicolon);
+		return;
+	}
 
-		case ',':
-			return singleCharTok(Token::Type::comma);
+	std::size_t additionalSpaces { };
 
-		case '(':
-			return singleCharTok(Token::Type::parenLeft);
+	auto source = m_lines.lineSource(offset, additionalSpaces);
+	auto location = m_lines.location(offset);
 
-		case ')':
-			return singleCharTok(Token::Type::parenRight);
+	if (location.line == 0) location.column += m_base.column + m_baseSpaces;
+	location.line += m_base.line;
 
-		case '{':
-			return singleCharTok(Token::Type::braceLeft);
+	throw SyntaxError(m_path, location.line, location.column + additionalSpaces, source, message, expected);
+}
 
-		case '}':
-			return singleCharTok(Token::Type::braceRight);
+lsd::StringView Lexer::checkedSource(lsd::StringView source, lsd::StringView path) {
+	if (source.size() > sourceLimit) throw SyntaxError(path, 0, 0, lsd::StringView(), error::Message::sourceTooLarge);
+	return source;
+}
 
-		case '[':
-			return singleCharTok(Token::Type::bracketLeft);
+TokenBuffer Lexer::tokenize() {
+	TokenBuffer tokens(m_source, m_base);
+	tokens.reserve(m_source.size() / 6 + 1);
 
-		case ']':
-			return singleCharTok(Token::Type::bracketRight);
+	for (auto token = nextToken(); token.type() != Token::Type::eof; token = nextToken())
+		tokens.pushBack(token);
 
-		case ':':
-			return singleCharTok(Token::Type::colon);
+	tokens.pushBack(Token::Type::eof, static_cast<TokenBuffer::offset_type>(m_source.size()), 0);
+	tokens.bindLiterals(std::move(m_literals));
 
+	return tokens;
+}
 
+/**
+ * Each chunk is lexed speculatively, assuming it starts outside of strings and comments.
+ * Since the lexer carries no state between tokens besides its position, a chunk agrees with the sequential lexer
+ * from the first token start they share onwards. Stitching walks the chunks in order and lexes sequentially 
+ * until it reaches such a token start, which only happens when a chunk boundary falls into a multiline string or comment.
+ */
+struct Lexer::Chunk {
+public:
+	TokenBuffer::offset_type begin;
+	TokenBuffer::offset_type end;
 
-		// Double character tokens
+	SymbolTable symbols;
+	LiteralArena literals;
+	TokenBuffer tokens;
+	lsd::Vector<TokenBuffer::offset_type> starts; // Offset each token was lexed from, which differs from the token data for strings
 
-		case '=':
-			return doubleCharTok(Token::Type::assign, Token::Type::equal);
+	TokenBuffer::offset_type stateEnd; // Position after the last token
 
-		case '|':
-			return doubleCharTok(Token::Type::bitOr, Token::Type::logicOr);
+	std::exception_ptr error;
+	TokenBuffer::offset_type errorStart;
+};
 
+void Lexer::lexChunk(Chunk& chunk) const {
+	Lexer lexer(m_source, m_path, chunk.symbols);
+	lexer.m_iter = m_source.begin() + chunk.begin;
 
-		// Tokens with an equal appended
+	chunk.stateEnd = chunk.begin;
 
+	try {
+		while (true) {
+			lexer.skipEmpty();
 
-		case '/':
-			return singleCharEqualTok(Token::Type::div, Token::Type::assignDiv);
+			auto start = static_cast<TokenBuffer::offset_type>(lexer.m_iter - m_source.begin());
+			if (start >= chunk.end || lexer.m_iter == m_source.end()) break;
 
-		case '*':
-			return singleCharEqualTok(Token::Type::mul, Token::Type::assignMul);
+			try {
+				chunk.tokens.pushBack(lexer.nextToken());
+			} catch (...) {
+				chunk.error = std::current_exception();
+				chunk.errorStart = start;
 
-		case '%':
-			return singleCharEqualTok(Token::Type::mod, Token::Type::assignMod);
+				break;
+			}
 
-		case '!':
-			return singleCharEqualTok(Token::Type::logicNot, Token::Type::notEqual);
+			chunk.starts.pushBack(start);
+			chunk.stateEnd = static_cast<TokenBuffer::offset_type>(lexer.m_iter - m_source.begin());
+		}
+	} catch (const Exception&) { } // Errors between tokens are rediscovered by the sequential stitching pass
 
-		case '&':
-			return singleCharEqualTok(Token::Type::bitAnd, Token::Type::assignBitAnd);
+	chunk.literals = std::move(lexer.m_literals);
+}
 
-		case '~':
-			return singleCharEqualTok(Token::Type::bitNot, Token::Type::assignBitNot);
+TokenBuffer Lexer::tokenizeParallel(size_type threadCount, size_type chunkSize) {
+	if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
 
-		case '^':
-			return singleCharEqualTok(Token::Type::bitXOr, Token::Type::assignBitXOr);
+	auto chunkCount = std::min(threadCount, m_source.size() / std::max(chunkSize, size_type { 1 }));
+	if (chunkCount <= 1 || m_iter != m_source.begin()) return tokenize();
 
+	// Split at line starts, so that only multiline strings and comments can straddle chunk boundaries
+	lsd::Vector<Chunk> chunks;
+	chunks.resize(chunkCount);
+	
+	for (size_type i = 0, begin = 0; i < chunkCount; i++) {
+		size_type end = m_source.size();
 
-		// More complicated cases
+		if (i + 1 < chunkCount) {
+			auto nominal = m_source.begin() + m_source.size() / chunkCount * (i + 1);
+			end = std::max(static_cast<size_type>(simd::findLineEnd(nominal, m_source.end()) - m_source.begin()), begin);
+		}
 
-		case '+':
-			return singleCharEqualOrDoubleCharTok(Token::Type::add, Token::Type::increment, Token::Type::assignAdd);
+		chunks[i].begin = static_cast<TokenBuffer::offset_type>(begin);
+		chunks[i].end = static_cast<TokenBuffer::offset_type>(end);
+		chunks[i].tokens = TokenBuffer(m_source);
+		chunks[i].tokens.reserve((end - begin) / 6 + 1);
 
-		case '-':
-			return singleCharEqualOrDoubleCharTok(Token::Type::sub, Token::Type::decrement, Token::Type::assignSub);
+		begin = end;
+	}
 
+	lsd::Vector<std::thread> workers;
+	workers.reserve(chunkCount - 1);
 
-		case '>': {
-			auto begin = m_iter;
-			auto col = m_column++;
+	for (size_type i = 1; i < chunkCount; i++)
+		workers.emplaceBack([this, &chunks, i]() { lexChunk(chunks[i]); });
 
-			if (auto c = *m_iter, n = next(); n == c) {
-				if (auto n = next(); n == '=') {
-					next();
+	lexChunk(chunks[0]);
 
-					return Token(Token::Type::assignShiftRight, { begin, m_iter }, m_line, col);
-				}
+	for (auto& worker : workers)
+		worker.join();
 
-				return Token(Token::Type::shiftRight, { begin, m_iter }, m_line, col);
-			} else if (n == '=') {
-				next();
 
-				return Token(Token::Type::greaterEqual, { begin, m_iter }, m_line, col);
+	// Stitch the chunks together in order, remapping chunk local symbols and literals
+	size_type tokenCount = 1;
+	for (const auto& chunk : chunks)
+		tokenCount += chunk.tokens.size();
+
+	TokenBuffer tokens(m_source);
+	tokens.reserve(tokenCount + tokenCount / 16);
+
+	lsd::Vector<symbol_id> symbolMap;
+	lsd::Vector<literal_id> literalMap;
+
+	for (auto& chunk : chunks) {
+		symbolMap.clear();
+		symbolMap.resize(chunk.symbols.size(), SymbolTable::none);
+		literalMap.clear();
+		literalMap.resize(chunk.literals.size(), LiteralArena::none);
+
+		while (true) {
+			skipEmpty();
+
+			auto start = static_cast<TokenBuffer::offset_type>(m_iter - m_source.begin());
+			if (start >= chunk.end || m_iter == m_source.end()) break;
+
+			if (chunk.error && start == chunk.errorStart) {
+				if (!m_diagnostics) std::rethrow_exception(chunk.error);
+
+				// The chunk stopped at the error, so the rest of it is lexed sequentially to report and recover from it
+				tokens.pushBack(nextToken());
+				continue;
 			}
 
-			return Token(Token::Type::greater, { begin, m_iter }, m_line, col);
-		}
+			auto found = std::lower_bound(chunk.starts.begin(), chunk.starts.end(), start);
+			
+			if (found == chunk.starts.end() || *found != start) { // The speculation doesn't line up yet
+				tokens.pushBack(nextToken());
+				continue;
+			}
 
-		case '<': { // Most complex operator case, as it may parse to <, <=, <=>, <<, <<=
-			auto begin = m_iter;
-			auto col = m_column++;
+			// Assign global symbols and literals in order of first appearance, like the sequential lexer would
+			auto first = static_cast<TokenBuffer::index_type>(found - chunk.starts.begin());
 
-			if (auto c = *m_iter, n = next(); n == c) {
-				if (auto n = next(); n == '=') {
-					next();
+			for (auto i = first; i < chunk.tokens.size(); i++) {
+				auto type = chunk.tokens.type(i);
 
-					return Token(Token::Type::assignShiftRight, { begin, m_iter }, m_line, col);
+				if (type == Token::Type::identifier || type == Token::Type::attribute) {
+					if (auto symbol = chunk.tokens.symbol(i); symbolMap[symbol] == SymbolTable::none)
+						symbolMap[symbol] = m_symbols.intern(chunk.symbols.string(symbol));
+				} else if (type == Token::Type::string) {
+					if (auto literal = chunk.tokens.value(i).literal; literalMap[literal] == LiteralArena::none) {
+						auto string = chunk.literals.string(literal);
+						auto inSource = string.data() >= m_source.data() && string.data() < m_source.data() + m_source.size();
+
+						literalMap[literal] = inSource ? m_literals.view(string) : m_literals.insert(string);
+					}
 				}
+			}
 
-				return Token(Token::Type::shiftRight, { begin, m_iter }, m_line, col);
-			} else if (n == '=') {
-				if (auto n = next(); n == '>') {
-					next();
+			tokens.append(chunk.tokens, first, symbolMap, literalMap);
+			m_iter = m_source.begin() + chunk.stateEnd;
+		}
+	}
 
-					return Token(Token::Type::spaceship, { begin, m_iter }, m_line, col);
-				}
+	// Continue sequentially until the end in case the last chunk was skipped
+	for (auto token = nextToken(); token.type() != Token::Type::eof; token = nextToken())
+		tokens.pushBack(token);
+
+	tokens.pushBack(Token::Type::eof, static_cast<TokenBuffer::offset_type>(m_source.size()), 0);
+	tokens.bindLiterals(std::move(m_literals));
+
+	return tokens;
+}
+
+Token Lexer::nextToken() {
+	if (m_iter == m_source.end()) return Token(Token::Type::eof);
+	skipEmpty();
+	if (m_iter == m_source.end()) return Token(Token::Type::eof);
+
+	switch (charType(*m_iter)) {
+		// Strings
+		case CharType::string:
+			return stringLiteral();
+
+
+		// Single characters
+		case CharType::character: {
+			auto begin = m_iter + 1;
+			char32 value = 0;
+
+			switch (auto c = next()) {
+				case '\0':
+					syntaxError(error::Message::expectedDifferent, '\'');
+
+					return Token(Token::Type::character, { begin, m_iter }, { .character = value });
+
+				case '\'':
+					syntaxError(error::Message::emptyChar);
+
+					return Token(Token::Type::character, { begin, m_iter++ }, { .character = value });
+
+				case '\n':
+				case '\t':
+					syntaxError(error::Message::unescapedChar);
+					value = static_cast<uint8>(c);
+
+					break;
+
+				case '\\':
+					value = escapeSequence();
+					m_iter--; // Step back onto the last character of the escape sequence
 
-				return Token(Token::Type::greaterEqual, { begin, m_iter }, m_line, col);
+					break;
+
+				default:
+					value = static_cast<uint8>(c);
+
+					break;
 			}
 
-			return Token(Token::Type::greater, { begin, m_iter }, m_line, col);
+			if (next() != '\'') {
+				syntaxError(error::Message::expectedDifferent, '\'');
+
+				// Overlong literals are skipped up to their closing quote on the same line, instead of lexing their remaining characters
+				auto end = std::find_if(m_iter, m_source.end(), [](char c) { return c == '\'' || c == '\n'; });
+				if (end == m_source.end() || *end != '\'') 
+					return Token(Token::Type::character, { begin, m_iter }, { .character = value });
+
+				m_iter = end + 1;
+				return Token(Token::Type::character, { begin, end }, { .character = value });
+			}
+	
+			return Token(Token::Type::character, { begin, m_iter++ }, { .character = value });
 		}
 
 
+		// Operators and other special symbols
+
+		case CharType::symbol:
+			return operatorTok();
+
+
 		// Attributes
 
-		case '@': {
-			auto begin = ++m_iter;
-			auto col = m_column++;
-			
-			auto c = *m_iter;
-			while ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
-				c = next();
+		case CharType::attribute: {
+			auto begin = m_iter + 1;
+		
+			auto it = begin;
+			while (it != m_source.end() && hasFlag(*it, attributeChar))
+				++it;
+
+			m_iter = it;
 
-			return Token(Token::Type::attribute, { begin, m_iter}, m_line, col);
+			lsd::StringView value(begin, m_iter);
+			return Token(Token::Type::attribute, value, { .symbol = intern(value) });
 		}
 
 
 		// Remaining literals, keywords and identifiers
 
-		case '.':
-			if (auto c = *(m_iter + 1); c >= '0' && c <= '9')
+		case CharType::dot:
+			if (auto it = m_iter + 1; it != m_source.end() && charType(*it) == CharType::digit)
 				return numericLiteral(true);
 
-			return singleCharTok(Token::Type::dot);
+			return operatorTok();
 
-		default:
-			if (auto c = *m_iter; c >= '0' && c <= '9')
-				return numericLiteral(false);
+		case CharType::digit:
+			return numericLiteral(false);
 
+		case CharType::identifier:
 			return keywordOrIdentifier();
 	}
 
@@ -274,350 +609,424 @@ Token Lexer::nextToken() {
 }
 
 
-Token Lexer::singleCharTok(Token::Type type) {
-	auto begin = m_iter++;
+Token Lexer::operatorTok() {
+	auto begin = m_iter;
+
+	size_type state = 0;
+	for (; m_iter != m_source.end(); m_iter++) {
+		auto next = operatorTable.transitions[state][operatorTable.classes[static_cast<uint8>(*m_iter)]];
+		if (next == 0) break;
 
-	return Token(type, { begin, m_iter }, m_line, m_column++);
+		state = next;
+	}
+
+	return Token(operatorTable.accepting[state], { begin, m_iter });
 }
 
-Token Lexer::doubleCharTok(Token::Type singleChar, Token::Type doubleChar) {
+
+Token Lexer::numericLiteral(bool guaranteedFloat) {
 	auto begin = m_iter;
-	auto col = m_column;
+	auto end = m_source.end();
 
-	if (auto c = *m_iter, n = next(); n == c) {
-		next();
-		
-		return Token(doubleChar, { begin, m_iter }, m_line, col);
+	uint64 value = 0;
+	bool overflow = false;
+
+	if (!guaranteedFloat && *m_iter == '0' && m_iter + 1 != end) {
+		uint32 base = 0;
+
+		switch (*(m_iter + 1)) {
+			case 'B': case 'b':
+				base = 2;
+				break;
+
+			case 'O': case 'o':
+				base = 8;
+				break;
+
+			case 'X': case 'x':
+				base = 16;
+				break;
+		}
+
+		if (base != 0) {
+			m_iter += 2;
+			if (digitSequence(base, &value, &overflow) == 0) 
+				syntaxError(error::Message::invalidNumericLiteral);
+
+			// Binary, octal and hexadecimal literals spell out a bit pattern, so signed ones may use all 64 bits
+			return integralLiteral(begin, value, overflow, false);
+		}
 	}
 
-	return Token(singleChar, { begin, m_iter }, m_line, col);
+	if (!guaranteedFloat) {
+		digitSequence(10, &value, &overflow);
+
+		if (m_iter == end || *m_iter != '.') 
+			return integralLiteral(begin, value, overflow, true);
+	}
+
+	m_iter++; // Skip the decimal point
+
+	auto fractionDigits = digitSequence(10, nullptr, nullptr);
+	if (guaranteedFloat && fractionDigits == 0) 
+		syntaxError(error::Message::invalidNumericLiteral);
+
+	if (m_iter != end && *m_iter == 'e') {
+		if (fractionDigits == 0) 
+			syntaxError(error::Message::invalidNumericLiteral);
+
+		if (++m_iter != end && (*m_iter == '+' || *m_iter == '-')) 
+			m_iter++;
+
+		if (digitSequence(10, nullptr, nullptr) == 0) 
+			syntaxError(error::Message::invalidNumericLiteral);
+	}
+
+	if (m_iter != end) {
+		if (*m_iter == 'u' || *m_iter == 'U') {
+			syntaxError(error::Message::invalidNumericLiteral);
+			m_iter++;
+		} else if (*m_iter == 'f') 
+			m_iter++;
+	}
+
+	return floatingLiteral(begin);
 }
 
-Token Lexer::singleCharEqualTok(Token::Type singleChar, Token::Type equal) {
-	auto begin = m_iter;
-	auto col = m_column;
+Token Lexer::integralLiteral(const char* begin, uint64 value, bool overflow, bool decimal) {
+	auto type = Token::Type::integral;
 
-	if (auto n = next(); n == '=') {
-		next();
+	if (m_iter != m_source.end()) {
+		if (*m_iter == 'u' || *m_iter == 'U') {
+			m_iter++;
+			type = Token::Type::unsignedIntegral;
+		} else if (*m_iter == 'f' && decimal) {
+			m_iter++;
+			return floatingLiteral(begin);
+		}
+	}
 
-		return Token(equal, { begin, m_iter }, m_line, col);
+	if (overflow || (type == Token::Type::integral && decimal && value > static_cast<uint64>(std::numeric_limits<int64>::max()))) {
+		auto end = std::exchange(m_iter, begin); // Errors of whole literals are reported at their beginning
+		syntaxError(error::Message::numericLiteralOutOfRange);
+		m_iter = end;
 	}
 
-	return Token(singleChar, { begin, m_iter }, m_line, col);
+	lsd::StringView data(begin, m_iter);
+
+	if (type == Token::Type::unsignedIntegral) 
+		return Token(type, data, { .unsignedIntegral = value });
+	
+	return Token(type, data, { .integral = static_cast<int64>(value) });
 }
 
-Token Lexer::singleCharEqualOrDoubleCharTok(Token::Type singleChar, Token::Type doubleChar, Token::Type equal) {
-	auto begin = m_iter;
-	auto col = m_column;
+Token Lexer::floatingLiteral(const char* begin) {
+	static constexpr size_type bufferSize = 128;
+
+	char buffer[bufferSize];
+	lsd::String fallback;
+
+	// Copy the literal without underscores and suffix, very long literals fall back to the heap
+	auto last = (*(m_iter - 1) == 'f') ? m_iter - 1 : m_iter;
+	char* digits = buffer;
+
+	if (static_cast<size_type>(last - begin) > bufferSize) {
+		fallback.resize(last - begin);
+		digits = fallback.data();
+	}
 
-	if (auto c = *m_iter, n = next(); n == c) {
-		next();
+	auto digitsEnd = digits;
+	for (auto it = begin; it != last; it++)
+		if (*it != '_') *digitsEnd++ = *it;
 
-		return Token(doubleChar, { begin, m_iter }, m_line, col);
-	} else if (n == '=') {
-		next();
+	float64 value = 0.0;
+	auto result = std::from_chars(digits, digitsEnd, value);
 
-		return Token(equal, { begin, m_iter }, m_line, col);
+	if (result.ec != std::errc() || result.ptr != digitsEnd) {
+		auto end = std::exchange(m_iter, begin); // Errors of whole literals are reported at their beginning
+		syntaxError((result.ec == std::errc::result_out_of_range) ? error::Message::numericLiteralOutOfRange : error::Message::invalidNumericLiteral);
+		m_iter = end;
 	}
 
-	return Token(singleChar, { begin, m_iter }, m_line, col);
+	return Token(Token::Type::floating, { begin, m_iter }, { .floating = value });
 }
 
+size_type Lexer::digitSequence(uint32 base, uint64* value, bool* overflow) {
+	const auto limit = std::numeric_limits<uint64>::max() / base;
+	const auto limitDigit = std::numeric_limits<uint64>::max() % base;
 
-Token Lexer::numericLiteral(bool guaranteedFloat) {
-	auto col = m_column;
-	auto begin = m_iter;
+	size_type count = 0;
+	bool prevUnderscore = false;
 
-	bool prevUnderscore = true;
-	auto c = *m_iter;
+	for (auto end = m_source.end(); m_iter != end; m_iter++) {
+		auto c = *m_iter;
 
-	auto type = Token::Type::integral;
-	if (guaranteedFloat) goto parseFloatBehindDecPoint;
+		if (c == '_') {
+			// Underscores may only separate two digits
+			if (count == 0 || prevUnderscore) 
+				syntaxError(error::Message::invalidNumericLiteral);
 
-	if (c == '0') {
-		switch (c = next()) {
-			case 'B': case 'b':
-				VALIDATE_NUM(c == '0' || c == '1');
+			prevUnderscore = true;
+			continue;
+		}
 
-				break;
+		auto digit = digitValues[static_cast<uint8>(c)];
+		if (digit >= base) break;
 
-			case 'O': case 'o':
-				VALIDATE_NUM(c >= '0' && c <= '7');
+		if (value) {
+			if (*value > limit || (*value == limit && digit > limitDigit)) 
+				*overflow = true;
 
-				break;
+			*value = *value * base + digit;
+		}
 
-			case 'X': case 'x':
-				VALIDATE_NUM(std::isxdigit(c));
+		prevUnderscore = false;
+		count++;
+	}
 
-				break;
+	if (prevUnderscore) {
+		m_iter--;
+		syntaxError(error::Message::invalidNumericLiteral);
+		m_iter++;
+	}
 
-			default:
-				if (std::isdigit(c))
-					goto parseRegularNumber;
+	return count;
+}
 
-				break;
-		}
-	} else {
-	parseRegularNumber:
-		VALIDATE_NUM(std::isdigit(c));
+Token Lexer::keywordOrIdentifier() {
+	auto begin = m_iter;
 
-		if (c == '.') {
-			prevUnderscore = true;
+	auto it = m_iter + 1; // The first character is always part of the identifier
+	while (it != m_source.end() && hasFlag(*it, identifierChar))
+		++it;
 
-		parseFloatBehindDecPoint:
-			type = Token::Type::floating;
+	m_iter = it;
 
-			auto currCol = m_column;
-			VALIDATE_NUM(std::isdigit(c));
+	lsd::StringView value(begin, m_iter);
 
-			if (c == 'e') {
-				if (currCol - m_column == 0) REPORT_INV_NUM;
+	if (auto type = keywordType(value); type != Token::Type::identifier)
+		return Token(type, value);
 
-				prevUnderscore = true;
-				if (c = *(m_iter + 1); c == '+' || c == '-') next();
+	return Token(Token::Type::identifier, value, { .symbol = intern(value) });
+}
 
-				currCol = m_column;
-				VALIDATE_NUM(std::isdigit(c));
-				if (currCol - m_column == 0) REPORT_INV_NUM;
-			} else if (guaranteedFloat && currCol - m_column == 0) REPORT_INV_NUM;
+symbol_id Lexer::intern(lsd::StringView name) {
+	// Names touching the end of a partial source might continue, they are interned once they were lexed completely
+	if (m_partial && m_iter == m_source.end()) 
+		return SymbolTable::none;
+
+	return m_symbols.intern(name);
+}
+
+Token Lexer::stringLiteral() {
+	auto begin = m_iter + 1;
+	auto end = m_source.end();
+
+	// Literals without escape sequences are referenced directly inside of the source
+	auto it = begin;
+	for (; it != end && *it != '"' && *it != '\\'; it++) {
+		if (*it == '\0') {
+			m_iter = it;
+			syntaxError(error::Message::disallowedChar);
 		}
 	}
 
-	if (c == '_') REPORT_INV_NUM;
-	if (c == 'U' || c == 'u') {
-		if (type == Token::Type::floating) REPORT_INV_NUM;
-		type = Token::Type::unsignedIntegral;
-	} else if (c == 'f') type = Token::Type::floating;
+	if (it != end && *it == '"') {
+		m_iter = it + 1;
 
-	return Token(type, { begin, m_iter }, m_line, col);
-}
+		lsd::StringView data(begin, it);
+		return Token(Token::Type::string, data, { .literal = m_literals.view(data) });
+	}
 
-Token Lexer::keywordOrIdentifier() {
-	static const lsd::UnorderedFlatMap<lsd::StringView, Token::Type> lookup {
-		{ "null", Token::Type::kNull },
+	// Otherwise the contents are decoded into the scratch buffer and copied into the literal arena
+	m_scratch.clear();
+	m_scratch.append(lsd::StringView(begin, it));
 
-		{ "true", Token::Type::kTrue },
-		{ "false", Token::Type::kFalse },
+	for (m_iter = it; m_iter != end && *m_iter != '"'; ) {
+		switch (*m_iter) {
+			case '\0':
+				syntaxError(error::Message::disallowedChar);
+				m_iter++;
 
-		{ "move", Token::Type::kMove },
-	
-		{ "if", Token::Type::kIf },
-		{ "else", Token::Type::kElse },
-		{ "for", Token::Type::kFor },
-		{ "do", Token::Type::kDo },
-		{ "break", Token::Type::kBreak },
-		{ "continue", Token::Type::kContinue },
-		{ "return", Token::Type::kReturn },
-		{ "yield", Token::Type::kYield },
-
-		{ "raise", Token::Type::kRaise },
-		{ "try", Token::Type::kTry },
-		{ "catch", Token::Type::kCatch },
-
-		{ "this", Token::Type::kThis },
-
-		{ "let", Token::Type::kLet },
-
-		{ "func", Token::Type::kFunc },
-		{ "coroutine", Token::Type::kCoroutine },
-		{ "enum", Token::Type::kEnum },
-		{ "class", Token::Type::kClass },
-		{ "type", Token::Type::kType },
-		{ "namespace", Token::Type::kNamespace },
-		{ "import", Token::Type::kImport }
-	};
+				break;
 
-	auto begin = m_iter;
-	auto col = m_column;
+			case '\\': {
+				bool unicode = (m_iter + 1 != end) && (*(m_iter + 1) == 'u' || *(m_iter + 1) == 'U');
+				auto value = escapeSequence();
+
+				if (unicode) appendUtf8(m_scratch, value);
+				else m_scratch.pushBack(static_cast<char>(value));
+
+				break;
+			}
 
-	while (true) {
-		switch (next()) {
 			default:
-				continue;
+				m_scratch.pushBack(*m_iter++);
 
-			case ';':
-			case '.':
-			case ',':
-			case ':':
-			case '(':
-			case ')':
-			case '{':
-			case '}':
-			case '[':
-			case ']':
-			case '^':
-			case '~':
-			case '|':
-			case '&':
-			case '+':
-			case '-':
-			case '*':
-			case '/':
-			case '%':
-			case '=':
-			case '>':
-			case '<':
-			case '!':
-			case ' ':
-			case '@':
-			case '\t':
-			case '\n':
-			case '\r':
-			case '\f':
-			case '\v':
-			case '\'':
-			case '"':
-			case '\\':
-			case '\b':
-			case '\0':
+				break;
 		}
-
-		break;
 	}
 
-	lsd::StringView value(begin, m_iter);
+	if (m_iter == end) {
+		syntaxError(error::Message::expectedDifferent, '"');
 
-	if (auto it = lookup.find(value); it != lookup.end())
-		return Token(it->second, value, m_line, col);
+		return Token(Token::Type::string, { begin, m_iter }, { .literal = m_literals.insert(m_scratch) });
+	}
 
-	return Token(Token::Type::identifier, value, m_line, col);
+	lsd::StringView data(begin, m_iter++); // m_iter++ skips the closing quotation mark
+	return Token(Token::Type::string, data, { .literal = m_literals.insert(m_scratch) });
 }
 
-void Lexer::verifyEscapeSequence() {
-	switch (next()) {
-		default:
-			throwSyntaxError(error::Message::invalidEscape);
+char32 Lexer::escapeSequence() {
+	uint32 maxDigits = 0;
 
+	switch (next()) {
 		case '\0':
-			throwSyntaxError(error::Message::expectedDifferent, '\'');
+			syntaxError(error::Message::invalidEscape);
+
+			return 0;
 
 		case 'x':
-		case 'u':
-		case 'U':
-			if (std::isxdigit(next())) {
-				return;
-			}
+			maxDigits = 2;
+			break;
 
-		case 'b':
-		case 'e':
-		case 'f':
-		case 'n':
-		case 'r':
-		case 't':
-		case 'v':
-		case '\\':
-		case '\'':
-		case '"':
-			return;
-	}
-}
+		case 'u':
+			maxDigits = 4;
+			break;
 
+		case 'U':
+			maxDigits = 8;
+			break;
 
-void Lexer::skipEmpty() {
-	size_type blockCommentMode = 0;
+		case 'b': m_iter++; return '\b';
+		case 'e': m_iter++; return 0x1B;
+		case 'f': m_iter++; return '\f';
+		case 'n': m_iter++; return '\n';
+		case 'r': m_iter++; return '\r';
+		case 't': m_iter++; return '\t';
+		case 'v': m_iter++; return '\v';
+		case '\\': m_iter++; return '\\';
+		case '\'': m_iter++; return '\'';
+		case '"': m_iter++; return '"';
 
-	char c = *m_iter;
-	do {
-		switch (c) {
-			case '\n':
-				++m_line;
-				m_column = -1;
+		default:
+			syntaxError(error::Message::invalidEscape);
 
-				break;
+			break;
+	}
 
-			case '\r': case '\f': case '\v': case ' ': case '\t':
-				break;
+	// Hexadecimal escapes take as many digits as they can fit
+	char32 value = 0;
+	uint32 digits = 0;
 
-			case '*':
-				if (blockCommentMode) {
-					auto it = m_iter + 1;
-					if (it == m_source.end()) break;
+	for (m_iter++; digits < maxDigits && m_iter != m_source.end(); m_iter++, digits++) {
+		auto digit = digitValues[static_cast<uint8>(*m_iter)];
+		if (digit >= 16) break;
 
-					if (*it == '/') {
-						next();
+		value = (value << 4) | digit;
+	}
 
-						--blockCommentMode;
-					}
+	if (digits == 0 || (maxDigits > 2 && (value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF))))
+		syntaxError(error::Message::invalidEscape);
 
-					break;
-				}
+	return value;
+}
 
-				return;
+void Lexer::appendUtf8(lsd::String& output, char32 codePoint) {
+	if (codePoint < 0x80) {
+		output.pushBack(static_cast<char>(codePoint));
+	} else if (codePoint < 0x800) {
+		output.pushBack(static_cast<char>(0xC0 | (codePoint >> 6)));
+		output.pushBack(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	} else if (codePoint < 0x10000) {
+		output.pushBack(static_cast<char>(0xE0 | (codePoint >> 12)));
+		output.pushBack(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		output.pushBack(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	} else {
+		output.pushBack(static_cast<char>(0xF0 | (codePoint >> 18)));
+		output.pushBack(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		output.pushBack(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		output.pushBack(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+}
 
-			case '/': {
-				auto it = m_iter + 1;
-				if (it == m_source.end()) break;
 
-				if (c = *it; c == '/') {
-					++m_line;
-					m_column = -1;
+void Lexer::skipEmpty() {
+	m_tokenFailed = false; // Whitespace is skipped before every token
 
-					for (m_iter += 2; m_iter != m_source.end() && *m_iter != '\n'; m_iter++)
-						;
+	size_type blockCommentMode = 0;
 
-					break;
-				} else if (c == '*') {
-					blockCommentMode += 1;
+	auto it = m_iter;
+	auto end = m_source.end();
 
-					break;
-				}
+	while (it != end) {
+		if (blockCommentMode) { // Inside of block comments, only comment delimiters and null characters have to be checked
+			if (it = simd::findCommentBoundary(it, end); it == end)
+				break;
+			else if (*it == '\0') {
+				if (!skipDisallowed(it)) break;
+				continue;
 			}
 
-			default:
-				if (blockCommentMode) break;
-
-				return;
+			if (auto n = it + 1; n == end) {
+				++it;
+			} else if (*it == '*' && *n == '/') {
+				--blockCommentMode;
+				it += 2;
+			} else if (*it == '/' && *n == '*') {
+				++blockCommentMode;
+				it += 2;
+			} else if (*it == '/' && *n == '/') {
+				it = simd::findLineEnd(n + 1, end);
+			} else ++it;
+
+			continue;
 		}
-	} while ((c = next()) != '\0');
 
-	if (blockCommentMode != 0)
-		throwSyntaxError(error::Message::unclosedBlockComment);
-}
+		if (it = simd::skipBlank(it, end); it == end)
+			break;
+		else if (*it == '\0') {
+			if (!skipDisallowed(it)) break;
+			continue;
+		} else if (*it != '/' || it + 1 == end)
+			break;
 
-char Lexer::next() {
-	if (++m_iter == m_source.end()) return '\0';
+		if (auto n = *(it + 1); n == '/') {
+			it = simd::findLineEnd(it + 2, end);
+		} else if (n == '*') {
+			++blockCommentMode;
+			it += 2;
+		} else break;
+	}
 
-	if (*m_iter == '\0') {
-		throwSyntaxError(error::Message::disallowedChar);
+	m_iter = it;
 
-		return '\0';
-	}
+	if (it != end && *it == '\0')
+		syntaxError(error::Message::disallowedChar);
 
-	++m_column;
-	return *m_iter;
+	if (blockCommentMode != 0)
+		syntaxError(error::Message::unclosedBlockComment);
 }
 
-lsd::String Lexer::currentLine(std::size_t& additionalSpaces) {
-	lsd::String str;
+bool Lexer::skipDisallowed(const char*& it) {
+	if (!m_diagnostics) return false;
 
-	auto it = m_iter;
-	auto begin = it - 1;
-	do {
-		--begin;
-		
-		if (*begin == '\n')
-			break;
+	m_iter = it++;
+	syntaxError(error::Message::disallowedChar);
 
-		it = begin;
-	} while (it != m_source.begin());
+	return true;
+}
 
-	for (auto c = *it; it >= m_source.end() && c != '\n'; ++it, c = *it) {
-		switch (c) {
-			case '\t':
-				str.append(' ', 4);
-				additionalSpaces += 3;
+char Lexer::next() {
+	if (++m_iter == m_source.end()) return '\0';
 
-			case '\r':
-			case '\f':
-			case '\v':
-				break;
+	if (*m_iter == '\0') {
+		syntaxError(error::Message::disallowedChar);
 
-			default:
-				str.pushBack(c);
-		}
+		return '\0';
 	}
 
-	return str;
+	return *m_iter;
 }
 
 } // namespace compiler
@@ -0,0 +1,292 @@
+#include <Elyrium/Compiler/ModuleLoader.hpp>
+
+#include <Elyrium/Core/Error.hpp>
+
+#include <Elyrium/Compiler/Lexer.hpp>
+#include <Elyrium/Compiler/Parser.hpp>
+#include <Elyrium/Compiler/SymbolTable.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <thread>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace {
+
+struct FoundImport {
+public:
+	lsd::String path;
+	TokenBuffer::index_type token;
+};
+
+[[noreturn]] void throwImportError(const TokenBuffer& tokens, lsd::StringView path, TokenBuffer::index_type token, error::Message message) {
+	std::size_t additionalSpaces { };
+	auto source = tokens.lineSource(token, additionalSpaces);
+	auto location = tokens.location(token);
+	auto module = tokens.literals().string(tokens.value(token).literal);
+
+	throw ImportError(path, location.line, location.column + additionalSpaces, source, message, module);
+}
+
+/**
+ * @brief Collects the string tokens of the import declarations of a tree, the same ones which are found when scanning its tokens
+ */
+void collectImports(const lsd::Vector<ast::decl_ptr>& declarations, lsd::Vector<const Token*>& modules) {
+	for (const auto& declaration : declarations) {
+		if (auto import = dynamic_cast<const ast::ImportDecl*>(declaration.get())) {
+			for (const auto& module : import->modules()) {
+				if (module.type() == Token::Type::string)
+					modules.pushBack(&module);
+			}
+		} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(declaration.get()))
+			collectImports(namespaceDecl->declarations(), modules);
+	}
+}
+
+} // namespace
+
+void ModuleLoader::addSearchPath(lsd::StringView path) {
+	m_searchPaths.emplaceBack(std::filesystem::path(path.begin(), path.end()).string().c_str());
+}
+
+size_type ModuleLoader::load(lsd::StringView path) {
+	std::error_code error;
+	auto canonical = std::filesystem::weakly_canonical(std::filesystem::path(path.begin(), path.end()), error);
+	if (error) canonical = std::filesystem::path(path.begin(), path.end());
+
+	size_type root;
+	auto first = m_units.size(); // First unit scheduled by this load
+
+	{
+		std::lock_guard lock(m_mutex);
+
+		m_error = nullptr;
+		root = schedule(lsd::String(canonical.string().c_str()));
+	}
+
+	auto threadCount = m_threadCount;
+	if (threadCount == 0) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	lsd::Vector<std::thread> workers;
+	workers.reserve(threadCount - 1);
+
+	for (size_type i = 1; i < threadCount; i++)
+		workers.emplaceBack([this]() { work(); });
+
+	work();
+
+	for (auto& worker : workers)
+		worker.join();
+
+	if (m_error) {
+		// Queued units were dropped and the others may be half loaded, so every unit of this load is forgotten and loaded again by the next one
+		while (m_units.size() > first) {
+			m_paths.erase(m_units.back()->m_path);
+			m_units.popBack();
+		}
+
+		std::rethrow_exception(std::exchange(m_error, nullptr));
+	}
+
+	return root;
+}
+
+void ModuleLoader::work() {
+	std::unique_lock lock(m_mutex);
+
+	while (true) {
+		// The graph is complete once nothing is queued and no running worker can discover more modules
+		m_condition.wait(lock, [this]() { return !m_queue.empty() || m_running == 0; });
+		if (m_queue.empty()) break;
+
+		auto index = m_queue.back();
+		m_queue.popBack();
+		++m_running;
+
+		lock.unlock();
+
+		try {
+			loadUnit(index);
+		} catch (...) {
+			lock.lock();
+			if (!m_error) m_error = std::current_exception();
+			lock.unlock();
+		}
+
+		lock.lock();
+		--m_running;
+
+		if (m_error) m_queue.clear();
+		if (m_running == 0) m_condition.notify_all();
+	}
+}
+
+void ModuleLoader::loadUnit(size_type index) {
+	Unit* unit;
+
+	{
+		std::lock_guard lock(m_mutex);
+		unit = m_units[index].get();
+	}
+
+	unit->m_source = m_fileSystem.map(unit->m_path);
+
+	if (m_cache && loadCachedUnit(index, *unit))
+		return;
+
+	// Lexing only touches a local symbol table, so modules don't contend for the one of the context
+	SymbolTable symbols;
+	auto tokens = Lexer(unit->m_source.view(), unit->m_path, symbols).tokenize();
+
+	lsd::Vector<FoundImport> imports;
+
+	for (TokenBuffer::index_type i = 0; i < tokens.size(); i++) {
+		if (tokens.type(i) != Token::Type::kImport)
+			continue;
+
+		// Only string literals can be resolved here, constant variables are left to the compiler and malformed declarations to the parser
+		for (auto j = i + 1; ; j += 2) {
+			if (tokens.type(j) == Token::Type::string) {
+				auto path = resolve(unit->m_path, tokens.literals().string(tokens.value(j).literal));
+				if (path.empty()) throwImportError(tokens, unit->m_path, j, error::Message::moduleNotFound);
+
+				imports.pushBack(FoundImport { std::move(path), j });
+			} else if (tokens.type(j) != Token::Type::identifier)
+				break;
+
+			if (tokens.type(j + 1) != Token::Type::comma)
+				break;
+		}
+	}
+
+	lsd::Vector<symbol_id> symbolMap;
+	symbolMap.reserve(symbols.size());
+
+	{
+		std::lock_guard lock(m_mutex);
+
+		for (symbol_id symbol = 0; symbol < symbols.size(); symbol++)
+			symbolMap.pushBack(m_context.symbols().intern(symbols.string(symbol)));
+
+		// Every edge is checked as it is added, so the edge closing a cycle always finds the rest of it
+		for (auto& import : imports) {
+			auto target = schedule(std::move(import.path));
+			if (reaches(target, index)) throwImportError(tokens, unit->m_path, import.token, error::Message::circularImport);
+
+			unit->m_imports.pushBack(Import { target, import.token });
+		}
+	}
+
+	tokens.remapSymbols(symbolMap);
+	unit->m_module = Parser(std::move(tokens), unit->m_path, m_lazyBodies).parse();
+
+	if (m_cache && !m_lazyBodies)
+		m_cache->store(unit->m_path, unit->m_source.view(), unit->m_module);
+}
+
+bool ModuleLoader::loadCachedUnit(size_type index, Unit& unit) {
+	// The mutex is only held while the identifiers of the module are interned into the symbol table of the context
+	if (!m_cache->load(unit.m_path, unit.m_source.view(), unit.m_module, &m_mutex))
+		return false;
+
+	lsd::Vector<const Token*> modules;
+	collectImports(unit.m_module.declarations(), modules);
+
+	lsd::Vector<lsd::String> imports;
+
+	for (auto module : modules) {
+		imports.pushBack(resolve(unit.m_path, unit.m_module.literals().string(module->literal())));
+		if (imports.back().empty()) break;
+	}
+
+	if (imports.empty() || !imports.back().empty()) {
+		std::lock_guard lock(m_mutex);
+
+		bool circular = false;
+
+		for (auto& import : imports) {
+			auto target = schedule(std::move(import));
+			if ((circular = reaches(target, index))) break;
+
+			unit.m_imports.pushBack(Import { target, noToken });
+		}
+
+		if (!circular) return true;
+
+		unit.m_imports.clear();
+	}
+
+	unit.m_module = ast::Module();
+	return false;
+}
+
+size_type ModuleLoader::schedule(lsd::String&& path) {
+	if (auto found = m_paths.find(path); found != m_paths.end())
+		return found->second;
+
+	auto index = m_units.size();
+
+	auto& unit = m_units.emplaceBack(lsd::UniquePointer<Unit>::create());
+	unit->m_path = path;
+
+	m_paths.emplace(std::move(path), index);
+	m_queue.pushBack(index);
+	m_condition.notify_one();
+
+	return index;
+}
+
+bool ModuleLoader::reaches(size_type from, size_type to) const {
+	if (from == to) return true;
+
+	lsd::Vector<size_type> stack { from };
+	lsd::Vector<bool> visited(m_units.size(), false);
+	visited[from] = true;
+
+	while (!stack.empty()) {
+		auto current = stack.back();
+		stack.popBack();
+
+		for (const auto& import : m_units[current]->m_imports) {
+			if (import.unit == to) return true;
+
+			if (!visited[import.unit]) {
+				visited[import.unit] = true;
+				stack.pushBack(import.unit);
+			}
+		}
+	}
+
+	return false;
+}
+
+lsd::String ModuleLoader::resolve(lsd::StringView importer, lsd::StringView name) const {
+	std::filesystem::path file(name.begin(), name.end());
+	if (file.extension() != extension.data()) file += extension.data();
+
+	auto tryPath = [](const std::filesystem::path& path) {
+		std::error_code error;
+		if (!std::filesystem::is_regular_file(path, error)) return lsd::String();
+
+		auto canonical = std::filesystem::weakly_canonical(path, error);
+		return lsd::String((error ? path : canonical).string().c_str());
+	};
+
+	if (auto path = tryPath(std::filesystem::path(importer.begin(), importer.end()).parent_path() / file); !path.empty())
+		return path;
+
+	for (const auto& searchPath : m_searchPaths) {
+		if (auto path = tryPath(std::filesystem::path(searchPath.data()) / file); !path.empty())
+			return path;
+	}
+
+	return lsd::String();
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,1060 @@
+#include <Elyrium/Compiler/Optimizer.hpp>
+
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+#include <LSD/UnorderedFlatMap.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace ir {
+
+namespace {
+
+[[nodiscard]] bool constantLoad(Opcode opcode) noexcept {
+	switch (opcode) {
+		case Opcode::loadConstant:
+		case Opcode::loadInteger:
+		case Opcode::loadNull:
+		case Opcode::loadTrue:
+		case Opcode::loadFalse:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief Returns the generic opcode of an opcode specialized for signed integrals, which computes the same for integral constants
+ */
+[[nodiscard]] Opcode generic(Opcode opcode) noexcept {
+	switch (opcode) {
+		case Opcode::addI64:
+			return Opcode::add;
+		case Opcode::subtractI64:
+			return Opcode::subtract;
+		case Opcode::multiplyI64:
+			return Opcode::multiply;
+		case Opcode::divideI64:
+			return Opcode::divide;
+		case Opcode::moduloI64:
+			return Opcode::modulo;
+		case Opcode::addImmediateI64:
+			return Opcode::addImmediate;
+		case Opcode::negateI64:
+			return Opcode::negate;
+		case Opcode::bitShiftLeftI64:
+			return Opcode::bitShiftLeft;
+		case Opcode::bitShiftRightI64:
+			return Opcode::bitShiftRight;
+		case Opcode::bitNotI64:
+			return Opcode::bitNot;
+		case Opcode::bitAndI64:
+			return Opcode::bitAnd;
+		case Opcode::bitOrI64:
+			return Opcode::bitOr;
+		case Opcode::bitXOrI64:
+			return Opcode::bitXOr;
+		case Opcode::compareI64:
+			return Opcode::compare;
+		case Opcode::equalI64:
+			return Opcode::equal;
+		case Opcode::notEqualI64:
+			return Opcode::notEqual;
+		case Opcode::lessI64:
+			return Opcode::less;
+		case Opcode::lessEqualI64:
+			return Opcode::lessEqual;
+		case Opcode::jumpIfEqualI64:
+			return Opcode::jumpIfEqual;
+		case Opcode::jumpIfNotEqualI64:
+			return Opcode::jumpIfNotEqual;
+		case Opcode::jumpIfLargerI64:
+			return Opcode::jumpIfLarger;
+		case Opcode::jumpIfSmallerI64:
+			return Opcode::jumpIfSmaller;
+		case Opcode::jumpIfLargerEqualI64:
+			return Opcode::jumpIfLargerEqual;
+		case Opcode::jumpIfSmallerEqualI64:
+			return Opcode::jumpIfSmallerEqual;
+
+		default:
+			return opcode;
+	}
+}
+
+[[nodiscard]] bool conditionalJump(Opcode opcode) noexcept {
+	return opcode != Opcode::jump && opcode != Opcode::ret && traits(opcode).control;
+}
+
+/**
+ * @brief Removes the instructions which were replaced by a nop
+ */
+void compact(Block& block) {
+	lsd::Vector<Instruction> instructions;
+
+	for (auto& instruction : block.instructions)
+		if (instruction.code.opcode != Opcode::nop) instructions.pushBack(std::move(instruction));
+
+	block.instructions = std::move(instructions);
+}
+
+
+// Constant propagation
+
+/**
+ * @brief What is known about a value, which only ever goes from unknown over a constant to varying
+ */
+struct Lattice {
+public:
+	enum class State : uint8 {
+		unknown,	// Not computed by any instruction which executes so far
+		constant,
+		varying
+	};
+
+	enum class Type : uint8 {
+		integral,
+		boolean,
+		null
+	};
+
+	State state = State::unknown;
+	Type type = Type::integral;
+	int64 value = 0;
+
+	[[nodiscard]] static constexpr Lattice varying() noexcept {
+		return Lattice { State::varying };
+	}
+	[[nodiscard]] static constexpr Lattice constant(Type type, int64 value) noexcept {
+		return Lattice { State::constant, type, value };
+	}
+
+	[[nodiscard]] constexpr bool operator==(const Lattice&) const noexcept = default;
+
+	[[nodiscard]] constexpr bool integral() const noexcept {
+		return state == State::constant && type == Type::integral;
+	}
+};
+
+[[nodiscard]] Lattice meet(const Lattice& first, const Lattice& second) noexcept {
+	if (first.state == Lattice::State::unknown) return second;
+	if (second.state == Lattice::State::unknown || first == second) return first;
+
+	return Lattice::varying();
+}
+
+[[nodiscard]] Lattice integral(int64 value) noexcept {
+	return Lattice::constant(Lattice::Type::integral, value);
+}
+
+[[nodiscard]] Lattice boolean(bool value) noexcept {
+	return Lattice::constant(Lattice::Type::boolean, value);
+}
+
+/**
+ * @brief Folds an operation on constants, leaving operations which would overflow or whose result depends on the runtime to it
+ */
+[[nodiscard]] Lattice fold(Opcode opcode, const Lattice& left, const Lattice& right, int32 immediate) noexcept {
+	constexpr auto min = std::numeric_limits<int64>::min();
+	constexpr auto max = std::numeric_limits<int64>::max();
+
+	auto sum = [](int64 first, int64 second, Lattice& result) {
+		auto wrapped = static_cast<int64>(static_cast<uint64>(first) + static_cast<uint64>(second));
+		if (((first ^ wrapped) & (second ^ wrapped)) >= 0) result = integral(wrapped);
+	};
+
+	auto result = Lattice::varying();
+	auto a = left.value;
+	auto b = right.value;
+
+	switch (opcode) {
+		case Opcode::negate:
+			if (left.integral() && a != min) result = integral(-a);
+			break;
+		case Opcode::positive:
+			if (left.integral()) result = left;
+			break;
+		case Opcode::bitNot:
+			if (left.integral()) result = integral(~a);
+			break;
+		case Opcode::logicNot:
+			if (left.state == Lattice::State::constant && left.type != Lattice::Type::integral) result = boolean(a == 0);
+			break;
+		case Opcode::addImmediate:
+			if (left.integral()) sum(a, immediate, result);
+			break;
+
+		case Opcode::equal:
+		case Opcode::notEqual:
+			if (left.type == right.type) result = boolean((a == b) == (opcode == Opcode::equal));
+			break;
+
+		default:
+			if (!left.integral() || !right.integral()) break;
+
+			switch (opcode) {
+				case Opcode::add:
+					sum(a, b, result);
+					break;
+				case Opcode::subtract:
+					if (b != min) sum(a, -b, result);
+					break;
+				case Opcode::multiply:
+					if (a == 0 || b == 0) result = integral(0);
+					else if ((a == -1 && b != min) || (b == -1 && a != min)) result = integral(a * b);
+					else if (a != -1 && b != -1) {
+						auto product = static_cast<int64>(static_cast<uint64>(a) * static_cast<uint64>(b));
+						if (product / b == a) result = integral(product);
+					}
+
+					break;
+				// Rounding of negative operands is up to the runtime
+				case Opcode::divide:
+					if (a >= 0 && b > 0) result = integral(a / b);
+					break;
+				case Opcode::modulo:
+					if (a >= 0 && b > 0) result = integral(a % b);
+					break;
+				case Opcode::bitShiftLeft:
+					if (a >= 0 && b >= 0 && b < 63 && a <= (max >> b)) result = integral(a << b);
+					break;
+				case Opcode::bitShiftRight:
+					if (a >= 0 && b >= 0 && b < 64) result = integral(a >> b);
+					break;
+
+				case Opcode::bitAnd:
+					result = integral(a & b);
+					break;
+				case Opcode::bitOr:
+					result = integral(a | b);
+					break;
+				case Opcode::bitXOr:
+					result = integral(a ^ b);
+					break;
+
+				case Opcode::compare:
+					result = integral((a > b) - (a < b));
+					break;
+				case Opcode::less:
+					result = boolean(a < b);
+					break;
+				case Opcode::lessEqual:
+					result = boolean(a <= b);
+					break;
+
+				default:
+					break;
+			}
+	}
+
+	return result;
+}
+
+[[nodiscard]] Lattice evaluate(const Function& function, const Instruction& instruction, const lsd::Vector<Lattice>& lattices) {
+	const auto& code = instruction.code;
+
+	switch (code.opcode) {
+		case Opcode::loadInteger:
+			return integral(bytecode::Instruction::immediate(code.b));
+		case Opcode::loadConstant: {
+			const auto& constant = function.function->constants[code.b];
+			return (constant.type() == bytecode::Constant::Type::integral) ? integral(constant.integral()) : Lattice::varying();
+		}
+		case Opcode::loadNull:
+			return Lattice::constant(Lattice::Type::null, 0);
+		case Opcode::loadTrue:
+			return boolean(true);
+		case Opcode::loadFalse:
+			return boolean(false);
+		case Opcode::move:
+			return lattices[instruction.operands[0]];
+
+		default:
+			if (!traits(code.opcode).pure) return Lattice::varying();
+	}
+
+	Lattice operands[2];
+	auto unknown = false;
+
+	for (size_type i = 0; i < instruction.operands.size(); i++) {
+		operands[i] = lattices[instruction.operands[i]];
+
+		if (operands[i].state == Lattice::State::varying) return Lattice::varying();
+		unknown |= operands[i].state == Lattice::State::unknown;
+	}
+
+	if (unknown) return Lattice { };
+
+	return fold(generic(code.opcode), operands[0], operands[1], bytecode::Instruction::immediate(code.c));
+}
+
+enum class Branch : uint8 {
+	none,		// The condition is unknown yet
+	taken,
+	fallthrough,
+	both
+};
+
+[[nodiscard]] Branch evaluateBranch(const Instruction& instruction, const lsd::Vector<Lattice>& lattices) noexcept {
+	const auto& left = lattices[instruction.operands[0]];
+	const auto& right = lattices[instruction.operands.back()];
+
+	if (left.state == Lattice::State::unknown || right.state == Lattice::State::unknown) return Branch::none;
+	if (left.state == Lattice::State::varying || right.state == Lattice::State::varying) return Branch::both;
+
+	auto taken = false;
+
+	switch (auto opcode = generic(instruction.code.opcode); opcode) {
+		// Only null and booleans have a truth value the optimizer knows of
+		case Opcode::jumpIfTrue:
+		case Opcode::jumpIfFalse:
+			if (left.type == Lattice::Type::integral) return Branch::both;
+			taken = (left.value != 0) == (opcode == Opcode::jumpIfTrue);
+			break;
+
+		case Opcode::jumpIfEqual:
+		case Opcode::jumpIfNotEqual:
+			if (left.type != right.type) return Branch::both;
+			taken = (left.value == right.value) == (opcode == Opcode::jumpIfEqual);
+			break;
+
+		default: {
+			if (!left.integral() || !right.integral()) return Branch::both;
+
+			auto order = (left.value > right.value) - (left.value < right.value);
+
+			switch (opcode) {
+				case Opcode::jumpIfLarger:
+					taken = order > 0;
+					break;
+				case Opcode::jumpIfSmaller:
+					taken = order < 0;
+					break;
+				case Opcode::jumpIfLargerEqual:
+					taken = order >= 0;
+					break;
+				case Opcode::jumpIfSmallerEqual:
+					taken = order <= 0;
+					break;
+
+				default:
+					return Branch::both;
+			}
+		}
+	}
+
+	return taken ? Branch::taken : Branch::fallthrough;
+}
+
+[[nodiscard]] bytecode::Instruction load(Function& function, operand_type reg, const Lattice& lattice) {
+	switch (lattice.type) {
+		case Lattice::Type::null:
+			return bytecode::Instruction { Opcode::loadNull, reg };
+		case Lattice::Type::boolean:
+			return bytecode::Instruction { lattice.value ? Opcode::loadTrue : Opcode::loadFalse, reg };
+
+		default:
+			break;
+	}
+
+	// Same range as the compiler uses for literals
+	if (lattice.value > std::numeric_limits<int16>::min() && lattice.value <= std::numeric_limits<int16>::max())
+		return bytecode::Instruction { Opcode::loadInteger, reg, static_cast<operand_type>(lattice.value) };
+
+	auto& constants = function.function->constants;
+	auto constant = bytecode::Constant::fromIntegral(lattice.value);
+
+	operand_type index = 0;
+	for (; index < constants.size() && constants[index] != constant; index++);
+
+	if (index == constants.size()) constants.pushBack(constant);
+
+	return bytecode::Instruction { Opcode::loadConstant, reg, index };
+}
+
+
+// Common subexpressions
+
+[[nodiscard]] bool commutative(Opcode opcode) noexcept {
+	switch (opcode) {
+		case Opcode::add:
+		case Opcode::multiply:
+		case Opcode::bitAnd:
+		case Opcode::bitOr:
+		case Opcode::bitXOr:
+		case Opcode::equal:
+		case Opcode::notEqual:
+		case Opcode::addI64:
+		case Opcode::multiplyI64:
+		case Opcode::bitAndI64:
+		case Opcode::bitOrI64:
+		case Opcode::bitXOrI64:
+		case Opcode::equalI64:
+		case Opcode::notEqualI64:
+		case Opcode::addU64:
+		case Opcode::multiplyU64:
+		case Opcode::bitAndU64:
+		case Opcode::bitOrU64:
+		case Opcode::bitXOrU64:
+		case Opcode::equalU64:
+		case Opcode::notEqualU64:
+		case Opcode::addF64:
+		case Opcode::multiplyF64:
+		case Opcode::equalF64:
+		case Opcode::notEqualF64:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+void append(lsd::String& key, uint32 value) {
+	key.append(lsd::StringView(reinterpret_cast<const char*>(&value), sizeof(value)));
+}
+
+/**
+ * @brief Returns a key which is equal for instructions computing the same value
+ */
+[[nodiscard]] lsd::String key(const bytecode::Instruction& code, const lsd::Vector<value_id>& operands) {
+	lsd::String key;
+	append(key, static_cast<uint32>(code.opcode));
+
+	const auto& info = describe(code.opcode);
+
+	// Literal operands, like the slot of a load or the immediate of addImmediate
+	for (size_type i = 0; i < 3; i++) {
+		if (info.operands[i] == Operand::reg || info.operands[i] == Operand::none) continue;
+		append(key, (i == 0) ? code.a : ((i == 1) ? code.b : code.c));
+	}
+
+	if (commutative(code.opcode) && operands.size() == 2) {
+		append(key, std::min(operands[0], operands[1]));
+		append(key, std::max(operands[0], operands[1]));
+	} else {
+		for (auto operand : operands)
+			append(key, operand);
+	}
+
+	return key;
+}
+
+} // namespace
+
+void propagateConstants(Function& function) {
+	auto& blocks = function.blocks;
+	auto& values = function.values;
+
+	struct Use {
+	public:
+		block_id block;
+		uint32 index;
+		bool phi;
+	};
+
+	lsd::Vector<Lattice> lattices(values.size());
+	lsd::Vector<lsd::Vector<Use>> uses(values.size());
+
+	lsd::Vector<uint8> executable(blocks.size(), 0);
+	lsd::Vector<lsd::Vector<uint8>> edges(blocks.size()); // Executable edges, in the order of the predecessors
+
+	for (block_id id = 0; id < blocks.size(); id++) {
+		const auto& block = blocks[id];
+		if (block.removed) continue;
+
+		edges[id] = lsd::Vector<uint8>(block.predecessors.size(), 0);
+
+		for (uint32 i = 0; i < block.phis.size(); i++)
+			for (auto operand : block.phis[i].operands)
+				uses[operand].pushBack(Use { id, i, true });
+
+		for (uint32 i = 0; i < block.instructions.size(); i++)
+			for (auto operand : block.instructions[i].operands)
+				uses[operand].pushBack(Use { id, i, false });
+	}
+
+	// Registers may hold anything on entry, and captured ones may change through the closures
+	for (value_id value = 0; value < values.size(); value++)
+		if (values[value].block == noBlock || values[value].pinned) lattices[value] = Lattice::varying();
+
+	lsd::Vector<block_id> blockWorklist;
+	lsd::Vector<value_id> valueWorklist;
+
+	auto update = [&](value_id value, const Lattice& lattice) {
+		auto merged = meet(lattices[value], lattice);
+
+		if (merged != lattices[value]) {
+			lattices[value] = merged;
+			valueWorklist.pushBack(value);
+		}
+	};
+
+	auto visitPhi = [&](block_id id, uint32 index) {
+		const auto& phi = blocks[id].phis[index];
+		Lattice lattice;
+
+		for (size_type i = 0; i < phi.operands.size(); i++)
+			if (edges[id][i]) lattice = meet(lattice, lattices[phi.operands[i]]);
+
+		update(phi.result, lattice);
+	};
+
+	auto markEdge = [&](block_id from, block_id to) {
+		const auto& target = blocks[to];
+		auto added = false;
+
+		for (size_type i = 0; i < target.predecessors.size(); i++) {
+			if (target.predecessors[i] != from || edges[to][i]) continue;
+
+			edges[to][i] = 1;
+			added = true;
+		}
+
+		if (!added) return;
+
+		if (!executable[to]) {
+			executable[to] = 1;
+			blockWorklist.pushBack(to);
+		} else {
+			for (uint32 i = 0; i < target.phis.size(); i++)
+				visitPhi(to, i);
+		}
+	};
+
+	auto visitInstruction = [&](block_id id, uint32 index) {
+		const auto& block = blocks[id];
+		const auto& instruction = block.instructions[index];
+		auto opcode = instruction.code.opcode;
+
+		if (opcode == Opcode::jump) markEdge(id, block.successors[0]);
+		else if (conditionalJump(opcode)) {
+			auto branch = evaluateBranch(instruction, lattices);
+
+			if (branch == Branch::taken || branch == Branch::both) markEdge(id, block.successors[0]);
+			if (branch == Branch::fallthrough || branch == Branch::both) markEdge(id, block.successors.back());
+		} else if (instruction.results[1] != noValue) {
+			update(instruction.results[0], Lattice::varying());
+			update(instruction.results[1], Lattice::varying());
+		} else if (instruction.results[0] != noValue) update(instruction.results[0], evaluate(function, instruction, lattices));
+	};
+
+	executable[0] = 1;
+	blockWorklist.pushBack(0);
+
+	while (!blockWorklist.empty() || !valueWorklist.empty()) {
+		while (!blockWorklist.empty()) {
+			auto id = blockWorklist.back();
+			blockWorklist.popBack();
+
+			const auto& block = blocks[id];
+
+			for (uint32 i = 0; i < block.phis.size(); i++)
+				visitPhi(id, i);
+
+			for (uint32 i = 0; i < block.instructions.size(); i++)
+				visitInstruction(id, i);
+
+			if ((block.instructions.empty() || !traits(block.instructions.back().code.opcode).control) && !block.successors.empty())
+				markEdge(id, block.successors[0]);
+		}
+
+		while (!valueWorklist.empty()) {
+			auto value = valueWorklist.back();
+			valueWorklist.popBack();
+
+			for (const auto& use : uses[value]) {
+				if (!executable[use.block]) continue;
+
+				if (use.phi) visitPhi(use.block, use.index);
+				else visitInstruction(use.block, use.index);
+			}
+		}
+	}
+
+	auto constant = [&](value_id value) {
+		return lattices[value].state == Lattice::State::constant && !values[value].pinned;
+	};
+
+	auto edgeExecutable = [&](block_id from, block_id to) {
+		const auto& predecessors = blocks[to].predecessors;
+
+		for (size_type i = 0; i < predecessors.size(); i++)
+			if (predecessors[i] == from && edges[to][i]) return true;
+
+		return false;
+	};
+
+	struct Edge {
+	public:
+		block_id from;
+		block_id to;
+	};
+
+	lsd::Vector<Edge> removed;
+
+	for (block_id id = 0; id < blocks.size(); id++) {
+		auto& block = blocks[id];
+		if (block.removed || !executable[id]) continue;
+
+		// Constant phis become loads at the start of their block, which makes their operands dead
+		lsd::Vector<Phi> phis;
+		lsd::Vector<Instruction> instructions;
+
+		for (auto& phi : block.phis) {
+			if (constant(phi.result)) {
+				auto& instruction = instructions.emplaceBack();
+
+				instruction.code = load(function, values[phi.result].reg, lattices[phi.result]);
+				instruction.results[0] = phi.result;
+			} else phis.pushBack(std::move(phi));
+		}
+
+		for (auto& instruction : block.instructions) {
+			auto opcode = instruction.code.opcode;
+
+			if (conditionalJump(opcode) && block.successors.size() == 2 && block.successors[0] != block.successors[1]) {
+				auto taken = edgeExecutable(id, block.successors[0]);
+				auto fallthrough = edgeExecutable(id, block.successors[1]);
+
+				if (taken && !fallthrough) {
+					removed.pushBack(Edge { id, block.successors[1] });
+
+					instruction.code = bytecode::Instruction { Opcode::jump };
+					instruction.operands.clear();
+				} else if (fallthrough && !taken) {
+					removed.pushBack(Edge { id, block.successors[0] });
+					continue;
+				}
+			} else if ((opcode == Opcode::checkI64 || opcode == Opcode::checkBool) && constant(instruction.operands[0])) {
+				// Checks of constants the optimizer knows the type of are removed
+				auto type = lattices[instruction.operands[0]].type;
+				if (type == ((opcode == Opcode::checkI64) ? Lattice::Type::integral : Lattice::Type::boolean)) continue;
+			} else if (instruction.results[0] != noValue && instruction.results[1] == noValue && !constantLoad(opcode) && traits(opcode).pure && constant(instruction.results[0])) {
+				instruction.code = load(function, values[instruction.results[0]].reg, lattices[instruction.results[0]]);
+				instruction.operands.clear();
+			}
+
+			instructions.pushBack(std::move(instruction));
+		}
+
+		block.phis = std::move(phis);
+		block.instructions = std::move(instructions);
+	}
+
+	for (const auto& edge : removed)
+		function.removeEdge(edge.from, edge.to);
+
+	function.computeDominators();
+}
+
+void eliminateCommonSubexpressions(Function& function) {
+	auto& values = function.values;
+
+	lsd::Vector<value_id> replacements(values.size(), noValue);
+	lsd::Vector<value_id> numbers(values.size()); // Values known to be equal share a number, which is one of them
+	lsd::UnorderedFlatMap<lsd::String, value_id> available;
+
+	for (value_id value = 0; value < values.size(); value++)
+		numbers[value] = value;
+
+	auto resolve = [&](value_id value) {
+		while (replacements[value] != noValue) value = replacements[value];
+		return value;
+	};
+
+	auto replace = [&](Instruction& instruction, value_id value) {
+		function.moveValue(value);
+
+		replacements[instruction.results[0]] = value;
+		instruction.code.opcode = Opcode::nop;
+	};
+
+	auto tree = function.dominatorTree();
+	lsd::Vector<block_id> stack;
+	stack.pushBack(0);
+
+	// Blocks are visited in preorder, so an available value not dominating a block was computed in a subtree which is done
+	while (!stack.empty()) {
+		auto id = stack.back();
+		stack.popBack();
+
+		for (auto child : tree[id])
+			stack.pushBack(child);
+
+		auto& block = function.blocks[id];
+
+		// Loads are only reused within their block, as writes on other paths aren't tracked
+		lsd::UnorderedFlatMap<lsd::String, value_id> variables; // Globals and upvalues
+		lsd::UnorderedFlatMap<lsd::String, value_id> objects; // Members and elements
+
+		for (auto& instruction : block.instructions) {
+			lsd::Vector<value_id> numbered;
+			auto pinned = false;
+
+			for (auto& operand : instruction.operands) {
+				operand = resolve(operand);
+
+				numbered.pushBack(numbers[operand]);
+				pinned |= values[operand].pinned;
+			}
+
+			auto opcode = instruction.code.opcode;
+			auto traits = ir::traits(opcode);
+
+			switch (opcode) {
+				case Opcode::call:
+				case Opcode::close:
+					variables.clear();
+					objects.clear();
+					continue;
+
+				case Opcode::storeMember:
+				case Opcode::storeIndex:
+					objects.clear();
+					continue;
+
+				case Opcode::storeGlobal:
+				case Opcode::storeUpvalue: {
+					// Loads of the slot afterwards use the stored value directly
+					auto load = (opcode == Opcode::storeGlobal) ? Opcode::loadGlobal : Opcode::loadUpvalue;
+
+					if (pinned) variables.clear();
+					else variables[key(bytecode::Instruction { load, 0, instruction.code.a }, { })] = instruction.operands[0];
+
+					continue;
+				}
+
+				case Opcode::loadGlobal:
+				case Opcode::loadUpvalue:
+				case Opcode::loadMember:
+				case Opcode::loadIndex: {
+					if (pinned || values[instruction.results[0]].pinned) continue;
+
+					auto& table = (opcode == Opcode::loadGlobal || opcode == Opcode::loadUpvalue) ? variables : objects;
+					auto key = ir::key(instruction.code, numbered);
+
+					if (auto found = table.find(key); found != table.end()) replace(instruction, found->second);
+					else table.emplace(std::move(key), instruction.results[0]);
+
+					continue;
+				}
+
+				default:
+					break;
+			}
+
+			if (!traits.pure || pinned || values[instruction.results[0]].pinned) continue;
+
+			if (opcode == Opcode::move) {
+				numbers[instruction.results[0]] = numbered[0];
+				continue;
+			}
+
+			auto key = ir::key(instruction.code, numbered);
+			auto found = available.find(key);
+
+			if (found == available.end()) available.emplace(std::move(key), instruction.results[0]);
+			else if (!function.dominates(values[found->second].block, id)) found->second = instruction.results[0];
+			else if (constantLoad(opcode)) numbers[instruction.results[0]] = found->second; // Loading a constant again is cheaper than keeping it in a register
+			else replace(instruction, found->second);
+		}
+
+		compact(block);
+	}
+
+	function.replaceUses(replacements);
+}
+
+void hoistLoopInvariants(Function& function) {
+	auto& blocks = function.blocks;
+	auto& values = function.values;
+
+	lsd::Vector<value_id> replacements(values.size(), noValue);
+
+	auto resolve = [&](value_id value) {
+		while (replacements[value] != noValue) value = replacements[value];
+		return value;
+	};
+
+	struct Loop {
+	public:
+		block_id header;
+		lsd::Vector<block_id> body; // In reverse postorder
+	};
+
+	lsd::Vector<uint32> order(blocks.size(), 0);
+
+	for (uint32 i = 0; i < function.reversePostorder.size(); i++)
+		order[function.reversePostorder[i]] = i;
+
+	// Loops are found through the edges back to a block dominating their source
+	lsd::Vector<Loop> loops;
+	lsd::Vector<uint8> inLoop(blocks.size(), 0);
+
+	for (auto header : function.reversePostorder) {
+		lsd::Vector<block_id> worklist;
+
+		for (auto predecessor : blocks[header].predecessors)
+			if (function.dominates(header, predecessor)) worklist.pushBack(predecessor);
+
+		if (worklist.empty()) continue;
+
+		auto& loop = loops.emplaceBack(Loop { header, { } });
+		loop.body.pushBack(header);
+		inLoop[header] = 1;
+
+		while (!worklist.empty()) {
+			auto id = worklist.back();
+			worklist.popBack();
+
+			if (inLoop[id]) continue;
+
+			inLoop[id] = 1;
+			loop.body.pushBack(id);
+
+			for (auto predecessor : blocks[id].predecessors)
+				worklist.pushBack(predecessor);
+		}
+
+		for (auto id : loop.body)
+			inLoop[id] = 0;
+
+		std::sort(loop.body.begin(), loop.body.end(), [&](block_id first, block_id second) {
+			return order[first] < order[second];
+		});
+	}
+
+	// Inner loops come first, so what they hoist may be hoisted out of the loops around them as well
+	std::stable_sort(loops.begin(), loops.end(), [](const Loop& first, const Loop& second) {
+		return first.body.size() < second.body.size();
+	});
+
+	// Constants and copies flowing into phis or calls are copied into place anyways, so hoisting them gains nothing
+	lsd::Vector<uint8> copied(values.size(), 0);
+
+	for (const auto& block : blocks) {
+		if (block.removed) continue;
+
+		for (const auto& phi : block.phis)
+			for (auto operand : phi.operands)
+				copied[operand] = 1;
+
+		for (const auto& instruction : block.instructions)
+			if (instruction.code.opcode == Opcode::call)
+				for (auto operand : instruction.operands)
+					copied[operand] = 1;
+	}
+
+	for (const auto& loop : loops) {
+		auto preheader = noBlock;
+		auto entries = 0;
+
+		for (auto id : loop.body)
+			inLoop[id] = 1;
+
+		for (auto predecessor : blocks[loop.header].predecessors) {
+			if (inLoop[predecessor]) continue;
+
+			preheader = predecessor;
+			entries++;
+		}
+
+		auto writes = false;
+
+		for (auto id : loop.body)
+			for (const auto& instruction : blocks[id].instructions)
+				writes |= traits(instruction.code.opcode).writes;
+
+		if (entries == 1 && blocks[preheader].successors.size() == 1) {
+			auto invariant = [&](value_id value) {
+				const auto& defined = values[value];
+				return !defined.pinned && (defined.block == noBlock || !inLoop[defined.block]);
+			};
+
+			auto hoistable = [&](const Instruction& instruction, bool header) {
+				auto opcode = instruction.code.opcode;
+				auto traits = ir::traits(opcode);
+
+				if (instruction.results[0] == noValue || instruction.results[1] != noValue || values[instruction.results[0]].pinned) return false;
+				if ((!traits.pure && !traits.reads) || traits.writes || opcode == Opcode::loadMethod) return false;
+				if ((constantLoad(opcode) || opcode == Opcode::move) && copied[instruction.results[0]]) return false;
+				if ((traits.reads && writes) || (traits.throws && !header)) return false;
+
+				for (auto operand : instruction.operands)
+					if (!invariant(operand)) return false;
+
+				return true;
+			};
+
+			lsd::Vector<Instruction> hoisted;
+			lsd::UnorderedFlatMap<lsd::String, value_id> available; // Hoisted values, which equal instructions of the loop reuse
+
+			for (auto changed = true; changed;) {
+				changed = false;
+
+				for (auto id : loop.body) {
+					// Instructions which may throw are only hoisted if nothing observable happens before them
+					auto header = id == loop.header;
+
+					for (auto& instruction : blocks[id].instructions) {
+						if (instruction.code.opcode == Opcode::nop) continue;
+
+						for (auto& operand : instruction.operands)
+							operand = resolve(operand);
+
+						if (hoistable(instruction, header)) {
+							auto result = instruction.results[0];
+							auto key = ir::key(instruction.code, instruction.operands);
+
+							values[result].block = preheader;
+
+							if (auto found = available.find(key); found != available.end()) replacements[result] = found->second;
+							else {
+								function.moveValue(result);
+								available.emplace(std::move(key), result);
+
+								hoisted.pushBack(instruction);
+							}
+
+							instruction.code.opcode = Opcode::nop;
+							changed = true;
+						} else {
+							auto traits = ir::traits(instruction.code.opcode);
+							header &= !traits.throws && !traits.writes;
+						}
+					}
+				}
+			}
+
+			if (!hoisted.empty()) {
+				for (auto id : loop.body)
+					compact(blocks[id]);
+
+				auto& instructions = blocks[preheader].instructions;
+				auto terminated = !instructions.empty() && traits(instructions.back().code.opcode).control;
+
+				Instruction terminator;
+
+				if (terminated) {
+					terminator = std::move(instructions.back());
+					instructions.popBack();
+				}
+
+				for (auto& instruction : hoisted)
+					instructions.pushBack(std::move(instruction));
+
+				if (terminated) instructions.pushBack(std::move(terminator));
+			}
+		}
+
+		for (auto id : loop.body)
+			inLoop[id] = 0;
+	}
+
+	function.replaceUses(replacements);
+}
+
+void eliminateDeadCode(Function& function) {
+	auto& values = function.values;
+
+	lsd::Vector<uint8> live(values.size(), 0);
+	lsd::Vector<const lsd::Vector<value_id>*> operands(values.size(), nullptr);
+	lsd::Vector<value_id> worklist;
+
+	auto mark = [&](value_id value) {
+		if (live[value]) return;
+
+		live[value] = 1;
+		worklist.pushBack(value);
+	};
+
+	auto root = [&](const Instruction& instruction) {
+		auto traits = ir::traits(instruction.code.opcode);
+
+		if (traits.throws || traits.writes || traits.control) return true;
+
+		for (auto result : instruction.results)
+			if (result != noValue && values[result].pinned) return true;
+
+		return false;
+	};
+
+	for (auto& block : function.blocks) {
+		if (block.removed) continue;
+
+		for (const auto& phi : block.phis) {
+			operands[phi.result] = &phi.operands;
+			if (values[phi.result].pinned) mark(phi.result);
+		}
+
+		for (const auto& instruction : block.instructions) {
+			for (auto result : instruction.results)
+				if (result != noValue) operands[result] = &instruction.operands;
+
+			if (!root(instruction)) continue;
+
+			for (auto operand : instruction.operands)
+				mark(operand);
+		}
+	}
+
+	while (!worklist.empty()) {
+		auto value = worklist.back();
+		worklist.popBack();
+
+		if (operands[value])
+			for (auto operand : *operands[value])
+				mark(operand);
+	}
+
+	for (auto& block : function.blocks) {
+		if (block.removed) continue;
+
+		lsd::Vector<Phi> phis;
+
+		for (auto& phi : block.phis)
+			if (live[phi.result]) phis.pushBack(std::move(phi));
+
+		block.phis = std::move(phis);
+
+		for (auto& instruction : block.instructions) {
+			auto used = root(instruction);
+
+			for (auto result : instruction.results)
+				used |= result != noValue && live[result];
+
+			if (!used) instruction.code.opcode = Opcode::nop;
+		}
+
+		compact(block);
+	}
+}
+
+} // namespace ir
+
+lsd::Vector<bytecode::Instruction> optimize(const lsd::Vector<bytecode::Instruction>& code, bytecode::Function& function, const bytecode::Program& program, OptimizationLevel level) {
+	if (level == OptimizationLevel::none) return code;
+
+	auto ir = ir::build(code, function, program);
+
+	ir::propagateConstants(ir);
+
+	if (level == OptimizationLevel::full) {
+		ir::eliminateCommonSubexpressions(ir);
+		ir::hoistLoopInvariants(ir);
+	}
+
+	ir::eliminateDeadCode(ir);
+
+	return ir::lower(ir);
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -2,9 +2,9 @@
 #include "Elyrium/Compiler/Token.hpp"
 #include "Elyrium/Core/Error.hpp"
 #include <Elyrium/Compiler/Parser.hpp>
+#include <Elyrium/Compiler/StreamLexer.hpp>
 
-#include <LSD/UnorderedFlatMap.h>
-#include <LSD/UnorderedFlatSet.h>
+#include <LSD/Array.h>
 
 using namespace lsd::enum_operators;
 
@@ -12,270 +12,576 @@ namespace elyrium {
 
 namespace compiler {
 
-Parser::Parser(lsd::StringView source, lsd::StringView path) :
-	m_path(path), m_source(std::move(source)), m_lexer(m_source, m_path), m_current(m_lexer.nextToken()) {
-	m_last = m_current;
+namespace {
+
+// Operator tables
+
+enum OperatorRole : uint8 {
+	operandRole = 1 << 0,
+	prefixRole = 1 << 1,
+	postfixRole = 1 << 2,
+	infixRole = 1 << 3
+};
+
+struct OperatorDescription {
+public:
+	Token::Type type;
+	uint8 roles;
+	Parser::Precedence precedence = Parser::Precedence::atomic; // Binding power as an infix operator
+};
+
+// Every table the expression parsers dispatch on is generated from this description
+inline constexpr lsd::Array operatorDescriptions {
+	OperatorDescription { Token::Type::identifier, operandRole },
+	OperatorDescription { Token::Type::integral, operandRole },
+	OperatorDescription { Token::Type::unsignedIntegral, operandRole },
+	OperatorDescription { Token::Type::floating, operandRole },
+	OperatorDescription { Token::Type::character, operandRole },
+	OperatorDescription { Token::Type::string, operandRole },
+	OperatorDescription { Token::Type::kTrue, operandRole },
+	OperatorDescription { Token::Type::kFalse, operandRole },
+	OperatorDescription { Token::Type::kNull, operandRole },
+	OperatorDescription { Token::Type::kFunc, operandRole }, // Closures
+
+	OperatorDescription { Token::Type::increment, prefixRole | postfixRole },
+	OperatorDescription { Token::Type::decrement, prefixRole | postfixRole },
+	OperatorDescription { Token::Type::logicNot, prefixRole },
+	OperatorDescription { Token::Type::bitNot, prefixRole },
+
+	OperatorDescription { Token::Type::mul, infixRole, Parser::Precedence::factor },
+	OperatorDescription { Token::Type::div, infixRole, Parser::Precedence::factor },
+	OperatorDescription { Token::Type::mod, infixRole, Parser::Precedence::factor },
+
+	OperatorDescription { Token::Type::add, prefixRole | infixRole, Parser::Precedence::term },
+	OperatorDescription { Token::Type::sub, prefixRole | infixRole, Parser::Precedence::term },
+
+	OperatorDescription { Token::Type::shiftLeft, infixRole, Parser::Precedence::shift },
+	OperatorDescription { Token::Type::shiftRight, infixRole, Parser::Precedence::shift },
+
+	OperatorDescription { Token::Type::spaceship, infixRole, Parser::Precedence::spaceship },
+	OperatorDescription { Token::Type::greater, infixRole, Parser::Precedence::comparison },
+	OperatorDescription { Token::Type::less, infixRole, Parser::Precedence::comparison },
+	OperatorDescription { Token::Type::greaterEqual, infixRole, Parser::Precedence::comparison },
+	OperatorDescription { Token::Type::lessEqual, infixRole, Parser::Precedence::comparison },
+	OperatorDescription { Token::Type::equal, infixRole, Parser::Precedence::equality },
+	OperatorDescription { Token::Type::notEqual, infixRole, Parser::Precedence::equality },
+
+	OperatorDescription { Token::Type::bitAnd, prefixRole | infixRole, Parser::Precedence::bitAnd }, // Also the dereference operator
+	OperatorDescription { Token::Type::bitXOr, infixRole, Parser::Precedence::bitXOr },
+	OperatorDescription { Token::Type::bitOr, infixRole, Parser::Precedence::bitOr },
+
+	OperatorDescription { Token::Type::logicAnd, infixRole, Parser::Precedence::logicAnd },
+	OperatorDescription { Token::Type::logicOr, infixRole, Parser::Precedence::logicOr },
+
+	OperatorDescription { Token::Type::assign, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignMul, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignDiv, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignMod, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignAdd, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignSub, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignShiftLeft, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignShiftRight, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignBitAnd, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignBitXOr, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignBitOr, infixRole, Parser::Precedence::assign },
+	OperatorDescription { Token::Type::assignBitNot, infixRole, Parser::Precedence::assign },
+};
+
+inline constexpr size_type tokenTypeCount = static_cast<size_type>(Token::Type::attribute) + 1;
+
+struct OperatorTable {
+public:
+	lsd::Array<uint8, tokenTypeCount> roles { };
+	lsd::Array<Parser::Precedence, tokenTypeCount> precedences { };
+};
+
+consteval OperatorTable makeOperatorTable() {
+	OperatorTable table { };
+
+	for (const auto& description : operatorDescriptions) {
+		table.roles[static_cast<size_type>(description.type)] |= description.roles;
+		table.precedences[static_cast<size_type>(description.type)] = description.precedence;
+	}
+
+	return table;
+}
+
+inline constexpr OperatorTable operatorTable = makeOperatorTable();
+
+constexpr bool hasRole(Token::Type type, OperatorRole role) noexcept {
+	return (operatorTable.roles[static_cast<size_type>(type)] & role) != 0;
+}
+
+constexpr bool isExpressionStart(Token::Type type) noexcept {
+	return (operatorTable.roles[static_cast<size_type>(type)] & (operandRole | prefixRole)) != 0;
+}
+
+constexpr Parser::Precedence infixPrecedence(Token::Type type) noexcept {
+	return operatorTable.precedences[static_cast<size_type>(type)];
+}
+
+TokenBuffer tokenize(Lexer&& lexer, size_type threadCount) {
+	return (threadCount == 1) ? lexer.tokenize() : lexer.tokenizeParallel(threadCount);
+}
+
+} // namespace
+
+Parser::Parser(Context& context, lsd::StringView source, lsd::StringView path, bool lazyBodies) :
+	m_path(path), m_source(std::move(source)), m_tokens(tokenize(Lexer(m_source, m_path, context.symbols()), context.lexerThreadCount())), m_lazyBodies(lazyBodies) { }
+
+Parser::Parser(TokenBuffer&& tokens, lsd::StringView path, bool lazyBodies) :
+	m_path(path), m_source(tokens.source()), m_tokens(std::move(tokens)), m_lazyBodies(lazyBodies) { }
+
+Parser::Parser(Context& context, lsd::StringView source, lsd::StringView path, Diagnostics& diagnostics, bool lazyBodies) :
+	m_path(path), m_source(std::move(source)), m_tokens(tokenize(Lexer(m_source, m_path, context.symbols(), diagnostics), context.lexerThreadCount())), m_lazyBodies(lazyBodies), m_diagnostics(&diagnostics) { }
+
+Parser::Parser(Context& context, filesys::InputStream& input, lsd::String& source, lsd::StringView path, bool lazyBodies) :
+	m_path(path), m_tokens(StreamLexer(input, path, context.symbols()).tokenize(source)), m_lazyBodies(lazyBodies) {
+	m_source = m_tokens.source();
 }
 
 ast::Module Parser::parse() {
 	ast::Module module;
 
-	while (m_current.type() != Token::Type::eof)
+	while (currentType() != Token::Type::eof) {
+		auto start = m_current;
 		module.bindDeclaration(parseDeclaration());
 
+		if (m_panic && !synchronize(start)) break;
+	}
+
+	if (m_diagnostics) m_diagnostics->sort(); // Lexer errors were all reported before the parser ran
+
+	module.bindLiterals(m_tokens.releaseLiterals());
+	module.bindArena(std::move(m_arena));
+
+	if (m_lazyBodies)
+		module.bindTokens(std::move(m_tokens), m_path);
+
 	return module;
 }
 
+void Parser::parseLazyBody(ast::Module& module, ast::FunctionDecl& function) {
+	parseLazyBody<ast::FunctionDecl>(module, function);
+}
+
+void Parser::parseLazyBody(ast::Module& module, ast::ClosureExpr& closure) {
+	parseLazyBody<ast::ClosureExpr>(module, closure);
+}
+
+template <class Node> void Parser::parseLazyBody(ast::Module& module, Node& node) {
+	if (!node.lazy())
+		return;
+
+	// The parser borrows the tokens and the arena of the module, nodes keep their addresses since the arena blocks never move
+	Parser parser(module.releaseTokens(), module.path(), true);
+	parser.m_arena = module.releaseArena();
+	parser.m_current = node.lazyBody().first;
+	parser.m_last = parser.m_current;
+
+	try {
+		node.bindBody(parser.parseBlockStatement());
+	} catch (...) {
+		module.bindTokens(std::move(parser.m_tokens), parser.m_path);
+		module.bindArena(std::move(parser.m_arena));
+
+		throw;
+	}
+
+	module.bindTokens(std::move(parser.m_tokens), parser.m_path);
+	module.bindArena(std::move(parser.m_arena));
+}
+
+ast::FlatModule Parser::parseFlat() {
+	while (currentType() != Token::Type::eof) {
+		auto start = m_current;
+		m_flat.bindDeclaration(parseFlatDeclaration());
+
+		if (m_panic && !synchronize(start)) break;
+	}
+
+	if (m_diagnostics) m_diagnostics->sort(); // Lexer errors were all reported before the parser ran
+
+	m_flat.bindTokens(std::move(m_tokens));
+
+	return std::move(m_flat);
+}
+
 
-Token& Parser::next() {
+Token::Type Parser::next() {
 	m_last = m_current;
-	return m_current = m_lexer.nextToken();
+
+	if (m_current + 1 < m_tokens.size()) // The last token is always eof, which is never advanced past
+		++m_current;
+
+	return m_tokens.type(m_current);
 }
 
 void Parser::consume(bool cond, error::Message message, char expected) {
-	verify(cond, message, expected);
-	next();
+	if (verify(cond, message, expected)) next();
 }
 
-void Parser::verify(bool cond, error::Message message, char expected) const {
-	if (!cond) {
-		std::size_t additionalSpaces { };
-		auto source = m_last.lineSource(additionalSpaces);
-		throw SyntaxError(m_path, m_last.line(), m_last.column() + additionalSpaces, source, message, expected);
+bool Parser::verify(bool cond, error::Message message, char expected) {
+	if (cond) return true;
+
+	if (m_diagnostics) {
+		if (!m_panic) m_diagnostics->report(message, m_tokens.offset(m_last), expected);
+		m_panic = true;
+
+		return false;
 	}
+
+	std::size_t additionalSpaces { };
+	auto source = m_tokens.lineSource(m_last, additionalSpaces);
+	auto location = m_tokens.location(m_last);
+	throw SyntaxError(m_path, location.line, location.column + additionalSpaces, source, message, expected);
 }
 
+bool Parser::synchronize(TokenBuffer::index_type start) {
+	m_panic = false;
 
-// Expressions
+	if (m_current != start && (m_tokens.type(m_last) == Token::Type::semicolon || m_tokens.type(m_last) == Token::Type::braceRight))
+		return true; // The failed construct still reached its end
 
-ast::expr_ptr Parser::parseExpression(Precedence precedence, ast::expr_ptr&& expr) {
-	static const lsd::UnorderedFlatMap<Token::Type, Precedence> infixParsers {
-		{ Token::Type::mul, Precedence::factor },
-		{ Token::Type::div, Precedence::factor },
-		{ Token::Type::mod, Precedence::factor },
-
-		{ Token::Type::add, Precedence::term },
-		{ Token::Type::sub, Precedence::term },
-
-		{ Token::Type::shiftLeft, Precedence::shift },
-		{ Token::Type::shiftRight, Precedence::shift },
-
-		{ Token::Type::spaceship, Precedence::spaceship },
-		{ Token::Type::greater, Precedence::comparison},
-		{ Token::Type::less, Precedence::comparison },
-		{ Token::Type::greaterEqual, Precedence::comparison },
-		{ Token::Type::lessEqual, Precedence::comparison },
-		{ Token::Type::equal, Precedence::equality },
-		{ Token::Type::notEqual, Precedence::equality },
-
-		{ Token::Type::bitAnd, Precedence::bitAnd },
-		{ Token::Type::bitXOr, Precedence::bitXOr },
-		{ Token::Type::bitOr, Precedence::bitOr },
-
-		{ Token::Type::logicAnd, Precedence::logicAnd },
-		{ Token::Type::logicOr, Precedence::logicOr },
-
-		{ Token::Type::assign, Precedence::assign },
-		{ Token::Type::assignMul, Precedence::assign },
-		{ Token::Type::assignDiv, Precedence::assign },
-		{ Token::Type::assignMod, Precedence::assign },
-		{ Token::Type::assignAdd, Precedence::assign },
-		{ Token::Type::assignSub, Precedence::assign },
-		{ Token::Type::assignShiftLeft, Precedence::assign },
-		{ Token::Type::assignShiftRight, Precedence::assign },
-		{ Token::Type::assignBitAnd, Precedence::assign },
-		{ Token::Type::assignBitXOr, Precedence::assign },
-		{ Token::Type::assignBitOr, Precedence::assign },
-		{ Token::Type::assignBitNot, Precedence::assign },
-	};
+	for (size_type depth = 0; currentType() != Token::Type::eof; next()) {
+		switch (currentType()) {
+			case Token::Type::semicolon:
+				if (depth == 0) {
+					next();
 
-	bool grouped = m_current.type() == Token::Type::parenLeft;
-	if (grouped) { // When parsing a grouped expression, the precedence should be reset to parse the entire group
-		precedence = Precedence::atomic;
+					return true;
+				}
 
-		next();
-	}
+				break;
 
-	auto expression = expr ? std::move(expr) : parseUnaryExpression();
-	ast::expr_ptr rightExpr { };
+			case Token::Type::braceLeft:
+				++depth;
 
-	while (m_current.type() != Token::Type::eof) {
-		auto parserIt = infixParsers.find(m_current.type());
-		if (parserIt == infixParsers.end())
-			break;
+				break;
 
-		if (precedence == Precedence::assignRight) // Simulate right-associativity with assignment
-			precedence = Precedence::assignLeft;
+			case Token::Type::braceRight:
+				if (depth == 0) {
+					if (m_current == start) break; // A stray brace which the failed construct started at is skipped to make progress
 
+					return true;
+				}
 
-		if (auto newPrec = parserIt->second; newPrec <= precedence) { // Continue parsing in cases where binding power decreases
-			precedence = newPrec;
+				if (--depth == 0) {
+					next();
 
-			if (rightExpr) expression->bindRight(std::move(rightExpr));
+					return true;
+				}
 
-			expression = parseInfixExpression(std::move(expression));
-			rightExpr = parseUnaryExpression();
-		} else {
-			expression->bindRight(parseExpression(newPrec, std::move(rightExpr)));
+				break;
+
+			default:
+				break;
 		}
 	}
-	
-	if (rightExpr) expression->bindRight(std::move(rightExpr));
 
-	if (grouped)
-		consume(m_current.type() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+	m_panic = true;
 
-	return expression;
+	return false;
 }
 
-ast::expr_ptr Parser::parseUnaryExpression() {
-	static constexpr lsd::Array legalTokenTypes = {
-		Token::Type::add,
-		Token::Type::sub,
-		Token::Type::increment,
-		Token::Type::decrement,
-		Token::Type::deref,
-		Token::Type::logicNot,
-		Token::Type::bitNot,
-		Token::Type::increment,
-		Token::Type::decrement,
-		Token::Type::identifier,
-		Token::Type::integral,
-		Token::Type::kTrue,
-		Token::Type::kFalse,
-		Token::Type::kNull,
-		Token::Type::unsignedIntegral,
-		Token::Type::character,
-		Token::Type::string,
-	};
 
-	static const lsd::UnorderedFlatSet<Token::Type> prefixOperators {
-		Token::Type::add,
-		Token::Type::sub,
-		Token::Type::increment,
-		Token::Type::decrement,
-		Token::Type::deref,
-		Token::Type::logicNot,
-		Token::Type::bitNot,
-	};
+// Expressions
 
-	static const lsd::UnorderedFlatSet<Token::Type> postfixOperators {
-		Token::Type::increment,
-		Token::Type::decrement,
-	};
+ast::infix_expr_ptr Parser::parseInfixExpression(ast::expr_ptr&& rightExpr) {
+	auto expr = m_arena.create<ast::InfixExpr>(currentToken(), std::move(rightExpr));
+	next();
 
-	// Check for special expressions first
-	switch (m_current.type()) {
-		case Token::Type::kFunc:
-			parseClosure();
+	return expr;
+}
 
-		default:
+ast::expr_ptr Parser::parseClosure() {
+	auto value = m_arena.create<ast::ClosureExpr>();
+
+	if (next() == Token::Type::braceLeft) {
+		while (next() != Token::Type::braceRight) {
+			value->bindCaptureExpression(parseExpression());
+			
+			if (currentType() != Token::Type::comma)
+				break;
+		}
+
+		consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
 	}
 
-	bool legal = false;
+	value->bindConstruct(parseFunctionConstruct());
+
+	if (m_lazyBodies) value->bindLazyBody(preParseBlockStatement());
+	else value->bindBody(parseBlockStatement());
 
-	for (auto type : legalTokenTypes) {
-		if (m_current.type() == type) {
-			legal = true;
-			break;
+	return value;
+}
+
+
+ast::expr_ptr Parser::parseExpression() {
+	using enum ExpressionFrame::Resume;
+
+	auto bottom = m_frames.size(); // Closures parse their bodies with another call, whose frames are stacked on top
+
+	auto step = ExpressionStep::expression;
+	auto precedence = Precedence::atomic;
+	ast::expr_ptr value; // Operand an expression starts with, or the result of the last finished call
+
+	while (true) {
+		switch (step) {
+			case ExpressionStep::expression: { // Corresponds to parseFlatExpression()
+				m_frames.emplaceBack();
+
+				auto& frame = m_frames.back();
+				frame.precedence = std::exchange(precedence, Precedence::atomic); // Only nested expressions start at a different precedence
+				frame.expression = std::move(value);
+
+				if (currentType() == Token::Type::parenLeft) {
+					frame.grouped = true;
+					frame.precedence = Precedence::atomic;
+
+					next();
+				}
+
+				if (frame.expression) {
+					step = continueInfixExpression(value, precedence);
+				} else {
+					frame.resume = first;
+					step = ExpressionStep::operand;
+				}
+
+				break;
+			}
+
+			case ExpressionStep::operand: { // Corresponds to parseFlatUnaryExpression() and parseFlatAtomicMemberExpression()
+				if (!verify(isExpressionStart(currentType()), error::Message::expectedExpression)) {
+					value = m_arena.create<ast::AtomicExpr>(currentToken());
+					step = ExpressionStep::resume;
+
+					break;
+				}
+
+				auto prefixes = m_current;
+				while (currentType() != Token::Type::eof && hasRole(currentType(), prefixRole))
+					next();
+
+				auto prefixCount = m_current - prefixes;
+				step = ExpressionStep::resume;
+
+				if (currentType() == Token::Type::eof) { // The source ended before the operand
+					value = finishOperand(nullptr, prefixes, prefixCount);
+				} else if (currentType() == Token::Type::parenLeft) {
+					m_frames.emplaceBack();
+
+					auto& frame = m_frames.back();
+					frame.prefixes = prefixes;
+					frame.prefixCount = prefixCount;
+					frame.resume = base;
+
+					step = ExpressionStep::expression;
+				} else {
+					if (currentType() == Token::Type::kFunc) {
+						value = parseClosure();
+					} else {
+						value = m_arena.create<ast::AtomicExpr>(currentToken());
+
+						next();
+					}
+
+					switch (currentType()) {
+						case Token::Type::dot:
+						case Token::Type::parenLeft:
+						case Token::Type::bracketLeft: {
+							m_frames.emplaceBack();
+
+							auto& frame = m_frames.back();
+							frame.prefixes = prefixes;
+							frame.prefixCount = prefixCount;
+							frame.member = m_arena.create<ast::MemberExpr>(std::move(value));
+
+							step = continueMemberExpression(value);
+
+							break;
+						}
+
+						default: // Operands without member accesses, calls or subscripts don't need a frame
+							value = finishOperand(std::move(value), prefixes, prefixCount);
+
+							break;
+					}
+				}
+
+				break;
+			}
+
+			case ExpressionStep::resume: { // Returns the value to the suspended caller
+				if (m_frames.size() == bottom)
+					return value;
+
+				auto& frame = m_frames.back();
+
+				switch (frame.resume) {
+					case first:
+						frame.expression = std::move(value);
+						step = continueInfixExpression(value, precedence);
+
+						break;
+
+					case right:
+						frame.rightExpr = std::move(value);
+						step = continueInfixExpression(value, precedence);
+
+						break;
+
+					case nested:
+						frame.expression->bindRight(std::move(value));
+						step = continueInfixExpression(value, precedence);
+
+						break;
+
+					case base:
+						frame.member = m_arena.create<ast::MemberExpr>(std::move(value));
+						step = continueMemberExpression(value);
+
+						break;
+
+					case argument:
+						frame.arguments.emplaceBack(std::move(value));
+
+						if (currentType() != Token::Type::comma || next() == Token::Type::parenRight)
+							step = finishCall(value);
+						else step = ExpressionStep::expression;
+
+						break;
+
+					case subscript:
+						frame.member->pushSubscript(std::move(value));
+						verify(currentType() == Token::Type::bracketRight, error::Message::expectedDifferent, ']');
+
+						next();
+						step = continueMemberExpression(value);
+
+						break;
+				}
+
+				break;
+			}
 		}
 	}
+}
 
-	verify(legal, error::Message::expectedExpression);
-
-	auto expression = ast::unary_expr_ptr::create();
-	while (m_current.type() != Token::Type::eof) {
-		if (auto op = prefixOperators.find(m_current.type()); op == prefixOperators.end()) {
-			expression->bindExpr(parseAtomicMemberExpression());
+Parser::ExpressionStep Parser::continueInfixExpression(ast::expr_ptr& value, Precedence& precedence) {
+	auto& frame = m_frames.back();
 
+	while (currentType() != Token::Type::eof) {
+		if (!hasRole(currentType(), infixRole))
 			break;
-		}
 
-		expression->pushPrefix(m_current);
+		if (frame.precedence == Precedence::assignRight) // Simulate right-associativity with assignment
+			frame.precedence = Precedence::assignLeft;
 
-		next();
-	}
+		if (auto newPrec = infixPrecedence(currentType()); newPrec <= frame.precedence) { // Continue parsing in cases where binding power decreases
+			frame.precedence = newPrec;
 
-	if (auto op = postfixOperators.find(m_current.type()); op != postfixOperators.end()) {
-		expression->setPostfix(m_current); // Guarantees right associativity with postfix operators
+			if (frame.rightExpr) frame.expression->bindRight(std::move(frame.rightExpr));
 
-		next();
+			frame.expression = parseInfixExpression(std::move(frame.expression));
+			frame.resume = ExpressionFrame::Resume::right;
+
+			return ExpressionStep::operand;
+		} else {
+			value = std::move(frame.rightExpr);
+			precedence = newPrec;
+			frame.resume = ExpressionFrame::Resume::nested;
+
+			return ExpressionStep::expression;
+		}
 	}
 
-	return ast::UnaryExpr::simplify(std::move(expression));
-}
+	if (frame.rightExpr) frame.expression->bindRight(std::move(frame.rightExpr));
 
-ast::expr_ptr Parser::parseAtomicMemberExpression() {
-	ast::expr_ptr baseExpr;
-	if (m_current.type() != Token::Type::parenLeft) {
-		baseExpr = ast::atomic_expr_ptr::create(m_current);
+	if (frame.grouped)
+		consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
 
-		next();
-	} else baseExpr = parseExpression();
+	value = std::move(frame.expression);
+	m_frames.popBack();
+
+	return ExpressionStep::resume;
+}
 
-	auto expression = ast::member_expr_ptr::create(std::move(baseExpr));
 
-	while (m_current.type() != Token::Type::eof) {
-		if (m_current.type() == Token::Type::dot) { // Member access
-			verify(next().type() == Token::Type::identifier, error::Message::expectedIdentifier);
+Parser::ExpressionStep Parser::continueMemberExpression(ast::expr_ptr& value) {
+	auto& frame = m_frames.back();
 
-			expression->pushMember(m_current); 
-		} else if (m_current.type() == Token::Type::parenLeft) { // Function call
-			ast::detail::arg_t arguments;
+	while (currentType() != Token::Type::eof) {
+		if (currentType() == Token::Type::dot) { // Member access
+			verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
 
-			while (next().type() != Token::Type::parenRight) {
-				arguments.emplaceBack(parseExpression());
+			frame.member->pushMember(currentToken()); 
+		} else if (currentType() == Token::Type::parenLeft) { // Function call
+			if (next() != Token::Type::parenRight) {
+				frame.resume = ExpressionFrame::Resume::argument;
 
-				if (m_current.type() != Token::Type::comma)
-					break;
+				return ExpressionStep::expression;
 			}
 
-			verify(m_current.type() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
-
-			expression->pushCall(std::move(arguments));
-		} else if (m_current.type() == Token::Type::bracketLeft) { // Subscript
+			return finishCall(value);
+		} else if (currentType() == Token::Type::bracketLeft) { // Subscript
 			next();
-			expression->pushSubscript(parseExpression());
-			
-			verify(m_current.type() == Token::Type::bracketRight, error::Message::expectedDifferent, ']');
+			frame.resume = ExpressionFrame::Resume::subscript;
+
+			return ExpressionStep::expression;
 		} else break;
 
 		next();
 	}
 
-	return ast::MemberExpr::simplify(std::move(expression));
-}
+	auto member = ast::MemberExpr::simplify(std::move(frame.member));
+	auto prefixes = frame.prefixes;
+	auto prefixCount = frame.prefixCount;
+	m_frames.popBack();
 
-ast::infix_expr_ptr Parser::parseInfixExpression(ast::expr_ptr&& rightExpr) {
-	auto expr = ast::infix_expr_ptr::create(m_current, std::move(rightExpr));
-	next();
+	value = finishOperand(std::move(member), prefixes, prefixCount);
 
-	return expr;
+	return ExpressionStep::resume;
 }
 
-ast::expr_ptr Parser::parseClosure() {
-	auto value = ast::closure_expr_ptr::create();
+ast::expr_ptr Parser::finishOperand(ast::expr_ptr&& operand, TokenBuffer::index_type prefixes, TokenBuffer::index_type prefixCount) {
+	if (prefixCount == 0 && !hasRole(currentType(), postfixRole))
+		return std::move(operand);
 
-	if (next().type() == Token::Type::braceLeft) {
-		while (next().type() != Token::Type::braceRight) {
-			value->bindCaptureExpression(parseExpression());
-			
-			if (m_current.type() != Token::Type::comma)
-				break;
-		}
+	auto expression = m_arena.create<ast::UnaryExpr>();
+
+	for (auto i = prefixes; i < prefixes + prefixCount; i++)
+		expression->pushPrefix(m_tokens.token(i));
+
+	expression->bindExpr(std::move(operand));
+
+	if (hasRole(currentType(), postfixRole)) {
+		expression->setPostfix(currentToken()); // Guarantees right associativity with postfix operators
+
+		next();
 	}
 
-	value->bindConstruct(parseFunctionConstruct());
-	value->bindBody(parseBlockStatement());
+	return ast::UnaryExpr::simplify(std::move(expression));
+}
 
-	return value;
+Parser::ExpressionStep Parser::finishCall(ast::expr_ptr& value) {
+	auto& frame = m_frames.back();
+
+	verify(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+
+	frame.member->pushCall(std::exchange(frame.arguments, ast::detail::arg_t()));
+
+	next();
+
+	return continueMemberExpression(value);
 }
 
 
 // Statements
 
 ast::stmt_ptr Parser::parseStatement() {
-	switch (m_current.type()) {
+	switch (currentType()) {
 		case Token::Type::kIf:
 			return parseIfStatement();
 		
@@ -287,23 +593,23 @@ ast::stmt_ptr Parser::parseStatement() {
 			// return parseTryCatchStatement();
 
 		case Token::Type::braceLeft:
-			return ast::block_stmt_ptr::create(parseBlockStatement());
+			return m_arena.create<ast::BlockStmt>(parseBlockStatement());
 
 		case Token::Type::kYield:
 		case Token::Type::kReturn: {
-			auto value = ast::jump_stmt_ptr::create(m_current);
+			auto value = m_arena.create<ast::JumpStmt>(currentToken());
 			next();
 			value->bindExpr(parseExpression());
 			
-			consume(m_current.type() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+			consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
 
 			return ast::stmt_ptr(std::move(value));
 		}
 
 		case Token::Type::kBreak:
 		case Token::Type::kContinue: {
-			auto value = ast::jump_stmt_ptr::create(m_current);
-			consume(next().type() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+			auto value = m_arena.create<ast::JumpStmt>(currentToken());
+			consume(next() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
 
 			return value;
 		}
@@ -323,21 +629,25 @@ ast::stmt_ptr Parser::parseStatementAndObjDeclaration() {
 }
 
 ast::stmt_ptr Parser::parseExprStatement() {
-	if (m_current.type() == Token::Type::semicolon)
-		return ast::null_stmt_ptr::create();
+	if (currentType() == Token::Type::semicolon) {
+		next();
+
+		return m_arena.create<ast::NullStmt>();
+	}
 	
-	auto value = ast::expr_stmt_ptr::create(parseExpression());
-	consume(m_current.type() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+	auto value = m_arena.create<ast::ExprStmt>(parseExpression());
+	consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
 
 	return value;
 
 }
 
 ast::stmt_ptr Parser::parseIfStatement() {
-	auto value = ast::if_stmt_ptr::create(parseIfConstruct(), parseStatement());
+	auto construct = parseIfConstruct(); // The order in which arguments are evaluated is unspecified, so the construct is parsed first
+	auto value = m_arena.create<ast::IfStmt>(std::move(construct), parseStatement());
 
-	if (m_current.type() == Token::Type::kElse) {
-		if (next().type() == Token::Type::kIf)
+	if (currentType() == Token::Type::kElse) {
+		if (next() == Token::Type::kIf)
 			value->bindElseStatement(parseIfStatement());
 		else value->bindElseStatement(parseStatement());
 	}
@@ -346,40 +656,42 @@ ast::stmt_ptr Parser::parseIfStatement() {
 }
 
 ast::stmt_ptr Parser::parseForStatement() {
-	if (m_current.type() == Token::Type::kDo) {
+	if (currentType() == Token::Type::kDo) {
 		next();
-		auto value = ast::stmt_ptr(ast::for_stmt_ptr::create(parseStatement(), parseForConstruct()));
-		consume(m_current.type() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+		auto statement = parseStatement();
+		auto value = ast::stmt_ptr(m_arena.create<ast::ForStmt>(std::move(statement), parseForConstruct()));
+		consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
 
 		return value;
 	}
 		
-	return ast::for_stmt_ptr::create(parseForConstruct(), parseStatement());
+	auto construct = parseForConstruct();
+	return m_arena.create<ast::ForStmt>(std::move(construct), parseStatement());
 }
 
 ast::stmt_ptr Parser::parseTryCatchStatement() {
 	next();
-	auto value = ast::try_catch_stmt_ptr::create(parseStatement());
+	auto value = m_arena.create<ast::TryCatchStmt>(parseStatement());
 
-	consume(m_current.type() == Token::Type::kCatch, error::Message::noCatchBehindTry);
+	consume(currentType() == Token::Type::kCatch, error::Message::noCatchBehindTry);
 	
 	do {
 		auto construct = ast::detail::catch_construct_ptr();
 
-		if (m_current.type() == Token::Type::parenLeft) {
-			verify(next().type() == Token::Type::identifier, error::Message::expectedIdentifier);
+		if (currentType() == Token::Type::parenLeft) {
+			verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
 
-			construct = ast::detail::catch_construct_ptr::create();
-			construct->identifier = m_current;
+			construct = m_arena.create<ast::detail::CatchConstruct>();
+			construct->identifier = currentToken();
 			
-			if (m_current.type() == Token::Type::colon) {
+			if (currentType() == Token::Type::colon) {
 				next();
-				construct->type = ast::detail::type_ident_ptr::create(parseTypeIdentifier());
+				construct->type = m_arena.create<ast::detail::TypeIdentifier>(parseTypeIdentifier());
 			}
 		}
 
 		value->bindCatchBlock(parseStatement(), std::move(construct));
-	} while (m_current.type() == Token::Type::kCatch);
+	} while (currentType() == Token::Type::kCatch);
 
 	return value;
 }
@@ -388,9 +700,9 @@ ast::stmt_ptr Parser::parseTryCatchStatement() {
 // Declaration parsers
 
 ast::decl_ptr Parser::parseDeclaration() {
-	switch (m_current.type()) {
+	switch (currentType()) {
 		case Token::Type::semicolon: {
-			auto value = ast::null_decl_ptr::create();
+			auto value = m_arena.create<ast::NullDecl>();
 			next();
 
 			return value;
@@ -408,31 +720,35 @@ ast::decl_ptr Parser::parseDeclaration() {
 }
 
 ast::decl_ptr Parser::parseNamespaceDeclaration() {
-	verify(next().type() == Token::Type::identifier, error::Message::expectedIdentifier);
-	auto value = ast::namespace_decl_ptr::create(m_current);
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto value = m_arena.create<ast::NamespaceDecl>(currentToken());
 
-	consume(next().type() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
+	consume(next() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
 
-	while (m_current.type() != Token::Type::braceRight)
+	while (currentType() != Token::Type::braceRight) {
+		auto start = m_current;
 		value->bindDecl(parseDeclaration());
 
-	consume(m_current.type() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+		if (m_panic && !synchronize(start)) break;
+	}
+
+	consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
 
 	return value;
 }
 
 ast::decl_ptr Parser::parseImportDeclaration() {
-	auto value = ast::import_decl_ptr::create();
+	auto value = m_arena.create<ast::ImportDecl>();
 
-	while (next().type() != Token::Type::semicolon) {
-		verify(m_current.type() == Token::Type::identifier || m_current.type() == Token::Type::string, error::Message::importDeclRequiresStrOrConst);
-		value->bindModule(m_current);
+	while (next() != Token::Type::semicolon) {
+		verify(currentType() == Token::Type::identifier || currentType() == Token::Type::string, error::Message::importDeclRequiresStrOrConst);
+		value->bindModule(currentToken());
 		
-		if (next().type() != Token::Type::comma)
+		if (next() != Token::Type::comma)
 			break;
 	}
 	
-	consume(m_current.type() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+	consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
 
 	return value;
 }
@@ -446,63 +762,69 @@ ast::obj_decl_ptr Parser::parseObjectDeclaration() {
 }
 
 ast::obj_decl_ptr Parser::parseVariableDeclaration(ast::detail::Attributes&& attributes){
-	auto value = ast::variable_decl_ptr::create(std::move(attributes));
+	auto value = m_arena.create<ast::VariableDecl>(std::move(attributes));
 
-	while (next().type() != Token::Type::semicolon) {
+	while (next() != Token::Type::semicolon) {
 		value->bindDeclaration(parseIdentifierDeclaration());
 
-		if (m_current.type() != Token::Type::comma)
+		if (currentType() != Token::Type::comma)
 			break;
 	}
 
-	consume(m_current.type() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+	consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
 
 	return value;
 }
 
 ast::obj_decl_ptr Parser::parseFunctionDeclaration(ast::detail::Attributes&& attributes) {
-	verify(next().type() == Token::Type::identifier, error::Message::expectedIdentifier);
-	auto value = ast::function_decl_ptr::create(std::move(attributes), m_current);
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto value = m_arena.create<ast::FunctionDecl>(std::move(attributes), currentToken());
 	
 	next();
 
 	value->bindConstruct(parseFunctionConstruct());
-	value->bindBody(parseBlockStatement());
+
+	if (m_lazyBodies) value->bindLazyBody(preParseBlockStatement());
+	else value->bindBody(parseBlockStatement());
 
 	return value;
 }
 
 ast::obj_decl_ptr Parser::parseClassDeclaration(ast::detail::Attributes&& attributes) {
-	verify(next().type() == Token::Type::identifier, error::Message::expectedIdentifier);
-	auto value = ast::class_decl_ptr::create(std::move(attributes), m_current);
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto value = m_arena.create<ast::ClassDecl>(std::move(attributes), currentToken());
 	
-	consume(next().type() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
+	consume(next() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
 
-	while (m_current.type() != Token::Type::braceRight)
+	while (currentType() != Token::Type::braceRight) {
+		auto start = m_current;
 		value->bindDecl(parseObjectDeclaration());
+
+		if (m_panic && !synchronize(start)) break;
+	}
 	
 	return value;
 }
 
 ast::obj_decl_ptr Parser::parseEnumDeclaration(ast::detail::Attributes&& attributes) {
-	verify(next().type() == Token::Type::identifier, error::Message::expectedIdentifier);
-	auto value = ast::enum_decl_ptr::create(std::move(attributes), m_current);
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto value = m_arena.create<ast::EnumDecl>(std::move(attributes), currentToken());
 
-	if (next().type() == Token::Type::colon) {
+	if (next() == Token::Type::colon) {
 		next();
-		value->bindType(ast::detail::type_ident_ptr::create(parseTypeIdentifier()));
+		value->bindType(m_arena.create<ast::detail::TypeIdentifier>(parseTypeIdentifier()));
 	}
 	
-	consume(m_current.type() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
+	consume(currentType() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
 
-	while (m_current.type() != Token::Type::braceRight) {
+	while (currentType() != Token::Type::braceRight && !m_panic) {
 		value->bindValue(parseExpression());
 
-		if (m_current.type() != Token::Type::comma)
+		if (currentType() != Token::Type::comma)
 			break;
 	}
 
-	consume(m_current.type() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+	consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
 	
 	return value;
 }
@@ -513,23 +835,23 @@ ast::obj_decl_ptr Parser::parseEnumDeclaration(ast::detail::Attributes&& attribu
 ast::detail::TypeIdentifier Parser::parseTypeIdentifier() {
 	auto value = ast::detail::TypeIdentifier();
 
-	if (m_current.type() == Token::Type::identifier) {
-		value.identifier = m_current;
+	if (currentType() == Token::Type::identifier) {
+		value.identifier = currentToken();
 		next();
 
-		if (m_current.type() == Token::Type::bracketLeft) {
-			while (next().type() != Token::Type::bracketRight) {
+		if (currentType() == Token::Type::bracketLeft) {
+			while (next() != Token::Type::bracketRight) {
 				value.generics.emplaceBack(parseTypeIdentifier());
 
-				if (m_current.type() != Token::Type::comma)
+				if (currentType() != Token::Type::comma)
 					break;
 			}
 
-			consume(m_current.type() == Token::Type::bracketRight, error::Message::expectedDifferent, ']');
+			consume(currentType() == Token::Type::bracketRight, error::Message::expectedDifferent, ']');
 		}
 	}
 
-	while (m_current.type() == Token::Type::pointer) {
+	while (currentType() == Token::Type::pointer) {
 		++value.pointerCount;
 		next();
 	}
@@ -540,18 +862,18 @@ ast::detail::TypeIdentifier Parser::parseTypeIdentifier() {
 }
 
 ast::detail::IdentifierDecl Parser::parseIdentifierDeclaration() {
-	verify(m_current.type() == Token::Type::identifier, error::Message::expectedIdentifier);
+	verify(currentType() == Token::Type::identifier, error::Message::expectedIdentifier);
 	
 	auto value = ast::detail::IdentifierDecl();
-	value.identifier = m_current;
+	value.identifier = currentToken();
 	next();
 
-	if (m_current.type() == Token::Type::colon) {
+	if (currentType() == Token::Type::colon) {
 		next();
-		value.type = ast::detail::type_ident_ptr::create(parseTypeIdentifier());
+		value.type = m_arena.create<ast::detail::TypeIdentifier>(parseTypeIdentifier());
 	}
 	
-	if (m_current.type() == Token::Type::assign) {
+	if (currentType() == Token::Type::assign) {
 		next();
 		value.expression = parseExpression();
 	}
@@ -562,46 +884,46 @@ ast::detail::IdentifierDecl Parser::parseIdentifierDeclaration() {
 ast::detail::Attributes Parser::parseAttributes() {
 	auto value = ast::detail::Attributes();
 
-	do value.attributes.pushBack(m_current);
-	while (next().type() == Token::Type::attribute);
+	do value.attributes.pushBack(currentToken());
+	while (next() == Token::Type::attribute);
 
 	return value;
 }
 
 ast::detail::IfConstruct Parser::parseIfConstruct() {
-	consume(next().type() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
+	consume(next() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
 	auto value = ast::detail::IfConstruct();
 
-	if (m_current.type() == Token::Type::attribute || m_current.type() == Token::Type::kLet) {
-		value.init = parseVariableDeclaration((m_current.type() == Token::Type::attribute) ? parseAttributes() : ast::detail::Attributes());
+	if (currentType() == Token::Type::attribute || currentType() == Token::Type::kLet) {
+		value.init = parseVariableDeclaration((currentType() == Token::Type::attribute) ? parseAttributes() : ast::detail::Attributes());
 		value.condition = parseExpression();
 	} else {
 		auto expr = parseExpression();
 		
-		if (m_current.type() == Token::Type::semicolon) {
+		if (currentType() == Token::Type::semicolon) {
 			next();
 
-			value.init = ast::expr_stmt_ptr::create(std::move(expr));
+			value.init = m_arena.create<ast::ExprStmt>(std::move(expr));
 			value.condition = parseExpression();
 		} else value.condition = std::move(expr);
 	}
 
-	consume(m_current.type() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+	consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
 
 	return value;
 }
 
 ast::detail::ForConstruct Parser::parseForConstruct() {
-	consume(next().type() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
+	consume(next() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
 	auto value = ast::detail::ForConstruct();
 
 	auto expr = ast::expr_ptr();
 
-	if (m_current.type() == Token::Type::attribute || m_current.type() == Token::Type::kLet)
-		value.init = parseVariableDeclaration((m_current.type() == Token::Type::attribute) ? parseAttributes() : ast::detail::Attributes());
-	else if (m_current.type() == Token::Type::semicolon) {
-		value.init = ast::null_stmt_ptr::create();
-		if (next().type() == Token::Type::semicolon) {
+	if (currentType() == Token::Type::attribute || currentType() == Token::Type::kLet)
+		value.init = parseVariableDeclaration((currentType() == Token::Type::attribute) ? parseAttributes() : ast::detail::Attributes());
+	else if (currentType() == Token::Type::semicolon) {
+		value.init = m_arena.create<ast::NullStmt>();
+		if (next() == Token::Type::semicolon) {
 			next();
 			goto forLoopCheckedEnd;
 		}
@@ -609,21 +931,21 @@ ast::detail::ForConstruct Parser::parseForConstruct() {
 
 	expr = parseExpression();
 
-	if (m_current.type() == Token::Type::semicolon) {
+	if (currentType() == Token::Type::semicolon) {
 		next();
 
 		if (value.init) { // The above semicolon is the second semicolon, as the init statement is a variable declaration
 			value.condition() = std::move(expr);
 
-			if (m_current.type() == Token::Type::parenRight) {
+			if (currentType() == Token::Type::parenRight) {
 				next();
 				goto forLoopUncheckedEnd;
 			} else value.loop().emplaceBack(parseExpression());
 		} else { // The above semicolon is the first encountered
-			value.init = ast::expr_stmt_ptr::create(std::move(expr)); // If a expression was before the first semicolon, it is always the init statement
+			value.init = m_arena.create<ast::ExprStmt>(std::move(expr)); // If a expression was before the first semicolon, it is always the init statement
 			expr = parseExpression(); // This is either the condition, the first item of a range loop or the first expression in the loop expressions
 
-			if (m_current.type() == Token::Type::semicolon) { // This semicolon is the second
+			if (currentType() == Token::Type::semicolon) { // This semicolon is the second
 				value.condition() = std::move(expr);
 
 				next();
@@ -632,14 +954,14 @@ ast::detail::ForConstruct Parser::parseForConstruct() {
 		}
 	}
 
-	while (m_current.type() == Token::Type::comma) { // This is either the loop expression or the items of a range based loop
-		if (next(); m_current.type() == Token::Type::colon || m_current.type() == Token::Type::parenRight)
+	while (currentType() == Token::Type::comma) { // This is either the loop expression or the items of a range based loop
+		if (next(); currentType() == Token::Type::colon || currentType() == Token::Type::parenRight)
 			break;
 
 		value.loop().emplaceBack(parseExpression());
 	}
 
-	if (m_current.type() == Token::Type::colon && !value.condition()) { // This handles the range of a range based loop
+	if (currentType() == Token::Type::colon && !value.condition()) { // This handles the range of a range based loop
 		next();
 
 		value.rangeBased = true;
@@ -647,7 +969,7 @@ ast::detail::ForConstruct Parser::parseForConstruct() {
 	}
 	
 forLoopCheckedEnd:
-	consume(m_current.type() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+	consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
 
 forLoopUncheckedEnd:
 	// This can come before the check, but as the check above doesn't require this to have been executed, it may save some time
@@ -663,20 +985,20 @@ forLoopUncheckedEnd:
 ast::detail::FunctionConstruct Parser::parseFunctionConstruct() {
 	auto value = ast::detail::FunctionConstruct();
 
-	consume(m_current.type() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
+	consume(currentType() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
 
-	while (m_current.type() != Token::Type::parenRight) {
+	while (currentType() != Token::Type::parenRight && !m_panic) {
 		value.parameters.emplaceBack(parseIdentifierDeclaration());
 
-		if (m_current.type() != Token::Type::comma)
+		if (currentType() != Token::Type::comma)
 			break;
 	}
 
-	consume(m_current.type() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+	consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
 
-	if (m_current.type() == Token::Type::colon) {
+	if (currentType() == Token::Type::colon) {
 		next();
-		value.type = ast::detail::type_ident_ptr::create(parseTypeIdentifier());
+		value.type = m_arena.create<ast::detail::TypeIdentifier>(parseTypeIdentifier());
 	}
 
 	return value;
@@ -686,10 +1008,95 @@ ast::BlockStmt Parser::parseBlockStatement() {
 	next();
 
 	auto value = ast::BlockStmt();
-	while (m_current.type() != Token::Type::eof && m_current.type() != Token::Type::braceRight)
+	while (currentType() != Token::Type::eof && currentType() != Token::Type::braceRight) {
+		auto start = m_current;
 		value.pushStatement(parseStatementAndObjDeclaration());
+
+		if (m_panic && !synchronize(start)) break;
+	}
 	
-	consume(m_current.type() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+	consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+
+	return value;
+}
+
+ast::detail::LazyBody Parser::preParseBlockStatement() {
+	// Only brackets are matched, so mismatched and unterminated brackets are still reported while the body is skipped
+
+	auto value = ast::detail::LazyBody();
+	value.first = m_current;
+
+	if (!verify(currentType() == Token::Type::braceLeft, error::Message::expectedDifferent, '{')) {
+		value.last = value.first;
+
+		return value;
+	}
+
+	auto closing = [](Token::Type type) {
+		switch (type) {
+			case Token::Type::parenRight:
+				return ')';
+			case Token::Type::bracketRight:
+				return ']';
+			default:
+				return '}';
+		}
+	};
+
+	m_brackets.clear();
+	m_brackets.pushBack(Token::Type::braceRight);
+
+	auto index = m_current;
+	while (!m_brackets.empty()) {
+		auto type = m_tokens.type(++index);
+
+		switch (type) {
+			case Token::Type::parenLeft:
+				m_brackets.pushBack(Token::Type::parenRight);
+
+				break;
+
+			case Token::Type::braceLeft:
+				m_brackets.pushBack(Token::Type::braceRight);
+
+				break;
+
+			case Token::Type::bracketLeft:
+				m_brackets.pushBack(Token::Type::bracketRight);
+
+				break;
+
+			case Token::Type::parenRight:
+			case Token::Type::braceRight:
+			case Token::Type::bracketRight:
+			case Token::Type::eof:
+				if (type != m_brackets.back()) {
+					m_last = index - 1;
+					m_current = index;
+
+					verify(false, error::Message::expectedDifferent, closing(m_brackets.back()));
+
+					if (type == Token::Type::eof) { // Only reached with diagnostics, the unterminated body is left unparsed
+						value.last = index;
+
+						return value;
+					}
+				}
+
+				m_brackets.popBack();
+
+				break;
+
+			default:
+				break;
+		}
+	}
+
+	value.last = index;
+
+	m_last = index;
+	m_current = index;
+	next(); // Skip the closing brace just like parseBlockStatement()
 
 	return value;
 }
@@ -697,10 +1104,10 @@ ast::BlockStmt Parser::parseBlockStatement() {
 bool Parser::basicParseObjectDeclaration(ast::obj_decl_ptr& value) {
 	ast::detail::Attributes attributes;
 	
-	if (m_current.type() == Token::Type::attribute)
+	if (currentType() == Token::Type::attribute)
 		attributes = parseAttributes();
 
-	switch (m_current.type()) {
+	switch (currentType()) {
 		case Token::Type::kLet:
 			value = parseVariableDeclaration(std::move(attributes));
 
@@ -733,6 +1140,657 @@ bool Parser::basicParseObjectDeclaration(ast::obj_decl_ptr& value) {
 	return true;
 }
 
+
+// Flat tree parsers
+
+ast::node_index Parser::flushScratch(size_type top) {
+	auto list = m_flat.pushList(m_scratch.data() + top, m_scratch.size() - top);
+	m_scratch.resize(top);
+
+	return list;
+}
+
+void Parser::bindFlatRight(ast::node_index expr, ast::node_index right) {
+	assert(m_flat.kind(expr) == ast::NodeKind::infixExpr && "elyrium::compiler::Parser::bindFlatRight(): Attempted to bind an expression to the right of another unbindable expression, aborting!");
+
+	m_flat.setRhs(expr, right);
+}
+
+ast::node_index Parser::parseFlatExpression(Precedence precedence, ast::node_index expr) {
+	bool grouped = currentType() == Token::Type::parenLeft;
+	if (grouped) { // When parsing a grouped expression, the precedence should be reset to parse the entire group
+		precedence = Precedence::atomic;
+
+		next();
+	}
+
+	auto expression = (expr != ast::FlatModule::none) ? expr : parseFlatUnaryExpression();
+	auto rightExpr = ast::FlatModule::none;
+
+	while (currentType() != Token::Type::eof) {
+		if (!hasRole(currentType(), infixRole))
+			break;
+
+		if (precedence == Precedence::assignRight) // Simulate right-associativity with assignment
+			precedence = Precedence::assignLeft;
+
+		if (auto newPrec = infixPrecedence(currentType()); newPrec <= precedence) { // Continue parsing in cases where binding power decreases
+			precedence = newPrec;
+
+			if (rightExpr != ast::FlatModule::none) bindFlatRight(expression, rightExpr);
+
+			expression = parseFlatInfixExpression(expression);
+			rightExpr = parseFlatUnaryExpression();
+		} else {
+			bindFlatRight(expression, parseFlatExpression(newPrec, std::exchange(rightExpr, ast::FlatModule::none)));
+		}
+	}
+
+	if (rightExpr != ast::FlatModule::none) bindFlatRight(expression, rightExpr);
+
+	if (grouped)
+		consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+
+	return expression;
+}
+
+ast::node_index Parser::parseFlatUnaryExpression() {
+	if (!verify(isExpressionStart(currentType()), error::Message::expectedExpression))
+		return m_flat.pushNode(ast::NodeKind::atomicExpr, m_current); // Placeholder for the missing expression, the token is left to synchronize at
+
+	auto top = m_scratch.size();
+	auto operand = ast::FlatModule::none;
+
+	while (currentType() != Token::Type::eof) {
+		if (!hasRole(currentType(), prefixRole)) {
+			operand = parseFlatAtomicMemberExpression();
+
+			break;
+		}
+
+		m_scratch.pushBack(m_current);
+
+		next();
+	}
+
+	auto postfix = ast::FlatModule::none;
+	if (hasRole(currentType(), postfixRole)) {
+		postfix = m_current; // Guarantees right associativity with postfix operators
+
+		next();
+	}
+
+	if (m_scratch.size() == top && postfix == ast::FlatModule::none) // Unary expressions without operators are simplified to their operand
+		return operand;
+
+	return m_flat.pushNode(ast::NodeKind::unaryExpr, postfix, operand, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatAtomicMemberExpression() {
+	ast::node_index baseExpr;
+	if (currentType() == Token::Type::kFunc) {
+		baseExpr = parseFlatClosure();
+	} else if (currentType() != Token::Type::parenLeft) {
+		baseExpr = m_flat.pushNode(ast::NodeKind::atomicExpr, m_current);
+
+		next();
+	} else baseExpr = parseFlatExpression();
+
+	auto top = m_scratch.size();
+
+	while (currentType() != Token::Type::eof) {
+		if (currentType() == Token::Type::dot) { // Member access
+			verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+
+			m_scratch.pushBack(m_flat.pushNode(ast::NodeKind::memberChain, m_current));
+		} else if (currentType() == Token::Type::parenLeft) { // Function call
+			auto argumentTop = m_scratch.size();
+
+			while (next() != Token::Type::parenRight) {
+				m_scratch.pushBack(parseFlatExpression());
+
+				if (currentType() != Token::Type::comma)
+					break;
+			}
+
+			verify(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+
+			auto arguments = flushScratch(argumentTop);
+			m_scratch.pushBack(m_flat.pushNode(ast::NodeKind::callChain, ast::FlatModule::none, arguments));
+		} else if (currentType() == Token::Type::bracketLeft) { // Subscript
+			next();
+			auto index = parseFlatExpression();
+
+			verify(currentType() == Token::Type::bracketRight, error::Message::expectedDifferent, ']');
+
+			m_scratch.pushBack(m_flat.pushNode(ast::NodeKind::subscriptChain, ast::FlatModule::none, index));
+		} else break;
+
+		next();
+	}
+
+	if (m_scratch.size() == top) // Member expressions without a chain are simplified to their base
+		return baseExpr;
+
+	return m_flat.pushNode(ast::NodeKind::memberExpr, ast::FlatModule::none, baseExpr, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatInfixExpression(ast::node_index rightExpr) {
+	auto expr = m_flat.pushNode(ast::NodeKind::infixExpr, m_current, rightExpr);
+	next();
+
+	return expr;
+}
+
+ast::node_index Parser::parseFlatClosure() {
+	auto top = m_scratch.size();
+
+	if (next() == Token::Type::braceLeft) {
+		while (next() != Token::Type::braceRight) {
+			m_scratch.pushBack(parseFlatExpression());
+
+			if (currentType() != Token::Type::comma)
+				break;
+		}
+
+		consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+	}
+
+	auto captures = flushScratch(top);
+
+	auto function = parseFlatFunctionConstruct();
+	m_flat.setField(function, 2, parseFlatBlockStatement());
+
+	return m_flat.pushNode(ast::NodeKind::closureExpr, ast::FlatModule::none, captures, function);
+}
+
+ast::node_index Parser::parseFlatStatement() {
+	switch (currentType()) {
+		case Token::Type::kIf:
+			return parseFlatIfStatement();
+
+		case Token::Type::kDo:
+		case Token::Type::kFor:
+			return parseFlatForStatement();
+
+		case Token::Type::kTry:
+			// return parseFlatTryCatchStatement();
+
+		case Token::Type::braceLeft:
+			return parseFlatBlockStatement();
+
+		case Token::Type::kYield:
+		case Token::Type::kReturn: {
+			auto value = m_flat.pushNode(ast::NodeKind::jumpStmt, m_current);
+			next();
+			m_flat.setLhs(value, parseFlatExpression());
+
+			consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+
+			return value;
+		}
+
+		case Token::Type::kBreak:
+		case Token::Type::kContinue: {
+			auto value = m_flat.pushNode(ast::NodeKind::jumpStmt, m_current);
+			consume(next() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+
+			return value;
+		}
+
+		default:
+			return parseFlatExprStatement();
+	}
+}
+
+ast::node_index Parser::parseFlatStatementAndObjDeclaration() {
+	auto value = ast::FlatModule::none;
+
+	if (!basicParseFlatObjectDeclaration(value))
+		return parseFlatStatement();
+
+	return value;
+}
+
+ast::node_index Parser::parseFlatExprStatement() {
+	if (currentType() == Token::Type::semicolon) {
+		next();
+
+		return m_flat.pushNode(ast::NodeKind::nullStmt);
+	}
+
+	auto value = m_flat.pushNode(ast::NodeKind::exprStmt, ast::FlatModule::none, parseFlatExpression());
+	consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+
+	return value;
+}
+
+ast::node_index Parser::parseFlatIfStatement() {
+	auto init = ast::FlatModule::none;
+	auto condition = ast::FlatModule::none;
+
+	parseFlatIfConstruct(init, condition);
+	auto statement = parseFlatStatement();
+
+	auto value = m_flat.pushNode(ast::NodeKind::ifStmt, ast::FlatModule::none, m_flat.pushRecord({ init, condition, statement }));
+
+	if (currentType() == Token::Type::kElse) {
+		if (next() == Token::Type::kIf)
+			m_flat.setRhs(value, parseFlatIfStatement());
+		else m_flat.setRhs(value, parseFlatStatement());
+	}
+
+	return value;
+}
+
+ast::node_index Parser::parseFlatForStatement() {
+	if (currentType() == Token::Type::kDo) {
+		next();
+		auto statement = parseFlatStatement();
+		auto value = m_flat.pushNode(ast::NodeKind::forStmt, ast::FlatModule::none, parseFlatForConstruct(), statement);
+		consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+
+		return value;
+	}
+
+	auto construct = parseFlatForConstruct();
+	return m_flat.pushNode(ast::NodeKind::forStmt, ast::FlatModule::none, construct, parseFlatStatement());
+}
+
+ast::node_index Parser::parseFlatTryCatchStatement() {
+	next();
+	auto tryBlock = parseFlatStatement();
+
+	consume(currentType() == Token::Type::kCatch, error::Message::noCatchBehindTry);
+
+	auto top = m_scratch.size();
+
+	do {
+		auto identifier = ast::FlatModule::none;
+		auto type = ast::FlatModule::none;
+
+		if (currentType() == Token::Type::parenLeft) {
+			verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+
+			identifier = m_current;
+
+			if (currentType() == Token::Type::colon) {
+				next();
+				type = parseFlatTypeIdentifier();
+			}
+		}
+
+		auto statement = parseFlatStatement();
+		m_scratch.pushBack(m_flat.pushNode(ast::NodeKind::catchClause, identifier, type, statement));
+	} while (currentType() == Token::Type::kCatch);
+
+	return m_flat.pushNode(ast::NodeKind::tryCatchStmt, ast::FlatModule::none, tryBlock, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatDeclaration() {
+	switch (currentType()) {
+		case Token::Type::semicolon: {
+			auto value = m_flat.pushNode(ast::NodeKind::nullDecl);
+			next();
+
+			return value;
+		}
+
+		case Token::Type::kNamespace:
+			return parseFlatNamespaceDeclaration();
+
+		case Token::Type::kImport:
+			return parseFlatImportDeclaration();
+
+		default:
+			return parseFlatObjectDeclaration();
+	}
+}
+
+ast::node_index Parser::parseFlatNamespaceDeclaration() {
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto identifier = m_current;
+
+	consume(next() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
+
+	auto top = m_scratch.size();
+	while (currentType() != Token::Type::braceRight) {
+		auto start = m_current;
+		m_scratch.pushBack(parseFlatDeclaration());
+
+		if (m_panic && !synchronize(start)) break;
+	}
+
+	consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+
+	return m_flat.pushNode(ast::NodeKind::namespaceDecl, identifier, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatImportDeclaration() {
+	auto top = m_scratch.size();
+
+	while (next() != Token::Type::semicolon) {
+		verify(currentType() == Token::Type::identifier || currentType() == Token::Type::string, error::Message::importDeclRequiresStrOrConst);
+		m_scratch.pushBack(m_current);
+
+		if (next() != Token::Type::comma)
+			break;
+	}
+
+	consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+
+	return m_flat.pushNode(ast::NodeKind::importDecl, ast::FlatModule::none, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatObjectDeclaration() {
+	auto value = ast::FlatModule::none;
+
+	verify(basicParseFlatObjectDeclaration(value), error::Message::expectedDeclaration);
+
+	return value;
+}
+
+ast::node_index Parser::parseFlatVariableDeclaration(ast::node_index attributes) {
+	auto top = m_scratch.size();
+
+	while (next() != Token::Type::semicolon) {
+		m_scratch.pushBack(parseFlatIdentifierDeclaration());
+
+		if (currentType() != Token::Type::comma)
+			break;
+	}
+
+	consume(currentType() == Token::Type::semicolon, error::Message::expectedDifferent, ';');
+
+	return m_flat.pushNode(ast::NodeKind::variableDecl, ast::FlatModule::none, attributes, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatFunctionDeclaration(ast::node_index attributes) {
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto identifier = m_current;
+
+	next();
+
+	auto function = parseFlatFunctionConstruct();
+	m_flat.setField(function, 2, parseFlatBlockStatement());
+
+	return m_flat.pushNode(ast::NodeKind::functionDecl, identifier, attributes, function);
+}
+
+ast::node_index Parser::parseFlatClassDeclaration(ast::node_index attributes) {
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto identifier = m_current;
+
+	consume(next() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
+
+	auto top = m_scratch.size();
+	while (currentType() != Token::Type::braceRight) {
+		auto start = m_current;
+		m_scratch.pushBack(parseFlatObjectDeclaration());
+
+		if (m_panic && !synchronize(start)) break;
+	}
+
+	return m_flat.pushNode(ast::NodeKind::classDecl, identifier, attributes, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatEnumDeclaration(ast::node_index attributes) {
+	verify(next() == Token::Type::identifier, error::Message::expectedIdentifier);
+	auto identifier = m_current;
+	auto type = ast::FlatModule::none;
+
+	if (next() == Token::Type::colon) {
+		next();
+		type = parseFlatTypeIdentifier();
+	}
+
+	consume(currentType() == Token::Type::braceLeft, error::Message::expectedDifferent, '{');
+
+	auto top = m_scratch.size();
+	while (currentType() != Token::Type::braceRight && !m_panic) {
+		m_scratch.pushBack(parseFlatExpression());
+
+		if (currentType() != Token::Type::comma)
+			break;
+	}
+
+	consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+
+	auto values = flushScratch(top);
+	return m_flat.pushNode(ast::NodeKind::enumDecl, identifier, attributes, m_flat.pushRecord({ type, values }));
+}
+
+ast::node_index Parser::parseFlatTypeIdentifier() {
+	auto identifier = ast::FlatModule::none;
+	ast::node_index pointerCount = 0;
+	auto top = m_scratch.size();
+
+	if (currentType() == Token::Type::identifier) {
+		identifier = m_current;
+		next();
+
+		if (currentType() == Token::Type::bracketLeft) {
+			while (next() != Token::Type::bracketRight) {
+				m_scratch.pushBack(parseFlatTypeIdentifier());
+
+				if (currentType() != Token::Type::comma)
+					break;
+			}
+
+			consume(currentType() == Token::Type::bracketRight, error::Message::expectedDifferent, ']');
+		}
+	}
+
+	while (currentType() == Token::Type::pointer) {
+		++pointerCount;
+		next();
+	}
+
+	if (identifier == ast::FlatModule::none) verify(pointerCount, error::Message::expectedIdentifier);
+
+	return m_flat.pushNode(ast::NodeKind::typeIdentifier, identifier, pointerCount, flushScratch(top));
+}
+
+ast::node_index Parser::parseFlatIdentifierDeclaration() {
+	verify(currentType() == Token::Type::identifier, error::Message::expectedIdentifier);
+
+	auto identifier = m_current;
+	auto type = ast::FlatModule::none;
+	auto expression = ast::FlatModule::none;
+	next();
+
+	if (currentType() == Token::Type::colon) {
+		next();
+		type = parseFlatTypeIdentifier();
+	}
+
+	if (currentType() == Token::Type::assign) {
+		next();
+		expression = parseFlatExpression();
+	}
+
+	return m_flat.pushNode(ast::NodeKind::identifierDecl, identifier, type, expression);
+}
+
+ast::node_index Parser::parseFlatAttributes() {
+	auto top = m_scratch.size();
+
+	do m_scratch.pushBack(m_current);
+	while (next() == Token::Type::attribute);
+
+	return flushScratch(top);
+}
+
+void Parser::parseFlatIfConstruct(ast::node_index& init, ast::node_index& condition) {
+	consume(next() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
+
+	if (currentType() == Token::Type::attribute || currentType() == Token::Type::kLet) {
+		init = parseFlatVariableDeclaration((currentType() == Token::Type::attribute) ? parseFlatAttributes() : ast::FlatModule::emptyList);
+		condition = parseFlatExpression();
+	} else {
+		auto expr = parseFlatExpression();
+
+		if (currentType() == Token::Type::semicolon) {
+			next();
+
+			init = m_flat.pushNode(ast::NodeKind::exprStmt, ast::FlatModule::none, expr);
+			condition = parseFlatExpression();
+		} else condition = expr;
+	}
+
+	consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+}
+
+ast::node_index Parser::parseFlatForConstruct() {
+	consume(next() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
+
+	auto init = ast::FlatModule::none;
+	auto condition = ast::FlatModule::none;
+	auto expr = ast::FlatModule::none;
+	bool rangeBased = false;
+	auto top = m_scratch.size(); // Loop expressions or items of a range based loop
+
+	if (currentType() == Token::Type::attribute || currentType() == Token::Type::kLet)
+		init = parseFlatVariableDeclaration((currentType() == Token::Type::attribute) ? parseFlatAttributes() : ast::FlatModule::emptyList);
+	else if (currentType() == Token::Type::semicolon) {
+		init = m_flat.pushNode(ast::NodeKind::nullStmt);
+		if (next() == Token::Type::semicolon) {
+			next();
+			goto forLoopCheckedEnd;
+		}
+	}
+
+	expr = parseFlatExpression();
+
+	if (currentType() == Token::Type::semicolon) {
+		next();
+
+		if (init != ast::FlatModule::none) { // The above semicolon is the second semicolon, as the init statement is a variable declaration
+			condition = std::exchange(expr, ast::FlatModule::none);
+
+			if (currentType() == Token::Type::parenRight) {
+				next();
+				goto forLoopUncheckedEnd;
+			} else m_scratch.pushBack(parseFlatExpression());
+		} else { // The above semicolon is the first encountered
+			init = m_flat.pushNode(ast::NodeKind::exprStmt, ast::FlatModule::none, expr);
+			expr = parseFlatExpression();
+
+			if (currentType() == Token::Type::semicolon) { // This semicolon is the second
+				condition = std::exchange(expr, ast::FlatModule::none);
+
+				next();
+				m_scratch.pushBack(parseFlatExpression());
+			} else m_scratch.pushBack(std::exchange(expr, ast::FlatModule::none));
+		}
+	}
+
+	while (currentType() == Token::Type::comma) { // This is either the loop expression or the items of a range based loop
+		if (next(); currentType() == Token::Type::colon || currentType() == Token::Type::parenRight)
+			break;
+
+		m_scratch.pushBack(parseFlatExpression());
+	}
+
+	if (currentType() == Token::Type::colon && condition == ast::FlatModule::none) { // This handles the range of a range based loop
+		next();
+
+		rangeBased = true;
+		condition = parseFlatExpression();
+	}
+
+forLoopCheckedEnd:
+	consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+
+forLoopUncheckedEnd:
+	if (condition == ast::FlatModule::none)
+		condition = std::exchange(expr, ast::FlatModule::none);
+
+	if (expr != ast::FlatModule::none)
+		m_scratch.pushBack(expr);
+
+	auto loopOrItems = flushScratch(top);
+	return m_flat.pushRecord({ init, condition, loopOrItems, rangeBased });
+}
+
+ast::node_index Parser::parseFlatFunctionConstruct() {
+	consume(currentType() == Token::Type::parenLeft, error::Message::expectedDifferent, '(');
+
+	auto top = m_scratch.size();
+	while (currentType() != Token::Type::parenRight && !m_panic) {
+		m_scratch.pushBack(parseFlatIdentifierDeclaration());
+
+		if (currentType() != Token::Type::comma)
+			break;
+	}
+
+	consume(currentType() == Token::Type::parenRight, error::Message::expectedDifferent, ')');
+
+	auto type = ast::FlatModule::none;
+	if (currentType() == Token::Type::colon) {
+		next();
+		type = parseFlatTypeIdentifier();
+	}
+
+	auto parameters = flushScratch(top);
+	return m_flat.pushRecord({ parameters, type, ast::FlatModule::none }); // The body is filled in once it was parsed
+}
+
+ast::node_index Parser::parseFlatBlockStatement() {
+	next();
+
+	auto top = m_scratch.size();
+	while (currentType() != Token::Type::eof && currentType() != Token::Type::braceRight) {
+		auto start = m_current;
+		m_scratch.pushBack(parseFlatStatementAndObjDeclaration());
+
+		if (m_panic && !synchronize(start)) break;
+	}
+
+	consume(currentType() == Token::Type::braceRight, error::Message::expectedDifferent, '}');
+
+	return m_flat.pushNode(ast::NodeKind::blockStmt, ast::FlatModule::none, flushScratch(top));
+}
+
+bool Parser::basicParseFlatObjectDeclaration(ast::node_index& value) {
+	auto attributes = ast::FlatModule::emptyList;
+
+	if (currentType() == Token::Type::attribute)
+		attributes = parseFlatAttributes();
+
+	switch (currentType()) {
+		case Token::Type::kLet:
+			value = parseFlatVariableDeclaration(attributes);
+
+			break;
+
+		case Token::Type::kFunc:
+			value = parseFlatFunctionDeclaration(attributes);
+
+			break;
+
+		case Token::Type::kCoroutine:
+			// value = parseFlatCoroutineDeclaration(attributes);
+
+			break;
+
+		case Token::Type::kClass:
+			value = parseFlatClassDeclaration(attributes);
+
+			break;
+
+		case Token::Type::kEnum:
+			value = parseFlatEnumDeclaration(attributes);
+
+			break;
+
+		default:
+			return false;
+	}
+
+	return true;
+}
+
 } // namespace compiler
 
 } // namespace elyrium
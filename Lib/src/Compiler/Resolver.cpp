@@ -0,0 +1,349 @@
+#include <Elyrium/Compiler/Resolver.hpp>
+
+#include <Elyrium/Compiler/Parser.hpp>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace {
+
+template <class Name> [[nodiscard]] const Name* findMember(const lsd::Vector<Name>& members, symbol_id symbol) noexcept {
+	for (const auto& member : members)
+		if (member.symbol == symbol) return &member;
+
+	return nullptr;
+}
+
+} // namespace
+
+Resolution Resolver::resolve() {
+	m_functions.emplaceBack();
+	m_scopes.pushBack(Scope { declareMembers(m_module->declarations(), { }), 0 });
+
+	for (const auto& declaration : m_module->declarations())
+		this->declaration(declaration.get());
+
+	return std::move(m_resolution);
+}
+
+void Resolver::error(const Token& token, error::Message message) const {
+	throw compileError(token, m_source, *m_lines, m_path, message);
+}
+
+
+// Names
+
+lsd::Vector<Resolver::Name> Resolver::declareMembers(const lsd::Vector<ast::decl_ptr>& declarations, const lsd::Vector<symbol_id>& path) {
+	lsd::Vector<Name> members;
+
+	for (const auto& declaration : declarations) {
+		auto node = declaration.get();
+
+		if (auto variable = dynamic_cast<const ast::VariableDecl*>(node)) {
+			for (const auto& identifier : variable->identifiers())
+				declareSlot(identifier.identifier, members, path);
+		} else if (auto function = dynamic_cast<const ast::FunctionDecl*>(node)) {
+			declareSlot(function->identifier(), members, path);
+		} else if (auto classDecl = dynamic_cast<const ast::ClassDecl*>(node)) {
+			declareSlot(classDecl->identifier(), members, path);
+		} else if (auto enumDecl = dynamic_cast<const ast::EnumDecl*>(node)) {
+			declareSlot(enumDecl->identifier(), members, path);
+		} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(node)) {
+			const auto& identifier = namespaceDecl->identifier();
+			if (findMember(members, identifier.symbol())) error(identifier, error::Message::redeclaration);
+
+			// The members are declared into a vector of their own first, since declaring nested namespaces moves the existing ones
+			auto index = static_cast<uint32>(m_namespaces.size());
+			auto& nameSpace = m_namespaces.emplaceBack();
+			nameSpace.path = path;
+			nameSpace.path.pushBack(identifier.symbol());
+
+			members.pushBack(Name { identifier.symbol(), Binding { }, &identifier, index });
+
+			auto nested = m_namespaces[index].path;
+			m_namespaces[index].members = declareMembers(namespaceDecl->declarations(), nested);
+		}
+	}
+
+	return members;
+}
+
+uint32 Resolver::declareSlot(const Token& identifier, lsd::Vector<Name>& members, const lsd::Vector<symbol_id>& path) {
+	if (findMember(members, identifier.symbol())) error(identifier, error::Message::redeclaration);
+
+	auto slot = static_cast<uint32>(m_resolution.m_globals.size());
+
+	auto& global = m_resolution.m_globals.emplaceBack();
+	global.path = path;
+	global.path.pushBack(identifier.symbol());
+
+	auto binding = Binding { path.empty() ? Binding::Kind::global : Binding::Kind::staticMember, false, slot };
+
+	members.pushBack(Name { identifier.symbol(), binding, &identifier });
+	m_resolution.m_bindings.emplace(&identifier, binding);
+
+	return slot;
+}
+
+void Resolver::declareLocal(const Token& identifier) {
+	auto binding = Binding { Binding::Kind::local, false, m_functions.back().localCount++ };
+
+	m_scopes.back().names.pushBack(Name { identifier.symbol(), binding, &identifier });
+	m_resolution.m_bindings.emplace(&identifier, binding);
+}
+
+const Resolver::Name* Resolver::find(const Token& identifier, size_type& function) const noexcept {
+	// Innermost names are searched first, so they shadow the outer ones
+	for (auto scope = m_scopes.size(); scope > 0; scope--) {
+		const auto& current = m_scopes[scope - 1];
+		function = current.function;
+
+		for (auto name = current.names.size(); name > 0; name--)
+			if (current.names[name - 1].symbol == identifier.symbol()) return &current.names[name - 1];
+
+		if (current.nameSpace != none)
+			if (auto member = findMember(m_namespaces[current.nameSpace].members, identifier.symbol())) return member;
+	}
+
+	return nullptr;
+}
+
+Resolver::Name Resolver::lookup(const Token& identifier) {
+	size_type function;
+	Name name;
+
+	if (auto found = find(identifier, function)) {
+		name = *found;
+
+		if (name.binding.kind == Binding::Kind::local && function + 1 != m_functions.size()) {
+			m_resolution.m_bindings.find(name.declaration)->second.captured = true;
+			name.binding = Binding { Binding::Kind::upvalue, false, capture(m_functions.size() - 1, function, name.binding.index) };
+		}
+	} else {
+		// Names the module doesn't declare get a slot which is bound once when the module is linked
+		auto external = m_externals.find(identifier.symbol());
+
+		if (external == m_externals.end()) {
+			external = m_externals.emplace(identifier.symbol(), static_cast<uint32>(m_resolution.m_globals.size())).first;
+
+			auto& global = m_resolution.m_globals.emplaceBack();
+			global.path.pushBack(identifier.symbol());
+			global.external = true;
+		}
+
+		name = Name { identifier.symbol(), Binding { Binding::Kind::global, false, external->second } };
+	}
+
+	if (name.nameSpace == none) m_resolution.m_bindings.emplace(&identifier, name.binding);
+
+	return name;
+}
+
+uint32 Resolver::capture(size_type function, size_type owner, uint32 local) {
+	// Functions between the owner of the local and the one using it pass it on as an upvalue of their own
+	auto captured = (function == owner + 1) ? bytecode::Capture { true, local } : bytecode::Capture { false, capture(function - 1, owner, local) };
+	auto& captures = m_functions[function].captures;
+
+	for (size_type i = 0; i < captures.size(); i++)
+		if (captures[i].local == captured.local && captures[i].index == captured.index) return static_cast<uint32>(i);
+
+	captures.pushBack(captured);
+	return static_cast<uint32>(captures.size() - 1);
+}
+
+
+// Traversal
+
+void Resolver::declaration(ast::Declaration* declaration) {
+	if (auto variable = dynamic_cast<ast::VariableDecl*>(declaration)) {
+		for (const auto& identifier : variable->identifiers())
+			if (identifier.expression) expression(identifier.expression.get());
+	} else if (auto function = dynamic_cast<ast::FunctionDecl*>(declaration)) {
+		this->function(*function);
+	} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(declaration)) {
+		const auto& scope = m_scopes.back();
+		const auto& members = (scope.nameSpace == none) ? scope.names : m_namespaces[scope.nameSpace].members;
+
+		m_scopes.pushBack(Scope { { }, 0, findMember(members, namespaceDecl->identifier().symbol())->nameSpace });
+
+		for (const auto& member : namespaceDecl->declarations())
+			this->declaration(member.get());
+
+		m_scopes.popBack();
+	}
+}
+
+template <class Node> void Resolver::function(Node& node) {
+	Parser::parseLazyBody(*m_module, node);
+
+	const auto& parameters = node.construct().parameters;
+
+	for (const auto& parameter : parameters)
+		if (parameter.expression) expression(parameter.expression.get());
+
+	m_functions.emplaceBack();
+	m_scopes.pushBack(Scope { { }, m_functions.size() - 1 });
+
+	for (const auto& parameter : parameters)
+		declareLocal(parameter.identifier);
+
+	for (const auto& statement : node.body().statements())
+		this->statement(statement.get());
+
+	m_scopes.popBack();
+
+	m_resolution.m_functions.emplace(&node, std::move(m_functions.back()));
+	m_functions.popBack();
+}
+
+void Resolver::statement(ast::Statement* statement) {
+	auto pushScope = [this]() {
+		m_scopes.pushBack(Scope { { }, m_functions.size() - 1 });
+	};
+
+	if (auto variable = dynamic_cast<const ast::VariableDecl*>(statement)) {
+		// Initializers still refer to the names the new locals shadow
+		for (const auto& identifier : variable->identifiers()) {
+			if (identifier.expression) expression(identifier.expression.get());
+			declareLocal(identifier.identifier);
+		}
+	} else if (auto expr = dynamic_cast<const ast::ExprStmt*>(statement)) {
+		expression(expr->expr().get());
+	} else if (auto block = dynamic_cast<const ast::BlockStmt*>(statement)) {
+		pushScope();
+
+		for (const auto& statement : block->statements())
+			this->statement(statement.get());
+
+		m_scopes.popBack();
+	} else if (auto ifStmt = dynamic_cast<const ast::IfStmt*>(statement)) {
+		pushScope();
+
+		const auto& construct = ifStmt->construct();
+
+		if (construct.init) this->statement(construct.init.get());
+		expression(construct.condition.get());
+
+		this->statement(ifStmt->statement().get());
+		if (ifStmt->elseStatement()) this->statement(ifStmt->elseStatement().get());
+
+		m_scopes.popBack();
+	} else if (auto forStmt = dynamic_cast<const ast::ForStmt*>(statement)) {
+		pushScope();
+
+		const auto& construct = forStmt->construct();
+
+		if (construct.init) this->statement(construct.init.get());
+
+		if (construct.rangeBased) {
+			expression(construct.range().get());
+
+			for (const auto& item : construct.items()) {
+				if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(item.get()); atomic && atomic->value().type() == Token::Type::identifier)
+					declareLocal(atomic->value());
+				else expression(item.get());
+			}
+		} else {
+			if (construct.condition()) expression(construct.condition().get());
+
+			for (const auto& loop : construct.loop())
+				expression(loop.get());
+		}
+
+		this->statement(forStmt->statement().get());
+
+		m_scopes.popBack();
+	} else if (auto jump = dynamic_cast<const ast::JumpStmt*>(statement)) {
+		if (jump->expr()) expression(jump->expr().get());
+	} else if (auto tryCatch = dynamic_cast<const ast::TryCatchStmt*>(statement)) {
+		this->statement(tryCatch->tryBlock().get());
+
+		for (const auto& [block, construct] : tryCatch->catchBlocks()) {
+			pushScope();
+
+			if (construct) declareLocal(construct->identifier);
+			this->statement(block.get());
+
+			m_scopes.popBack();
+		}
+	} else if (auto function = dynamic_cast<ast::FunctionDecl*>(statement)) {
+		// Declared before the body is resolved, so the function can call itself
+		declareLocal(function->identifier());
+		this->function(*function);
+	}
+}
+
+void Resolver::expression(ast::Expression* expression) {
+	// Closure bodies resolve their expressions with another call, whose expressions are stacked on top
+	auto bottom = m_expressions.size();
+	m_expressions.pushBack(PendingExpression { expression });
+
+	// Operands are pushed in reverse, so they are popped and resolved in the order they appear in
+	while (m_expressions.size() > bottom) {
+		auto pending = m_expressions.back();
+		m_expressions.popBack();
+
+		if (pending.body) {
+			function(*static_cast<ast::ClosureExpr*>(pending.expression));
+		} else if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(pending.expression)) {
+			if (atomic->value().type() == Token::Type::identifier && lookup(atomic->value()).nameSpace != none)
+				error(atomic->value(), error::Message::namespaceAsValue);
+		} else if (auto member = dynamic_cast<ast::MemberExpr*>(pending.expression)) {
+			this->member(*member);
+		} else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(pending.expression)) {
+			m_expressions.pushBack(PendingExpression { unary->expr().get() });
+		} else if (auto infix = dynamic_cast<const ast::InfixExpr*>(pending.expression)) {
+			m_expressions.pushBack(PendingExpression { infix->right().get() });
+			m_expressions.pushBack(PendingExpression { infix->left().get() });
+		} else if (auto closure = dynamic_cast<ast::ClosureExpr*>(pending.expression)) {
+			m_expressions.pushBack(PendingExpression { closure, true });
+
+			const auto& captures = closure->captures();
+			for (auto capture = captures.size(); capture > 0; capture--)
+				m_expressions.pushBack(PendingExpression { captures[capture - 1].get() });
+		}
+	}
+}
+
+void Resolver::member(ast::MemberExpr& expression) {
+	const auto& chain = expression.chain();
+	auto consumed = uint32 { 0 };
+
+	auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression.value().get());
+	auto named = atomic && atomic->value().type() == Token::Type::identifier;
+
+	if (named) {
+		auto name = lookup(atomic->value());
+
+		// Members of namespaces are resolved statically, so the chain starts at the member the namespaces lead to
+		for (auto last = &atomic->value(); name.nameSpace != none;) {
+			auto identifier = (consumed < chain.size()) ? std::get_if<Token>(&chain[consumed]) : nullptr;
+			if (!identifier) error(*last, error::Message::namespaceAsValue);
+
+			auto member = findMember(m_namespaces[name.nameSpace].members, identifier->symbol());
+			if (!member) error(*identifier, error::Message::unknownMember);
+
+			name = *member;
+			last = identifier;
+			++consumed;
+		}
+
+		if (consumed != 0) m_resolution.m_bindings.emplace(&expression, Binding { name.binding.kind, false, name.binding.index, consumed });
+	}
+
+	for (auto i = chain.size(); i > consumed; i--) {
+		if (auto arguments = std::get_if<ast::detail::arg_t>(&chain[i - 1])) {
+			for (auto argument = arguments->size(); argument > 0; argument--)
+				m_expressions.pushBack(PendingExpression { (*arguments)[argument - 1].get() });
+		} else if (auto subscript = std::get_if<ast::detail::subscript_t>(&chain[i - 1])) {
+			m_expressions.pushBack(PendingExpression { subscript->get() });
+		}
+	}
+
+	if (!named) m_expressions.pushBack(PendingExpression { expression.value().get() });
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,168 @@
+#include <Elyrium/Compiler/StreamLexer.hpp>
+
+#include <cassert>
+#include <cstring>
+
+namespace elyrium {
+
+namespace compiler {
+
+StreamLexer::StreamLexer(filesys::InputStream& input, lsd::StringView path, SymbolTable& symbols, size_type chunkSize) : 
+	m_input(input), m_path(path), m_symbols(symbols), m_chunkSize(chunkSize) {
+	refill();
+}
+
+Token StreamLexer::nextToken() {
+	while (true) {
+		if (!m_exhausted && m_window.size() - m_position < m_chunkSize)
+			refill();
+
+		auto begin = m_window.data();
+		auto end = begin + m_window.size();
+
+		m_lexer->m_iter = begin + m_position;
+
+		try {
+			auto token = m_lexer->nextToken();
+
+			// A token which reaches the end of the window might continue in the input, so it is lexed again with more input
+			if (!m_exhausted && m_lexer->m_iter == end) {
+				refill();
+				continue;
+			}
+
+			m_position = static_cast<size_type>(m_lexer->m_iter - begin);
+
+			if (token.type() == Token::Type::eof) 
+				return token;
+
+			m_tokenOffset = static_cast<size_type>(token.data().data() - begin);
+
+			if (token.type() == Token::Type::string) {
+				auto value = token.value();
+				value.literal = m_literals.insert(m_lexer->m_literals.string(value.literal));
+
+				return Token(token.type(), token.data(), value);
+			}
+
+			return token;
+		} catch (const SyntaxError&) {
+			// Truncated tokens can only be noticed at the end of the window, and errors show the rest of their line as well
+			auto iter = m_lexer->m_iter;
+			if (m_exhausted || (iter < end - 1 && std::memchr(iter, '\n', end - iter)))
+				throw;
+
+			refill();
+		}
+	}
+}
+
+TokenBuffer StreamLexer::tokenize(lsd::String& source) {
+	assert(m_windowOffset == 0 && m_position == 0 && "elyrium::compiler::StreamLexer::tokenize(): Tokens were already read from the input, aborting!");
+
+	struct Lexed {
+	public:
+		Token::Type type;
+		size_type offset;
+		size_type length;
+		Token::Value value;
+	};
+
+	// The source grows while it is read, so the tokens are only pointed into it once all of it was read
+	source.clear();
+	source.append(lsd::StringView(m_window.data(), m_window.size()));
+	m_transcript = &source;
+
+	lsd::Vector<Lexed> lexed;
+
+	try {
+		for (auto token = nextToken(); token.type() != Token::Type::eof; token = nextToken())
+			lexed.pushBack(Lexed { token.type(), m_windowOffset + m_tokenOffset, token.data().size(), token.value() });
+	} catch (...) {
+		m_transcript = nullptr;
+		throw;
+	}
+
+	m_transcript = nullptr;
+
+	TokenBuffer tokens(lsd::StringView(source.data(), source.size()));
+	tokens.reserve(lexed.size() + 1);
+
+	for (const auto& token : lexed)
+		tokens.pushBack(Token(token.type, lsd::StringView(source.data() + token.offset, token.length), token.value));
+
+	tokens.pushBack(Token::Type::eof, static_cast<TokenBuffer::offset_type>(source.size()), 0);
+	tokens.bindLiterals(releaseLiterals());
+
+	return tokens;
+}
+
+SourceLocation StreamLexer::location() const {
+	auto location = m_lexer->m_lines.location(m_tokenOffset);
+
+	if (location.line == 0) location.column += m_base.column;
+	location.line += m_base.line;
+
+	return location;
+}
+
+void StreamLexer::refill() {
+	// Keep the whole line of the current position if it isn't too long, so that errors can show it, which it never is if all input is kept anyways
+	auto keep = m_position;
+	for (auto lineBegin = m_position; m_transcript || m_position - lineBegin < m_chunkSize; lineBegin--) {
+		if (lineBegin == 0 || m_window[lineBegin - 1] == '\n') {
+			keep = lineBegin;
+			break;
+		}
+	}
+
+	if (keep != 0) {
+		size_type lastLineBegin = 0;
+		size_type lines = 0;
+
+		for (auto it = m_window.data(), end = m_window.data() + keep; (it = static_cast<char*>(std::memchr(it, '\n', end - it))) != nullptr; ) {
+			lines++;
+			lastLineBegin = static_cast<size_type>(++it - m_window.data());
+		}
+
+		if (lines != 0) {
+			m_base.line += lines;
+			m_base.column = keep - lastLineBegin;
+			m_baseTabs = 0;
+		} else m_base.column += keep;
+
+		for (auto i = lastLineBegin; i < keep; i++)
+			if (m_window[i] == '\t') m_baseTabs++;
+
+		std::memmove(m_window.data(), m_window.data() + keep, m_window.size() - keep);
+		m_window.resize(m_window.size() - keep);
+
+		m_position -= keep;
+		m_tokenOffset = 0;
+		m_windowOffset += keep;
+	}
+
+	// Read at least one chunk past the current position, or less if the input ends first
+	for (auto target = m_window.size() + m_chunkSize; !m_exhausted && m_window.size() < target; ) {
+		auto size = m_window.size();
+		m_window.resize(target);
+
+		auto count = m_input.read(m_window.data() + size, target - size);
+		m_window.resize(size + count);
+
+		if (m_transcript) {
+			m_transcript->append(lsd::StringView(m_window.data() + size, count));
+			if (m_transcript->size() > Lexer::sourceLimit) throw SyntaxError(m_path, 0, 0, lsd::StringView(), error::Message::sourceTooLarge);
+		}
+
+		if (count == 0) m_exhausted = true;
+	}
+
+	m_lexer = lsd::UniquePointer<Lexer>::create(lsd::StringView(m_window.data(), m_window.size()), m_path, m_symbols, m_base);
+	m_lexer->m_partial = !m_exhausted;
+	m_lexer->m_baseSpaces = m_baseTabs * 3;
+}
+
+} // namespace compiler
+
+} // namespace elyrium
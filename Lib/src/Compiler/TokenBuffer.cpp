@@ -0,0 +1,164 @@
+#include <Elyrium/Compiler/TokenBuffer.hpp>
+
+#include <bit>
+#include <cassert>
+
+namespace elyrium {
+
+namespace compiler {
+
+void TokenBuffer::reserve(size_type count) {
+	m_types.reserve(count);
+	m_offsets.reserve(count);
+	m_lengths.reserve(count);
+	m_payloads.reserve(count);
+}
+
+void TokenBuffer::pushBack(const Token& token) {
+	auto payload = token.symbol();
+
+	switch (token.type()) {
+		case Token::Type::integral:
+			payload = static_cast<uint32>(m_constants.size());
+			m_constants.pushBack(std::bit_cast<uint64>(token.integral()));
+
+			break;
+
+		case Token::Type::unsignedIntegral:
+			payload = static_cast<uint32>(m_constants.size());
+			m_constants.pushBack(token.unsignedIntegral());
+
+			break;
+
+		case Token::Type::floating:
+			payload = static_cast<uint32>(m_constants.size());
+			m_constants.pushBack(std::bit_cast<uint64>(token.floating()));
+
+			break;
+
+		case Token::Type::character:
+			payload = token.character();
+
+			break;
+
+		case Token::Type::string:
+			payload = token.literal();
+
+			break;
+
+		default:
+			break;
+	}
+
+	pushBack(token.type(), static_cast<offset_type>(token.data().data() - m_source.data()), static_cast<offset_type>(token.data().size()), payload);
+}
+
+void TokenBuffer::pushBack(Token::Type type, offset_type offset, offset_type length, uint32 payload) {
+	assert(offset + length <= m_source.size() && "elyrium::compiler::TokenBuffer::pushBack(): Token is not located inside of the source, aborting!");
+
+	m_types.pushBack(static_cast<Token::type_tag>(type));
+	m_offsets.pushBack(offset);
+	m_lengths.pushBack(length);
+	m_payloads.pushBack(payload);
+}
+
+void TokenBuffer::append(const TokenBuffer& other, index_type first, const lsd::Vector<symbol_id>& symbols, const lsd::Vector<literal_id>& literals) {
+	assert(other.m_source.data() == m_source.data() && "elyrium::compiler::TokenBuffer::append(): Tokens do not belong to the same source, aborting!");
+
+	auto base = size() - first;
+	auto count = size() + other.size() - first;
+
+	m_types.resize(count);
+	m_offsets.resize(count);
+	m_lengths.resize(count);
+	m_payloads.resize(count);
+
+	for (auto i = first; i < other.size(); i++) {
+		auto payload = other.m_payloads[i];
+
+		switch (other.type(i)) {
+			case Token::Type::identifier:
+			case Token::Type::attribute:
+				payload = symbols[payload];
+
+				break;
+
+			case Token::Type::string:
+				payload = literals[payload];
+
+				break;
+
+			case Token::Type::integral:
+			case Token::Type::unsignedIntegral:
+			case Token::Type::floating:
+				payload = static_cast<uint32>(m_constants.size());
+				m_constants.pushBack(other.m_constants[other.m_payloads[i]]);
+
+				break;
+
+			default:
+				break;
+		}
+
+		m_types[base + i] = other.m_types[i];
+		m_offsets[base + i] = other.m_offsets[i];
+		m_lengths[base + i] = other.m_lengths[i];
+		m_payloads[base + i] = payload;
+	}
+}
+
+void TokenBuffer::remapSymbols(const lsd::Vector<symbol_id>& symbols) noexcept {
+	for (size_type i = 0; i < size(); i++) {
+		if (auto type = this->type(i); type == Token::Type::identifier || type == Token::Type::attribute)
+			m_payloads[i] = symbols[m_payloads[i]];
+	}
+}
+
+void TokenBuffer::remapLiterals(const lsd::Vector<literal_id>& literals) noexcept {
+	for (size_type i = 0; i < size(); i++) {
+		if (type(i) == Token::Type::string)
+			m_payloads[i] = literals[m_payloads[i]];
+	}
+}
+
+Token::Value TokenBuffer::value(index_type index) const noexcept {
+	Token::Value value;
+
+	switch (type(index)) {
+		case Token::Type::integral:
+			value.integral = std::bit_cast<int64>(m_constants[m_payloads[index]]);
+
+			break;
+
+		case Token::Type::unsignedIntegral:
+			value.unsignedIntegral = m_constants[m_payloads[index]];
+
+			break;
+
+		case Token::Type::floating:
+			value.floating = std::bit_cast<float64>(m_constants[m_payloads[index]]);
+
+			break;
+
+		case Token::Type::character:
+			value.character = m_payloads[index];
+
+			break;
+
+		case Token::Type::string:
+			value.literal = m_payloads[index];
+
+			break;
+
+		default:
+			value.symbol = m_payloads[index];
+
+			break;
+	}
+
+	return value;
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,711 @@
+#include <Elyrium/Compiler/TypeChecker.hpp>
+
+#include <LSD/Array.h>
+
+namespace elyrium {
+
+namespace compiler {
+
+namespace {
+
+struct Spelling {
+public:
+	const char* string;
+	Type type;
+};
+
+inline constexpr lsd::Array typeSpellings {
+	Spelling { "int", Type::integral },
+	Spelling { "uint", Type::unsignedIntegral },
+	Spelling { "float", Type::floating },
+	Spelling { "bool", Type::boolean },
+};
+
+/**
+ * @brief Returns the type of an annotation, generic types, pointers and other named types are typed dynamically
+ */
+[[nodiscard]] Type annotation(const ast::detail::type_ident_ptr& type) noexcept {
+	if (!type || !type->generics.empty() || type->pointerCount != 0) return Type::unknown;
+
+	for (const auto& spelling : typeSpellings)
+		if (type->identifier.data() == lsd::StringView(spelling.string)) return spelling.type;
+
+	return Type::unknown;
+}
+
+[[nodiscard]] bool numeric(Type type) noexcept {
+	return type == Type::integral || type == Type::unsignedIntegral || type == Type::floating;
+}
+
+/**
+ * @brief Returns the value of an integral literal, which may be negated
+ */
+[[nodiscard]] bool integralLiteral(const ast::Expression* expression, int64& value) noexcept {
+	auto sign = int64 { 1 };
+
+	if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression)) {
+		const auto& prefix = unary->prefix();
+		if (unary->postfix().type() != Token::Type::none || prefix.size() != 1 || prefix[0].type() != Token::Type::sub) return false;
+
+		sign = -1;
+		expression = unary->expr().get();
+	}
+
+	auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression);
+	if (!atomic || atomic->value().type() != Token::Type::integral) return false;
+
+	value = sign * atomic->value().integral();
+	return true;
+}
+
+[[nodiscard]] bool assignmentOperator(Token::Type type) noexcept {
+	switch (type) {
+		case Token::Type::assign:
+		case Token::Type::kMove:
+		case Token::Type::assignAdd:
+		case Token::Type::assignSub:
+		case Token::Type::assignMul:
+		case Token::Type::assignDiv:
+		case Token::Type::assignMod:
+		case Token::Type::assignShiftLeft:
+		case Token::Type::assignShiftRight:
+		case Token::Type::assignBitXOr:
+		case Token::Type::assignBitNot:
+		case Token::Type::assignBitOr:
+		case Token::Type::assignBitAnd:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief Checks if a binary or compound assignment operator only applies to integrals
+ */
+[[nodiscard]] bool bitwiseOperator(Token::Type type) noexcept {
+	switch (type) {
+		case Token::Type::shiftLeft:
+		case Token::Type::shiftRight:
+		case Token::Type::bitAnd:
+		case Token::Type::bitOr:
+		case Token::Type::bitXOr:
+		case Token::Type::assignShiftLeft:
+		case Token::Type::assignShiftRight:
+		case Token::Type::assignBitAnd:
+		case Token::Type::assignBitOr:
+		case Token::Type::assignBitXOr:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+[[nodiscard]] bool arithmeticOperator(Token::Type type) noexcept {
+	switch (type) {
+		case Token::Type::add:
+		case Token::Type::sub:
+		case Token::Type::mul:
+		case Token::Type::div:
+		case Token::Type::mod:
+		case Token::Type::assignAdd:
+		case Token::Type::assignSub:
+		case Token::Type::assignMul:
+		case Token::Type::assignDiv:
+		case Token::Type::assignMod:
+			return true;
+
+		default:
+			return bitwiseOperator(type);
+	}
+}
+
+[[nodiscard]] bool comparisonOperator(Token::Type type) noexcept {
+	switch (type) {
+		case Token::Type::equal:
+		case Token::Type::notEqual:
+		case Token::Type::less:
+		case Token::Type::lessEqual:
+		case Token::Type::greater:
+		case Token::Type::greaterEqual:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+[[nodiscard]] bool incrementOperator(Token::Type type) noexcept {
+	return type == Token::Type::increment || type == Token::Type::decrement;
+}
+
+/**
+ * @brief Returns the number of prefix operators in front of the increments directly in front of the operand
+ */
+[[nodiscard]] size_type outerPrefixes(const lsd::Vector<Token>& prefix) noexcept {
+	auto operators = prefix.size();
+
+	while (operators > 0 && incrementOperator(prefix[operators - 1].type()))
+		--operators;
+
+	return operators;
+}
+
+/**
+ * @brief Returns the type of a value after the first operators prefix operators were applied to it, from the innermost one outwards
+ */
+[[nodiscard]] Type applyPrefixes(const lsd::Vector<Token>& prefix, size_type operators, Type type) noexcept {
+	for (; operators > 0; operators--) {
+		switch (prefix[operators - 1].type()) {
+			case Token::Type::sub:
+				if (type == Type::unsignedIntegral) type = Type::unknown;
+				[[fallthrough]];
+			case Token::Type::add:
+				if (!numeric(type)) type = Type::unknown;
+				break;
+			case Token::Type::bitNot:
+				if (type != Type::integral && type != Type::unsignedIntegral) type = Type::unknown;
+				break;
+			case Token::Type::logicNot:
+				type = Type::boolean;
+				break;
+
+			default:
+				type = Type::unknown;
+		}
+	}
+
+	return type;
+}
+
+} // namespace
+
+Typing TypeChecker::check() {
+	m_globals = lsd::Vector<Type>(m_resolution->globals().size(), Type::unknown);
+	declareGlobals(m_module->declarations());
+
+	m_functions.emplaceBack();
+
+	for (const auto& declaration : m_module->declarations())
+		this->declaration(declaration.get());
+
+	return std::move(m_typing);
+}
+
+void TypeChecker::error(const Token& token, error::Message message) const {
+	throw compileError(token, m_source, *m_lines, m_path, message);
+}
+
+void TypeChecker::record(const void* node, Type type) {
+	// Unknown types aren't recorded, as that is what the typing returns for nodes it doesn't know
+	if (m_final && type != Type::unknown) m_typing.m_types[node] = type;
+}
+
+void TypeChecker::declareGlobals(const lsd::Vector<ast::decl_ptr>& declarations) {
+	for (const auto& declaration : declarations) {
+		if (auto variable = dynamic_cast<const ast::VariableDecl*>(declaration.get())) {
+			for (const auto& identifier : variable->identifiers())
+				m_globals[m_resolution->binding(identifier.identifier).index] = annotation(identifier.type);
+		} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(declaration.get())) {
+			declareGlobals(namespaceDecl->declarations());
+		}
+	}
+}
+
+
+// Storage
+
+void TypeChecker::declareLocal(const ast::detail::IdentifierDecl& identifier, Type value, const ast::Expression* expression) {
+	const auto& binding = m_resolution->binding(identifier.identifier);
+	auto& local = state().locals[binding.index];
+
+	auto declared = annotation(identifier.type);
+
+	if (declared != Type::unknown) {
+		local = Local { declared, true, true };
+		record(&identifier, declared);
+
+		// Locals without an initializer start out as the zero of their type
+		if (!expression) return;
+	} else if (binding.captured) {
+		// Closures may store anything into the local
+		local = Local { Type::unknown, false, true };
+	}
+
+	store(Target { Target::Kind::local, binding.index }, value, expression, &identifier, identifier.identifier);
+}
+
+Type TypeChecker::read(const Target& target) noexcept {
+	switch (target.kind) {
+		case Target::Kind::local:
+			return state().locals[target.index].type;
+		case Target::Kind::upvalue:
+			return state().upvalues[target.index];
+
+		default:
+			return Type::unknown;
+	}
+}
+
+Type TypeChecker::store(const Target& target, Type value, const ast::Expression* expression, const void* node, const Token& token) {
+	auto declared = Type::unknown;
+
+	switch (target.kind) {
+		case Target::Kind::local: {
+			auto& local = state().locals[target.index];
+
+			if (local.declared) {
+				declared = local.type;
+			} else if (local.assigned && local.type != value) {
+				// Locals stored with values of different types are typed dynamically
+				if (local.type != Type::unknown) {
+					local.type = Type::unknown;
+					state().changed = true;
+				}
+			} else if (!local.assigned) {
+				local = Local { value, false, true };
+				state().changed = true;
+			}
+
+			break;
+		}
+
+		case Target::Kind::upvalue:
+			declared = state().upvalues[target.index];
+			break;
+		case Target::Kind::global:
+			declared = m_globals[target.index];
+			break;
+
+		default:
+			break;
+	}
+
+	if (declared == Type::unknown) return value;
+
+	if (expression && convert(expression, declared)) value = declared;
+
+	if (value == Type::unknown) {
+		if (m_final) m_typing.m_checks[node] = declared;
+	} else if (value != declared && m_final) error(token, error::Message::typeMismatch);
+
+	return declared;
+}
+
+bool TypeChecker::convert(const ast::Expression* expression, Type type) {
+	int64 value;
+
+	if (!integralLiteral(expression, value) || (type != Type::floating && (type != Type::unsignedIntegral || value < 0))) return false;
+
+	if (m_final) {
+		m_typing.m_types[expression] = type;
+		if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression)) m_typing.m_types[unary->expr().get()] = type;
+	}
+
+	return true;
+}
+
+Type TypeChecker::operands(const ast::Expression* left, Type leftType, const ast::Expression* right, Type rightType, bool bitwise) {
+	int64 value;
+	auto type = leftType;
+
+	// Integral literals take the type of the other operand, if they fit into it
+	if (leftType != rightType) {
+		if (integralLiteral(left, value) && leftType == Type::integral) type = rightType;
+		else if (!integralLiteral(right, value) || rightType != Type::integral) return Type::unknown;
+	}
+
+	if (!numeric(type) || (bitwise && type == Type::floating)) return Type::unknown;
+
+	if (leftType != type && !convert(left, type)) return Type::unknown;
+	if (rightType != type && !convert(right, type)) return Type::unknown;
+
+	return type;
+}
+
+
+// Traversal
+
+void TypeChecker::declaration(ast::Declaration* declaration) {
+	if (auto variable = dynamic_cast<const ast::VariableDecl*>(declaration)) {
+		for (const auto& identifier : variable->identifiers()) {
+			auto slot = m_resolution->binding(identifier.identifier).index;
+			record(&identifier, m_globals[slot]);
+
+			if (identifier.expression) {
+				auto value = expression(identifier.expression.get());
+				store(Target { Target::Kind::global, slot }, value, identifier.expression.get(), &identifier, identifier.identifier);
+			}
+		}
+	} else if (auto function = dynamic_cast<const ast::FunctionDecl*>(declaration)) {
+		this->function(*function);
+	} else if (auto namespaceDecl = dynamic_cast<const ast::NamespaceDecl*>(declaration)) {
+		for (const auto& member : namespaceDecl->declarations())
+			this->declaration(member.get());
+	}
+}
+
+template <class Node> void TypeChecker::function(const Node& node) {
+	const auto& resolved = m_resolution->function(&node);
+	const auto& construct = node.construct();
+
+	m_functions.emplaceBack();
+
+	auto& state = this->state();
+	const auto& enclosing = m_functions[m_functions.size() - 2];
+
+	state.locals = lsd::Vector<Local>(resolved.localCount, Local { });
+	state.result = annotation(construct.type);
+
+	// Upvalues only have the declared types of their locals, since the functions storing into them check the values
+	for (const auto& capture : resolved.captures) {
+		if (!capture.local) state.upvalues.pushBack(enclosing.upvalues[capture.index]);
+		else if (const auto& local = enclosing.locals[capture.index]; local.declared) state.upvalues.pushBack(local.type);
+		else state.upvalues.pushBack(Type::unknown);
+	}
+
+	auto body = [&]() {
+		for (const auto& parameter : construct.parameters) {
+			// Callers aren't typed, so parameters with a declared type are checked once the function is entered
+			auto declared = annotation(parameter.type);
+			if (declared != Type::unknown && m_final) m_typing.m_checks[&parameter] = declared;
+
+			declareLocal(parameter, declared, nullptr);
+		}
+
+		for (const auto& statement : node.body().statements())
+			this->statement(statement.get());
+	};
+
+	// The types of the locals only ever become less precise, so they stop changing after a few passes over the body
+	auto final = m_final;
+	m_final = false;
+
+	do {
+		this->state().changed = false;
+		body();
+	} while (this->state().changed);
+
+	m_final = true;
+	body();
+
+	m_final = final;
+	m_functions.popBack();
+}
+
+void TypeChecker::statement(ast::Statement* statement) {
+	if (auto variable = dynamic_cast<const ast::VariableDecl*>(statement)) {
+		for (const auto& identifier : variable->identifiers()) {
+			auto value = identifier.expression ? expression(identifier.expression.get()) : Type::unknown;
+			declareLocal(identifier, value, identifier.expression.get());
+		}
+	} else if (auto expr = dynamic_cast<const ast::ExprStmt*>(statement)) {
+		expression(expr->expr().get());
+	} else if (auto block = dynamic_cast<const ast::BlockStmt*>(statement)) {
+		for (const auto& statement : block->statements())
+			this->statement(statement.get());
+	} else if (auto ifStmt = dynamic_cast<const ast::IfStmt*>(statement)) {
+		const auto& construct = ifStmt->construct();
+
+		if (construct.init) this->statement(construct.init.get());
+		expression(construct.condition.get());
+
+		this->statement(ifStmt->statement().get());
+		if (ifStmt->elseStatement()) this->statement(ifStmt->elseStatement().get());
+	} else if (auto forStmt = dynamic_cast<const ast::ForStmt*>(statement)) {
+		const auto& construct = forStmt->construct();
+
+		if (construct.init) this->statement(construct.init.get());
+
+		if (construct.rangeBased) {
+			expression(construct.range().get());
+
+			for (const auto& item : construct.items()) {
+				auto atomic = dynamic_cast<const ast::AtomicExpr*>(item.get());
+
+				if (atomic && atomic->value().type() == Token::Type::identifier && m_resolution->binding(atomic->value()).kind == Binding::Kind::local)
+					store(Target { Target::Kind::local, m_resolution->binding(atomic->value()).index }, Type::unknown, nullptr, item.get(), atomic->value());
+				else expression(item.get());
+			}
+		} else {
+			if (construct.condition()) expression(construct.condition().get());
+
+			for (const auto& loop : construct.loop())
+				expression(loop.get());
+		}
+
+		this->statement(forStmt->statement().get());
+	} else if (auto jump = dynamic_cast<const ast::JumpStmt*>(statement)) {
+		if (jump->keyword().type() != Token::Type::kReturn) {
+			if (jump->expr()) expression(jump->expr().get());
+			return;
+		}
+
+		auto value = jump->expr() ? expression(jump->expr().get()) : Type::unknown;
+		auto declared = state().result;
+
+		if (declared == Type::unknown) return;
+
+		// Returning nothing returns null, which never has a declared type
+		if (!jump->expr()) {
+			if (m_final) error(jump->keyword(), error::Message::typeMismatch);
+			return;
+		}
+
+		if (convert(jump->expr().get(), declared)) value = declared;
+
+		if (value == Type::unknown) {
+			if (m_final) m_typing.m_checks[jump] = declared;
+		} else if (value != declared && m_final) error(jump->keyword(), error::Message::typeMismatch);
+	} else if (auto tryCatch = dynamic_cast<const ast::TryCatchStmt*>(statement)) {
+		this->statement(tryCatch->tryBlock().get());
+
+		for (const auto& [block, construct] : tryCatch->catchBlocks()) {
+			if (construct) store(Target { Target::Kind::local, m_resolution->binding(construct->identifier).index }, Type::unknown, nullptr, construct.get(), construct->identifier);
+			this->statement(block.get());
+		}
+	} else if (auto function = dynamic_cast<const ast::FunctionDecl*>(statement)) {
+		store(Target { Target::Kind::local, m_resolution->binding(function->identifier()).index }, Type::unknown, nullptr, function, function->identifier());
+
+		// Nested functions only depend on declared types, so they are checked once
+		if (m_final) this->function(*function);
+	}
+}
+
+Type TypeChecker::expression(const ast::Expression* expression) {
+	m_frames.pushBack(ExpressionFrame { expression, ExpressionFrame::Kind::value });
+	return evaluate().type;
+}
+
+TypeChecker::Target TypeChecker::target(const ast::Expression* expression) {
+	m_frames.pushBack(ExpressionFrame { expression, ExpressionFrame::Kind::target });
+	return evaluate().target;
+}
+
+TypeChecker::ExpressionResult TypeChecker::evaluate() {
+	// Closures check their bodies with another call, whose frames are stacked on top
+	auto bottom = m_frames.size() - 1;
+	ExpressionResult result;
+
+	while (m_frames.size() > bottom) {
+		const auto& frame = m_frames.back();
+		auto expression = frame.expression;
+
+		if (frame.kind == ExpressionFrame::Kind::target) continueTarget(result);
+		else if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression)) finishValue(result, this->atomic(*atomic));
+		else if (auto member = dynamic_cast<const ast::MemberExpr*>(expression)) continueMember(*member, result);
+		else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression)) continueUnary(*unary, result);
+		else if (auto infix = dynamic_cast<const ast::InfixExpr*>(expression)) continueInfix(*infix, result);
+		else if (auto closure = dynamic_cast<const ast::ClosureExpr*>(expression)) continueClosure(*closure, result);
+		else finishValue(result, Type::unknown);
+	}
+
+	return result;
+}
+
+void TypeChecker::call(const ast::Expression* expression, ExpressionFrame::Kind kind) {
+	m_frames.pushBack(ExpressionFrame { expression, kind });
+}
+
+void TypeChecker::finishValue(ExpressionResult& result, Type type) {
+	record(m_frames.back().expression, type);
+	m_frames.popBack();
+
+	result.type = type;
+}
+
+void TypeChecker::finishTarget(ExpressionResult& result, const Target& target) {
+	m_frames.popBack();
+	result.target = target;
+}
+
+Type TypeChecker::atomic(const ast::AtomicExpr& expression) {
+	switch (expression.value().type()) {
+		case Token::Type::identifier:
+			return read(variable(expression.value()));
+
+		case Token::Type::integral:
+			return Type::integral;
+		case Token::Type::unsignedIntegral:
+			return Type::unsignedIntegral;
+		case Token::Type::floating:
+			return Type::floating;
+		case Token::Type::kTrue:
+		case Token::Type::kFalse:
+			return Type::boolean;
+
+		default:
+			return Type::unknown;
+	}
+}
+
+TypeChecker::Target TypeChecker::variable(const Token& identifier) const noexcept {
+	const auto& binding = m_resolution->binding(identifier);
+
+	switch (binding.kind) {
+		case Binding::Kind::local:
+			return Target { Target::Kind::local, binding.index };
+		case Binding::Kind::upvalue:
+			return Target { Target::Kind::upvalue, binding.index };
+
+		default:
+			return Target { Target::Kind::global, binding.index };
+	}
+}
+
+void TypeChecker::continueTarget(ExpressionResult& result) {
+	auto& frame = m_frames.back();
+	auto expression = frame.expression;
+
+	if (auto atomic = dynamic_cast<const ast::AtomicExpr*>(expression); atomic && atomic->value().type() == Token::Type::identifier) {
+		return finishTarget(result, variable(atomic->value()));
+	} else if (auto member = dynamic_cast<const ast::MemberExpr*>(expression)) {
+		if (auto binding = m_resolution->find(member); binding && binding->consumed == member->chain().size())
+			return finishTarget(result, Target { Target::Kind::global, binding->index });
+	} else if (auto unary = dynamic_cast<const ast::UnaryExpr*>(expression); unary && unary->postfix().type() == Token::Type::none) {
+		// Prefix increments result in the incremented place itself, which is the target of their operand once they were typed
+		if (frame.stage == 0) {
+			frame.stage = 1;
+			return call(unary, ExpressionFrame::Kind::value);
+		}
+
+		frame.expression = unary->expr().get();
+		frame.stage = 0;
+
+		return;
+	}
+
+	if (frame.stage == 0) {
+		frame.stage = 1;
+		return call(expression, ExpressionFrame::Kind::value);
+	}
+
+	finishTarget(result, Target { });
+}
+
+void TypeChecker::continueMember(const ast::MemberExpr& expression, ExpressionResult& result) {
+	auto& frame = m_frames.back();
+	const auto& chain = expression.chain();
+
+	if (frame.stage == 0) {
+		frame.stage = 1;
+
+		// Chains starting with namespaces start at the static member they lead to
+		if (auto binding = m_resolution->find(&expression)) frame.element = binding->consumed;
+		else return call(expression.value().get(), ExpressionFrame::Kind::value);
+	}
+
+	for (; frame.element < chain.size(); frame.element++, frame.operand = 0) {
+		if (auto arguments = std::get_if<ast::detail::arg_t>(&chain[frame.element])) {
+			if (frame.operand < arguments->size()) return call((*arguments)[frame.operand++].get(), ExpressionFrame::Kind::value);
+		} else if (auto subscript = std::get_if<ast::detail::subscript_t>(&chain[frame.element]); subscript && frame.operand == 0) {
+			++frame.operand;
+			return call(subscript->get(), ExpressionFrame::Kind::value);
+		}
+	}
+
+	finishValue(result, Type::unknown);
+}
+
+void TypeChecker::continueUnary(const ast::UnaryExpr& expression, ExpressionResult& result) {
+	auto& frame = m_frames.back();
+
+	const auto& prefix = expression.prefix();
+	const auto& postfix = expression.postfix();
+
+	auto operators = outerPrefixes(prefix);
+	auto incremented = incrementOperator(postfix.type()) || operators != prefix.size();
+
+	if (frame.stage == 0) {
+		if (int64 value; !incremented && operators == 1 && integralLiteral(&expression, value)) {
+			record(expression.expr().get(), Type::integral);
+			return finishValue(result, applyPrefixes(prefix, operators, Type::integral));
+		}
+
+		frame.stage = 1;
+		return call(expression.expr().get(), incremented ? ExpressionFrame::Kind::target : ExpressionFrame::Kind::value);
+	}
+
+	auto type = result.type;
+
+	if (incremented) {
+		auto value = read(result.target);
+
+		record(expression.expr().get(), value);
+
+		// Increments of values which aren't numbers are typed dynamically, postfix increments result in the value before the increment
+		if (!numeric(value)) value = Type::unknown;
+
+		auto stored = store(result.target, value, nullptr, &expression, incrementOperator(postfix.type()) ? postfix : prefix[operators]);
+		type = incrementOperator(postfix.type()) ? value : stored;
+	}
+
+	finishValue(result, applyPrefixes(prefix, operators, type));
+}
+
+void TypeChecker::continueInfix(const ast::InfixExpr& expression, ExpressionResult& result) {
+	auto& frame = m_frames.back();
+
+	auto type = expression.op().type();
+	auto left = expression.left().get();
+	auto right = expression.right().get();
+
+	switch (frame.stage) {
+		case 0:
+			frame.stage = 1;
+			return call(left, assignmentOperator(type) ? ExpressionFrame::Kind::target : ExpressionFrame::Kind::value);
+
+		case 1:
+			if (assignmentOperator(type)) frame.target = result.target;
+			else frame.type = result.type;
+
+			frame.stage = 2;
+			return call(right, ExpressionFrame::Kind::value);
+
+		default:
+			break;
+	}
+
+	auto rightType = result.type;
+
+	if (assignmentOperator(type)) {
+		auto target = frame.target;
+
+		if (type == Token::Type::assign || type == Token::Type::kMove) return finishValue(result, store(target, rightType, right, &expression, expression.op()));
+
+		auto current = read(target);
+		record(left, current);
+
+		auto value = operands(left, current, right, rightType, bitwiseOperator(type));
+		return finishValue(result, store(target, value, nullptr, &expression, expression.op()));
+	}
+
+	auto leftType = frame.type;
+
+	if (type == Token::Type::logicAnd || type == Token::Type::logicOr) return finishValue(result, Type::boolean);
+
+	if (comparisonOperator(type)) {
+		operands(left, leftType, right, rightType, false);
+		return finishValue(result, Type::boolean);
+	}
+
+	if (type == Token::Type::spaceship) return finishValue(result, (operands(left, leftType, right, rightType, false) != Type::unknown) ? Type::integral : Type::unknown);
+	if (arithmeticOperator(type)) return finishValue(result, operands(left, leftType, right, rightType, bitwiseOperator(type)));
+
+	finishValue(result, Type::unknown);
+}
+
+void TypeChecker::continueClosure(const ast::ClosureExpr& expression, ExpressionResult& result) {
+	auto& frame = m_frames.back();
+	const auto& captures = expression.captures();
+
+	if (frame.element < captures.size()) return call(captures[frame.element++].get(), ExpressionFrame::Kind::value);
+
+	if (m_final) function(expression);
+	finishValue(result, Type::unknown);
+}
+
+} // namespace compiler
+
+} // namespace elyrium
@@ -0,0 +1,66 @@
+#include <Elyrium/Core/Arena.hpp>
+
+#include <cstring>
+
+namespace elyrium {
+
+Arena::Arena(Arena&& other) noexcept :
+	m_head(std::exchange(other.m_head, nullptr)),
+	m_current(std::exchange(other.m_current, 0)),
+	m_end(std::exchange(other.m_end, 0)),
+	m_blockSize(other.m_blockSize),
+	m_allocatedBytes(std::exchange(other.m_allocatedBytes, 0)) { }
+
+Arena::~Arena() {
+	release();
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+	if (this != &other) {
+		release();
+
+		m_head = std::exchange(other.m_head, nullptr);
+		m_current = std::exchange(other.m_current, 0);
+		m_end = std::exchange(other.m_end, 0);
+		m_blockSize = other.m_blockSize;
+		m_allocatedBytes = std::exchange(other.m_allocatedBytes, 0);
+	}
+
+	return *this;
+}
+
+lsd::StringView Arena::copy(lsd::StringView string) {
+	auto data = static_cast<char*>(allocate(string.size() + 1, alignof(char)));
+
+	std::memcpy(data, string.data(), string.size());
+	data[string.size()] = '\0';
+
+	return lsd::StringView(data, string.size());
+}
+
+void Arena::release() noexcept {
+	while (m_head) {
+		auto previous = m_head->previous;
+		::operator delete(m_head);
+		m_head = previous;
+	}
+
+	m_current = 0;
+	m_end = 0;
+	m_allocatedBytes = 0;
+}
+
+void Arena::addBlock(size_type minimumSize) {
+	auto size = sizeof(Block) + (minimumSize > m_blockSize ? minimumSize : m_blockSize);
+	auto block = static_cast<Block*>(::operator new(size));
+
+	block->previous = m_head;
+	block->size = size;
+	m_head = block;
+
+	m_current = reinterpret_cast<uintptr>(block + 1);
+	m_end = reinterpret_cast<uintptr>(block) + size;
+	m_allocatedBytes += size;
+}
+
+} // namespace elyrium
@@ -1,7 +1,6 @@
 #include "LSD/StringView.h"
 #include <Elyrium/Core/Error.hpp>
 
-#include <LSD/UnorderedDenseMap.h>
 #include <LSD/String.h>
 
 #include <cstdio>
@@ -11,6 +10,67 @@
 
 namespace elyrium {
 
+namespace {
+
+// Descriptions of the messages in the order of their declaration
+inline constexpr const char* messageDescriptions[] = {
+	"Invalid syntax",
+	"Invalid numeric literal",
+	"Numeric literal is out of range",
+	"Disallowed character in code",
+	"Invalid escape sequence",
+	"Unescaped special character",
+	"Character can't be empty",
+	"Expected \"*/\"",
+	"Source is too large to be lexed",
+	"Expected different",
+	"Expected indentifier",
+	"Expected expression",
+	"Expected declaration",
+	"No catch-block was found behind a try-block",
+	"Import declaration requires string or a constant string variable",
+	"Could not find module",
+	"Circular import of module",
+	"Name was already declared in this scope",
+	"Namespace has no member with this name",
+	"Namespace can't be used as a value",
+	"Construct is not supported by the bytecode compiler yet",
+	"Expression can't be assigned to",
+	"Jump statement outside of a loop",
+	"Function requires too many registers",
+	"Function contains too many constants",
+	"Function is too large to be compiled",
+	"Value doesn't have the declared type",
+};
+
+static_assert(
+	sizeof(messageDescriptions) / sizeof(messageDescriptions[0]) == static_cast<size_type>(error::Message::typeMismatch) + 1,
+	"elyrium::error: Every message requires a description!"
+);
+
+/**
+ * @brief Formats into a string with a single call to snprintf for messages which fit into a small guess
+ */
+template <class... Args> void formatMessage(lsd::String& string, const char* format, Args... args) {
+	static constexpr size_type sizeGuess = 256;
+
+	string.resize(sizeGuess);
+	auto length = static_cast<size_type>(std::snprintf(string.data(), sizeGuess + 1, format, args...));
+
+	string.resize(length);
+	if (length > sizeGuess) std::snprintf(string.data(), length + 1, format, args...);
+}
+
+} // namespace
+
+namespace error {
+
+const char* describe(Message message) noexcept {
+	return messageDescriptions[static_cast<size_type>(message)];
+}
+
+} // namespace error
+
 SyntaxError::SyntaxError(
 	lsd::StringView fileName, 
 	size_type line, 
@@ -18,35 +78,8 @@ SyntaxError::SyntaxError(
 	lsd::StringView lineSource, 
 	error::Message message,
 	char expected) {
-	static const lsd::UnorderedDenseMap<error::Message, const char*> errorMsg({
-		{ error::Message::invalidSyntax, "Invalid syntax" },
-		{ error::Message::invalidNumericLiteral, "Invalid numeric literal" },
-		{ error::Message::disallowedChar, "Disallowed character in code" },
-		{ error::Message::unescapedChar, "Unescaped special character" },
-		{ error::Message::invalidEscape, "Invalid escape sequence" },
-		{ error::Message::emptyChar, "Character can't be empty" },
-		{ error::Message::unclosedBlockComment, "Expected \"*/\"" },
-		{ error::Message::expectedExpression, "Expected expression" },
-		{ error::Message::expectedIdentifier, "Expected indentifier" },
-		{ error::Message::expectedDeclaration, "Expected declaration" },
-		{ error::Message::noCatchBehindTry, "No catch-block was found behind a try-block"},
-		{ error::Message::importDeclRequiresStrOrConst, "Import declaration requires string or a constant string variable" },
-	});
-
-	
 	if (message == error::Message::expectedDifferent) {
-		size_type len = std::snprintf(nullptr, 0, ELYRIUM_CUSTOM_ERROR_MSG("Syntax error", "Expected '%c'"),
-									  fileName.data(),
-									  line + 1,
-									  column,
-									  static_cast<int>(lineSource.size()),
-									  lineSource.data(),
-									  static_cast<int>(column) + 1,
-									  '^',
-									  expected);
-		
-		m_message.resize(len);
-		std::snprintf(m_message.data(), len + 1, ELYRIUM_CUSTOM_ERROR_MSG("Syntax error", "Expected '%c'"),
+		formatMessage(m_message, ELYRIUM_CUSTOM_ERROR_MSG("Syntax error", "Expected '%c'"),
 					  fileName.data(),
 					  line + 1,
 					  column,
@@ -56,18 +89,7 @@ SyntaxError::SyntaxError(
 					  '^',
 					  expected);
 	} else {
-		size_type len = std::snprintf(nullptr, 0, ELYRIUM_ERROR_MSG("Syntax error"), 
-									  fileName.data(),
-									  line + 1,
-									  column,
-									  static_cast<int>(lineSource.size()),
-									  lineSource.data(),
-									  static_cast<int>(column) + 1,
-									  '^',
-									  errorMsg.at(message));
-
-		m_message.resize(len);
-		std::snprintf(m_message.data(), len + 1, ELYRIUM_ERROR_MSG("Syntax error"),
+		formatMessage(m_message, ELYRIUM_ERROR_MSG("Syntax error"),
 					  fileName.data(),
 					  line + 1,
 					  column,
@@ -75,8 +97,45 @@ SyntaxError::SyntaxError(
 					  lineSource.data(),
 					  static_cast<int>(column) + 1,
 					  '^',
-					  errorMsg.at(message));
+					  error::describe(message));
 	}
 }
 
+ImportError::ImportError(
+	lsd::StringView fileName, 
+	size_type line, 
+	size_type column,
+	lsd::StringView lineSource, 
+	error::Message message,
+	lsd::StringView module) {
+	formatMessage(m_message, ELYRIUM_CUSTOM_ERROR_MSG("Import error", "%s \"%.*s\""),
+				  fileName.data(),
+				  line + 1,
+				  column,
+				  static_cast<int>(lineSource.size()),
+				  lineSource.data(),
+				  static_cast<int>(column) + 1,
+				  '^',
+				  error::describe(message),
+				  static_cast<int>(module.size()),
+				  module.data());
+}
+
+CompileError::CompileError(
+	lsd::StringView fileName, 
+	size_type line, 
+	size_type column,
+	lsd::StringView lineSource, 
+	error::Message message) {
+	formatMessage(m_message, ELYRIUM_ERROR_MSG("Compile error"),
+				  fileName.data(),
+				  line + 1,
+				  column,
+				  static_cast<int>(lineSource.size()),
+				  lineSource.data(),
+				  static_cast<int>(column) + 1,
+				  '^',
+				  error::describe(message));
+}
+
 } // namespace elyrium
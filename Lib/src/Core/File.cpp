@@ -2,12 +2,18 @@
 
 #include <LSD/Array.h>
 
+#include <cerrno>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
+#include <utility>
 
 #ifdef ELYRIUM_POSIX
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #elif defined(ELYRIUM_WINDOWS)
 #include <io.h>
 #endif
@@ -48,6 +54,13 @@ constexpr const char* enumToOpenMode(OpenMode m) {
 	return openModes[static_cast<size_type>(m)];
 }
 
+[[noreturn]] void throwSystemError(const char* message, lsd::StringView path) {
+	lsd::String error(message);
+	error.append(" \"").append(path).append("\" with error: ").append(std::strerror(errno));
+
+	throw FilesystemError(error);
+}
+
 }
 
 
@@ -92,11 +105,166 @@ void FileSystem::returnBuffer(char* buffer) {
 	m_buffers.pushBack(buffer);
 }
 
+SourceBuffer FileSystem::map(lsd::StringView path) const {
+	SourceBuffer buffer;
+
+#ifdef ELYRIUM_POSIX
+	auto fd = ::open(path.data(), O_RDONLY);
+	if (fd < 0) throwSystemError("Failed to open file", path);
+
+	struct stat status;
+	if (::fstat(fd, &status) != 0) {
+		::close(fd);
+		throwSystemError("Failed to query file", path);
+	}
+
+	// Only regular, non-empty files can be mapped, everything else is read below
+	if (S_ISREG(status.st_mode) && status.st_size > 0) {
+		auto size = static_cast<size_type>(status.st_size);
+		auto pageSize = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		auto mappedSize = (size + pageSize) & ~(pageSize - 1); // Always leaves room for at least one null byte
+
+		// Reserve zeroed anonymous memory first, then map the file over the front of it, so the sentinel exists even if the file fills its last page
+		auto reserved = ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (reserved != MAP_FAILED) {
+			auto data = ::mmap(reserved, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+
+			if (data != MAP_FAILED) {
+				::madvise(data, size, MADV_SEQUENTIAL);
+				::close(fd);
+
+				buffer.m_data = static_cast<char*>(data);
+				buffer.m_size = size;
+				buffer.m_mappedSize = mappedSize;
+
+				return buffer;
+			}
+
+			::munmap(reserved, mappedSize);
+		}
+	}
+
+	::close(fd);
+#endif
+
+	auto file = std::fopen(path.data(), "rb");
+	if (!file) throwSystemError("Failed to open file", path);
+
+	// Read everything with as few calls as possible, growing the buffer for streams of unknown size
+	size_type capacity = 0;
+	if (std::fseek(file, 0, SEEK_END) == 0) {
+		if (auto end = std::ftell(file); end > 0) capacity = static_cast<size_type>(end);
+		std::fseek(file, 0, SEEK_SET);
+	}
+
+	if (capacity == 0) capacity = bufferSize;
+
+	auto data = static_cast<char*>(std::malloc(capacity + 1));
+	size_type size = 0;
+
+	while (data) {
+		size += std::fread(data + size, 1, capacity - size, file);
+		if (size < capacity) break;
+
+		auto c = std::fgetc(file);
+		if (c == EOF) break;
+
+		auto grown = static_cast<char*>(std::realloc(data, capacity * 2 + 1));
+		if (!grown) std::free(data);
+
+		data = grown;
+		capacity *= 2;
+
+		if (data) data[size++] = static_cast<char>(c);
+	}
+
+	auto failed = (data == nullptr) || std::ferror(file);
+	std::fclose(file);
+
+	if (failed) {
+		std::free(data);
+		throwSystemError("Failed to read file", path);
+	}
+
+	data[size] = '\0';
+
+	buffer.m_data = data;
+	buffer.m_size = size;
+
+	return buffer;
+}
+
 File FileSystem::tmpFile() {
 	return File(std::tmpfile(), nullptr, { });
 }
 
 
+// Source buffer
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept : 
+	m_data(std::exchange(other.m_data, nullptr)), 
+	m_size(std::exchange(other.m_size, 0)), 
+	m_mappedSize(std::exchange(other.m_mappedSize, 0)) { }
+
+SourceBuffer::~SourceBuffer() {
+	release();
+}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+	if (this != &other) {
+		release();
+
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_mappedSize = std::exchange(other.m_mappedSize, 0);
+	}
+
+	return *this;
+}
+
+void SourceBuffer::release() noexcept {
+#ifdef ELYRIUM_POSIX
+	if (m_mappedSize != 0) ::munmap(m_data, m_mappedSize);
+	else std::free(m_data);
+#else
+	std::free(m_data);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_mappedSize = 0;
+}
+
+
+// Input stream
+
+size_type InputStream::read(char* buffer, size_type size) {
+	if (m_file) {
+		auto count = std::fread(buffer, 1, size, m_file->stream().get());
+		if (count == 0 && std::ferror(m_file->stream().get())) 
+			throwSystemError("Failed to read file", m_file->path());
+
+		return count;
+	}
+
+#ifdef ELYRIUM_POSIX
+	while (true) {
+		auto count = ::read(m_descriptor, buffer, size);
+
+		if (count >= 0) return static_cast<size_type>(count);
+		if (errno != EINTR) throwSystemError("Failed to read file descriptor", { });
+	}
+#elif defined(ELYRIUM_WINDOWS)
+	auto count = ::_read(m_descriptor, buffer, static_cast<unsigned int>(size));
+	if (count < 0) throwSystemError("Failed to read file descriptor", { });
+
+	return static_cast<size_type>(count);
+#else
+	throw FilesystemError("Reading from file descriptors is not supported on this platform");
+#endif
+}
+
+
 // File
 
 BasicFile<char>::~BasicFile<char>() {
@@ -0,0 +1,70 @@
+#include <Elyrium/Core/LineTable.hpp>
+
+#include <Elyrium/Core/SIMD.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace elyrium {
+
+void LineTable::build() const {
+	if (!m_lineBegins.empty()) return;
+
+	assert(m_source.size() <= std::numeric_limits<offset_type>::max() && "elyrium::LineTable::build(): Source is too large to be located by offsets, aborting!");
+
+	m_lineBegins.pushBack(0);
+
+	auto end = m_source.data() + m_source.size();
+	for (auto it = simd::findLineEnd(m_source.data(), end); it != end; it = simd::findLineEnd(it + 1, end))
+		m_lineBegins.pushBack(static_cast<offset_type>(it - m_source.data() + 1));
+}
+
+SourceLocation LineTable::location(size_type offset) const {
+	build();
+
+	auto line = std::upper_bound(m_lineBegins.begin(), m_lineBegins.end(), offset) - m_lineBegins.begin() - 1;
+	return { static_cast<size_type>(line), offset - m_lineBegins[line] };
+}
+
+lsd::String LineTable::lineSource(size_type offset, size_type& additionalSpaces) const {
+	lsd::String str;
+
+	auto lineView = line(location(offset).line);
+	auto target = m_source.data() + offset;
+
+	for (auto it = lineView.begin(); it != lineView.end(); it++) {
+		switch (auto c = *it; c) {
+			case '\t':
+				str.append("    ", 4);
+				if (it < target) additionalSpaces += 3;
+
+			case '\r':
+			case '\f':
+			case '\v':
+				break;
+
+			default:
+				str.pushBack(c);
+		}
+	}
+
+	return str;
+}
+
+lsd::StringView LineTable::line(size_type line) const {
+	build();
+
+	auto begin = m_lineBegins[line];
+	auto end = (line + 1 < m_lineBegins.size()) ? m_lineBegins[line + 1] - 1 : m_source.size();
+
+	return lsd::StringView(m_source.data() + begin, end - begin);
+}
+
+size_type LineTable::lineCount() const {
+	build();
+
+	return m_lineBegins.size();
+}
+
+} // namespace elyrium
@@ -0,0 +1,199 @@
+#include <Elyrium/Interpreter/Disassembler.hpp>
+
+#include <Elyrium/Interpreter/Encoding.hpp>
+
+#include <cstdio>
+
+namespace elyrium {
+
+namespace bytecode {
+
+namespace {
+
+template <class... Args> void print(lsd::String& output, const char* format, Args... args) {
+	char buffer[128];
+
+	auto length = std::snprintf(buffer, sizeof(buffer), format, args...);
+	if (length > 0) output.append(buffer);
+}
+
+void printQuoted(lsd::String& output, lsd::StringView string, char quote) {
+	output.append((quote == '"') ? "\"" : "'");
+
+	for (auto c : string) {
+		switch (c) {
+			case '\n':
+				output.append("\\n");
+				break;
+			case '\t':
+				output.append("\\t");
+				break;
+			case '\r':
+				output.append("\\r");
+				break;
+			case '\\':
+				output.append("\\\\");
+				break;
+			case '\0':
+				output.append("\\0");
+				break;
+
+			default:
+				if (c == quote) {
+					output.append((quote == '"') ? "\\\"" : "\\'");
+				} else if (static_cast<unsigned char>(c) < 0x20) {
+					print(output, "\\x%02x", static_cast<unsigned>(c));
+				} else {
+					char character[2] = { c, '\0' };
+					output.append(character);
+				}
+		}
+	}
+
+	output.append((quote == '"') ? "\"" : "'");
+}
+
+void printConstant(lsd::String& output, const Constant& constant, const Program& program, const compiler::SymbolTable& symbols) {
+	switch (constant.type()) {
+		case Constant::Type::integral:
+			print(output, "%lld", static_cast<long long>(constant.integral()));
+			break;
+		case Constant::Type::unsignedIntegral:
+			print(output, "%lluu", static_cast<unsigned long long>(constant.unsignedIntegral()));
+			break;
+		case Constant::Type::floating:
+			print(output, "%g", constant.floating());
+			break;
+		case Constant::Type::character:
+			if (constant.character() < 0x80) {
+				char character = static_cast<char>(constant.character());
+				printQuoted(output, lsd::StringView(&character, 1), '\'');
+			} else print(output, "U+%04X", static_cast<unsigned>(constant.character()));
+
+			break;
+		case Constant::Type::string:
+			printQuoted(output, program.strings.string(constant.string()), '"');
+			break;
+		case Constant::Type::symbol:
+			output.append(symbols.string(constant.symbol()));
+			break;
+	}
+}
+
+void printGlobal(lsd::String& output, const Global& global, const compiler::SymbolTable& symbols) {
+	for (size_type i = 0; i < global.path.size(); i++) {
+		if (i != 0) output.append(".");
+		output.append(symbols.string(global.path[i]));
+	}
+}
+
+} // namespace
+
+lsd::String disassemble(const Program& program, const compiler::SymbolTable& symbols) {
+	lsd::String output;
+
+	if (!program.globals.empty()) {
+		output.append("globals\n");
+
+		for (size_type i = 0; i < program.globals.size(); i++) {
+			print(output, "  g%zu  ", i);
+			printGlobal(output, program.globals[i], symbols);
+			output.append(program.globals[i].external ? " (external)\n" : "\n");
+		}
+
+		output.append("\n");
+	}
+
+	for (size_type i = 0; i < program.functions.size(); i++) {
+		const auto& function = program.functions[i];
+
+		if (i != 0) output.append("\n");
+
+		print(output, "function %zu ", i);
+		if (function.name == compiler::SymbolTable::none) output.append((i == 0) ? "<module>" : "<closure>");
+		else output.append(symbols.string(function.name));
+		print(output, ": %u parameters, %u registers, %zu constants, %zu bytes\n",
+			static_cast<unsigned>(function.parameterCount), static_cast<unsigned>(function.registerCount), function.constants.size(), function.code.size());
+
+		if (!function.captures.empty()) {
+			output.append("captures ");
+
+			for (size_type capture = 0; capture < function.captures.size(); capture++)
+				print(output, (capture == 0) ? "%c%u" : ", %c%u", function.captures[capture].local ? 'r' : 'u', static_cast<unsigned>(function.captures[capture].index));
+
+			output.append("\n");
+		}
+
+		for (size_type pc = 0, size = 0; pc < function.code.size(); pc += size) {
+			Instruction instruction;
+			size = decode(function.code.data() + pc, instruction);
+
+			const auto& info = describe(instruction.opcode);
+			const operand_type operands[3] = { instruction.a, instruction.b, instruction.c };
+
+			// Prefixes are shown as part of the name of the instruction they widen
+			char name[48];
+			if (size == encodedSize(instruction.opcode, Width::narrow)) std::snprintf(name, sizeof(name), "%s", info.name);
+			else std::snprintf(name, sizeof(name), "%s.%s", describe(static_cast<Opcode>(function.code[pc])).name, info.name);
+
+			print(output, (info.operands[0] == Operand::none) ? "%04zu  %s" : "%04zu  %-23s ", pc, name);
+
+			// Constants and globals are listed after the operands, so the instructions stay aligned
+			const Constant* constants[3] = { };
+			const Global* globals[3] = { };
+			size_type noteCount = 0;
+
+			for (size_type operand = 0; operand < 3 && info.operands[operand] != Operand::none; operand++) {
+				auto value = operands[operand];
+
+				if (operand != 0) output.append(", ");
+
+				switch (info.operands[operand]) {
+					case Operand::reg:
+						print(output, "r%u", static_cast<unsigned>(value));
+						break;
+					case Operand::constant:
+						print(output, "k%u", static_cast<unsigned>(value));
+						if (value < function.constants.size()) constants[noteCount++] = &function.constants[value];
+
+						break;
+					case Operand::global:
+						print(output, "g%u", static_cast<unsigned>(value));
+						if (value < program.globals.size()) globals[noteCount++] = &program.globals[value];
+
+						break;
+					case Operand::upvalue:
+						print(output, "u%u", static_cast<unsigned>(value));
+						break;
+					case Operand::immediate:
+						print(output, "%d", static_cast<int>(Instruction::immediate(value)));
+						break;
+					case Operand::target:
+						print(output, "@%04lld", static_cast<long long>(pc) + Instruction::immediate(value));
+						break;
+					case Operand::function:
+						print(output, "f%u", static_cast<unsigned>(value));
+						break;
+
+					default:
+						print(output, "%u", static_cast<unsigned>(value));
+				}
+			}
+
+			for (size_type note = 0; note < noteCount; note++) {
+				output.append((note == 0) ? " ; " : ", ");
+
+				if (constants[note]) printConstant(output, *constants[note], program, symbols);
+				else printGlobal(output, *globals[note], symbols);
+			}
+
+			output.append("\n");
+		}
+	}
+
+	return output;
+}
+
+} // namespace bytecode
+
+} // namespace elyrium
@@ -0,0 +1,181 @@
+#include <Elyrium/Interpreter/Encoding.hpp>
+
+#include <limits>
+
+namespace elyrium {
+
+namespace bytecode {
+
+namespace {
+
+[[nodiscard]] bool signedOperand(Operand operand) noexcept {
+	return operand == Operand::immediate || operand == Operand::target;
+}
+
+[[nodiscard]] size_type operandCount(const OpcodeInfo& info) noexcept {
+	size_type count = 0;
+	while (count < 3 && info.operands[count] != Operand::none) ++count;
+
+	return count;
+}
+
+[[nodiscard]] Width operandWidth(operand_type operand, bool isSigned) noexcept {
+	if (isSigned) {
+		auto value = Instruction::immediate(operand);
+
+		if (value >= std::numeric_limits<int8>::min() && value <= std::numeric_limits<int8>::max()) return Width::narrow;
+		else if (value >= std::numeric_limits<int16>::min() && value <= std::numeric_limits<int16>::max()) return Width::wide;
+	} else {
+		if (operand <= std::numeric_limits<uint8>::max()) return Width::narrow;
+		else if (operand <= std::numeric_limits<uint16>::max()) return Width::wide;
+	}
+
+	return Width::extraWide;
+}
+
+[[nodiscard]] size_type targetIndex(const OpcodeInfo& info) noexcept {
+	for (size_type i = 0; i < 3; i++)
+		if (info.operands[i] == Operand::target) return i;
+
+	return 3;
+}
+
+} // namespace
+
+Width width(const Instruction& instruction) noexcept {
+	const auto& info = describe(instruction.opcode);
+	const operand_type operands[3] = { instruction.a, instruction.b, instruction.c };
+
+	auto result = Width::narrow;
+
+	for (size_type i = 0; i < operandCount(info); i++) {
+		auto operand = operandWidth(operands[i], signedOperand(info.operands[i]));
+		if (operand > result) result = operand;
+	}
+
+	return result;
+}
+
+size_type encodedSize(Opcode opcode, Width width) noexcept {
+	return (width != Width::narrow) + 1 + operandCount(describe(opcode)) * static_cast<size_type>(width);
+}
+
+void encode(lsd::Vector<uint8>& code, const Instruction& instruction) {
+	encode(code, instruction, width(instruction));
+}
+
+void encode(lsd::Vector<uint8>& code, const Instruction& instruction, Width width) {
+	const operand_type operands[3] = { instruction.a, instruction.b, instruction.c };
+
+	if (width == Width::wide) code.pushBack(static_cast<uint8>(Opcode::wide));
+	else if (width == Width::extraWide) code.pushBack(static_cast<uint8>(Opcode::extraWide));
+
+	code.pushBack(static_cast<uint8>(instruction.opcode));
+
+	for (size_type i = 0; i < operandCount(describe(instruction.opcode)); i++)
+		for (size_type byte = 0; byte < static_cast<size_type>(width); byte++)
+			code.pushBack(static_cast<uint8>(operands[i] >> (byte * 8)));
+}
+
+lsd::Vector<uint8> assemble(const lsd::Vector<Instruction>& instructions) {
+	// Starts out with every jump as narrow as its other operands allow
+	lsd::Vector<Width> widths;
+	widths.reserve(instructions.size());
+
+	for (const auto& instruction : instructions) {
+		auto withoutTarget = instruction;
+
+		switch (targetIndex(describe(instruction.opcode))) {
+			case 0:
+				withoutTarget.a = 0;
+				break;
+			case 1:
+				withoutTarget.b = 0;
+				break;
+			case 2:
+				withoutTarget.c = 0;
+				break;
+		}
+
+		widths.pushBack(width(withoutTarget));
+	}
+
+	lsd::Vector<size_type> addresses(instructions.size() + 1, 0);
+
+	auto offset = [&](size_type jump, operand_type target) {
+		return static_cast<operand_type>(static_cast<int32>(static_cast<int64>(addresses[target]) - static_cast<int64>(addresses[jump])));
+	};
+
+	for (auto changed = true; changed;) {
+		changed = false;
+
+		for (size_type i = 0; i < instructions.size(); i++)
+			addresses[i + 1] = addresses[i] + encodedSize(instructions[i].opcode, widths[i]);
+
+		for (size_type i = 0; i < instructions.size(); i++) {
+			const auto& instruction = instructions[i];
+			auto target = targetIndex(describe(instruction.opcode));
+
+			if (target == 3) continue;
+
+			auto required = operandWidth(offset(i, (target == 0) ? instruction.a : ((target == 1) ? instruction.b : instruction.c)), true);
+
+			if (required > widths[i]) {
+				widths[i] = required;
+				changed = true;
+			}
+		}
+	}
+
+	lsd::Vector<uint8> code;
+	code.reserve(addresses.back());
+
+	for (size_type i = 0; i < instructions.size(); i++) {
+		auto instruction = instructions[i];
+
+		switch (targetIndex(describe(instruction.opcode))) {
+			case 0:
+				instruction.a = offset(i, instruction.a);
+				break;
+			case 1:
+				instruction.b = offset(i, instruction.b);
+				break;
+			case 2:
+				instruction.c = offset(i, instruction.c);
+				break;
+		}
+
+		encode(code, instruction, widths[i]);
+	}
+
+	return code;
+}
+
+size_type decode(const uint8* code, Instruction& instruction) noexcept {
+	auto width = Width::narrow;
+	auto start = code;
+
+	if (*code == static_cast<uint8>(Opcode::wide)) {
+		width = Width::wide;
+		++code;
+	} else if (*code == static_cast<uint8>(Opcode::extraWide)) {
+		width = Width::extraWide;
+		++code;
+	}
+
+	instruction = Instruction { static_cast<Opcode>(*code++) };
+
+	const auto& info = describe(instruction.opcode);
+	operand_type* operands[3] = { &instruction.a, &instruction.b, &instruction.c };
+
+	auto count = operandCount(info);
+
+	for (size_type i = 0; i < count; i++)
+		*operands[i] = signedOperand(info.operands[i]) ? readSignedOperand(code, width, i) : readOperand(code, width, i);
+
+	return static_cast<size_type>(code - start) + count * static_cast<size_type>(width);
+}
+
+} // namespace bytecode
+
+} // namespace elyrium
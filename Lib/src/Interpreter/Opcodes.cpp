@@ -0,0 +1,156 @@
+#include <Elyrium/Interpreter/Opcodes.hpp>
+
+#include <iterator>
+
+namespace elyrium {
+
+namespace {
+
+using enum Operand;
+
+inline constexpr OpcodeInfo invalidInfo { "invalid", { none, none, none } };
+
+} // namespace
+
+const OpcodeInfo& describe(Opcode opcode) noexcept {
+	// Opcodes are dense, so they index the table directly
+	static constexpr OpcodeInfo infos[] = {
+		{ "nop", { none, none, none } },
+
+		{ "wide", { none, none, none } },
+		{ "extraWide", { none, none, none } },
+
+		{ "move", { reg, reg, none } },
+		{ "loadConstant", { reg, constant, none } },
+		{ "loadInteger", { reg, immediate, none } },
+		{ "loadNull", { reg, none, none } },
+		{ "loadTrue", { reg, none, none } },
+		{ "loadFalse", { reg, none, none } },
+		{ "loadGlobal", { reg, global, none } },
+		{ "storeGlobal", { global, reg, none } },
+		{ "loadUpvalue", { reg, upvalue, none } },
+		{ "storeUpvalue", { upvalue, reg, none } },
+		{ "loadMember", { reg, reg, constant } },
+		{ "storeMember", { reg, constant, reg } },
+		{ "loadIndex", { reg, reg, reg } },
+		{ "storeIndex", { reg, reg, reg } },
+		{ "loadMethod", { reg, reg, constant } },
+
+		{ "add", { reg, reg, reg } },
+		{ "subtract", { reg, reg, reg } },
+		{ "multiply", { reg, reg, reg } },
+		{ "divide", { reg, reg, reg } },
+		{ "modulo", { reg, reg, reg } },
+		{ "addImmediate", { reg, reg, immediate } },
+		{ "negate", { reg, reg, none } },
+		{ "positive", { reg, reg, none } },
+
+		{ "bitShiftLeft", { reg, reg, reg } },
+		{ "bitShiftRight", { reg, reg, reg } },
+		{ "bitNot", { reg, reg, none } },
+		{ "bitAnd", { reg, reg, reg } },
+		{ "bitOr", { reg, reg, reg } },
+		{ "bitXOr", { reg, reg, reg } },
+		{ "compare", { reg, reg, reg } },
+		{ "equal", { reg, reg, reg } },
+		{ "notEqual", { reg, reg, reg } },
+		{ "less", { reg, reg, reg } },
+		{ "lessEqual", { reg, reg, reg } },
+		{ "logicNot", { reg, reg, none } },
+
+		{ "jump", { target, none, none } },
+		{ "ret", { reg, count, none } },
+		{ "call", { reg, count, none } },
+		{ "closure", { reg, function, none } },
+		{ "close", { reg, none, none } },
+
+		{ "jumpIfEqual", { reg, reg, target } },
+		{ "jumpIfNotEqual", { reg, reg, target } },
+		{ "jumpIfLarger", { reg, reg, target } },
+		{ "jumpIfSmaller", { reg, reg, target } },
+		{ "jumpIfLargerEqual", { reg, reg, target } },
+		{ "jumpIfSmallerEqual", { reg, reg, target } },
+		{ "jumpIfTrue", { reg, target, none } },
+		{ "jumpIfFalse", { reg, target, none } },
+
+		{ "checkI64", { reg, none, none } },
+		{ "checkU64", { reg, none, none } },
+		{ "checkF64", { reg, none, none } },
+		{ "checkBool", { reg, none, none } },
+
+		{ "addI64", { reg, reg, reg } },
+		{ "subtractI64", { reg, reg, reg } },
+		{ "multiplyI64", { reg, reg, reg } },
+		{ "divideI64", { reg, reg, reg } },
+		{ "moduloI64", { reg, reg, reg } },
+		{ "addImmediateI64", { reg, reg, immediate } },
+		{ "negateI64", { reg, reg, none } },
+		{ "bitShiftLeftI64", { reg, reg, reg } },
+		{ "bitShiftRightI64", { reg, reg, reg } },
+		{ "bitNotI64", { reg, reg, none } },
+		{ "bitAndI64", { reg, reg, reg } },
+		{ "bitOrI64", { reg, reg, reg } },
+		{ "bitXOrI64", { reg, reg, reg } },
+		{ "compareI64", { reg, reg, reg } },
+		{ "equalI64", { reg, reg, reg } },
+		{ "notEqualI64", { reg, reg, reg } },
+		{ "lessI64", { reg, reg, reg } },
+		{ "lessEqualI64", { reg, reg, reg } },
+		{ "jumpIfEqualI64", { reg, reg, target } },
+		{ "jumpIfNotEqualI64", { reg, reg, target } },
+		{ "jumpIfLargerI64", { reg, reg, target } },
+		{ "jumpIfSmallerI64", { reg, reg, target } },
+		{ "jumpIfLargerEqualI64", { reg, reg, target } },
+		{ "jumpIfSmallerEqualI64", { reg, reg, target } },
+
+		{ "addU64", { reg, reg, reg } },
+		{ "subtractU64", { reg, reg, reg } },
+		{ "multiplyU64", { reg, reg, reg } },
+		{ "divideU64", { reg, reg, reg } },
+		{ "moduloU64", { reg, reg, reg } },
+		{ "addImmediateU64", { reg, reg, immediate } },
+		{ "bitShiftLeftU64", { reg, reg, reg } },
+		{ "bitShiftRightU64", { reg, reg, reg } },
+		{ "bitNotU64", { reg, reg, none } },
+		{ "bitAndU64", { reg, reg, reg } },
+		{ "bitOrU64", { reg, reg, reg } },
+		{ "bitXOrU64", { reg, reg, reg } },
+		{ "compareU64", { reg, reg, reg } },
+		{ "equalU64", { reg, reg, reg } },
+		{ "notEqualU64", { reg, reg, reg } },
+		{ "lessU64", { reg, reg, reg } },
+		{ "lessEqualU64", { reg, reg, reg } },
+		{ "jumpIfEqualU64", { reg, reg, target } },
+		{ "jumpIfNotEqualU64", { reg, reg, target } },
+		{ "jumpIfLargerU64", { reg, reg, target } },
+		{ "jumpIfSmallerU64", { reg, reg, target } },
+		{ "jumpIfLargerEqualU64", { reg, reg, target } },
+		{ "jumpIfSmallerEqualU64", { reg, reg, target } },
+
+		{ "addF64", { reg, reg, reg } },
+		{ "subtractF64", { reg, reg, reg } },
+		{ "multiplyF64", { reg, reg, reg } },
+		{ "divideF64", { reg, reg, reg } },
+		{ "moduloF64", { reg, reg, reg } },
+		{ "addImmediateF64", { reg, reg, immediate } },
+		{ "negateF64", { reg, reg, none } },
+		{ "compareF64", { reg, reg, reg } },
+		{ "equalF64", { reg, reg, reg } },
+		{ "notEqualF64", { reg, reg, reg } },
+		{ "lessF64", { reg, reg, reg } },
+		{ "lessEqualF64", { reg, reg, reg } },
+		{ "jumpIfEqualF64", { reg, reg, target } },
+		{ "jumpIfNotEqualF64", { reg, reg, target } },
+		{ "jumpIfLargerF64", { reg, reg, target } },
+		{ "jumpIfSmallerF64", { reg, reg, target } },
+		{ "jumpIfLargerEqualF64", { reg, reg, target } },
+		{ "jumpIfSmallerEqualF64", { reg, reg, target } },
+	};
+
+	static_assert(std::size(infos) == static_cast<size_type>(Opcode::jumpIfSmallerEqualF64) + 1, "elyrium::describe(): Opcode table is incomplete!");
+
+	auto index = static_cast<size_type>(opcode);
+	return (index < std::size(infos)) ? infos[index] : invalidInfo;
+}
+
+} // namespace elyrium
@@ -0,0 +1,280 @@
+#include "Corpus.hpp"
+
+#include <Example.hpp>
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace bench {
+
+namespace {
+
+void appendFormat(lsd::String& output, const char* format, ...) {
+	char buffer[256];
+
+	va_list args;
+	va_start(args, format);
+	std::vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+
+	output.append(buffer);
+}
+
+void appendIndent(lsd::String& output, elyrium::size_type depth) {
+	for (elyrium::size_type i = 0; i < depth; i++)
+		output.append("\t");
+}
+
+void appendIdentifier(lsd::String& output, Random& random, elyrium::size_type minLength, elyrium::size_type maxLength) {
+	static constexpr char first[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+	static constexpr char rest[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_";
+
+	char buffer[64];
+	auto length = random.range(minLength, maxLength);
+
+	buffer[0] = first[random.next() % (sizeof(first) - 1)];
+	for (elyrium::size_type i = 1; i < length; i++)
+		buffer[i] = rest[random.next() % (sizeof(rest) - 1)];
+	buffer[length] = '\0';
+
+	output.append(buffer);
+}
+
+void appendLiteral(lsd::String& output, Random& random) {
+	switch (random.next() % 7) {
+		case 0:
+			appendFormat(output, "%llu", static_cast<unsigned long long>(random.next() % 1000000));
+			break;
+
+		case 1:
+			appendFormat(output, "0x%llXu", static_cast<unsigned long long>(random.next() >> 16));
+			break;
+
+		case 2:
+			appendFormat(output, "0b%d%d%d%d_%d%d%d%d",
+				static_cast<int>(random.next() & 1), static_cast<int>(random.next() & 1), static_cast<int>(random.next() & 1), static_cast<int>(random.next() & 1),
+				static_cast<int>(random.next() & 1), static_cast<int>(random.next() & 1), static_cast<int>(random.next() & 1), static_cast<int>(random.next() & 1));
+			break;
+
+		case 3:
+			appendFormat(output, "%llu.%llue-%llu",
+				static_cast<unsigned long long>(random.next() % 1000),
+				static_cast<unsigned long long>(random.next() % 100000),
+				static_cast<unsigned long long>(random.next() % 20));
+			break;
+
+		case 4:
+			appendFormat(output, "'%c'", static_cast<char>(random.range('a', 'z')));
+			break;
+
+		case 5:
+			output.append("\"escaped\\tstring\\n\"");
+			break;
+
+		default: {
+			output.append("\"");
+			for (auto words = random.range(1, 8); words > 0; words--) {
+				appendIdentifier(output, random, 2, 10);
+				output.append(" ");
+			}
+			output.append("\"");
+
+			break;
+		}
+	}
+}
+
+void appendNestedExpression(lsd::String& output, Random& random, elyrium::size_type depth) {
+	static constexpr const char* openings[] = { "call(", "table[", "object.method(" };
+	static constexpr const char* closings[] = { ")", "]", ")" };
+
+	lsd::Vector<elyrium::size_type> kinds;
+
+	for (elyrium::size_type i = 0; i < depth; i++) {
+		kinds.pushBack(random.next() % 3);
+		output.append(openings[kinds.back()]);
+	}
+
+	output.append("value");
+
+	for (elyrium::size_type i = depth; i > 0; i--)
+		output.append(closings[kinds[i - 1]]);
+}
+
+} // namespace
+
+elyrium::uint64 Random::next() noexcept { // splitmix64
+	auto z = (m_state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+	return z ^ (z >> 31);
+}
+
+lsd::String generateNesting(elyrium::size_type size, elyrium::uint64 seed) {
+	Random random(seed);
+	lsd::String output;
+
+	for (elyrium::size_type function = 0; output.size() < size; function++) {
+		appendFormat(output, "func nest%zu(count : int) : int {\n", function);
+
+		auto depth = random.range(8, 48);
+
+		for (elyrium::size_type level = 1; level <= depth; level++) {
+			appendIndent(output, level);
+
+			if (level % 2) output.append("if (count > 0) {\n");
+			else appendFormat(output, "for (let i%zu = 0; i%zu < count; i%zu++) {\n", level, level, level);
+		}
+
+		appendIndent(output, depth + 1);
+		output.append("result = ");
+		appendNestedExpression(output, random, random.range(32, 256));
+		output.append(";\n");
+
+		for (auto level = depth; level > 0; level--) {
+			appendIndent(output, level);
+			output.append("}\n");
+		}
+
+		output.append("\treturn count;\n}\n\n");
+	}
+
+	return output;
+}
+
+lsd::String generateIdentifiers(elyrium::size_type size, elyrium::uint64 seed) {
+	Random random(seed);
+	lsd::String output;
+
+	while (output.size() < size) {
+		output.append("let ");
+		appendIdentifier(output, random, 12, 48);
+		output.append(" = ");
+
+		for (auto operands = random.range(2, 12); operands > 0; operands--) {
+			appendIdentifier(output, random, 12, 48);
+
+			for (auto members = random.range(0, 16); members > 0; members--) {
+				output.append(".");
+				appendIdentifier(output, random, 8, 32);
+			}
+
+			if (operands > 1) output.append((random.chance(50)) ? " + " : " * ");
+		}
+
+		output.append(";\n");
+	}
+
+	return output;
+}
+
+lsd::String generateLiterals(elyrium::size_type size, elyrium::uint64 seed) {
+	Random random(seed);
+	lsd::String output;
+
+	for (elyrium::size_type row = 0; output.size() < size; ) {
+		appendFormat(output, "func literals%zu() {\n", row);
+
+		for (auto rows = random.range(16, 64); rows > 0; rows--, row++) {
+			output.append("\t");
+
+			if (random.chance(50)) {
+				appendFormat(output, "let row%zu = ", row);
+
+				for (auto columns = random.range(4, 16); columns > 0; columns--) {
+					appendLiteral(output, random);
+
+					if (columns > 1) appendFormat(output, ", column%zu_%zu = ", row, static_cast<elyrium::size_type>(columns));
+				}
+			} else {
+				output.append("table.insert(");
+
+				for (auto columns = random.range(4, 16); columns > 0; columns--) {
+					appendLiteral(output, random);
+
+					if (columns > 1) output.append(", ");
+				}
+
+				output.append(")");
+			}
+
+			output.append(";\n");
+		}
+
+		output.append("}\n\n");
+	}
+
+	return output;
+}
+
+lsd::String generateComments(elyrium::size_type size, elyrium::uint64 seed) {
+	Random random(seed);
+	lsd::String output;
+
+	for (elyrium::size_type declaration = 0; output.size() < size; declaration++) {
+		switch (random.next() % 4) {
+			case 0:
+				for (auto lines = random.range(1, 8); lines > 0; lines--) {
+					output.append("// ");
+					appendIdentifier(output, random, 4, 60);
+					output.append(" line comment with some words in it\n");
+				}
+
+				break;
+
+			case 1:
+				output.append("/**\n");
+				for (auto lines = random.range(1, 12); lines > 0; lines--) {
+					output.append(" * Documentation comment, describing ");
+					appendIdentifier(output, random, 4, 32);
+					output.append("\n");
+				}
+				output.append(" */\n");
+
+				break;
+
+			case 2:
+				output.append("/* Block comment /* with a nested comment */\n * // and a line comment, which hides the end of the block on its line */\n */\n");
+
+				break;
+
+			default:
+				output.append("/*\n");
+				for (auto lines = random.range(4, 32); lines > 0; lines--)
+					output.append("\tcommented out code: let x = y + z; func f() { }\n");
+				output.append("*/\n");
+
+				break;
+		}
+
+		appendFormat(output, "let declaration%zu = %zu; // Trailing comment\n", declaration, static_cast<elyrium::size_type>(random.next() % 1000));
+	}
+
+	return output;
+}
+
+lsd::String generateBrainfuck(elyrium::size_type size) {
+	lsd::String output;
+
+	while (output.size() < size) {
+		output.append(example::brainfuck);
+		output.append("\n");
+	}
+
+	return output;
+}
+
+lsd::Vector<Corpus> generateCorpora(elyrium::size_type size, elyrium::uint64 seed) {
+	lsd::Vector<Corpus> corpora;
+
+	corpora.pushBack({ "nesting", generateNesting(size, seed) });
+	corpora.pushBack({ "identifiers", generateIdentifiers(size, seed + 1) });
+	corpora.pushBack({ "literals", generateLiterals(size, seed + 2) });
+	corpora.pushBack({ "comments", generateComments(size, seed + 3) });
+	corpora.pushBack({ "brainfuck", generateBrainfuck(size) });
+
+	return corpora;
+}
+
+} // namespace bench
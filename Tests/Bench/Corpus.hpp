@@ -0,0 +1,59 @@
+/*************************
+ * @file Corpus.hpp
+ * @author Zhile Zhu (zhuzhile08@gmail.com)
+ *
+ * @brief Reproducible synthetic sources the lexer and parser benchmarks run over
+ *
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2026
+ *************************/
+
+#pragma once
+
+#include <Elyrium/Core/Common.hpp>
+
+#include <LSD/Vector.h>
+#include <LSD/String.h>
+#include <LSD/StringView.h>
+
+namespace bench {
+
+struct Corpus {
+public:
+	lsd::StringView name;
+	lsd::String source;
+};
+
+/**
+ * @brief Small deterministic generator, so a seed produces the same corpus on every platform and standard library
+ */
+class Random {
+public:
+	Random(elyrium::uint64 seed) noexcept : m_state(seed) { }
+
+	elyrium::uint64 next() noexcept;
+	/**
+	 * @brief Returns a number in [min, max]
+	 */
+	elyrium::uint64 range(elyrium::uint64 min, elyrium::uint64 max) noexcept {
+		return min + next() % (max - min + 1);
+	}
+	bool chance(elyrium::uint64 percent) noexcept {
+		return next() % 100 < percent;
+	}
+
+private:
+	elyrium::uint64 m_state;
+};
+
+// Every generator appends whole declarations until the source is at least size bytes long
+
+lsd::String generateNesting(elyrium::size_type size, elyrium::uint64 seed); // Deeply nested blocks, calls and subscripts
+lsd::String generateIdentifiers(elyrium::size_type size, elyrium::uint64 seed); // Long runs of long identifiers and member accesses
+lsd::String generateLiterals(elyrium::size_type size, elyrium::uint64 seed); // Functions full of numeric, character and string literals
+lsd::String generateComments(elyrium::size_type size, elyrium::uint64 seed); // Line, block and nested comments around sparse code
+lsd::String generateBrainfuck(elyrium::size_type size); // Repetitions of the example program of the command line interface
+
+lsd::Vector<Corpus> generateCorpora(elyrium::size_type size, elyrium::uint64 seed);
+
+} // namespace bench
@@ -0,0 +1,287 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <new>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <Elyrium/Core/Config.hpp>
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Context.hpp>
+
+#include <Elyrium/Compiler/Lexer.hpp>
+#include <Elyrium/Compiler/Parser.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
+
+#include "Corpus.hpp"
+
+namespace {
+
+// Every allocation is prefixed with its size, so the live and peak heap size can be tracked
+
+inline constexpr std::size_t allocationHeader = alignof(std::max_align_t);
+
+std::atomic<elyrium::size_type> allocationCount;
+std::atomic<elyrium::size_type> liveBytes;
+std::atomic<elyrium::size_type> peakBytes;
+
+void* allocate(std::size_t size) {
+	auto block = static_cast<std::size_t*>(std::malloc(size + allocationHeader));
+	if (!block) throw std::bad_alloc();
+
+	*block = size;
+
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	auto live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	auto peak = peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+
+	return reinterpret_cast<char*>(block) + allocationHeader;
+}
+
+void deallocate(void* pointer) noexcept {
+	if (!pointer) return;
+
+	auto block = reinterpret_cast<std::size_t*>(static_cast<char*>(pointer) - allocationHeader);
+	liveBytes.fetch_sub(*block, std::memory_order_relaxed);
+
+	std::free(block);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+	return allocate(size);
+}
+void* operator new[](std::size_t size) {
+	return allocate(size);
+}
+void operator delete(void* pointer) noexcept {
+	deallocate(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+	deallocate(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+	deallocate(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+	deallocate(pointer);
+}
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct Options {
+public:
+	elyrium::size_type size = 1 << 20;
+	elyrium::size_type iterations = 5;
+	elyrium::uint64 seed = 0x454C59524955ull;
+	const char* corpus = nullptr;
+	const char* output = nullptr;
+};
+
+struct Timing {
+public:
+	double best = 0.0;
+	double mean = 0.0;
+
+	void add(double seconds, elyrium::size_type iteration) {
+		if (iteration == 0 || seconds < best) best = seconds;
+		mean += (seconds - mean) / static_cast<double>(iteration + 1);
+	}
+};
+
+struct Result {
+public:
+	lsd::StringView name;
+	elyrium::size_type bytes = 0;
+
+	elyrium::size_type tokens = 0;
+	Timing lexer;
+
+	elyrium::size_type nodes = 0;
+	elyrium::size_type diagnostics = 0;
+	Timing parser;
+
+	elyrium::size_type allocations = 0;
+	elyrium::size_type peakHeapBytes = 0;
+};
+
+double secondsSince(clock_type::time_point start) {
+	return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+elyrium::size_type peakResidentBytes() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters { };
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+
+	return counters.PeakWorkingSetSize;
+#else
+	rusage usage { };
+	getrusage(RUSAGE_SELF, &usage);
+
+#if defined(__APPLE__)
+	return static_cast<elyrium::size_type>(usage.ru_maxrss);
+#else
+	return static_cast<elyrium::size_type>(usage.ru_maxrss) * 1024; // Linux reports kibibytes
+#endif
+#endif
+}
+
+Result run(const bench::Corpus& corpus, const Options& options) {
+	Result result;
+	result.name = corpus.name;
+	result.bytes = corpus.source.size();
+
+	lsd::StringView source(corpus.source.data(), corpus.source.size());
+
+	// Lexer throughput, by pulling single tokens like the streaming users of the lexer do
+	for (elyrium::size_type i = 0; i < options.iterations; i++) {
+		elyrium::Context context;
+		elyrium::compiler::Lexer lexer(source, corpus.name, context.symbols());
+
+		elyrium::size_type tokens = 0;
+
+		auto start = clock_type::now();
+		while (lexer.nextToken().type() != elyrium::compiler::Token::Type::eof)
+			++tokens;
+		result.lexer.add(secondsSince(start), i);
+
+		result.tokens = tokens;
+	}
+
+	// Parser throughput, excluding the lexing done when the parser is constructed
+	for (elyrium::size_type i = 0; i < options.iterations; i++) {
+		elyrium::Context context;
+		elyrium::compiler::Diagnostics diagnostics(source, corpus.name);
+		elyrium::compiler::Parser parser(context, source, corpus.name, diagnostics);
+
+		auto start = clock_type::now();
+		auto module = parser.parse();
+		result.parser.add(secondsSince(start), i);
+
+		result.nodes = module.arena().nodeCount();
+		result.diagnostics = diagnostics.size();
+	}
+
+	// Memory of the whole front end, measured separately so the counters don't slow down the timed runs
+	{
+		auto allocations = allocationCount.load();
+		peakBytes.store(liveBytes.load());
+		auto baseline = liveBytes.load();
+
+		{
+			elyrium::Context context;
+			elyrium::compiler::Diagnostics diagnostics(source, corpus.name);
+			elyrium::compiler::Parser parser(context, source, corpus.name, diagnostics);
+
+			auto module = parser.parse();
+		}
+
+		result.allocations = allocationCount.load() - allocations;
+		result.peakHeapBytes = peakBytes.load() - baseline;
+	}
+
+	return result;
+}
+
+void print(std::FILE* file, const Options& options, const lsd::Vector<Result>& results) {
+	std::fprintf(file, "{\n");
+	std::fprintf(file, "\t\"version\": \"%s\",\n", elyrium::config::version);
+	std::fprintf(file, "\t\"seed\": %llu,\n", static_cast<unsigned long long>(options.seed));
+	std::fprintf(file, "\t\"size\": %zu,\n", options.size);
+	std::fprintf(file, "\t\"iterations\": %zu,\n", options.iterations);
+	std::fprintf(file, "\t\"corpora\": [\n");
+
+	for (elyrium::size_type i = 0; i < results.size(); i++) {
+		const auto& result = results[i];
+		auto bytes = static_cast<double>(result.bytes);
+
+		std::fprintf(file, "\t\t{\n");
+		std::fprintf(file, "\t\t\t\"name\": \"%.*s\",\n", static_cast<int>(result.name.size()), result.name.data());
+		std::fprintf(file, "\t\t\t\"bytes\": %zu,\n", result.bytes);
+		std::fprintf(file, "\t\t\t\"lexer\": { \"tokens\": %zu, \"seconds\": %.6f, \"meanSeconds\": %.6f, \"tokensPerSecond\": %.0f, \"bytesPerSecond\": %.0f },\n",
+			result.tokens, result.lexer.best, result.lexer.mean, static_cast<double>(result.tokens) / result.lexer.best, bytes / result.lexer.best);
+		std::fprintf(file, "\t\t\t\"parser\": { \"nodes\": %zu, \"diagnostics\": %zu, \"seconds\": %.6f, \"meanSeconds\": %.6f, \"nodesPerSecond\": %.0f, \"bytesPerSecond\": %.0f },\n",
+			result.nodes, result.diagnostics, result.parser.best, result.parser.mean, static_cast<double>(result.nodes) / result.parser.best, bytes / result.parser.best);
+		std::fprintf(file, "\t\t\t\"memory\": { \"allocations\": %zu, \"allocationsPerKiB\": %.3f, \"peakHeapBytes\": %zu }\n",
+			result.allocations, static_cast<double>(result.allocations) * 1024.0 / bytes, result.peakHeapBytes);
+		std::fprintf(file, "\t\t}%s\n", (i + 1 < results.size()) ? "," : "");
+	}
+
+	std::fprintf(file, "\t],\n");
+	std::fprintf(file, "\t\"peakResidentBytes\": %zu\n", peakResidentBytes());
+	std::fprintf(file, "}\n");
+}
+
+int usage() {
+	std::fprintf(stderr,
+		"Usage: ElyriumBench [options]\n"
+		"\t--size <bytes>       Minimum size of every corpus (default 1048576)\n"
+		"\t--iterations <n>     Timed runs per corpus, the fastest one is reported (default 5)\n"
+		"\t--seed <n>           Seed of the corpus generator\n"
+		"\t--corpus <name>      Only run one of nesting, identifiers, literals, comments or brainfuck\n"
+		"\t--output <path>      Write the JSON results to a file instead of the standard output\n"
+	);
+
+	return 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	Options options;
+
+	for (int i = 1; i < argc; i++) {
+		if (i + 1 >= argc) return usage();
+
+		if (std::strcmp(argv[i], "--size") == 0) options.size = std::strtoull(argv[++i], nullptr, 0);
+		else if (std::strcmp(argv[i], "--iterations") == 0) options.iterations = std::strtoull(argv[++i], nullptr, 0);
+		else if (std::strcmp(argv[i], "--seed") == 0) options.seed = std::strtoull(argv[++i], nullptr, 0);
+		else if (std::strcmp(argv[i], "--corpus") == 0) options.corpus = argv[++i];
+		else if (std::strcmp(argv[i], "--output") == 0) options.output = argv[++i];
+		else return usage();
+	}
+
+	if (options.size == 0 || options.iterations == 0) return usage();
+
+	lsd::Vector<Result> results;
+
+	try {
+		for (const auto& corpus : bench::generateCorpora(options.size, options.seed)) {
+			if (options.corpus && corpus.name != lsd::StringView(options.corpus)) continue;
+
+			results.pushBack(run(corpus, options));
+		}
+	} catch (const elyrium::Exception& exception) {
+		std::fprintf(stderr, "%s", exception.what());
+
+		return 1;
+	}
+
+	if (results.empty()) return usage();
+
+	auto file = (options.output) ? std::fopen(options.output, "w") : stdout;
+	if (!file) {
+		std::fprintf(stderr, "Failed to open \"%s\"!\n", options.output);
+
+		return 1;
+	}
+
+	print(file, options, results);
+
+	if (file != stdout) std::fclose(file);
+
+	return 0;
+}
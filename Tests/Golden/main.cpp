@@ -0,0 +1,196 @@
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Context.hpp>
+
+#include <Elyrium/Compiler/Parser.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
+#include <Elyrium/Compiler/Compiler.hpp>
+#include <Elyrium/Interpreter/Disassembler.hpp>
+
+namespace {
+
+bool read(const std::filesystem::path& path, std::string& content) {
+	auto file = std::fopen(path.string().c_str(), "rb");
+	if (!file) return false;
+
+	char buffer[4096];
+	content.clear();
+
+	for (std::size_t count; (count = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+		content.append(buffer, count);
+
+	std::fclose(file);
+	return true;
+}
+
+bool write(const std::filesystem::path& path, const std::string& content) {
+	auto file = std::fopen(path.string().c_str(), "wb");
+	if (!file) return false;
+
+	auto written = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+
+	std::fclose(file);
+	return written;
+}
+
+/**
+ * @brief Compiles a source and returns its disassembly, or the error if it didn't compile
+ *
+ * @param compiled Set to whether the source compiled, if given
+ */
+std::string compile(const std::string& source, const std::string& name, elyrium::compiler::OptimizationLevel level, bool* compiled = nullptr) {
+	elyrium::Context context;
+	lsd::StringView view(source.data(), source.size());
+
+	try {
+		elyrium::compiler::Parser parser(context, view, name.c_str());
+		auto module = parser.parse();
+
+		elyrium::compiler::Compiler compiler(module, view, name.c_str(), level);
+		auto program = compiler.compile();
+
+		auto listing = elyrium::bytecode::disassemble(program, context.symbols());
+		if (compiled) *compiled = true;
+
+		return std::string(listing.data(), listing.size());
+	} catch (const elyrium::Exception& exception) {
+		if (compiled) *compiled = false;
+
+		return exception.what();
+	}
+}
+
+/**
+ * @brief Parses a source reporting every error like the -c option of the command line does, and returns the errors
+ */
+std::string check(const std::string& source, const std::string& name) {
+	elyrium::Context context;
+	lsd::StringView view(source.data(), source.size());
+
+	elyrium::compiler::Diagnostics diagnostics(view, name.c_str());
+	elyrium::compiler::Parser(context, view, name.c_str(), diagnostics).parse();
+
+	auto errors = diagnostics.format();
+	return std::string(errors.data(), errors.size());
+}
+
+std::string repeat(const char* text, std::size_t count) {
+	std::string result;
+	result.reserve(std::strlen(text) * count);
+
+	for (std::size_t i = 0; i < count; i++) result += text;
+	return result;
+}
+
+struct Source {
+public:
+	std::string name;
+	std::string source;
+};
+
+/**
+ * @brief Deeply nested expressions the parser accepts, which are too large to be compared with a listing but have to compile without running out of stack
+ */
+std::vector<Source> deepSources() {
+	return {
+		{ "200k nested calls", "let x = " + repeat("f(", 200000) + "1" + repeat(")", 200000) + ";\n" },
+		{ "200k nested parentheses", "let x = " + repeat("-(", 200000) + "a" + repeat(")", 200000) + ";\n" },
+		{ "200k long call chain", "let x = f" + repeat("(1)", 200000) + ";\n" },
+		{ "200k long member chain", "let x = a" + repeat(".b[1]", 200000) + ";\n" },
+		{ "50k long operator chain", "let x = 1" + repeat(" + 1", 50000) + ";\n" },
+		{ "50k long logic chain", "let x = a" + repeat(" && a || a", 50000) + ";\n" },
+		{ "50k long condition", "func f(x) {\n\tif (x" + repeat(" && x || !x", 50000) + ") { return x; }\n}\n" },
+		{ "50k long return value", "func f(x) {\n\treturn x" + repeat(" + x", 50000) + ";\n}\n" }
+	};
+}
+
+int usage() {
+	std::fprintf(stderr, "Usage: ElyriumGolden <directory> [-O0|-O1|-O2|-c] [--update]\n");
+	return 1;
+}
+
+} // namespace
+
+/**
+ * Compiles every .ely file of a directory at an optimization level and compares the disassembly with the .txt file of the same name,
+ * or compares the syntax errors reported for it with -c, then compiles the deeply nested expressions
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 2) return usage();
+
+	auto update = false;
+	auto diagnose = false;
+	auto level = elyrium::compiler::OptimizationLevel::none;
+
+	for (int i = 2; i < argc; i++) {
+		if (std::strcmp(argv[i], "--update") == 0) update = true;
+		else if (std::strcmp(argv[i], "-O0") == 0) level = elyrium::compiler::OptimizationLevel::none;
+		else if (std::strcmp(argv[i], "-O1") == 0) level = elyrium::compiler::OptimizationLevel::basic;
+		else if (std::strcmp(argv[i], "-O2") == 0) level = elyrium::compiler::OptimizationLevel::full;
+		else if (std::strcmp(argv[i], "-c") == 0) diagnose = true;
+		else return usage();
+	}
+
+	std::vector<std::filesystem::path> sources;
+
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(argv[1], error))
+		if (entry.path().extension() == ".ely") sources.push_back(entry.path());
+
+	if (error || sources.empty()) {
+		std::fprintf(stderr, "No sources found in %s\n", argv[1]);
+		return 1;
+	}
+
+	std::sort(sources.begin(), sources.end());
+
+	auto failures = 0;
+
+	for (const auto& path : sources) {
+		std::string source, expected;
+
+		if (!read(path, source)) {
+			std::fprintf(stderr, "FAIL %s: couldn't be read\n", path.string().c_str());
+			++failures;
+			continue;
+		}
+
+		auto expectedPath = path;
+		expectedPath.replace_extension(".txt");
+
+		auto actual = diagnose ? check(source, path.filename().string()) : compile(source, path.filename().string(), level);
+
+		if (update) {
+			if (!write(expectedPath, actual)) {
+				std::fprintf(stderr, "FAIL %s: couldn't be written\n", expectedPath.string().c_str());
+				++failures;
+			}
+		} else if (!read(expectedPath, expected)) {
+			std::fprintf(stderr, "FAIL %s: missing %s\n", path.filename().string().c_str(), expectedPath.filename().string().c_str());
+			++failures;
+		} else if (actual != expected) {
+			std::fprintf(stderr, "FAIL %s\n--- expected\n%s--- actual\n%s", path.filename().string().c_str(), expected.c_str(), actual.c_str());
+			++failures;
+		} else std::printf("ok   %s\n", path.filename().string().c_str());
+	}
+
+	if (!diagnose && !update) {
+		for (const auto& source : deepSources()) {
+			auto compiled = false;
+			auto error = compile(source.source, source.name, level, &compiled);
+
+			if (!compiled) {
+				std::fprintf(stderr, "FAIL %s\n%s", source.name.c_str(), error.c_str());
+				++failures;
+			} else std::printf("ok   %s\n", source.name.c_str());
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <Elyrium/Core/Error.hpp>
+
+#include <Elyrium/Compiler/Lexer.hpp>
+#include <Elyrium/Compiler/StreamLexer.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
+
+namespace {
+
+struct Case {
+public:
+	const char* name;
+	std::string source;
+};
+
+/**
+ * @brief Renders the tokens and symbols of a buffer, which also covers the order symbols and literals were assigned in
+ */
+std::string dump(const elyrium::compiler::TokenBuffer& tokens, const elyrium::compiler::SymbolTable& symbols) {
+	using elyrium::compiler::Token;
+
+	std::string output;
+
+	for (elyrium::compiler::TokenBuffer::index_type i = 0; i < tokens.size(); i++) {
+		auto value = tokens.value(i);
+		output += std::to_string(static_cast<int>(tokens.type(i))) + ' ' + std::to_string(tokens.offset(i)) + ' ' + std::to_string(tokens.length(i));
+
+		switch (tokens.type(i)) {
+			case Token::Type::identifier:
+			case Token::Type::attribute:
+				output += ' ' + std::to_string(value.symbol);
+
+				break;
+
+			case Token::Type::string: {
+				auto string = tokens.literals().string(value.literal);
+				output += ' ' + std::to_string(value.literal) + " \"" + std::string(string.data(), string.size()) + '"';
+
+				break;
+			}
+
+			case Token::Type::integral:
+			case Token::Type::unsignedIntegral:
+			case Token::Type::character:
+				output += ' ' + std::to_string(value.unsignedIntegral);
+
+				break;
+
+			case Token::Type::floating:
+				output += ' ' + std::to_string(value.floating);
+
+				break;
+
+			default:
+				break;
+		}
+
+		output += '\n';
+	}
+
+	for (elyrium::compiler::symbol_id symbol = 0; symbol < symbols.size(); symbol++) {
+		auto string = symbols.string(symbol);
+		output += std::string(string.data(), string.size()) + '\n';
+	}
+
+	return output;
+}
+
+/**
+ * @brief Lexes a source sequentially if threadCount is one, returning the tokens or the error raised
+ */
+std::string lex(const std::string& source, elyrium::size_type threadCount, elyrium::size_type chunkSize) {
+	lsd::StringView view(source.data(), source.size());
+
+	try {
+		elyrium::compiler::SymbolTable symbols;
+		elyrium::compiler::Lexer lexer(view, "test", symbols);
+
+		auto tokens = (threadCount == 1) ? lexer.tokenize() : lexer.tokenizeParallel(threadCount, chunkSize);
+		return dump(tokens, symbols);
+	} catch (const elyrium::Exception& exception) {
+		return exception.what();
+	}
+}
+
+/**
+ * @brief Lexes a source like lex(), but reports errors to diagnostics and returns them after the tokens
+ */
+std::string lexDiagnostics(const std::string& source, elyrium::size_type threadCount, elyrium::size_type chunkSize) {
+	lsd::StringView view(source.data(), source.size());
+
+	elyrium::compiler::SymbolTable symbols;
+	elyrium::compiler::Diagnostics diagnostics(view, "test");
+	elyrium::compiler::Lexer lexer(view, "test", symbols, diagnostics);
+
+	auto tokens = (threadCount == 1) ? lexer.tokenize() : lexer.tokenizeParallel(threadCount, chunkSize);
+	diagnostics.sort();
+
+	return dump(tokens, symbols) + diagnostics.format().data();
+}
+
+/**
+ * @brief Lexes a source with a stream lexer reading chunks of a size from a file, returning the same output as lex()
+ */
+std::string lexStream(const std::string& source, elyrium::size_type chunkSize) {
+	auto file = std::tmpfile();
+	if (!file) return "couldn't create a temporary file";
+
+	std::fwrite(source.data(), 1, source.size(), file);
+	std::rewind(file);
+
+#ifdef ELYRIUM_WINDOWS
+	elyrium::filesys::InputStream input(_fileno(file));
+#else
+	elyrium::filesys::InputStream input(fileno(file));
+#endif
+
+	std::string output;
+
+	try {
+		elyrium::compiler::SymbolTable symbols;
+		elyrium::compiler::StreamLexer lexer(input, "test", symbols, chunkSize);
+
+		lsd::String read;
+		auto tokens = lexer.tokenize(read);
+
+		output = dump(tokens, symbols);
+		if (std::string(read.data(), read.size()) != source) output += "input wasn't read completely\n";
+	} catch (const elyrium::Exception& exception) {
+		output = exception.what();
+	}
+
+	std::fclose(file);
+	return output;
+}
+
+/**
+ * @brief Sources which are split into many chunks with small chunk sizes, so that chunk boundaries fall into every construct spanning lines
+ */
+std::vector<Case> corpus() {
+	std::string lines;
+	for (int i = 0; i < 40; i++)
+		lines += "let value" + std::to_string(i % 7) + " = " + std::to_string(i) + " * 0x1f + 2.5e3 - '\\n';\n";
+
+	return {
+		{ "plain", lines },
+		{ "multiline string", lines + "let s = \"first\n\tsecond \\\"quoted\\\"\n// not a comment\n/* nor this */\nlast\";\n" + lines },
+		{ "strings with escapes", lines + "let t = \"a\\tb\n\\U0001F600 \\u00e9 \\x41\nc\";\nlet u = \"\";\nlet v = \"\n\n\n\";\n" + lines },
+		{ "block comments", lines + "/* first\nlet hidden = 1;\n\"not a string\n*/\n" + lines + "/* outer /* nested\n*/ still inside\n*/ let after = 2;\n" },
+		{ "line comments", lines + "// \"unterminated in a comment\nlet x = 1; // /* not a block\nlet y = \"// not a comment\";\n" + lines },
+		{ "identifier reuse", lines + "@attribute func value3(value1 : int) : int { return value1 + late; }\n" + lines + "let late = value0;\n" },
+		{ "unterminated string in a later chunk", lines + lines + "let broken = \"never closed\nlet more = 1;\n" },
+		{ "unclosed block comment in a later chunk", lines + lines + "/* never closed\nlet more = 1;\n" },
+		{ "invalid literal in a later chunk", lines + lines + "let bad = 0xZZ;\nlet more = 12345678901234567890123;\n" + lines },
+		{ "disallowed character in a later chunk", lines + lines + std::string("let nul = 1;\0let more = 2;\n", 27) + lines },
+		{ "several errors", lines + "let a = 0b2;\n" + lines + "let c = '';\n" + lines + "let d = \"open\n" }
+	};
+}
+
+/**
+ * @brief Checks that sources which tokens can't locate are rejected with a syntax error, before any of them is read
+ */
+bool checkSourceLimit() {
+	static constexpr char source[] = "let x = 1;";
+
+	try {
+		elyrium::compiler::SymbolTable symbols;
+		elyrium::compiler::Lexer(lsd::StringView(source, elyrium::compiler::Lexer::sourceLimit + 1), "test", symbols).tokenize();
+	} catch (const elyrium::SyntaxError& error) {
+		if (std::string(error.what()).find(elyrium::error::describe(elyrium::error::Message::sourceTooLarge)) != std::string::npos) return true;
+
+		std::fprintf(stderr, "FAIL source limit: unexpected error\n%s", error.what());
+		return false;
+	}
+
+	std::fprintf(stderr, "FAIL source limit: oversized source was lexed\n");
+	return false;
+}
+
+} // namespace
+
+/**
+ * Lexes every source of the corpus on several threads with small chunk sizes and through stream lexers with small windows,
+ * and compares tokens, symbols, literals and errors with the sequential lexer, then checks that oversized sources are rejected
+ */
+int main() {
+	static constexpr elyrium::size_type threadCounts[] = { 2, 3, 8 };
+	static constexpr elyrium::size_type chunkSizes[] = { 1, 13, 64, 500 };
+	static constexpr elyrium::size_type streamChunkSizes[] = { 1, 2, 3, 7, 64, 4096 };
+
+	auto failures = 0;
+
+	auto check = [&failures](const char* name, const char* mode, elyrium::size_type chunkSize, const std::string& expected, const std::string& actual) {
+		if (actual == expected) return true;
+
+		std::fprintf(stderr, "FAIL %s (%s, chunks of %zu bytes)\n--- expected\n%s--- actual\n%s", name, mode, chunkSize, expected.c_str(), actual.c_str());
+		++failures;
+
+		return false;
+	};
+
+	for (const auto& test : corpus()) {
+		auto expected = lex(test.source, 1, 0);
+		auto expectedDiagnostics = lexDiagnostics(test.source, 1, 0);
+		auto passed = true;
+
+		for (auto threadCount : threadCounts) {
+			for (auto chunkSize : chunkSizes) {
+				passed = passed &&
+					check(test.name, "parallel", chunkSize, expected, lex(test.source, threadCount, chunkSize)) &&
+					check(test.name, "parallel diagnostics", chunkSize, expectedDiagnostics, lexDiagnostics(test.source, threadCount, chunkSize));
+			}
+		}
+
+		for (auto chunkSize : streamChunkSizes)
+			passed = passed && check(test.name, "stream", chunkSize, expected, lexStream(test.source, chunkSize));
+
+		if (passed) std::printf("ok   %s\n", test.name);
+	}
+
+	if (checkSourceLimit()) std::printf("ok   source limit\n");
+	else ++failures;
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,448 @@
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <Elyrium/Core/Error.hpp>
+#include <Elyrium/Context.hpp>
+
+#include <Elyrium/Compiler/Parser.hpp>
+#include <Elyrium/Compiler/Diagnostics.hpp>
+#include <Elyrium/Compiler/IncrementalParser.hpp>
+
+#include "Corpus.hpp"
+
+#ifdef ELYRIUM_POSIX
+#include <unistd.h>
+#elif defined(ELYRIUM_WINDOWS)
+#include <io.h>
+#endif
+
+namespace {
+
+struct Source {
+public:
+	std::string name;
+	std::string source;
+};
+
+bool read(const std::filesystem::path& path, std::string& content) {
+	auto file = std::fopen(path.string().c_str(), "rb");
+	if (!file) return false;
+
+	char buffer[4096];
+	content.clear();
+
+	for (std::size_t count; (count = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+		content.append(buffer, count);
+
+	std::fclose(file);
+	return true;
+}
+
+/**
+ * @brief Returns what a function printed to the standard output, which is where the trees print themselves to
+ */
+template <class Function> std::string capture(Function&& function) {
+	auto file = std::tmpfile();
+	if (!file) return "couldn't create a temporary file";
+
+	std::fflush(stdout);
+
+#ifdef ELYRIUM_WINDOWS
+	auto saved = _dup(_fileno(stdout));
+	_dup2(_fileno(file), _fileno(stdout));
+#else
+	auto saved = dup(fileno(stdout));
+	dup2(fileno(file), fileno(stdout));
+#endif
+
+	function();
+	std::fflush(stdout);
+
+#ifdef ELYRIUM_WINDOWS
+	_dup2(saved, _fileno(stdout));
+	_close(saved);
+#else
+	dup2(saved, fileno(stdout));
+	close(saved);
+#endif
+
+	std::string output;
+	char buffer[4096];
+
+	std::rewind(file);
+	for (std::size_t count; (count = std::fread(buffer, 1, sizeof(buffer), file)) > 0;)
+		output.append(buffer, count);
+
+	std::fclose(file);
+	return output;
+}
+
+/**
+ * @brief Prints the tree parsed from a source, or returns the error raised while parsing it
+ */
+std::string printTree(const std::string& source) {
+	return capture([&source]() {
+		elyrium::Context context;
+
+		try {
+			elyrium::compiler::Parser(context, lsd::StringView(source.data(), source.size()), "test").parse().print();
+		} catch (const elyrium::Exception& exception) {
+			std::printf("%s", exception.what());
+		}
+	});
+}
+
+std::string printFlatTree(const std::string& source) {
+	return capture([&source]() {
+		elyrium::Context context;
+
+		try {
+			elyrium::compiler::Parser(context, lsd::StringView(source.data(), source.size()), "test").parseFlat().print();
+		} catch (const elyrium::Exception& exception) {
+			std::printf("%s", exception.what());
+		}
+	});
+}
+
+/**
+ * @brief Returns the errors a parser reports to diagnostics, recovering at the next statement after every error
+ */
+std::string diagnose(const std::string& source, bool flat) {
+	elyrium::Context context;
+	lsd::StringView view(source.data(), source.size());
+
+	elyrium::compiler::Diagnostics diagnostics(view, "test");
+	elyrium::compiler::Parser parser(context, view, "test", diagnostics);
+
+	if (flat) parser.parseFlat();
+	else parser.parse();
+
+	auto errors = diagnostics.format();
+	return std::string(errors.data(), errors.size());
+}
+
+std::string repeat(const char* text, std::size_t count) {
+	std::string output;
+	output.reserve(std::strlen(text) * count);
+
+	for (std::size_t i = 0; i < count; i++)
+		output += text;
+
+	return output;
+}
+
+/**
+ * @brief Sources covering every construct of the grammar and some errors, the generated corpora of the benchmarks and the golden sources
+ *
+ * @param generatedSize Minimum size of the generated corpora
+ */
+std::vector<Source> corpus(const char* directory, elyrium::size_type generatedSize) {
+	std::vector<Source> sources {
+		{ "constructs", 
+			"import \"io\", \"os\", foo;\n"
+			"@const let SUCCESS = 0;\n"
+			"enum Color : int { red = 2 }\n"
+			"namespace ns {\n"
+			"\tlet a : int* = 1, b = -42, c = 3.25, d = 'x', e = \"hi\\n\", f = 1844674407370955161u;\n"
+			"\tlet stack : arr[uint, STACK_LEN], x = 3 * 4 + 5 - 2 / 1 % 7;\n"
+			"\tfunc g(x : int) : int {\n"
+			"\t\tfor (let i = 0; i < 10; i++) { if (i == 2) break; else if (i) continue; else { } }\n"
+			"\t\tlet h = func (z : int) { return z * 2; } + 1;\n"
+			"\t\tx = y = z + 1;\n"
+			"\t\t++stack[ptr] &= MOD;\n"
+			"\t\treturn -x[1].m(2, 3).n * y--;\n"
+			"\t}\n"
+			"}\n"
+			"let l = a && b || c | d ^ e & f == g < h << i + j * k, m = !a.b, n = ~c >> 2 != 3 >= 4;\n"
+		},
+		{ "statements",
+			"func interpret(tape : str*) : int {\n"
+			"\tfor (let iptr : uint = 0; iptr <= tape.size(); iptr++) {\n"
+			"\t\tif (i == '<') {\n"
+			"\t\t\tif (--ptr >= stack.size())\n"
+			"\t\t\t\tbreak;\n"
+			"\t\t} else if (i == '+')\n"
+			"\t\t\t++stack[ptr] &= MOD;\n"
+			"\t\telse return -FAILURE;\n"
+			"\t}\n"
+			"\tx += y -= z *= 2;\n"
+			"\treturn 0;\n"
+			"}\n"
+		},
+		{ "closures",
+			"let f = func (x) { return x; };\n"
+			"let g = func (x : int) : int { return x * 2; }(4) + -func (y) { return y; }(1);\n"
+			"let h = func {a, b} (x) { return a(x) + b; };\n"
+			"func apply(list) {\n"
+			"\tlist.each(func (item) { total += item; });\n"
+			"\treturn func (scale) { return scale; };\n"
+			"}\n"
+		},
+		{ "missing expression", "func main() {\n\tlet a = 1 +;\n}\n" },
+		{ "unclosed call", "let x = foo(1, 2;\n" },
+		{ "missing parameter type", "func other(x) {\n\treturn 1;\n}\n" },
+		{ "unterminated string", "namespace n {\n\tlet e = \"unterminated\n}\n" },
+		{ "missing semicolon", "let f = 5\n" },
+		{ "unsupported class", "class Point { let x = 0; }\n" },
+		{ "unsupported catch", "func g() { try { x = 1; } catch (error) { x = 2; } }\n" }
+	};
+
+	for (elyrium::uint64 seed : { 1, 2 })
+		for (const auto& generated : bench::generateCorpora(generatedSize, seed))
+			sources.push_back({ std::string(generated.name.data(), generated.name.size()) + " " + std::to_string(seed), std::string(generated.source.data(), generated.source.size()) });
+
+	if (directory) {
+		std::vector<std::filesystem::path> paths;
+
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+			if (entry.path().extension() == ".ely") paths.push_back(entry.path());
+
+		std::sort(paths.begin(), paths.end());
+
+		for (const auto& path : paths) {
+			if (Source source { path.filename().string(), { } }; read(path, source.source))
+				sources.push_back(std::move(source));
+		}
+	}
+
+	return sources;
+}
+
+/**
+ * @brief Long and deeply nested expressions, of which the nested ones are only as deep as the recursive flat parser can handle on small native stacks
+ */
+std::vector<Source> deepSources() {
+	return {
+		{ "200k long call chain", "let x = f" + repeat("(1)", 200000) + ";\n" },
+		{ "200k long member chain", "let x = a" + repeat(".b[1]", 200000) + ";\n" },
+		{ "nested calls", "let x = " + repeat("f(", 500) + "1" + repeat(")", 500) + ";\n" },
+		{ "nested parentheses", "let x = " + repeat("-(", 500) + "a" + repeat(")", 500) + ";\n" },
+		{ "directly nested parentheses", "let x = " + repeat("(", 500) + "a" + repeat(")", 500) + ";\n" },
+		{ "operator chain", "let x = a" + repeat(" = a * a", 500) + ";\n" }
+	};
+}
+
+/**
+ * @brief Checks that closures are parsed as operands, which can be called and combined with operators like any other operand
+ */
+bool checkClosures() {
+	static constexpr const char* source = "let f = func (x) { return x; }, g = func (x) { return x; }(1) * -func (x) { return x; }.y;\n";
+	static constexpr std::size_t closureCount = 3;
+
+	auto tree = printTree(source);
+
+	std::size_t count = 0;
+	for (auto position = tree.find("Closure expression"); position != std::string::npos; position = tree.find("Closure expression", position + 1))
+		++count;
+
+	if (tree.rfind("File ", 0) == 0 || count != closureCount) {
+		std::fprintf(stderr, "FAIL closure operands: parsed %zu of %zu closures\n%s", count, closureCount, tree.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Checks that all parsers print the same trees and raise the same errors as parse()
+ */
+bool checkTrees(const Source& source) {
+	auto expected = printTree(source.source);
+	auto actual = printFlatTree(source.source);
+
+	if (actual == expected) return true;
+
+	std::fprintf(stderr, "FAIL %s (flat)\n--- expected\n%s--- actual\n%s", source.name.c_str(), expected.c_str(), actual.c_str());
+	return false;
+}
+
+/**
+ * @brief Checks that the tree parser handles nesting which would overflow the native stack of a recursive parser
+ *
+ * @note The trees are too deep to be printed, since every level of them is indented further
+ */
+bool checkNesting() {
+	std::vector<Source> sources {
+		{ "200k nested calls", "let x = " + repeat("f(", 200000) + "1" + repeat(")", 200000) + ";\n" },
+		{ "200k nested parentheses", "let x = " + repeat("-(", 200000) + "a" + repeat(")", 200000) + ";\n" },
+		{ "200k long operator chain", "let x = a" + repeat(" = a * a", 200000) + ";\n" }
+	};
+
+	auto passed = true;
+
+	for (const auto& source : sources) {
+		elyrium::Context context;
+
+		try {
+			auto module = elyrium::compiler::Parser(context, lsd::StringView(source.source.data(), source.source.size()), "test").parse();
+
+			if (module.declarations().size() != 1) {
+				std::fprintf(stderr, "FAIL %s: parsed %zu declarations\n", source.name.c_str(), module.declarations().size());
+				passed = false;
+			}
+		} catch (const elyrium::Exception& exception) {
+			std::fprintf(stderr, "FAIL %s\n%s", source.name.c_str(), exception.what());
+			passed = false;
+		}
+	}
+
+	return passed;
+}
+
+/**
+ * @brief Mutates a source randomly and checks that all parsers agree on the trees and on the errors they raise or report for every mutation
+ */
+bool checkMutations(const Source& source, elyrium::uint64 seed) {
+	static constexpr char pieces[] = ";{}()[]'\\,:.+=*/-!<>&|^%\nx1_@\"";
+	static constexpr int mutationCount = 100;
+
+	bench::Random random(seed);
+
+	for (int i = 0; i < mutationCount; i++) {
+		auto mutated = source.source;
+
+		for (auto count = random.range(1, 6); count > 0 && !mutated.empty(); count--) {
+			auto offset = random.range(0, mutated.size() - 1);
+			auto piece = pieces[random.range(0, sizeof(pieces) - 2)];
+
+			switch (random.range(0, 2)) {
+				case 0: mutated.erase(offset, random.range(1, 4)); break;
+				case 1: mutated.insert(offset, 1, piece); break;
+				default: mutated[offset] = piece; break;
+			}
+		}
+
+		Source mutation { source.name + " mutation " + std::to_string(i), mutated };
+		if (!checkTrees(mutation)) return false;
+
+		if (auto expected = diagnose(mutated, false), actual = diagnose(mutated, true); actual != expected) {
+			std::fprintf(stderr, "FAIL %s (flat diagnostics)\n--- source\n%s\n--- expected\n%s--- actual\n%s", mutation.name.c_str(), mutated.c_str(), expected.c_str(), actual.c_str());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Applies random edits to a source and compares the module or error after every edit with a full reparse
+ *
+ * @note Edits are undone again half of the time, so the source keeps returning to a state which parses
+ */
+bool checkIncremental(const Source& source, elyrium::uint64 seed) {
+	static constexpr const char* pieces[] = { 
+		"x", " ", "\n", "\n\n", "\t", "{", "}", "(", ")", ",", "+", "1", "\"", "/*", "*/", "//",
+		"let a = 1;\n", "func g() { return 2; }\n", "if (a) b;"
+	};
+	static constexpr int editCount = 200;
+
+	struct Edit {
+	public:
+		std::size_t offset;
+		std::size_t removed;
+		std::string inserted;
+	};
+
+	elyrium::Context context;
+	elyrium::compiler::IncrementalParser parser(context, lsd::StringView(source.source.data(), source.source.size()), "test");
+
+	bench::Random random(seed);
+	auto current = source.source;
+	std::optional<Edit> undo;
+
+	for (int i = 0; i < editCount; i++) {
+		Edit edit;
+
+		if (undo && random.chance(50)) {
+			edit = std::move(*undo);
+			undo.reset();
+		} else {
+			edit.offset = random.range(0, current.size());
+			edit.removed = (edit.offset < current.size() && random.chance(33)) ? random.range(0, std::min<std::size_t>(current.size() - edit.offset, 20)) : 0;
+			edit.inserted = random.chance(25) ? "" : pieces[random.range(0, std::size(pieces) - 1)];
+
+			undo = Edit { edit.offset, edit.inserted.size(), current.substr(edit.offset, edit.removed) };
+		}
+
+		current.replace(edit.offset, edit.removed, edit.inserted);
+
+		auto actual = capture([&parser, &edit]() {
+			try {
+				parser.edit(edit.offset, edit.removed, lsd::StringView(edit.inserted.data(), edit.inserted.size()));
+				parser.module().print();
+			} catch (const elyrium::Exception& exception) {
+				std::printf("%s", exception.what());
+			}
+		});
+		auto expected = printTree(current);
+
+		if (auto edited = parser.source(); actual != expected || std::string(edited.data(), edited.size()) != current) {
+			std::fprintf(stderr, "FAIL %s (edit %d replacing %zu bytes at %zu with \"%s\")\n--- source\n%s\n--- expected\n%s--- actual\n%s",
+				source.name.c_str(), i, edit.removed, edit.offset, edit.inserted.c_str(), current.c_str(), expected.c_str(), actual.c_str());
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int usage() {
+	std::fprintf(stderr, "Usage: ElyriumParser <trees | incremental> [directory]\n");
+	return 1;
+}
+
+} // namespace
+
+/**
+ * Parses a corpus, long and deeply nested expressions and random mutations of the corpus with every parser and checks that all of them
+ * print the same trees and raise the same errors, or edits the sources of a corpus randomly and checks that the incremental parser keeps up with full reparses
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 2) return usage();
+
+	auto incremental = std::strcmp(argv[1], "incremental") == 0;
+	if (!incremental && std::strcmp(argv[1], "trees") != 0) return usage();
+
+	auto failures = 0;
+	elyrium::uint64 seed = 0;
+
+	auto report = [&failures](const std::string& name, bool passed) {
+		if (passed) std::printf("ok   %s\n", name.c_str());
+		else ++failures;
+	};
+
+	// Every edit is checked with a full reparse, so the incremental parser is tested with smaller corpora
+	auto sources = corpus(argc > 2 ? argv[2] : nullptr, incremental ? (1 << 10) : (1 << 14));
+
+	if (incremental) {
+		for (const auto& source : sources) {
+			// Only sources which parse can be edited
+			if (printTree(source.source).rfind("File ", 0) != 0)
+				report(source.name, checkIncremental(source, ++seed));
+		}
+	} else {
+		for (const auto& source : sources)
+			report(source.name, checkTrees(source));
+
+		for (const auto& source : deepSources())
+			report(source.name, checkTrees(source));
+
+		report("200k deep nesting", checkNesting());
+		report("closure operands", checkClosures());
+
+		// Each mutation is printed twice, so the large generated corpora are left out
+		for (const auto& source : sources) {
+			if (source.source.size() < (1 << 12))
+				report(source.name + " mutations", checkMutations(source, ++seed));
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}